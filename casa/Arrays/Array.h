@@ -179,6 +179,13 @@ public:
     // initial value.
     Array(const IPosition &shape, const T &initialValue);
 
+    // Create an array of the given shape using the given allocator for
+    // its storage (e.g. to get aligned or pooled storage).
+    // Elements of a POD type are uninitialized.
+    // Other constructors use the default allocator (see
+    // <linkto class=StorageAllocator>StorageAllocator</linkto>).
+    Array(const IPosition &shape, const StorageAllocator &allocator);
+
     // After construction, this and other reference the same storage.
     Array(const Array<T> &other);
 
@@ -776,6 +783,10 @@ protected:
     // The end for an STL-style iteration.
     T* end_p;
 
+    // Create a Block for n elements using the given allocator.
+    // If null, the default array allocator is used.
+    static Block<T>* makeBlock (size_t n, const StorageAllocator* allocator);
+
 
     // Fill the steps and the end for a derived class.
     void makeSteps()
@@ -29,6 +29,7 @@
 #include <casa/Arrays/MaskedArray.h>
 #include <casa/Arrays/Slicer.h>
 #include <casa/Arrays/ArrayIter.h>
+#include <casa/Arrays/ArrayChunkIter.h>
 #include <casa/Arrays/ArrayError.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/BasicMath/Functional.h>
@@ -51,7 +52,7 @@ template<class T> Array<T>::Array()
 template<class T> Array<T>::Array(const IPosition &Shape)
 : ArrayBase (Shape)
 {
-    data_p = new Block<T>(nelements());
+    data_p = makeBlock (nelements(), 0);
     begin_p = data_p->storage();
     setEndIter();
     DebugAssert(ok(), ArrayError);
@@ -64,13 +65,35 @@ template<class T> Array<T>::Array(const IPosition &Shape,
 				  const T &initialValue)
 : ArrayBase (Shape)
 {
-    data_p = new Block<T>(nelements());
+    data_p = makeBlock (nelements(), 0);
     begin_p = data_p->storage();
     setEndIter();
     DebugAssert(ok(), ArrayError);
     objset (begin_p, initialValue, nels_p);
 }
 
+// <thrown>
+//   <item> ArrayShapeError
+// </thrown>
+template<class T> Array<T>::Array(const IPosition &Shape,
+				  const StorageAllocator &allocator)
+: ArrayBase (Shape)
+{
+    data_p = makeBlock (nelements(), &allocator);
+    begin_p = data_p->storage();
+    setEndIter();
+    DebugAssert(ok(), ArrayError);
+}
+
+template<class T>
+Block<T>* Array<T>::makeBlock (size_t n, const StorageAllocator* allocator)
+{
+    if (allocator == 0) {
+        allocator = StorageAllocator::arrayDefault();
+    }
+    return (allocator == 0  ?  new Block<T>(n) : new Block<T>(n, *allocator));
+}
+
 
 template<class T> Array<T>::Array(const Array<T> &other)
 : ArrayBase (other),
@@ -152,33 +175,14 @@ template<class T> Array<T> Array<T>::copy() const
         return vp;
     } else if (contiguousStorage()) {
 	objcopy (vp.begin_p, begin_p, nels_p);
-    } else if (ndim() == 1) {
-	objcopy (vp.begin_p, begin_p, uInt(length_p(0)), 1U, uInt(inc_p(0)));
-    } else if (length_p(0) == 1  &&  ndim() == 2) {
-        // Special case which can be quite common (e.g. row in a matrix).
-	objcopy (vp.begin_p, begin_p, uInt(length_p(1)), 1U,
-		 uInt(originalLength_p(0)*inc_p(1)));
-    } else if (length_p(0) <= 25) {
-        // If not many elements on a line, it's better to use this loop.
-        T* ptr = vp.begin_p;
-        const_iterator iterend=end();
-        for (const_iterator iter=begin(); iter!=iterend; ++iter) {
-	    *ptr++ = *iter;
-	}
     } else {
-	// Step through Vector by Vector
-	// The output is guaranteed to have all incs set to 1
-	ArrayPositionIterator ai(shape(), 1);
-	IPosition index(ndim());
-        size_t offset;
-        size_t count=0;
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    objcopy (vp.begin_p + count*length_p(0), begin_p+offset,
-		     uInt(length_p(0)), 1U, uInt(inc_p(0)));
-	    ai.next(); count++;
+	// Copy chunk by chunk; the output is contiguous.
+	T* ptr = vp.begin_p;
+	for (ArrayChunkStepper iter(length_p, steps_p); !iter.pastEnd();
+	     iter.next()) {
+	    objcopy (ptr, begin_p + iter.offset(), iter.length(),
+		     1U, iter.incr());
+	    ptr += iter.length();
 	}
     }
     return vp;
@@ -195,44 +199,18 @@ template<class T> Array<T> &Array<T>::operator=(const Array<T> &other)
     if (!Conform  &&  nelements() != 0) {
 	validateConformance(other);  // We can't overwrite, so throw exception
     }
-    size_t offset, offset2;
-    IPosition index(other.ndim());
 
     if (Conform == True) { // Copy in place
         if (ndim() == 0) {
 	    return *this;
 	} else if (contiguousStorage() && other.contiguousStorage()) {
 	    objcopy (begin_p, other.begin_p, nels_p);
-	} else if (ndim() == 1) {
-	    objcopy (begin_p, other.begin_p, uInt(length_p(0)), uInt(inc_p(0)),
-		     uInt(other.inc_p(0)));
-	} else if (length_p(0) == 1  &&  ndim() == 2) {
-            // Special case which can be quite common (e.g. row in a matrix).
-	    objcopy (begin_p, other.begin_p, uInt(length_p(1)),
-		     uInt(originalLength_p(0)*inc_p(1)),
-		     uInt(other.originalLength_p(0)*other.inc_p(1)));
-	} else if (length_p(0) <= 25) {
-	    // If not many elements on a line, it's better to use this loop.
-	    const_iterator from(other.begin());
-	    iterator iterend=end();
-	    for (iterator iter=begin(); iter!=iterend; ++iter) {
-	        *iter = *from;
-		++from;
-	    }
 	} else {
-	    ArrayPositionIterator ai(other.shape(), 1);
-	    // Step through Vector by Vector
-	    while (! ai.pastEnd()) {
-	        index = ai.pos();
-		offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-					  inc_p.storage(), index);
-		offset2 = ArrayIndexOffset(other.ndim(),
-					   other.originalLength_p.storage(),
-					   other.inc_p.storage(), index);
-		objcopy (begin_p+offset, other.begin_p+offset2,
-			 uInt(length_p(0)), uInt(inc_p(0)),
-			 uInt(other.inc_p(0)));
-		ai.next();
+	    // Copy chunk by chunk.
+	    for (ArrayChunkStepper iter(length_p, steps_p, other.steps_p);
+		 !iter.pastEnd(); iter.next()) {
+		objcopy (begin_p + iter.offset(), other.begin_p + iter.offset2(),
+			 iter.length(), iter.incr(), iter.incr2());
 	    }
 	}
     } else {
@@ -296,36 +274,16 @@ template<class T> void Array<T>::set(const T &Value)
 {
     DebugAssert(ok(), ArrayError);
 
-    // Ultimately we should go to RawFillAll functions
-    // RawFillAll(ndim(), begin_p, inc_p.storage(), length_p.storage(), Value);
-    // Step through Vector by Vector
-    size_t offset;
     if (ndim() == 0) {
         return;
     } else if (contiguousStorage()) {
 	objset (begin_p, Value, nels_p);
-    } else if (ndim() == 1) {
-	objset (begin_p, Value, uInt(length_p(0)), uInt(inc_p(0)));
-    } else if (length_p(0) == 1  &&  ndim() == 2) {
-        // Special case which can be quite common (e.g. row in a matrix).
-        objset (begin_p, Value, uInt(length_p(1)),
-		uInt(originalLength_p(0)*inc_p(1)));
-    } else if (length_p(0) <= 25) {
-        // If not many elements on a line, it's better to use this loop.
-        iterator iterend=end();
-        for (iterator iter=begin(); iter!=iterend; ++iter) {
-	    *iter = Value;
-	}
     } else {
-	// Step through Vector by Vector
-	ArrayPositionIterator ai(shape(), 1);
-	IPosition index(ndim());
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    objset(begin_p+offset, Value, uInt(length_p(0)), uInt(inc_p(0)));
-	    ai.next();
+	// Step through the array chunk by chunk.
+	for (ArrayChunkStepper iter(length_p, steps_p); !iter.pastEnd();
+	     iter.next()) {
+	    objset (begin_p + iter.offset(), Value, iter.length(),
+		    iter.incr());
 	}
     }
 }
@@ -343,22 +301,15 @@ template<class T> void Array<T>::apply(T (*function)(T))
 	    begin_p[i] = function(begin_p[i]);
 	}
     } else {
-	// Step through Vector by Vector
-	ArrayPositionIterator ai(shape(), 1);
-	IPosition index(ndim());
-
-	uInt len  = length_p(0);
-	uInt incr = inc_p(0);
-	size_t offset;
-
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    for (uInt i=0; i < len; i++) {
-		begin_p[offset + i*incr] = function(begin_p[offset + i*incr]);
+	// Step through the array chunk by chunk.
+	for (ArrayChunkStepper iter(length_p, steps_p); !iter.pastEnd();
+	     iter.next()) {
+	    T* ptr = begin_p + iter.offset();
+	    size_t incr = iter.incr();
+	    size_t n = iter.length() * incr;
+	    for (size_t k=0; k<n; k+=incr) {
+		ptr[k] = function(ptr[k]);
 	    }
-	    ai.next();
 	}
     }
 }
@@ -376,22 +327,15 @@ template<class T> void Array<T>::apply(T (*function)(const T &))
 	    begin_p[i] = function(begin_p[i]);
 	}
     } else {
-	// Step through Vector by Vector
-	ArrayPositionIterator ai(shape(), 1);
-	IPosition index(ndim());
-
-	uInt len  = length_p(0);
-	uInt incr = inc_p(0);
-	size_t offset;
-
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    for (uInt i=0; i < len; i++) {
-		begin_p[offset+i*incr] = function(begin_p[offset+i*incr]);
+	// Step through the array chunk by chunk.
+	for (ArrayChunkStepper iter(length_p, steps_p); !iter.pastEnd();
+	     iter.next()) {
+	    T* ptr = begin_p + iter.offset();
+	    size_t incr = iter.incr();
+	    size_t n = iter.length() * incr;
+	    for (size_t k=0; k<n; k+=incr) {
+		ptr[k] = function(ptr[k]);
 	    }
-	    ai.next();
 	}
     }
 }
@@ -409,22 +353,15 @@ template<class T> void Array<T>::apply(const Functional<T,T> &function)
 	    begin_p[i] = function(begin_p[i]);
 	}
     } else {
-	// Step through Vector by Vector
-	ArrayPositionIterator ai(shape(), 1);
-	IPosition index(ndim());
-
-	uInt len  = length_p(0);
-	uInt incr = inc_p(0);
-	size_t offset;
-
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    for (uInt i=0; i < len; i++) {
-		begin_p[offset+i*incr] = function(begin_p[offset+i*incr]);
+	// Step through the array chunk by chunk.
+	for (ArrayChunkStepper iter(length_p, steps_p); !iter.pastEnd();
+	     iter.next()) {
+	    T* ptr = begin_p + iter.offset();
+	    size_t incr = iter.incr();
+	    size_t n = iter.length() * incr;
+	    for (size_t k=0; k<n; k+=incr) {
+		ptr[k] = function(ptr[k]);
 	    }
-	    ai.next();
 	}
     }
 }
@@ -563,7 +500,11 @@ template<class T> void Array<T>::resize(const IPosition &len, Bool copyValues)
       return;
     }
     // OK we differ, so we really have to resize ourselves.
-    Array<T> tmp(len);
+    // Keep using the same allocator.
+    const StorageAllocator* allocator =
+      (data_p.null()  ?  0 : data_p->allocator());
+    Array<T> tmp (allocator == 0  ?  Array<T>(len) :
+                                     Array<T>(len, *allocator));
     // Copy the contents if needed.
     if (copyValues) {
       tmp.copyMatchingPart (*this);
@@ -776,33 +717,12 @@ template<class T> T *Array<T>::getStorage(Bool &deleteIt)
     if (storage == 0) {
 	throw(ArrayError("Array<T>::getStorage - new of copy buffer fails"));
     }
-    // ok - copy it
-    if (ndim() == 1) {
-	objcopy(storage, begin_p, uInt(length_p(0)), 1U, uInt(inc_p(0)));
-    } else if (length_p(0) == 1  &&  ndim() == 2) {
-        // Special case which can be quite common (e.g. row in a matrix).
-	objcopy(storage, begin_p, uInt(length_p(1)), 1U,
-		uInt(originalLength_p(0)*inc_p(1)));
-    } else if (length_p(0) <= 25) {
-        // If not many elements on a line, it's better to use this loop.
-        T* ptr = storage;
-	iterator iterend=end();
-        for (iterator iter=begin(); iter!=iterend; ++iter) {
-	    *ptr++ = *iter;
-	}
-    } else {
-	ArrayPositionIterator ai(this->shape(), 1);
-	size_t offset;
-	IPosition index(ndim());
-	uInt count=0;
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    objcopy(storage + count*length_p(0), begin_p+offset,
-		    uInt(length_p(0)), 1U, uInt(inc_p(0)));
-	    ai.next(); count++;
-	}
+    // ok - copy it chunk by chunk
+    T* ptr = storage;
+    for (ArrayChunkStepper iter(length_p, steps_p); !iter.pastEnd();
+	 iter.next()) {
+	objcopy (ptr, begin_p + iter.offset(), iter.length(), 1U, iter.incr());
+	ptr += iter.length();
     }
     return storage;
 }
@@ -816,32 +736,11 @@ template<class T> void Array<T>::putStorage(T *&storage, Bool deleteAndCopy)
 	return;
     }
 
-    if (ndim() == 1) {
-	objcopy(begin_p, storage, uInt(length_p(0)), uInt(inc_p(0)), 1U);
-    } else if (length_p(0) == 1  &&  ndim() == 2) {
-        // Special case which can be quite common (e.g. row in a matrix).
-	objcopy(begin_p, storage, uInt(length_p(1)),
-		uInt(originalLength_p(0)*inc_p(1)), 1U);
-    } else if (length_p(0) <= 25) {
-        // If not many elements on a line, it's better to use this loop.
-        const T* ptr = storage;
-        iterator iterend=end();
-        for (iterator iter=begin(); iter!=iterend; ++iter) {
-	    *iter = *ptr++;
-	}
-    } else {
-	ArrayPositionIterator ai(this->shape(), 1);
-	size_t offset;
-	IPosition index(ndim());
-	size_t count=0;
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    objcopy(begin_p+offset, storage+count*length_p(0),
-		    uInt(length_p(0)), uInt(inc_p(0)), 1U);
-	    ai.next(); count++;
-	}
+    const T* ptr = storage;
+    for (ArrayChunkStepper iter(length_p, steps_p); !iter.pastEnd();
+	 iter.next()) {
+	objcopy (begin_p + iter.offset(), ptr, iter.length(), iter.incr(), 1U);
+	ptr += iter.length();
     }
     delete [] storage;
     storage = 0;
@@ -897,7 +796,7 @@ void Array<T>::takeStorage(const IPosition &shape, T *storage,
     case COPY:
 	if (data_p.null()  ||  data_p.nrefs() > 1
         ||  data_p->nelements() != new_nels) {
-	    data_p = new Block<T>(new_nels);
+	    data_p = makeBlock (new_nels, 0);
 	}
 	objcopy(data_p->storage(), storage, new_nels);
 	break;
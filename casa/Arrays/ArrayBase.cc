@@ -436,7 +436,7 @@ void ArrayBase::baseMakeSteps()
   // No Assert since the Array may not be constructed yet when
   // calling this.
   steps_p.resize (ndimen_p);
-  Int size = 1;
+  ssize_t size = 1;
   for (uInt i=0; i<inc_p.nelements(); i++) {
     steps_p(i) = inc_p(i) * size;
     size *= originalLength_p(i);
@@ -0,0 +1,116 @@
+//# ArrayChunkIter.cc: Iterate through the contiguous chunks of an Array
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casa/Arrays/ArrayChunkIter.h>
+#include <casa/Arrays/ArrayError.h>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+ArrayChunkStepper::ArrayChunkStepper (const IPosition& shape,
+                                      const IPosition& steps)
+{
+  init (shape, steps, steps);
+}
+
+ArrayChunkStepper::ArrayChunkStepper (const IPosition& shape,
+                                      const IPosition& steps1,
+                                      const IPosition& steps2)
+{
+  init (shape, steps1, steps2);
+}
+
+void ArrayChunkStepper::init (const IPosition& shape,
+                              const IPosition& steps1,
+                              const IPosition& steps2)
+{
+  uInt ndim = shape.nelements();
+  if (steps1.nelements() != ndim  ||  steps2.nelements() != ndim) {
+    throw ArrayConformanceError ("ArrayChunkStepper: shape and steps "
+                                 "have different lengths");
+  }
+  itsLength  = 1;
+  itsIncr1   = 1;
+  itsIncr2   = 1;
+  itsNChunk  = 0;
+  itsNOuter  = 0;
+  itsShape.resize (ndim, False);
+  itsStep1.resize (ndim, False);
+  itsStep2.resize (ndim, False);
+  // Nothing to do for an empty array.
+  if (ndim == 0  ||  shape.product() == 0) {
+    itsPos.resize (0);
+    reset();
+    itsPastEnd = True;
+    return;
+  }
+  // Axes with length 1 do not matter.
+  // Merge the first axes as long as the stride is constant in both arrays.
+  uInt axis = 0;
+  while (axis < ndim  &&  shape[axis] == 1) {
+    ++axis;
+  }
+  if (axis < ndim) {
+    itsLength = shape[axis];
+    itsIncr1  = steps1[axis];
+    itsIncr2  = steps2[axis];
+    for (++axis; axis<ndim; ++axis) {
+      if (shape[axis] != 1) {
+        if (steps1[axis] != ssize_t(itsIncr1*itsLength)  ||
+            steps2[axis] != ssize_t(itsIncr2*itsLength)) {
+          break;
+        }
+        itsLength *= shape[axis];
+      }
+    }
+  }
+  // The other axes are the outer ones.
+  itsNChunk = 1;
+  for (; axis<ndim; ++axis) {
+    if (shape[axis] != 1) {
+      itsShape[itsNOuter] = shape[axis];
+      itsStep1[itsNOuter] = steps1[axis];
+      itsStep2[itsNOuter] = steps2[axis];
+      itsNChunk *= shape[axis];
+      ++itsNOuter;
+    }
+  }
+  itsShape.resize (itsNOuter);
+  itsStep1.resize (itsNOuter);
+  itsStep2.resize (itsNOuter);
+  itsPos.resize (itsNOuter, False);
+  reset();
+}
+
+void ArrayChunkStepper::reset()
+{
+  itsOffset1 = 0;
+  itsOffset2 = 0;
+  itsPos = 0;
+  itsPastEnd = (itsNChunk == 0);
+}
+
+} //# NAMESPACE CASA - END
@@ -0,0 +1,349 @@
+//# ArrayChunkIter.h: Iterate through the contiguous chunks of an Array
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_ARRAYCHUNKITER_H
+#define CASA_ARRAYCHUNKITER_H
+
+#include <casa/aips.h>
+#include <casa/Arrays/IPosition.h>
+#include <iterator>
+#include <cstddef>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Forward Declarations
+template<class T> class Array;
+
+// <summary>
+// Random access iterator stepping through memory with a fixed stride
+// </summary>
+// <use visibility=export>
+// <reviewed reviewer="" date="" tests="tArrayChunkIter.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// StridedIterator is a lightweight STL random access iterator for data
+// elements that are <src>incr</src> elements apart in memory. It is the
+// iterator type of a chunk given by an
+// <linkto class=ArrayChunkIterator>ArrayChunkIterator</linkto>, but it can
+// be used for any strided data (e.g. a row of a contiguous Matrix).
+// <br>Use <src>StridedIterator<const T></src> for read-only access.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Matrix<Float> mat(10,20);
+//   // Iterate through the first row.
+//   StridedIterator<Float> beg(mat.data(), 10);
+//   std::fill (beg, beg+20, Float(1));
+// </srcblock>
+// </example>
+
+template<typename T> class StridedIterator
+{
+public:
+  typedef T                               value_type;
+  typedef T*                              pointer;
+  typedef T&                              reference;
+  typedef ptrdiff_t                       difference_type;
+  typedef std::random_access_iterator_tag iterator_category;
+
+  // Construct from a pointer and a stride (in elements).
+  // The default constructor gives a null iterator.
+  explicit StridedIterator (T* ptr=0, size_t incr=1)
+    : itsPtr(ptr), itsIncr(incr) {}
+
+  // Get the underlying pointer and stride.
+  // <group>
+  T* pos() const
+    { return itsPtr; }
+  size_t incr() const
+    { return itsIncr; }
+  // </group>
+
+  T& operator*() const
+    { return *itsPtr; }
+  T* operator->() const
+    { return itsPtr; }
+  T& operator[] (difference_type n) const
+    { return itsPtr[n*difference_type(itsIncr)]; }
+
+  StridedIterator& operator++()
+    { itsPtr += itsIncr; return *this; }
+  StridedIterator operator++(int)
+    { StridedIterator old(*this); itsPtr += itsIncr; return old; }
+  StridedIterator& operator--()
+    { itsPtr -= itsIncr; return *this; }
+  StridedIterator operator--(int)
+    { StridedIterator old(*this); itsPtr -= itsIncr; return old; }
+  StridedIterator& operator+= (difference_type n)
+    { itsPtr += n*difference_type(itsIncr); return *this; }
+  StridedIterator& operator-= (difference_type n)
+    { itsPtr -= n*difference_type(itsIncr); return *this; }
+  StridedIterator operator+ (difference_type n) const
+    { return StridedIterator (itsPtr + n*difference_type(itsIncr), itsIncr); }
+  StridedIterator operator- (difference_type n) const
+    { return StridedIterator (itsPtr - n*difference_type(itsIncr), itsIncr); }
+  difference_type operator- (const StridedIterator& other) const
+    { return (itsPtr - other.itsPtr) / difference_type(itsIncr); }
+
+  bool operator== (const StridedIterator& other) const
+    { return itsPtr == other.itsPtr; }
+  bool operator!= (const StridedIterator& other) const
+    { return itsPtr != other.itsPtr; }
+  bool operator< (const StridedIterator& other) const
+    { return itsPtr < other.itsPtr; }
+  bool operator> (const StridedIterator& other) const
+    { return itsPtr > other.itsPtr; }
+  bool operator<= (const StridedIterator& other) const
+    { return itsPtr <= other.itsPtr; }
+  bool operator>= (const StridedIterator& other) const
+    { return itsPtr >= other.itsPtr; }
+
+  // Convert to a read-only iterator.
+  operator StridedIterator<const T>() const
+    { return StridedIterator<const T> (itsPtr, itsIncr); }
+
+private:
+  T*     itsPtr;
+  size_t itsIncr;
+};
+
+
+// <summary>
+// Step through the chunks of one or two arrays with a constant stride
+// </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tArrayChunkIter.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// ArrayChunkStepper divides the elements of an array into "chunks".
+// A chunk is a run of elements with a constant stride in memory. Consecutive
+// axes are merged into a single chunk as long as the stride stays constant
+// and axes with length 1 are ignored, so a contiguous array consists of a
+// single chunk, a row of a Matrix is a single strided chunk, and a section
+// of a Cube with full first axes consists of contiguous planes.
+// <br>The stepper only deals with offsets (in elements) with respect to the
+// start of the array, so it is not templated. Iteration is done by simple
+// integer arithmetic in an inline function without any virtual calls or
+// IPosition copies, which makes it much faster than
+// <linkto class=ArrayPositionIterator>ArrayPositionIterator</linkto>.
+// <br>Two conforming arrays with different steps (e.g. a contiguous array and
+// an array section) can be stepped through in parallel. In that case the
+// stride has to be constant in both arrays for a chunk.
+// <br>Usually the templated classes
+// <linkto class=ArrayChunkIterator>ArrayChunkIterator</linkto> and
+// <linkto class=ReadOnlyArrayChunkIterator>ReadOnlyArrayChunkIterator</linkto>
+// are used for a single array. The Array class itself uses this class to
+// copy or set its data.
+// </synopsis>
+//
+// <example>
+// Copy an array into another one with the same shape.
+// <srcblock>
+//   ArrayChunkStepper iter(to.shape(), to.steps(), from.steps());
+//   T* toData = to.data();
+//   const T* fromData = from.data();
+//   for (; !iter.pastEnd(); iter.next()) {
+//     objcopy (toData + iter.offset(), fromData + iter.offset2(),
+//              iter.length(), iter.incr(), iter.incr2());
+//   }
+// </srcblock>
+// </example>
+
+class ArrayChunkStepper
+{
+public:
+  // Step through the chunks of an array with the given shape and steps
+  // (as returned by <src>ArrayBase::steps()</src>).
+  ArrayChunkStepper (const IPosition& shape, const IPosition& steps);
+
+  // Step through two arrays with the given shape in parallel.
+  ArrayChunkStepper (const IPosition& shape, const IPosition& steps1,
+                     const IPosition& steps2);
+
+  // Is the iteration past the last chunk?
+  Bool pastEnd() const
+    { return itsPastEnd; }
+
+  // Get the number of elements in each chunk.
+  size_t length() const
+    { return itsLength; }
+
+  // Get the stride of the elements in a chunk of the first
+  // or the second array.
+  // <group>
+  size_t incr() const
+    { return itsIncr1; }
+  size_t incr2() const
+    { return itsIncr2; }
+  // </group>
+
+  // Get the offset of the current chunk in the first or second array.
+  // <group>
+  size_t offset() const
+    { return itsOffset1; }
+  size_t offset2() const
+    { return itsOffset2; }
+  // </group>
+
+  // Get the total number of chunks.
+  size_t nchunks() const
+    { return itsNChunk; }
+
+  // Step to the next chunk.
+  void next()
+  {
+    for (uInt i=0; i<itsNOuter; ++i) {
+      itsOffset1 += itsStep1[i];
+      itsOffset2 += itsStep2[i];
+      if (++itsPos[i] < itsShape[i]) {
+        return;
+      }
+      itsPos[i] = 0;
+      itsOffset1 -= itsShape[i] * itsStep1[i];
+      itsOffset2 -= itsShape[i] * itsStep2[i];
+    }
+    itsPastEnd = True;
+  }
+
+  // Reset to the first chunk.
+  void reset();
+
+private:
+  void init (const IPosition& shape, const IPosition& steps1,
+             const IPosition& steps2);
+
+  size_t    itsLength;
+  size_t    itsIncr1;
+  size_t    itsIncr2;
+  size_t    itsNChunk;
+  ssize_t   itsOffset1;
+  ssize_t   itsOffset2;
+  uInt      itsNOuter;
+  Bool      itsPastEnd;
+  //# Shape, steps and position of the axes outside the chunk.
+  IPosition itsShape;
+  IPosition itsStep1;
+  IPosition itsStep2;
+  IPosition itsPos;
+};
+
+
+// <summary>
+// Iterate through the contiguous or strided chunks of an Array
+// </summary>
+// <use visibility=export>
+// <reviewed reviewer="" date="" tests="tArrayChunkIter.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// ArrayChunkIterator hands out raw pointer ranges for each run of
+// elements with a constant stride in an Array (see
+// <linkto class=ArrayChunkStepper>ArrayChunkStepper</linkto>). The chunks are
+// given in the order of the elements in the array. Usually the stride is 1,
+// so the chunk can be processed with plain pointer loops which the compiler
+// can vectorize. For a contiguous array there is only one chunk.
+// <br>It is a lightweight alternative for
+// <linkto class=ArrayIterator>ArrayIterator</linkto> when the inner loop
+// of an algorithm does not need to know the position of the data.
+// <br>ReadOnlyArrayChunkIterator does the same for a const Array.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Array<Float> arr = bigArray(blc, trc);
+//   for (ArrayChunkIterator<Float> iter(arr); !iter.pastEnd(); iter.next()) {
+//     if (iter.incr() == 1) {
+//       Float* data = iter.data();
+//       for (size_t i=0; i<iter.length(); ++i) {
+//         data[i] *= 2;
+//       }
+//     } else {
+//       std::transform (iter.begin(), iter.end(), iter.begin(), myFunc);
+//     }
+//   }
+// </srcblock>
+// </example>
+
+template<typename T> class ArrayChunkIterator : public ArrayChunkStepper
+{
+public:
+  typedef StridedIterator<T> iterator;
+
+  explicit ArrayChunkIterator (Array<T>& arr)
+    : ArrayChunkStepper (arr.shape(), arr.steps()),
+      itsData (arr.data())
+    {}
+
+  // Get a pointer to the first element of the current chunk.
+  T* data() const
+    { return itsData + offset(); }
+
+  // Get the STL iterators for the current chunk.
+  // <group>
+  iterator begin() const
+    { return iterator (data(), incr()); }
+  iterator end() const
+    { return iterator (data() + length()*incr(), incr()); }
+  // </group>
+
+private:
+  T* itsData;
+};
+
+template<typename T> class ReadOnlyArrayChunkIterator : public ArrayChunkStepper
+{
+public:
+  typedef StridedIterator<const T> iterator;
+
+  explicit ReadOnlyArrayChunkIterator (const Array<T>& arr)
+    : ArrayChunkStepper (arr.shape(), arr.steps()),
+      itsData (arr.data())
+    {}
+
+  // Get a pointer to the first element of the current chunk.
+  const T* data() const
+    { return itsData + offset(); }
+
+  // Get the STL iterators for the current chunk.
+  // <group>
+  iterator begin() const
+    { return iterator (data(), incr()); }
+  iterator end() const
+    { return iterator (data() + length()*incr(), incr()); }
+  // </group>
+
+private:
+  const T* itsData;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -0,0 +1,405 @@
+//# ArrayExpr.h: Lazily evaluated expressions of arrays
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_ARRAYEXPR_H
+#define CASA_ARRAYEXPR_H
+
+#include <casa/aips.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/BasicMath/Functors.h>
+#include <casa/BasicSL/Complex.h>
+#include <casa/Exceptions/Error.h>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+// <summary>
+//    Lazily evaluated element-wise expressions of arrays.
+// </summary>
+// <reviewed reviewer="UNKNOWN" date="" tests="tArrayExpr">
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+//   <li> <linkto group="ArrayMath.h#Array mathematical operations">ArrayMath</linkto>
+// </prerequisite>
+//
+// <synopsis>
+// The mathematical operators and functions in ArrayMath.h evaluate
+// immediately, so an expression like <src>sqrt(a*a + b*b) * w</src>
+// creates a temporary array for each operator and function, thus passes
+// four times over the data.
+// <br>The classes and functions in this file build an expression tree
+// instead (expression templates), which is evaluated in a single pass
+// by <src>arrayExprEval</src> or <src>arrayExprResult</src>.
+// An expression is started by wrapping an array (or Vector, Matrix, Cube)
+// in <src>arrayExpr</src>. The usual operators and mathematical functions
+// can be applied to it, where the other operand can be another expression,
+// an array, or a scalar.
+// <br>The tree holds references to the arrays, so it should be evaluated
+// in the same statement in which it is created.
+//
+// When all arrays (including the result) are contiguous, the evaluation
+// is a simple loop over the data pointers which compilers can vectorize.
+// Otherwise the arrays are iterated in the usual way.
+// The result may be one of the operands, because each element is read
+// before the corresponding element of the result is written.
+//
+// As with the ArrayMath operators, the shapes of all arrays must be equal;
+// an exception is thrown otherwise.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Matrix<Float> a(10,20), b(10,20), w(10,20), c;
+//      . . .
+//   // Evaluate in a single pass without temporaries.
+//   c = arrayExprResult (sqrt(arrayExpr(a)*a + arrayExpr(b)*b) * w);
+//   // Evaluate into an existing array.
+//   arrayExprEval (c, arrayExpr(c) * 2.f + a);
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Array arithmetic dominates many applications, where the memory traffic
+// and allocation of the temporaries is the main cost.
+// </motivation>
+//
+// <group name="Array expressions">
+
+
+// Expression node for an array.
+// The array has to stay alive while the expression is used.
+template<typename T> class ArrayExprLeaf
+{
+public:
+  typedef T value_type;
+  explicit ArrayExprLeaf (const Array<T>& arr)
+    : itsArray (&arr),
+      itsData  (arr.data())
+    {}
+  Bool contiguous() const
+    { return itsArray->contiguousStorage(); }
+  void getShape (IPosition& shape, Bool& defined) const
+  {
+    if (! defined) {
+      shape   = itsArray->shape();
+      defined = True;
+    } else if (! shape.isEqual (itsArray->shape())) {
+      throwArrayShapes ("arrayExprEval");
+    }
+  }
+  T operator[] (size_t i) const
+    { return itsData[i]; }
+  void initIter()
+    { itsIter = itsArray->begin(); }
+  T next()
+    { T v = *itsIter; ++itsIter; return v; }
+private:
+  const Array<T>* itsArray;
+  const T*        itsData;
+  typename Array<T>::const_iterator itsIter;
+};
+
+// Expression node for a scalar.
+template<typename T> class ArrayExprScalar
+{
+public:
+  typedef T value_type;
+  explicit ArrayExprScalar (const T& value)
+    : itsValue (value)
+    {}
+  Bool contiguous() const
+    { return True; }
+  void getShape (IPosition&, Bool&) const
+    {}
+  T operator[] (size_t) const
+    { return itsValue; }
+  void initIter()
+    {}
+  T next()
+    { return itsValue; }
+private:
+  T itsValue;
+};
+
+// Expression node applying a unary operator.
+template<typename E, typename Op> class ArrayExprUnary
+{
+public:
+  typedef typename Op::result_type value_type;
+  explicit ArrayExprUnary (const E& expr, Op op=Op())
+    : itsExpr (expr),
+      itsOp   (op)
+    {}
+  Bool contiguous() const
+    { return itsExpr.contiguous(); }
+  void getShape (IPosition& shape, Bool& defined) const
+    { itsExpr.getShape (shape, defined); }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsExpr[i]); }
+  void initIter()
+    { itsExpr.initIter(); }
+  value_type next()
+    { return itsOp (itsExpr.next()); }
+private:
+  E  itsExpr;
+  Op itsOp;
+};
+
+// Expression node applying a binary operator.
+template<typename L, typename R, typename Op> class ArrayExprBinary
+{
+public:
+  typedef typename Op::result_type value_type;
+  ArrayExprBinary (const L& left, const R& right, Op op=Op())
+    : itsLeft  (left),
+      itsRight (right),
+      itsOp    (op)
+    {}
+  Bool contiguous() const
+    { return itsLeft.contiguous()  &&  itsRight.contiguous(); }
+  void getShape (IPosition& shape, Bool& defined) const
+  {
+    itsLeft.getShape  (shape, defined);
+    itsRight.getShape (shape, defined);
+  }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsLeft[i], itsRight[i]); }
+  void initIter()
+    { itsLeft.initIter(); itsRight.initIter(); }
+  value_type next()
+  {
+    // Use separate statements to get a defined evaluation order.
+    typename L::value_type l = itsLeft.next();
+    return itsOp (l, itsRight.next());
+  }
+private:
+  L  itsLeft;
+  R  itsRight;
+  Op itsOp;
+};
+
+// An expression; the operators and functions are only defined for this
+// type to avoid clashes with the immediate Array operators.
+template<typename E> class ArrayExpr
+{
+public:
+  typedef typename E::value_type value_type;
+  explicit ArrayExpr (const E& expr)
+    : itsExpr (expr)
+    {}
+  const E& expr() const
+    { return itsExpr; }
+private:
+  E itsExpr;
+};
+
+// The real type of a (complex) type, used for e.g. amplitude.
+template<typename T> struct ArrayExprReal
+  { typedef T type; };
+template<> struct ArrayExprReal<Complex>
+  { typedef Float type; };
+template<> struct ArrayExprReal<DComplex>
+  { typedef Double type; };
+
+
+// Start an expression with an array.
+template<typename T>
+inline ArrayExpr<ArrayExprLeaf<T> > arrayExpr (const Array<T>& arr)
+  { return ArrayExpr<ArrayExprLeaf<T> > (ArrayExprLeaf<T>(arr)); }
+
+// Evaluate the expression in a single pass into the result array.
+// If the result array is empty, it is resized to the shape of the
+// expression. Otherwise the shapes must be equal.
+template<typename T, typename E>
+void arrayExprEval (Array<T>& result, const ArrayExpr<E>& expr)
+{
+  IPosition shape;
+  Bool defined = False;
+  expr.expr().getShape (shape, defined);
+  if (! defined) {
+    throw AipsError ("arrayExprEval: expression does not contain an array");
+  }
+  if (result.nelements() == 0) {
+    result.resize (shape);
+  } else if (! shape.isEqual (result.shape())) {
+    throwArrayShapes ("arrayExprEval");
+  }
+  E ex(expr.expr());
+  if (result.contiguousStorage()  &&  ex.contiguous()) {
+    T* res = result.data();
+    size_t n = result.nelements();
+    for (size_t i=0; i<n; ++i) {
+      res[i] = ex[i];
+    }
+  } else {
+    ex.initIter();
+    typename Array<T>::iterator end = result.end();
+    for (typename Array<T>::iterator iter=result.begin(); iter!=end; ++iter) {
+      *iter = ex.next();
+    }
+  }
+}
+
+// Evaluate the expression in a single pass into a new array.
+template<typename E>
+inline Array<typename E::value_type> arrayExprResult (const ArrayExpr<E>& expr)
+{
+  Array<typename E::value_type> result;
+  arrayExprEval (result, expr);
+  return result;
+}
+
+
+// Define a binary operator or function for all combinations of an
+// expression with an expression, array or scalar.
+#define ARRAYEXPR_BINARY(NAME, FUNCTOR) \
+template<typename L, typename R> \
+inline ArrayExpr<ArrayExprBinary<L,R,FUNCTOR<typename L::value_type> > > \
+NAME (const ArrayExpr<L>& left, const ArrayExpr<R>& right) \
+{ \
+  return ArrayExpr<ArrayExprBinary<L,R,FUNCTOR<typename L::value_type> > > \
+    (ArrayExprBinary<L,R,FUNCTOR<typename L::value_type> > \
+     (left.expr(), right.expr())); \
+} \
+template<typename L> \
+inline ArrayExpr<ArrayExprBinary<L,ArrayExprLeaf<typename L::value_type>, \
+                                 FUNCTOR<typename L::value_type> > > \
+NAME (const ArrayExpr<L>& left, const Array<typename L::value_type>& right) \
+  { return NAME (left, arrayExpr(right)); } \
+template<typename R> \
+inline ArrayExpr<ArrayExprBinary<ArrayExprLeaf<typename R::value_type>,R, \
+                                 FUNCTOR<typename R::value_type> > > \
+NAME (const Array<typename R::value_type>& left, const ArrayExpr<R>& right) \
+  { return NAME (arrayExpr(left), right); } \
+template<typename L> \
+inline ArrayExpr<ArrayExprBinary<L,ArrayExprScalar<typename L::value_type>, \
+                                 FUNCTOR<typename L::value_type> > > \
+NAME (const ArrayExpr<L>& left, const typename L::value_type& right) \
+{ \
+  typedef ArrayExprScalar<typename L::value_type> S; \
+  return ArrayExpr<ArrayExprBinary<L,S,FUNCTOR<typename L::value_type> > > \
+    (ArrayExprBinary<L,S,FUNCTOR<typename L::value_type> > \
+     (left.expr(), S(right))); \
+} \
+template<typename R> \
+inline ArrayExpr<ArrayExprBinary<ArrayExprScalar<typename R::value_type>,R, \
+                                 FUNCTOR<typename R::value_type> > > \
+NAME (const typename R::value_type& left, const ArrayExpr<R>& right) \
+{ \
+  typedef ArrayExprScalar<typename R::value_type> S; \
+  return ArrayExpr<ArrayExprBinary<S,R,FUNCTOR<typename R::value_type> > > \
+    (ArrayExprBinary<S,R,FUNCTOR<typename R::value_type> > \
+     (S(left), right.expr())); \
+}
+
+// Define a unary function giving the same type.
+#define ARRAYEXPR_UNARY(NAME, FUNCTOR) \
+template<typename E> \
+inline ArrayExpr<ArrayExprUnary<E,FUNCTOR<typename E::value_type> > > \
+NAME (const ArrayExpr<E>& expr) \
+{ \
+  return ArrayExpr<ArrayExprUnary<E,FUNCTOR<typename E::value_type> > > \
+    (ArrayExprUnary<E,FUNCTOR<typename E::value_type> > (expr.expr())); \
+}
+
+// Define a unary function giving the real type.
+#define ARRAYEXPR_UNARY_REAL(NAME, FUNCTOR) \
+template<typename E> \
+inline ArrayExpr<ArrayExprUnary<E,FUNCTOR<typename E::value_type, \
+                 typename ArrayExprReal<typename E::value_type>::type> > > \
+NAME (const ArrayExpr<E>& expr) \
+{ \
+  typedef FUNCTOR<typename E::value_type, \
+                  typename ArrayExprReal<typename E::value_type>::type> F; \
+  return ArrayExpr<ArrayExprUnary<E,F> > (ArrayExprUnary<E,F> (expr.expr())); \
+}
+
+// Element-wise arithmetic operators.
+// <group>
+ARRAYEXPR_BINARY (operator+, Plus)
+ARRAYEXPR_BINARY (operator-, Minus)
+ARRAYEXPR_BINARY (operator*, Multiplies)
+ARRAYEXPR_BINARY (operator/, Divides)
+template<typename E>
+inline ArrayExpr<ArrayExprUnary<E,std::negate<typename E::value_type> > >
+operator- (const ArrayExpr<E>& expr)
+{
+  typedef std::negate<typename E::value_type> F;
+  return ArrayExpr<ArrayExprUnary<E,F> > (ArrayExprUnary<E,F> (expr.expr()));
+}
+// </group>
+
+// Element-wise binary functions.
+// <group>
+ARRAYEXPR_BINARY (pow, Pow)
+ARRAYEXPR_BINARY (atan2, Atan2)
+ARRAYEXPR_BINARY (fmod, Fmod)
+ARRAYEXPR_BINARY (min, Min)
+ARRAYEXPR_BINARY (max, Max)
+// </group>
+
+// Element-wise unary functions.
+// <group>
+ARRAYEXPR_UNARY (sin, Sin)
+ARRAYEXPR_UNARY (sinh, Sinh)
+ARRAYEXPR_UNARY (asin, Asin)
+ARRAYEXPR_UNARY (cos, Cos)
+ARRAYEXPR_UNARY (cosh, Cosh)
+ARRAYEXPR_UNARY (acos, Acos)
+ARRAYEXPR_UNARY (tan, Tan)
+ARRAYEXPR_UNARY (tanh, Tanh)
+ARRAYEXPR_UNARY (atan, Atan)
+ARRAYEXPR_UNARY (square, Sqr)
+ARRAYEXPR_UNARY (cube, Pow3)
+ARRAYEXPR_UNARY (sqrt, Sqrt)
+ARRAYEXPR_UNARY (exp, Exp)
+ARRAYEXPR_UNARY (log, Log)
+ARRAYEXPR_UNARY (log10, Log10)
+ARRAYEXPR_UNARY (abs, Abs)
+ARRAYEXPR_UNARY (floor, Floor)
+ARRAYEXPR_UNARY (ceil, Ceil)
+ARRAYEXPR_UNARY (conj, Conj)
+// </group>
+
+// Element-wise functions on complex values giving a real value.
+// <group>
+ARRAYEXPR_UNARY_REAL (real, Real)
+ARRAYEXPR_UNARY_REAL (imag, Imag)
+ARRAYEXPR_UNARY_REAL (amplitude, CAbs)
+ARRAYEXPR_UNARY_REAL (phase, CArg)
+// </group>
+
+#undef ARRAYEXPR_BINARY
+#undef ARRAYEXPR_UNARY
+#undef ARRAYEXPR_UNARY_REAL
+
+// </group>
+
+} //# NAMESPACE CASA - END
+
+#endif
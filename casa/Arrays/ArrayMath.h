@@ -32,6 +32,7 @@
 #include <casa/BasicMath/Math.h>
 #include <casa/BasicMath/Functors.h>
 #include <casa/Arrays/Array.h>
+#include <casa/Arrays/ArrayChunkIter.h>
 //# Needed to get the proper Complex typedef's
 #include <casa/BasicSL/Complex.h>
 #include <casa/Utilities/Assert.h>
@@ -209,6 +210,19 @@ inline void arrayContTransform (const Array<L>& left, const Array<R>& right,
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     std::transform (left.cbegin(), left.cend(), right.cbegin(),
                     result.cbegin(), op);
+  } else if (left.shape().isEqual (right.shape())) {
+    // Step through the operands chunk by chunk.
+    RES* res = result.data();
+    for (ArrayChunkStepper iter(left.shape(), left.steps(), right.steps());
+         !iter.pastEnd(); iter.next()) {
+      StridedIterator<const L> liter(left.data() + iter.offset(),
+                                     iter.incr());
+      std::transform (liter, liter + iter.length(),
+                      StridedIterator<const R>(right.data() + iter.offset2(),
+                                               iter.incr2()),
+                      res, op);
+      res += iter.length();
+    }
   } else {
     std::transform (left.begin(), left.end(), right.begin(),
                     result.cbegin(), op);
@@ -228,10 +242,12 @@ inline void arrayContTransform (const Array<L>& left, R right,
     ////    std::transform (left.cbegin(), left.cend(),
     ////                    result.cbegin(), bind2nd(op, right));
   } else {
-    myrtransform (left.begin(), left.end(),
-                 result.cbegin(), right, op);
-    ////    std::transform (left.begin(), left.end(),
-    ////                    result.cbegin(), bind2nd(op, right));
+    RES* res = result.data();
+    for (ReadOnlyArrayChunkIterator<L> iter(left); !iter.pastEnd();
+         iter.next()) {
+      myrtransform (iter.begin(), iter.end(), res, right, op);
+      res += iter.length();
+    }
   }
 }
 
@@ -248,10 +264,12 @@ inline void arrayContTransform (L left, const Array<R>& right,
     ////    std::transform (right.cbegin(), right.cend(),
     ////                    result.cbegin(), bind1st(op, left));
   } else {
-    myltransform (right.begin(), right.end(),
-                  result.cbegin(), left, op);
-    ////    std::transform (right.begin(), right.end(),
-    ////                    result.cbegin(), bind1st(op, left));
+    RES* res = result.data();
+    for (ReadOnlyArrayChunkIterator<R> iter(right); !iter.pastEnd();
+         iter.next()) {
+      myltransform (iter.begin(), iter.end(), res, left, op);
+      res += iter.length();
+    }
   }
 }
 
@@ -265,7 +283,12 @@ inline void arrayContTransform (const Array<T>& arr,
   if (arr.contiguousStorage()) {
     std::transform (arr.cbegin(), arr.cend(), result.cbegin(), op);
   } else {
-    std::transform (arr.begin(), arr.end(), result.cbegin(), op);
+    RES* res = result.data();
+    for (ReadOnlyArrayChunkIterator<T> iter(arr); !iter.pastEnd();
+         iter.next()) {
+      std::transform (iter.begin(), iter.end(), res, op);
+      res += iter.length();
+    }
   }
 }
 
@@ -322,6 +345,16 @@ inline void arrayTransformInPlace (Array<L>& left, const Array<R>& right,
 {
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     transformInPlace (left.cbegin(), left.cend(), right.cbegin(), op);
+  } else if (left.shape().isEqual (right.shape())) {
+    // Step through the operands chunk by chunk.
+    for (ArrayChunkStepper iter(left.shape(), left.steps(), right.steps());
+         !iter.pastEnd(); iter.next()) {
+      StridedIterator<L> liter(left.data() + iter.offset(), iter.incr());
+      transformInPlace (liter, liter + iter.length(),
+                        StridedIterator<const R>(right.data() + iter.offset2(),
+                                                 iter.incr2()),
+                        op);
+    }
   } else {
     transformInPlace (left.begin(), left.end(), right.begin(), op);
   }
@@ -336,8 +369,9 @@ inline void arrayTransformInPlace (Array<L>& left, R right, BinaryOperator op)
     myiptransform (left.cbegin(), left.cend(), right, op);
     ////    transformInPlace (left.cbegin(), left.cend(), bind2nd(op, right));
   } else {
-    myiptransform (left.begin(), left.end(), right, op);
-    ////    transformInPlace (left.begin(), left.end(), bind2nd(op, right));
+    for (ArrayChunkIterator<L> iter(left); !iter.pastEnd(); iter.next()) {
+      myiptransform (iter.begin(), iter.end(), right, op);
+    }
   }
 }
 
@@ -350,11 +384,37 @@ inline void arrayTransformInPlace (Array<T>& arr, UnaryOperator op)
   if (arr.contiguousStorage()) {
     transformInPlace (arr.cbegin(), arr.cend(), op);
   } else {
-    transformInPlace (arr.begin(), arr.end(), op);
+    for (ArrayChunkIterator<T> iter(arr); !iter.pastEnd(); iter.next()) {
+      transformInPlace (iter.begin(), iter.end(), op);
+    }
   }
 }
 // </group>
 
+// Functions to reduce contiguous data in a fast and numerically stable way.
+// They are used by functions like sum, variance and minMax.
+// <br><src>pairwiseAccumulate</src> accumulates the <src>n</src> values
+// using the accumulation operator <src>op</src> (e.g. std::plus or
+// <src>SumSqr</src>) starting at T(). It uses pairwise summation, so the
+// rounding error grows as O(log n) instead of O(n). The innermost blocks
+// are accumulated in several independent partial sums, which makes it
+// possible for the compiler to vectorize the loop.
+// The masked version only accumulates the values having a True mask.
+// <br><src>contMinMax</src> finds the minimum and maximum of the values.
+// At least one value must be given.
+// <br>If compiled with OpenMP, large arrays are processed in chunks in
+// parallel. The chunk size is fixed, so the result does not depend on the
+// number of threads.
+// <group>
+template<typename T, typename AccumOperator>
+T pairwiseAccumulate (const T* data, size_t n, AccumOperator op);
+template<typename T, typename AccumOperator>
+T pairwiseAccumulate (const T* data, const Bool* mask, size_t n,
+                      AccumOperator op);
+template<typename T>
+void contMinMax (T& minVal, T& maxVal, const T* data, size_t n);
+// </group>
+
 // 
 // Element by element arithmetic modifying left in-place. left and other
 // must be conformant.
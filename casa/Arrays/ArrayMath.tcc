@@ -137,6 +137,167 @@ Array<T> arrayTransformResult (const Array<T>& arr, UnaryOperator op)
 }
 
 
+// Accumulate a block of values in 8 independent partial sums, so the
+// compiler can vectorize the loop.
+template<typename T, typename AccumOperator>
+inline T pairwiseAccumulateBlock (const T* data, size_t n, AccumOperator op)
+{
+  T s[8];
+  for (uInt j=0; j<8; ++j) {
+    s[j] = T();
+  }
+  size_t i = 0;
+  for (; i+8<=n; i+=8) {
+    for (uInt j=0; j<8; ++j) {
+      s[j] = op(s[j], data[i+j]);
+    }
+  }
+  for (; i<n; ++i) {
+    s[0] = op(s[0], data[i]);
+  }
+  return ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+}
+
+template<typename T, typename AccumOperator>
+inline T pairwiseAccumulateBlock (const T* data, const Bool* mask, size_t n,
+                                  AccumOperator op)
+{
+  T s[8];
+  for (uInt j=0; j<8; ++j) {
+    s[j] = T();
+  }
+  size_t i = 0;
+  for (; i+8<=n; i+=8) {
+    for (uInt j=0; j<8; ++j) {
+      s[j] = (mask[i+j]  ?  op(s[j], data[i+j]) : s[j]);
+    }
+  }
+  for (; i<n; ++i) {
+    if (mask[i]) {
+      s[0] = op(s[0], data[i]);
+    }
+  }
+  return ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+}
+
+// Split the data in halves until the blocks are small enough.
+template<typename T, typename AccumOperator>
+T pairwiseAccumulateRecur (const T* data, size_t n, AccumOperator op)
+{
+  if (n <= 128) {
+    return pairwiseAccumulateBlock (data, n, op);
+  }
+  size_t n2 = n/2;
+  return pairwiseAccumulateRecur (data, n2, op) +
+         pairwiseAccumulateRecur (data+n2, n-n2, op);
+}
+
+template<typename T, typename AccumOperator>
+T pairwiseAccumulateRecur (const T* data, const Bool* mask, size_t n,
+                           AccumOperator op)
+{
+  if (n <= 128) {
+    return pairwiseAccumulateBlock (data, mask, n, op);
+  }
+  size_t n2 = n/2;
+  return pairwiseAccumulateRecur (data, mask, n2, op) +
+         pairwiseAccumulateRecur (data+n2, mask+n2, n-n2, op);
+}
+
+// Large arrays are accumulated in chunks of a fixed size, which are summed
+// pairwise thereafter.
+template<typename T, typename AccumOperator>
+T pairwiseAccumulate (const T* data, size_t n, AccumOperator op)
+{
+  const size_t chunkSize = 65536;
+  if (n <= chunkSize) {
+    return pairwiseAccumulateRecur (data, n, op);
+  }
+  Int nchunk = (n + chunkSize - 1) / chunkSize;
+  Block<T> parts(nchunk);
+#ifdef _OPENMP
+#pragma omp parallel for if (nchunk >= 8)
+#endif
+  for (Int i=0; i<nchunk; ++i) {
+    size_t st = i*chunkSize;
+    parts[i] = pairwiseAccumulateRecur (data+st, std::min(chunkSize, n-st),
+                                        op);
+  }
+  return pairwiseAccumulateRecur (parts.storage(), nchunk, std::plus<T>());
+}
+
+template<typename T, typename AccumOperator>
+T pairwiseAccumulate (const T* data, const Bool* mask, size_t n,
+                      AccumOperator op)
+{
+  const size_t chunkSize = 65536;
+  if (n <= chunkSize) {
+    return pairwiseAccumulateRecur (data, mask, n, op);
+  }
+  Int nchunk = (n + chunkSize - 1) / chunkSize;
+  Block<T> parts(nchunk);
+#ifdef _OPENMP
+#pragma omp parallel for if (nchunk >= 8)
+#endif
+  for (Int i=0; i<nchunk; ++i) {
+    size_t st = i*chunkSize;
+    parts[i] = pairwiseAccumulateRecur (data+st, mask+st,
+                                        std::min(chunkSize, n-st), op);
+  }
+  return pairwiseAccumulateRecur (parts.storage(), nchunk, std::plus<T>());
+}
+
+// Use conditional assignments (instead of if/else), so the compiler
+// can vectorize the loop.
+// Each chunk starts at the first value of the array (instead of the first
+// value of the chunk), so the result is the same as for a sequential loop.
+// Otherwise a chunk starting with a NaN would give a NaN minimum and
+// maximum for the chunk, which would hide its real extremes.
+template<typename T>
+inline void contMinMaxChunk (T& minVal, T& maxVal, const T* data, size_t n,
+                             const T& startVal)
+{
+  T minv = startVal;
+  T maxv = startVal;
+  for (size_t i=0; i<n; ++i) {
+    minv = (data[i] < minv  ?  data[i] : minv);
+    maxv = (data[i] > maxv  ?  data[i] : maxv);
+  }
+  minVal = minv;
+  maxVal = maxv;
+}
+
+template<typename T>
+void contMinMax (T& minVal, T& maxVal, const T* data, size_t n)
+{
+  const size_t chunkSize = 65536;
+  if (n <= chunkSize) {
+    contMinMaxChunk (minVal, maxVal, data, n, data[0]);
+    return;
+  }
+  Int nchunk = (n + chunkSize - 1) / chunkSize;
+  Block<T> mins(nchunk);
+  Block<T> maxs(nchunk);
+#ifdef _OPENMP
+#pragma omp parallel for if (nchunk >= 8)
+#endif
+  for (Int i=0; i<nchunk; ++i) {
+    size_t st = i*chunkSize;
+    contMinMaxChunk (mins[i], maxs[i], data+st, std::min(chunkSize, n-st),
+                     data[0]);
+  }
+  // Combine in chunk order to get the same result as a sequential loop.
+  T minv = mins[0];
+  T maxv = maxs[0];
+  for (Int i=1; i<nchunk; ++i) {
+    minv = (mins[i] < minv  ?  mins[i] : minv);
+    maxv = (maxs[i] > maxv  ?  maxs[i] : maxv);
+  }
+  minVal = minv;
+  maxVal = maxv;
+}
+
+
 // <thrown>
 //   <item> ArrayError
 // </thrown>
@@ -753,19 +914,11 @@ template<class T> void minMax(T &minVal, T &maxVal, const Array<T> &array)
     throw(ArrayError("void minMax(T &min, T &max, const Array<T> &array) - "
                      "Array has no elements"));	
   }
-  T minv = array.data()[0];
-  T maxv = minv;
   if (array.contiguousStorage()) {
-    typename Array<T>::const_contiter iterEnd = array.cend();
-    for (typename Array<T>::const_contiter iter = array.cbegin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      } else if (*iter > maxv) {
-        maxv = *iter;
-      }
-    }
+    contMinMax (minVal, maxVal, array.data(), array.nelements());
   } else {
+    T minv = array.data()[0];
+    T maxv = minv;
     typename Array<T>::const_iterator iterEnd = array.end();
     for (typename Array<T>::const_iterator iter = array.begin();
          iter!=iterEnd; ++iter) {
@@ -775,9 +928,9 @@ template<class T> void minMax(T &minVal, T &maxVal, const Array<T> &array)
         maxv = *iter;
       }
     }
+    maxVal = maxv;
+    minVal = minv;
   }
-  maxVal = maxv;
-  minVal = minv;
 }
 
 // <thrown>
@@ -1039,7 +1192,7 @@ template<class T> Array<T> fmod(const Array<T> &a, const T &b)
 template<class T> T sum(const Array<T> &a)
 {
   return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), std::plus<T>()) :
+    pairwiseAccumulate(a.data(), a.nelements(), std::plus<T>()) :
     std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
 }
 
@@ -1085,7 +1238,8 @@ template<class T> T variance(const Array<T> &a, T mean)
 			 "elements"));
     }
     T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), casa::SumSqrDiff<T>(mean)) :
+      pairwiseAccumulate(a.data(), a.nelements(),
+                         casa::SumSqrDiff<T>(mean)) :
       std::accumulate(a.begin(),  a.end(),  T(), casa::SumSqrDiff<T>(mean));
     return T(sum/(1.0*a.nelements() - 1));
 }
@@ -1148,7 +1302,8 @@ template<class T> T avdev(const Array<T> &a, T mean)
 			 "element"));
     }
     T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), casa::SumAbsDiff<T>(mean)) :
+      pairwiseAccumulate(a.data(), a.nelements(),
+                         casa::SumAbsDiff<T>(mean)) :
       std::accumulate(a.begin(),  a.end(),  T(), casa::SumAbsDiff<T>(mean));
     return T(sum/(1.0*a.nelements()));
 }
@@ -1163,7 +1318,7 @@ template<class T> T rms(const Array<T> &a)
 			 "element"));
     }
     T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), casa::SumSqr<T>()) :
+      pairwiseAccumulate(a.data(), a.nelements(), casa::SumSqr<T>()) :
       std::accumulate(a.begin(),  a.end(),  T(), casa::SumSqr<T>());
     return T(sqrt(sum/(1.0*a.nelements())));
 }
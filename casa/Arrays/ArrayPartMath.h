@@ -232,7 +232,7 @@ private:
     Bool     itsSorted;
     Bool     itsTakeEvenMean;
     Bool     itsInPlace;
-    mutable Block<Float> itsTmp;
+    mutable Block<T> itsTmp;
 };
 template<typename T> class FractileFunc {
 public:
@@ -259,7 +259,7 @@ private:
   float    itsFraction;
   Bool     itsSorted;
   Bool     itsInPlace;
-  mutable Block<Float> itsTmp;
+  mutable Block<T> itsTmp;
 };
 template<typename T> class InterHexileRangeFunc: public InterFractileRangeFunc<T> {
 public:
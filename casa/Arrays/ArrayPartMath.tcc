@@ -29,12 +29,62 @@
 
 #include <casa/Arrays/ArrayPartMath.h>
 #include <casa/Arrays/ArrayError.h>
+#include <casa/Arrays/ArrayUtil.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/Utilities/Assert.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
 
+// Sum the lines of an array with shape [nc,nr] (leading=True) or [nr,nc]
+// (leading=False) into res, which must have been initialized.
+// Contiguous lines are summed pairwise. Strided lines are summed for a
+// block of result elements at a time, reading the data row by row; partial
+// sums of 128 values are used to limit the rounding error.
+// If OpenMP is used, large arrays are processed in parallel.
+template<class T>
+void partialSumsHelper (T* res, const T* data, size_t nr, size_t nc,
+                        Bool leading)
+{
+  if (leading) {
+    Int64 nrow = nr;
+#ifdef _OPENMP
+#pragma omp parallel for if (nr > 1  &&  nr*nc >= 65536)
+#endif
+    for (Int64 i=0; i<nrow; ++i) {
+      res[i] += pairwiseAccumulate (data + i*nc, nc, std::plus<T>());
+    }
+  } else {
+    const size_t blkSize = 1024;
+    const size_t subSize = 128;
+    Int64 nblk = (nr + blkSize - 1) / blkSize;
+#ifdef _OPENMP
+#pragma omp parallel for if (nblk > 1  &&  nr*nc >= 65536)
+#endif
+    for (Int64 blk=0; blk<nblk; ++blk) {
+      size_t st = blk*blkSize;
+      size_t nb = std::min(blkSize, nr-st);
+      T* resb = res + st;
+      Block<T> part(nb);
+      for (size_t j0=0; j0<nc; j0+=subSize) {
+        for (size_t k=0; k<nb; ++k) {
+          part[k] = T();
+        }
+        size_t j1 = std::min(nc, j0+subSize);
+        for (size_t j=j0; j<j1; ++j) {
+          const T* d = data + j*nr + st;
+          for (size_t k=0; k<nb; ++k) {
+            part[k] += d[k];
+          }
+        }
+        for (size_t k=0; k<nb; ++k) {
+          resb[k] += part[k];
+        }
+      }
+    }
+  }
+}
+
 template<class T> Array<T> partialSums (const Array<T>& array,
 					const IPosition& collapseAxes)
 {
@@ -57,6 +107,16 @@ template<class T> Array<T> partialSums (const Array<T>& array,
   const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
   T* res = resData;
+  // Collapsing the leading or trailing axes is done in a faster way.
+  Int layout = partialAxesLayout (ndim, collapseAxes);
+  if (layout != 0) {
+    size_t nr = result.nelements();
+    partialSumsHelper (resData, arrData, nr, array.nelements() / nr,
+                       layout < 0);
+    array.freeStorage (arrData, deleteData);
+    result.putStorage (resData, deleteRes);
+    return result;
+  }
   // Find out how contiguous the data is, i.e. if some contiguous data
   // end up in the same output element.
   // cont tells if any data are contiguous.
@@ -74,11 +134,8 @@ template<class T> Array<T> partialSums (const Array<T>& array,
   IPosition pos(ndim, 0);
   while (True) {
     if (cont) {
-      T tmp = *res;
-      for (uInt i=0; i<n0; i++) {
-	tmp += *data++;
-      }
-      *res = tmp;
+      *res += pairwiseAccumulate (data, n0, std::plus<T>());
+      data += n0;
     } else {
       for (uInt i=0; i<n0; i++) {
 	*res += *data++;
@@ -593,6 +650,82 @@ template<class T> Array<T> partialRmss (const Array<T>& array,
   return result;
 }
 
+// Helper function for partialMedians and the like.
+// If the collapse axes are the leading or trailing axes, it applies the
+// reduction function object to each line of values to collapse and
+// returns True. Otherwise it returns False and does nothing.
+// The values of a line are copied to a contiguous buffer on which the
+// function object can work in place. For trailing axes the buffers of
+// several lines are filled at the same time, reading the data row by row.
+// For leading axes the data are used directly if inPlace is True.
+// If OpenMP is used, the lines are processed in parallel, each thread
+// using its own copy of the function object.
+template <typename T, typename FuncType>
+Bool partialArrayMathLines (Array<T>& result, const Array<T>& array,
+                            const IPosition& collapseAxes,
+                            const FuncType& funcObj, Bool inPlace)
+{
+  uInt ndim = array.ndim();
+  Int layout = partialAxesLayout (ndim, collapseAxes);
+  if (layout == 0  ||  array.empty()) {
+    return False;
+  }
+  result.resize (array.shape().removeAxes (collapseAxes));
+  Bool leading = (layout < 0);
+  size_t nr = result.nelements();
+  size_t nc = array.nelements() / nr;
+  // Determine the number of lines to gather at once.
+  size_t nl = 1;
+  if (!leading) {
+    nl = std::max (size_t(1), std::min (size_t(64), 262144 / nc));
+    nl = std::min (nl, nr);
+  }
+  Int64 nblk = (nr + nl - 1) / nl;
+  Bool deleteData, deleteRes;
+  const T* arrData = array.getStorage (deleteData);
+  T* data = const_cast<T*>(arrData);
+  T* res = result.getStorage (deleteRes);
+#ifdef _OPENMP
+#pragma omp parallel if (nr > 1  &&  nr*nc >= 65536)
+#endif
+  {
+    FuncType func (funcObj);
+    Block<T> buf;
+    if (! (leading && inPlace)) {
+      buf.resize (nl*nc);
+    }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (Int64 blk=0; blk<nblk; ++blk) {
+      size_t st = blk*nl;
+      if (leading) {
+        T* line = data + st*nc;
+        if (!inPlace) {
+          objcopy (buf.storage(), line, nc);
+          line = buf.storage();
+        }
+        res[st] = func (Array<T>(IPosition(1,nc), line, SHARE));
+      } else {
+        size_t nb = std::min(nl, nr-st);
+        T* bufp = buf.storage();
+        for (size_t j=0; j<nc; ++j) {
+          const T* d = data + j*nr + st;
+          for (size_t k=0; k<nb; ++k) {
+            bufp[k*nc + j] = d[k];
+          }
+        }
+        for (size_t k=0; k<nb; ++k) {
+          res[st+k] = func (Array<T>(IPosition(1,nc), bufp + k*nc, SHARE));
+        }
+      }
+    }
+  }
+  array.freeStorage (arrData, deleteData);
+  result.putStorage (res, deleteRes);
+  return True;
+}
+
 template<class T> Array<T> partialMedians (const Array<T>& array,
 					   const IPosition& collapseAxes,
 					   Bool takeEvenMean,
@@ -609,6 +742,13 @@ template<class T> Array<T> partialMedians (const Array<T>& array,
   if (ndim == 0) {
     return Array<T>();
   }
+  // Collapsing the leading or trailing axes is done in a faster way.
+  Array<T> result;
+  if (partialArrayMathLines (result, array, collapseAxes,
+                             MedianFunc<T>(False, takeEvenMean, True),
+                             inPlace)) {
+    return result;
+  }
   // Get the remaining axes.
   // It also checks if axes are specified correctly.
   IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
@@ -626,7 +766,7 @@ template<class T> Array<T> partialMedians (const Array<T>& array,
     resShape.resize(1);
     resShape[0] = 1;
   }
-  Array<T> result (resShape);
+  result.resize (resShape);
   Bool deleteRes;
   T* resData = result.getStorage (deleteRes);
   T* res = resData;
@@ -670,6 +810,13 @@ template<class T> Array<T> partialMadfms (const Array<T>& array,
   if (ndim == 0) {
     return Array<T>();
   }
+  // Collapsing the leading or trailing axes is done in a faster way.
+  Array<T> result;
+  if (partialArrayMathLines (result, array, collapseAxes,
+                             MadfmFunc<T>(False, takeEvenMean, True),
+                             inPlace)) {
+    return result;
+  }
   // Get the remaining axes.
   // It also checks if axes are specified correctly.
   IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
@@ -687,7 +834,7 @@ template<class T> Array<T> partialMadfms (const Array<T>& array,
     resShape.resize(1);
     resShape[0] = 1;
   }
-  Array<T> result (resShape);
+  result.resize (resShape);
   Bool deleteRes;
   T* resData = result.getStorage (deleteRes);
   T* res = resData;
@@ -734,6 +881,13 @@ template<class T> Array<T> partialFractiles (const Array<T>& array,
   if (ndim == 0) {
     return Array<T>();
   }
+  // Collapsing the leading or trailing axes is done in a faster way.
+  Array<T> result;
+  if (partialArrayMathLines (result, array, collapseAxes,
+                             FractileFunc<T>(fraction, False, True),
+                             inPlace)) {
+    return result;
+  }
   // Get the remaining axes.
   // It also checks if axes are specified correctly.
   IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
@@ -751,7 +905,7 @@ template<class T> Array<T> partialFractiles (const Array<T>& array,
     resShape.resize(1);
     resShape[0] = 1;
   }
-  Array<T> result (resShape);
+  result.resize (resShape);
   Bool deleteRes;
   T* resData = result.getStorage (deleteRes);
   T* res = resData;
@@ -795,6 +949,13 @@ template<class T> Array<T> partialInterFractileRanges (const Array<T>& array,
   if (ndim == 0) {
     return Array<T>();
   }
+  // Collapsing the leading or trailing axes is done in a faster way.
+  Array<T> result;
+  if (partialArrayMathLines (result, array, collapseAxes,
+                             InterFractileRangeFunc<T>(fraction, False, True),
+                             inPlace)) {
+    return result;
+  }
   // Get the remaining axes.
   // It also checks if axes are specified correctly.
   IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
@@ -812,7 +973,7 @@ template<class T> Array<T> partialInterFractileRanges (const Array<T>& array,
     resShape.resize(1);
     resShape[0] = 1;
   }
-  Array<T> result (resShape);
+  result.resize (resShape);
   Bool deleteRes;
   T* resData = result.getStorage (deleteRes);
   T* res = resData;
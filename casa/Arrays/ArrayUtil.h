@@ -190,6 +190,21 @@ uInt partialFuncHelper (Int& nelemCont,
 // </group>
 
 
+// <summary> Helper function for partialX functions </summary>
+// <use visibility=export>
+// <synopsis>
+// This is a specialized helper function for functions like partialSums.
+// It tells if the collapse axes are the leading axes (returns -1) or
+// the trailing axes (returns 1) of an array with the given dimensionality.
+// In those cases each result element is formed from a contiguous or from
+// a regularly strided line of values, which can be processed faster.
+// Otherwise 0 is returned.
+// </synopsis>
+// <group name=partialAxesLayout>
+Int partialAxesLayout (uInt ndim, const IPosition& collapseAxes);
+// </group>
+
+
 // <summary>
 // Reverse the order of one or more axes of an array.
 // </summary>
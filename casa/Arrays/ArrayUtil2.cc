@@ -132,6 +132,20 @@ uInt partialFuncHelper (Int& nelemCont,
   return stax;
 }
 
+Int partialAxesLayout (uInt ndim, const IPosition& collapseAxes)
+{
+  // Get the remaining axes (in ascending order).
+  IPosition resultAxes = IPosition::otherAxes (ndim, collapseAxes);
+  uInt nres = resultAxes.nelements();
+  if (nres == 0  ||  resultAxes[0] == Int(ndim - nres)) {
+    return -1;
+  }
+  if (resultAxes[nres-1] == Int(nres-1)) {
+    return 1;
+  }
+  return 0;
+}
+
 uInt reorderArrayHelper (IPosition& newShape, IPosition& incr,
 			 const IPosition& shape, const IPosition& newAxisOrder)
 {
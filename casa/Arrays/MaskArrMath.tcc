@@ -29,6 +29,7 @@
 #include <casa/Arrays/MaskArrMath.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/Arrays/Array.h>
+#include <casa/Arrays/ArrayMath.h>
 #include <casa/Arrays/ArrayError.h>
 #include <casa/Arrays/ArrayIter.h>
 #include <casa/Arrays/VectorIter.h>
@@ -1337,22 +1338,13 @@ template<class T> T sum(const MaskedArray<T> &left)
 
     Bool leftarrDelete;
     const T *leftarrStorage = left.getArrayStorage(leftarrDelete);
-    const T *leftarrS = leftarrStorage;
 
     Bool leftmaskDelete;
     const LogicalArrayElem *leftmaskStorage
         = left.getMaskStorage(leftmaskDelete);
-    const LogicalArrayElem *leftmaskS = leftmaskStorage;
 
-    T sum = 0;
-    uInt ntotal = left.nelements();
-    while (ntotal--) {
-        if (*leftmaskS) {
-            sum += *leftarrS;
-        }
-        leftarrS++;
-        leftmaskS++;
-    }
+    T sum = pairwiseAccumulate (leftarrStorage, leftmaskStorage,
+                                left.nelements(), std::plus<T>());
 
     left.freeArrayStorage(leftarrStorage, leftarrDelete);
     left.freeMaskStorage(leftmaskStorage, leftmaskDelete);
@@ -1369,22 +1361,13 @@ template<class T> T sumsquares(const MaskedArray<T> &left)
 
     Bool leftarrDelete;
     const T *leftarrStorage = left.getArrayStorage(leftarrDelete);
-    const T *leftarrS = leftarrStorage;
 
     Bool leftmaskDelete;
     const LogicalArrayElem *leftmaskStorage
         = left.getMaskStorage(leftmaskDelete);
-    const LogicalArrayElem *leftmaskS = leftmaskStorage;
 
-    T sumsquares = 0;
-    uInt ntotal = left.nelements();
-    while (ntotal--) {
-        if (*leftmaskS) {
-            sumsquares += (*leftarrS * *leftarrS);
-        }
-        leftarrS++;
-        leftmaskS++;
-    }
+    T sumsquares = pairwiseAccumulate (leftarrStorage, leftmaskStorage,
+                                       left.nelements(), casa::SumSqr<T>());
 
     left.freeArrayStorage(leftarrStorage, leftarrDelete);
     left.freeMaskStorage(leftmaskStorage, leftmaskDelete);
@@ -765,6 +765,32 @@ void testResizeCopy()
 }
 
 
+void testAllocator()
+{
+  // An Array using a given allocator keeps it when resized.
+  Array<Float> arr1(IPosition(2,5,6), AlignedAllocator::instance());
+  indgen (arr1);
+  AlwaysAssertExit (size_t(arr1.data()) % AlignedAllocator::alignment == 0);
+  Array<Float> arr2 (arr1.copy());
+  arr1.resize (IPosition(2,7,6), True);
+  AlwaysAssertExit (size_t(arr1.data()) % AlignedAllocator::alignment == 0);
+  AlwaysAssertExit (allEQ (arr1(IPosition(2,0), IPosition(2,4,5)), arr2));
+  // Set the default allocator for Arrays.
+  StorageAllocator::setArrayDefault (&PoolAllocator::instance());
+  for (Int i=0; i<10; ++i) {
+    Vector<DComplex> vec(16, DComplex(i,1));
+    Matrix<Int> mat(4,4);
+    AlwaysAssertExit (size_t(vec.data()) % AlignedAllocator::alignment == 0);
+    AlwaysAssertExit (size_t(mat.data()) % AlignedAllocator::alignment == 0);
+    mat = i;
+    AlwaysAssertExit (allEQ (vec, DComplex(i,1))  &&  allEQ (mat, i));
+  }
+  Vector<String> svec(5);
+  AlwaysAssertExit (allEQ (svec, String()));
+  StorageAllocator::setArrayDefault (0);
+  PoolAllocator::releaseCache();
+}
+
 void checkRCDVec (const Vector<Int>& v1, const Vector<Int>& v2)
 {
   AlwaysAssertExit (allEQ(v1,v2));
@@ -1030,6 +1056,7 @@ int main()
 	testVector();
 	// Test the resize with copy.
 	testResizeCopy();
+	testAllocator();
         // Test getting row, column, diagonal
         testRowColDiag();
         {
@@ -0,0 +1,224 @@
+//# tArrayChunkIter.cc: Test program for the chunk iterators of an Array
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casa/Arrays/ArrayChunkIter.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Matrix.h>
+#include <casa/Arrays/Cube.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/ArrayError.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/iostream.h>
+#include <algorithm>
+#include <functional>
+
+using namespace casa;
+
+// Check that the chunks of an array contain all elements in order.
+template<typename T>
+void checkChunks (const Array<T>& arr, size_t nchunk, size_t length,
+                  size_t incr)
+{
+  ReadOnlyArrayChunkIterator<T> iter(arr);
+  AlwaysAssertExit (iter.nchunks() == nchunk);
+  AlwaysAssertExit (iter.length() == length);
+  AlwaysAssertExit (iter.incr() == incr);
+  typename Array<T>::const_iterator aiter = arr.begin();
+  size_t n = 0;
+  for (; !iter.pastEnd(); iter.next()) {
+    for (typename ReadOnlyArrayChunkIterator<T>::iterator citer=iter.begin();
+         citer!=iter.end(); ++citer) {
+      AlwaysAssertExit (&(*citer) == &(*aiter));
+      ++aiter;
+      ++n;
+    }
+  }
+  AlwaysAssertExit (n == arr.nelements());
+}
+
+void testChunks()
+{
+  Cube<Int> cube(4,5,6);
+  indgen (cube);
+  // Contiguous array is a single chunk.
+  checkChunks (cube, 1, 120, 1);
+  // Full planes are contiguous.
+  checkChunks (Array<Int>(cube(IPosition(3,0,0,1), IPosition(3,3,4,3))),
+               1, 60, 1);
+  // Partial lines are contiguous chunks.
+  checkChunks (Array<Int>(cube(IPosition(3,1,0,0), IPosition(3,2,4,5))),
+               30, 2, 1);
+  // Strided lines with full planes.
+  checkChunks (Array<Int>(cube(IPosition(3,0,0,0), IPosition(3,3,4,5),
+                               IPosition(3,2,1,1))),
+               1, 60, 2);
+  // A row of a matrix is a single strided chunk.
+  Matrix<Int> mat(7,8);
+  indgen (mat);
+  checkChunks (Array<Int>(mat.row(3)), 1, 8, 7);
+  // Axes with length 1 are ignored.
+  checkChunks (Array<Int>(cube(IPosition(3,1,0,2), IPosition(3,1,4,2))),
+               1, 5, 4);
+  checkChunks (Array<Int>(cube(IPosition(3,1,2,0), IPosition(3,1,2,5))),
+               1, 6, 20);
+  // Empty array has no chunks.
+  Array<Int> empty;
+  ReadOnlyArrayChunkIterator<Int> iter(empty);
+  AlwaysAssertExit (iter.pastEnd());
+  AlwaysAssertExit (iter.nchunks() == 0);
+  // Test reset.
+  ArrayChunkIterator<Int> iter2(cube);
+  iter2.next();
+  AlwaysAssertExit (iter2.pastEnd());
+  iter2.reset();
+  AlwaysAssertExit (!iter2.pastEnd()  &&  iter2.data() == cube.data());
+}
+
+void testStepper()
+{
+  // Step through a section and a contiguous array in parallel.
+  Cube<Float> cube(6,5,4);
+  indgen (cube);
+  Cube<Float> sect = cube(IPosition(3,1,0,0), IPosition(3,4,4,3));
+  Cube<Float> cont(sect.shape());
+  ArrayChunkStepper iter(sect.shape(), sect.steps(), cont.steps());
+  AlwaysAssertExit (iter.nchunks() == 20  &&  iter.length() == 4);
+  for (; !iter.pastEnd(); iter.next()) {
+    std::copy (sect.data() + iter.offset(),
+               sect.data() + iter.offset() + iter.length(),
+               cont.data() + iter.offset2());
+  }
+  AlwaysAssertExit (allEQ (cont, sect));
+  // Strides differing per array limit merging.
+  Cube<Float> sect2 = cube(IPosition(3,0,0,0), IPosition(3,5,4,3),
+                           IPosition(3,1,1,2));
+  ArrayChunkStepper iter2(sect2.shape(), cube.steps(), sect2.steps());
+  AlwaysAssertExit (iter2.nchunks() == 2  &&  iter2.length() == 30);
+  AlwaysAssertExit (iter2.incr() == 1  &&  iter2.incr2() == 1);
+  // Shape and steps must match.
+  Bool failed = False;
+  try {
+    ArrayChunkStepper iter3(IPosition(2,3,4), IPosition(3,1,3,12));
+  } catch (ArrayConformanceError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testStridedIterator()
+{
+  Matrix<Double> mat(5,6);
+  indgen (mat);
+  // Reverse sort the second row in place using the random access iterator.
+  StridedIterator<Double> beg(mat.data() + 1, 5);
+  StridedIterator<Double> end = beg + 6;
+  AlwaysAssertExit (end - beg == 6);
+  std::sort (beg, end, std::greater<Double>());
+  for (uInt i=0; i<6; ++i) {
+    AlwaysAssertExit (mat(1,i) == 1 + (5-i)*5);
+    AlwaysAssertExit (beg[i] == mat(1,i));
+  }
+  AlwaysAssertExit (mat(0,0) == 0  &&  mat(2,5) == 27);
+  StridedIterator<const Double> cbeg(beg);
+  AlwaysAssertExit (*(cbeg+2) == 16  &&  *(--end) == 1);
+}
+
+Int negateInt (Int v)
+{
+  return -v;
+}
+
+// Test the Array functions using the chunks.
+void testArrayFunctions()
+{
+  Cube<Int> cube(10,11,12);
+  indgen (cube);
+  Cube<Int> sect = cube(IPosition(3,1,2,3), IPosition(3,8,9,10),
+                        IPosition(3,1,2,1));
+  // copy and getStorage.
+  Cube<Int> cp = sect.copy();
+  AlwaysAssertExit (cp.contiguousStorage());
+  for (uInt k=0; k<sect.shape()(2); ++k) {
+    for (uInt j=0; j<sect.shape()(1); ++j) {
+      for (uInt i=0; i<sect.shape()(0); ++i) {
+        AlwaysAssertExit (cp(i,j,k) == cube(i+1, 2*j+2, k+3));
+      }
+    }
+  }
+  Bool deleteIt;
+  const Int* st = sect.getStorage (deleteIt);
+  AlwaysAssertExit (deleteIt);
+  AlwaysAssertExit (std::equal (st, st+sect.nelements(), cp.data()));
+  sect.freeStorage (st, deleteIt);
+  // assignment and putStorage.
+  Cube<Int> cube2(10,11,12);
+  indgen (cube2);
+  Cube<Int> sect2 = cube2(IPosition(3,0,0,0), IPosition(3,7,3,7));
+  sect2 = sect;
+  AlwaysAssertExit (allEQ (sect2, cp));
+  Int* st2 = sect2.getStorage (deleteIt);
+  for (uInt i=0; i<sect2.nelements(); ++i) {
+    st2[i] = -Int(i);
+  }
+  sect2.putStorage (st2, deleteIt);
+  AlwaysAssertExit (cube2(0,0,0) == 0  &&  cube2(1,0,0) == -1);
+  AlwaysAssertExit (cube2(0,1,0) == -8  &&  cube2(8,0,0) == 8);
+  // set and apply.
+  sect = 5;
+  AlwaysAssertExit (allEQ (sect, 5));
+  AlwaysAssertExit (cube(9,2,3) == 9 + 20 + 330);
+  AlwaysAssertExit (cube(1,3,3) == 1 + 30 + 330);
+  sect.apply (negateInt);
+  AlwaysAssertExit (allEQ (sect, -5));
+  // Transforms of non-contiguous arrays.
+  sect2 = 2;
+  sect += sect2;
+  AlwaysAssertExit (allEQ (sect, -3));
+  sect *= 3;
+  AlwaysAssertExit (allEQ (sect, -9));
+  AlwaysAssertExit (allEQ (Cube<Int>(sect - sect2), -11));
+  AlwaysAssertExit (allEQ (Cube<Int>(1 - sect), 10));
+  AlwaysAssertExit (allEQ (Cube<Int>(abs(sect)), 9));
+}
+
+int main()
+{
+  try {
+    testChunks();
+    testStepper();
+    testStridedIterator();
+    testArrayFunctions();
+  } catch (AipsError x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,163 @@
+//# tArrayExpr.cc: Test program for the lazily evaluated array expressions
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casa/Arrays/ArrayExpr.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Matrix.h>
+#include <casa/Arrays/Cube.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/ArrayError.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/iostream.h>
+
+using namespace casa;
+
+// Test contiguous arrays of various types.
+void testContiguous()
+{
+  Matrix<Float> a(10,11), b(10,11), w(10,11);
+  indgen (a, Float(1));
+  indgen (b, Float(-50));
+  indgen (w, Float(2), Float(0.5));
+  // Compare with the immediately evaluated expression.
+  Matrix<Float> exp1 (sqrt(a*a + b*b) * w);
+  Array<Float> res1 = arrayExprResult (sqrt(arrayExpr(a)*a + arrayExpr(b)*b) * w);
+  AlwaysAssertExit (allNear (res1, exp1, 1e-6));
+  AlwaysAssertExit (res1.shape() == a.shape());
+  // Use scalars and other functions.
+  Matrix<Float> res2;
+  arrayExprEval (res2, 2.f * arrayExpr(a) - b / 3.f + square(arrayExpr(b)));
+  AlwaysAssertExit (allNear (res2, Matrix<Float>(2.f*a - b/3.f + square(b)),
+                             1e-6));
+  arrayExprEval (res2, -max(arrayExpr(a), b) + min(arrayExpr(a), 5.f));
+  AlwaysAssertExit (allNear (res2, Matrix<Float>(-max(a,b) + min(a,5.f)),
+                             1e-6));
+  arrayExprEval (res2, pow(abs(arrayExpr(b)), 2.f) + exp(arrayExpr(a)/a));
+  AlwaysAssertExit (allNear (res2, Matrix<Float>(pow(abs(b),2.f) +
+                                                 exp(a/a)), 1e-5));
+  // Result can be an operand.
+  Matrix<Float> res3 (a.copy());
+  arrayExprEval (res3, arrayExpr(res3) * res3 + 1.f);
+  AlwaysAssertExit (allNear (res3, Matrix<Float>(a*a + 1.f), 1e-6));
+  // Integer arithmetic.
+  Vector<Int> ia(20), ib(20);
+  indgen (ia);
+  indgen (ib, 5);
+  Vector<Int> ires (arrayExprResult ((arrayExpr(ia) + ib) * 3 - ia / 2));
+  AlwaysAssertExit (allEQ (ires, (ia + ib) * 3 - ia / 2));
+}
+
+// Test complex expressions giving real results.
+void testComplex()
+{
+  Cube<Complex> c(3,4,5);
+  indgen (c, Complex(1,2), Complex(0.5,-0.25));
+  Cube<Float> amp (arrayExprResult (amplitude(arrayExpr(c) * c)));
+  AlwaysAssertExit (allNear (amp, amplitude(c*c), 1e-6));
+  Cube<Float> re (arrayExprResult (real(conj(arrayExpr(c)))));
+  AlwaysAssertExit (allNear (re, real(c), 1e-6));
+  Cube<Float> im (arrayExprResult (imag(conj(arrayExpr(c)))));
+  AlwaysAssertExit (allNear (im, -imag(c), 1e-6));
+  Cube<Float> ph (arrayExprResult (phase(arrayExpr(c))));
+  AlwaysAssertExit (allNear (ph, phase(c), 1e-6));
+  // A Float result can be evaluated into a Double array.
+  Cube<Double> damp;
+  arrayExprEval (damp, amplitude(arrayExpr(c)));
+  AlwaysAssertExit (damp.shape() == c.shape());
+  for (uInt i=0; i<c.nelements(); ++i) {
+    AlwaysAssertExit (near (damp.data()[i], Double(abs(c.data()[i])), 1e-6));
+  }
+}
+
+// Test non-contiguous operands and results.
+void testNonContiguous()
+{
+  Matrix<Double> a(20,30), b(20,30);
+  indgen (a);
+  indgen (b, 3.);
+  Matrix<Double> as (a(Slice(0,10,2), Slice(1,10,3)));
+  Matrix<Double> bs (b(Slice(1,10,2), Slice(0,10,3)));
+  AlwaysAssertExit (! as.contiguousStorage());
+  Matrix<Double> res (arrayExprResult (sqrt(arrayExpr(as)*as + bs) - 1.));
+  AlwaysAssertExit (res.contiguousStorage());
+  AlwaysAssertExit (allNear (res, Matrix<Double>(sqrt(as*as + bs) - 1.),
+                             1e-10));
+  // Evaluate into a non-contiguous result.
+  Matrix<Double> c(20,30);
+  c = 0.;
+  Matrix<Double> cs (c(Slice(0,10,2), Slice(0,10,3)));
+  arrayExprEval (cs, arrayExpr(as) + bs);
+  AlwaysAssertExit (allNear (cs, Matrix<Double>(as + bs), 1e-10));
+  AlwaysAssertExit (allEQ (c(Slice(1,10,2), Slice(0,10,3)), 0.));
+  // Mix contiguous and non-contiguous.
+  Matrix<Double> d(as.shape());
+  indgen (d);
+  arrayExprEval (d, arrayExpr(d) * as);
+  Matrix<Double> dexp(as.shape());
+  indgen (dexp);
+  AlwaysAssertExit (allNear (d, Matrix<Double>(dexp * as), 1e-10));
+}
+
+// Test that shape mismatches are detected.
+void testErrors()
+{
+  Vector<Float> a(10), b(11), c(12);
+  a = 1;
+  b = 2;
+  Bool failed = False;
+  try {
+    arrayExprResult (arrayExpr(a) + b);
+  } catch (ArrayConformanceError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  failed = False;
+  try {
+    arrayExprEval (c, arrayExpr(a) + 1.f);
+  } catch (ArrayConformanceError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+int main()
+{
+  try {
+    testContiguous();
+    testComplex();
+    testNonContiguous();
+    testErrors();
+  } catch (AipsError x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -30,6 +30,7 @@
 #include <casa/Arrays/ArrayMath.h>
 #include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/ArrayIO.h>
+#include <casa/BasicMath/Math.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/iostream.h>
 
@@ -422,6 +423,37 @@ void testMinMax1()
   AlwaysAssertExit (maxpos == IPosition(3,2,2,2));
 }
 
+// Test minMax for large arrays containing NaNs. Large contiguous arrays
+// are processed in chunks, which should give the same result as the
+// element by element loop used for non-contiguous arrays.
+template<typename T>
+void testMinMaxNaN()
+{
+  Array<T> a(IPosition(2,512,512));
+  a = 5;
+  T nan;
+  setNaN (nan);
+  // NaN at the start of the second chunk.
+  a.data()[65536] = nan;
+  a.data()[70000] = -1000;
+  a.data()[80000] = 1000;
+  T minval, maxval;
+  minMax (minval, maxval, a);
+  AlwaysAssertExit (minval == -1000  &&  maxval == 1000);
+  AlwaysAssertExit (min(a) == -1000  &&  max(a) == 1000);
+  // Same for a non-contiguous array.
+  Array<T> b(IPosition(2,1024,512));
+  Array<T> sb(b(IPosition(2,0,0), IPosition(2,1023,511), IPosition(2,2,1)));
+  sb = a;
+  AlwaysAssertExit (!sb.contiguousStorage());
+  minMax (minval, maxval, sb);
+  AlwaysAssertExit (minval == -1000  &&  maxval == 1000);
+  // A NaN as first value gives NaN (as a sequential loop does).
+  a.data()[0] = nan;
+  minMax (minval, maxval, a);
+  AlwaysAssertExit (isNaN(minval)  &&  isNaN(maxval));
+}
+
 // Instantiate the macro-ed functions.
 TestBinary(+, testPlusInt, Int, Int)
 TestBinary(-, testMinusInt, Int, Int)
@@ -563,6 +595,8 @@ int main()
     testMakeComplex<Float,Complex>();
     testMakeComplex<Double,DComplex>();
     testMinMax1();
+    testMinMaxNaN<Float>();
+    testMinMaxNaN<Double>();
   } catch (AipsError x) {
     cout << "Unexpected exception: " << x.getMesg() << endl;
     return 1;
@@ -28,6 +28,9 @@
 //# Includes
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Cube.h>
+#include <casa/Arrays/MaskedArray.h>
+#include <casa/Arrays/MaskArrMath.h>
 #include <casa/Arrays/ArrayPartMath.h>
 #include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/ArrayIO.h>
@@ -580,6 +583,64 @@ Bool doIt (PartFunc* partFunc, FullFunc* fullFunc, Bool doExtra)
   return !errFlag;
 }
 
+// Test the reduction kernels on arrays exceeding their chunk and block
+// sizes, comparing with results accumulated in Double.
+void testLarge()
+{
+  // Pairwise summation must be accurate for Float data.
+  Vector<Float> vec(1000000);
+  vec = 0.1f;
+  AlwaysAssertExit (near (sum(vec), 100000.f, 1e-5));
+  AlwaysAssertExit (near (mean(vec), 0.1f, 1e-5));
+  AlwaysAssertExit (near (rms(vec), 0.1f, 1e-5));
+  AlwaysAssertExit (nearAbs (variance(vec), 0.f, 1e-10));
+  // Masked sums and minMax.
+  indgen (vec, -500000.f);
+  vec = sin(vec);
+  vec(654321) = -3;
+  vec(65536) = 2;
+  LogicalArray mask(vec > 0.f);
+  MaskedArray<Float> marr(vec, mask);
+  Double s = 0, s2 = 0;
+  for (uInt i=0; i<vec.nelements(); ++i) {
+    if (vec[i] > 0) {
+      s  += vec[i];
+      s2 += vec[i]*vec[i];
+    }
+  }
+  AlwaysAssertExit (near (Double(sum(marr)), s, 1e-6));
+  AlwaysAssertExit (near (Double(sumsquares(marr)), s2, 1e-6));
+  Float mn, mx;
+  minMax (mn, mx, vec);
+  AlwaysAssertExit (mn == -3  &&  mx == 2);
+  // Collapse the trailing and leading axes of a cube.
+  Cube<Float> cube(40,30,300);
+  indgen (cube);
+  cube = cos(cube);
+  Array<Float> sums = partialSums (cube, IPosition(1,2));
+  Array<Float> meds = partialMedians (cube, IPosition(1,2));
+  for (Int i=0; i<40; ++i) {
+    for (Int j=0; j<30; ++j) {
+      Double ds = 0;
+      for (Int k=0; k<300; ++k) {
+        ds += cube(i,j,k);
+      }
+      IPosition pos(2,i,j);
+      AlwaysAssertExit (nearAbs (Double(sums(pos)), ds, 1e-4));
+      AlwaysAssertExit (meds(pos) ==
+                        median(cube(IPosition(3,i,j,0), IPosition(3,i,j,299)),
+                               False, False));
+    }
+  }
+  Vector<Float> psums (partialSums (cube, IPosition(2,0,1)));
+  Vector<Float> pmeds (partialMedians (cube, IPosition(2,0,1), True));
+  for (Int k=0; k<300; ++k) {
+    Array<Float> plane (cube.xyPlane(k));
+    AlwaysAssertExit (nearAbs (psums(k), sum(plane), 1e-4));
+    AlwaysAssertExit (pmeds(k) == median(plane, False, True));
+  }
+}
+
 int main (int argc, char* [])
 {
   Bool errFlag = False;
@@ -659,6 +720,8 @@ int main (int argc, char* [])
       cout << "  erronous" << endl;
       errFlag = True;
     }
+    cout << "Testing large arrays ..." << endl;
+    testLarge();
     if (argc > 1) {
       // Test performance.
       for (Int cnt=0; cnt<2; cnt++) {
@@ -0,0 +1,173 @@
+//# Allocator.cc: Allocators for the storage of a Block
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casa/Containers/Allocator.h>
+#include <casa/Exceptions/Error.h>
+#include <stdlib.h>
+#ifdef USE_THREADS
+# include <pthread.h>
+#endif
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+const StorageAllocator* StorageAllocator::theirArrayDefault = 0;
+
+StorageAllocator::~StorageAllocator()
+{}
+
+
+const size_t AlignedAllocator::alignment;
+
+AlignedAllocator::~AlignedAllocator()
+{}
+
+const AlignedAllocator& AlignedAllocator::instance()
+{
+  static AlignedAllocator allocator;
+  return allocator;
+}
+
+void* AlignedAllocator::allocate (size_t nbytes) const
+{
+  void* ptr;
+  if (posix_memalign (&ptr, alignment, nbytes) != 0) {
+    throw AllocError ("AlignedAllocator: cannot allocate memory", nbytes);
+  }
+  return ptr;
+}
+
+void AlignedAllocator::deallocate (void* ptr, size_t) const
+{
+  free (ptr);
+}
+
+
+//# The pools are singly linked lists of free chunks per size class.
+//# The link is stored in the first bytes of a chunk.
+//# Size class i contains chunks of 2**(i+6) bytes (64 bytes - 64 KBytes).
+namespace {
+  const uInt nSizeClass = 11;
+  const uInt maxChunkPerClass = 64;
+  __thread void* theirFreeList[nSizeClass];
+  __thread uInt  theirNFree[nSizeClass];
+
+  // Get the size class; -1 means too large for the pools.
+  inline Int sizeClass (size_t nbytes)
+  {
+    size_t sz = 64;
+    for (uInt i=0; i<nSizeClass; ++i, sz*=2) {
+      if (nbytes <= sz) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+#ifdef USE_THREADS
+  // A thread-specific key is used to free the pools when a thread exits.
+  pthread_key_t  theirPoolKey;
+  pthread_once_t theirPoolKeyOnce = PTHREAD_ONCE_INIT;
+  __thread bool  theirPoolKeySet = false;
+
+  extern "C" void poolAllocatorThreadExit (void*)
+  {
+    PoolAllocator::releaseCache();
+  }
+  void makePoolKey()
+  {
+    pthread_key_create (&theirPoolKey, poolAllocatorThreadExit);
+  }
+#endif
+}
+
+PoolAllocator::~PoolAllocator()
+{}
+
+const PoolAllocator& PoolAllocator::instance()
+{
+  static PoolAllocator allocator;
+  return allocator;
+}
+
+void* PoolAllocator::allocate (size_t nbytes) const
+{
+  Int cl = sizeClass (nbytes);
+  if (cl < 0) {
+    return AlignedAllocator::instance().allocate (nbytes);
+  }
+  void* ptr = theirFreeList[cl];
+  if (ptr) {
+    theirFreeList[cl] = *static_cast<void**>(ptr);
+    theirNFree[cl]--;
+    return ptr;
+  }
+  return AlignedAllocator::instance().allocate (size_t(64) << cl);
+}
+
+void PoolAllocator::deallocate (void* ptr, size_t nbytes) const
+{
+  Int cl = sizeClass (nbytes);
+  if (cl < 0  ||  theirNFree[cl] >= maxChunkPerClass) {
+    free (ptr);
+    return;
+  }
+#ifdef USE_THREADS
+  if (!theirPoolKeySet) {
+    pthread_once (&theirPoolKeyOnce, makePoolKey);
+    pthread_setspecific (theirPoolKey, &theirPoolKeySet);
+    theirPoolKeySet = true;
+  }
+#endif
+  *static_cast<void**>(ptr) = theirFreeList[cl];
+  theirFreeList[cl] = ptr;
+  theirNFree[cl]++;
+}
+
+void PoolAllocator::releaseCache()
+{
+  for (uInt i=0; i<nSizeClass; ++i) {
+    void* ptr = theirFreeList[i];
+    while (ptr) {
+      void* next = *static_cast<void**>(ptr);
+      free (ptr);
+      ptr = next;
+    }
+    theirFreeList[i] = 0;
+    theirNFree[i] = 0;
+  }
+}
+
+size_t PoolAllocator::nCached()
+{
+  size_t n = 0;
+  for (uInt i=0; i<nSizeClass; ++i) {
+    n += theirNFree[i];
+  }
+  return n;
+}
+
+} //# NAMESPACE CASA - END
@@ -0,0 +1,208 @@
+//# Allocator.h: Allocators for the storage of a Block
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_ALLOCATOR_H
+#define CASA_ALLOCATOR_H
+
+#include <casa/aips.h>
+#include <complex>
+#include <cstddef>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+// <summary>
+// Abstract base class for allocators of Block storage
+// </summary>
+//
+// <use visibility=export>
+//
+// <reviewed reviewer="" date="" tests="tBlock.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// A StorageAllocator allocates and frees raw memory for the elements of a
+// <linkto class=Block>Block</linkto> (and thereby of an
+// <linkto class=Array>Array</linkto>). The Block constructs the elements
+// in the raw memory; elements of a POD type (see
+// <linkto class=AllocPOD>AllocPOD</linkto>) are left uninitialized.
+// <br>By default a Block uses <src>new[]</src> and <src>delete[]</src>.
+// Another allocator can be given when constructing a Block or Array.
+// Furthermore a default allocator can be set for the storage of Arrays
+// created without an explicit allocator. It should be done at the start of
+// a program, because existing Arrays are not affected.
+// <br>Two allocators are predefined:
+// <ul>
+//  <li> <linkto class=AlignedAllocator>AlignedAllocator</linkto> gives
+//       storage aligned on 64 bytes (a cache line), which is beneficial
+//       for vectorized loops.
+//  <li> <linkto class=PoolAllocator>PoolAllocator</linkto> also gives
+//       aligned storage, but keeps freed small chunks in thread-local pools
+//       per size class for reuse. It avoids the cost of malloc if many
+//       temporary arrays of the same size are created.
+// </ul>
+// A derived class must be thread-safe and can assume that
+// <src>deallocate</src> is called with the same size as given to
+// <src>allocate</src>. Allocator objects must outlive the Blocks using them,
+// so in practice they should be static objects.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   // Use pooled storage for all Arrays created from now on.
+//   StorageAllocator::setArrayDefault (&PoolAllocator::instance());
+//   // Use aligned storage for this Array only.
+//   Array<Float> arr(IPosition(2,100,100), AlignedAllocator::instance());
+// </srcblock>
+// </example>
+
+class StorageAllocator
+{
+public:
+  virtual ~StorageAllocator();
+
+  // Allocate the given number of bytes (> 0).
+  // An AllocError exception is thrown if the memory cannot be allocated.
+  virtual void* allocate (size_t nbytes) const = 0;
+
+  // Free the memory allocated for the given number of bytes.
+  virtual void deallocate (void* ptr, size_t nbytes) const = 0;
+
+  // Get or set the default allocator used for the storage of an Array
+  // created without an explicit allocator. A null pointer (the default)
+  // means that <src>new[]</src> is used.
+  // <group>
+  static const StorageAllocator* arrayDefault()
+    { return theirArrayDefault; }
+  static void setArrayDefault (const StorageAllocator* allocator)
+    { theirArrayDefault = allocator; }
+  // </group>
+
+private:
+  static const StorageAllocator* theirArrayDefault;
+};
+
+
+// <summary>
+// Allocator giving storage aligned on a cache line
+// </summary>
+// <use visibility=export>
+// <synopsis>
+// This allocator gives storage aligned on 64 bytes using
+// <src>posix_memalign</src>. It has no state, so the static instance can be
+// used everywhere.
+// </synopsis>
+
+class AlignedAllocator : public StorageAllocator
+{
+public:
+  // The alignment in bytes.
+  static const size_t alignment = 64;
+
+  virtual ~AlignedAllocator();
+
+  // Get the static instance.
+  static const AlignedAllocator& instance();
+
+  virtual void* allocate (size_t nbytes) const;
+  virtual void deallocate (void* ptr, size_t nbytes) const;
+};
+
+
+// <summary>
+// Allocator keeping freed storage in thread-local pools
+// </summary>
+// <use visibility=export>
+// <synopsis>
+// This allocator gives storage aligned on 64 bytes. Requests up to
+// 64 KBytes are rounded up to a power of 2 (a size class). When freed,
+// such a chunk is kept in a pool of the calling thread for its size class,
+// so a subsequent request for the same size class is satisfied without
+// calling malloc or taking a lock. Larger requests are passed to
+// <linkto class=AlignedAllocator>AlignedAllocator</linkto>.
+// <br>The number of chunks kept per size class is limited, so the pools
+// cannot grow beyond about 8 MBytes per thread. The pools of a thread are
+// freed when the thread exits (if built with thread support) or when
+// <src>releaseCache</src> is called.
+// </synopsis>
+
+class PoolAllocator : public StorageAllocator
+{
+public:
+  virtual ~PoolAllocator();
+
+  // Get the static instance.
+  static const PoolAllocator& instance();
+
+  virtual void* allocate (size_t nbytes) const;
+  virtual void deallocate (void* ptr, size_t nbytes) const;
+
+  // Free all chunks in the pools of the calling thread.
+  static void releaseCache();
+
+  // Get the number of chunks in the pools of the calling thread.
+  static size_t nCached();
+};
+
+
+// <summary>
+// Tell if a type is a POD type for a Block allocator
+// </summary>
+// <use visibility=export>
+// <synopsis>
+// A <linkto class=Block>Block</linkto> using a
+// <linkto class=StorageAllocator>StorageAllocator</linkto> does not
+// construct and destruct the elements of a type for which
+// <src>AllocPOD<T>::value</src> is true; their values are undefined until
+// assigned. It is defined for the standard numeric types (including the
+// complex types) and pointers. Other types can be added by specialization.
+// </synopsis>
+// <group name=AllocPOD>
+template<typename T> struct AllocPOD { enum {value = 0}; };
+template<typename T> struct AllocPOD<T*> { enum {value = 1}; };
+template<> struct AllocPOD<bool> { enum {value = 1}; };
+template<> struct AllocPOD<char> { enum {value = 1}; };
+template<> struct AllocPOD<signed char> { enum {value = 1}; };
+template<> struct AllocPOD<unsigned char> { enum {value = 1}; };
+template<> struct AllocPOD<short> { enum {value = 1}; };
+template<> struct AllocPOD<unsigned short> { enum {value = 1}; };
+template<> struct AllocPOD<int> { enum {value = 1}; };
+template<> struct AllocPOD<unsigned int> { enum {value = 1}; };
+template<> struct AllocPOD<long> { enum {value = 1}; };
+template<> struct AllocPOD<unsigned long> { enum {value = 1}; };
+template<> struct AllocPOD<long long> { enum {value = 1}; };
+template<> struct AllocPOD<unsigned long long> { enum {value = 1}; };
+template<> struct AllocPOD<float> { enum {value = 1}; };
+template<> struct AllocPOD<double> { enum {value = 1}; };
+template<> struct AllocPOD<long double> { enum {value = 1}; };
+template<> struct AllocPOD<std::complex<float> > { enum {value = 1}; };
+template<> struct AllocPOD<std::complex<double> > { enum {value = 1}; };
+// </group>
+
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -30,7 +30,9 @@
 
 #include <casa/aips.h>
 #include <casa/Utilities/Copy.h>
+#include <casa/Containers/Allocator.h>
 #include <cstddef>                  // for ptrdiff_t
+#include <new>                      // for placement new
 
 //# For index checking
 #if defined(AIPS_ARRAY_INDEX_CHECK)
@@ -76,6 +78,12 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //
 // If index checking is turned on, an out-of-bounds index will
 // generate an <src>indexError<uInt></src> exception.
+//
+// By default the storage is allocated with <src>new[]</src>. Another
+// way of allocation (e.g. aligned or pooled storage) can be used by giving a
+// <linkto class=StorageAllocator>StorageAllocator</linkto> to the
+// constructor. The allocator is kept when the Block is resized or copied,
+// but not when storage is given to the Block by the user.
 // </synopsis>
 //
 // <example> 
@@ -101,15 +109,24 @@ template<class T> class Block {
 public:
   // Create a zero-length Block. Note that any index into this Block
   // is an error.
-  Block() : npts(0), array(0), destroyPointer(True) {}
+  Block() : npts(0), array(0), destroyPointer(True), alloc(0) {}
   // Create a Block with the given number of points. The values in Block
   // are uninitialized. Note that indices range between 0 and n-1.
-  explicit Block(size_t n) : npts(n), array(n>0 ? new T[n] : 0), destroyPointer(True)
+  explicit Block(size_t n) : npts(n), array(n>0 ? new T[n] : 0), destroyPointer(True),
+                             alloc(0)
     {}
   // Create a Block of the given length, and initialize (via operator= for 
   // objects of type T) with the provided value.
-  Block(size_t n, T val) : npts(n), array(n > 0 ? new T[n] : 0), destroyPointer(True)
+  Block(size_t n, T val) : npts(n), array(n > 0 ? new T[n] : 0), destroyPointer(True),
+                           alloc(0)
     { objset(array, val, n); }
+  // Create a Block with the given number of points using the given
+  // allocator for the storage. Elements of a POD type
+  // (see <linkto class=AllocPOD>AllocPOD</linkto>) are uninitialized,
+  // others are default constructed.
+  Block(size_t n, const StorageAllocator& allocator)
+    : npts(n), array(0), destroyPointer(True), alloc(&allocator)
+    { array = allocStorage(n); }
 
   // Create a <src>Block</src> from a C-array (i.e. pointer). If 
   // <src>takeOverStorage</src> is <src>True</src>, The Block assumes that
@@ -117,13 +134,14 @@ public:
   // the Block is destructed, otherwise the actual storage is not destroyed.
   // If true, <src>storagePointer</src> is set to <src>0</src>.
   Block(size_t n, T *&storagePointer, Bool takeOverStorage = True)
-    : npts(n), array(storagePointer), destroyPointer(takeOverStorage)
+    : npts(n), array(storagePointer), destroyPointer(takeOverStorage),
+      alloc(0)
     { if (destroyPointer) storagePointer = 0;}
 
   // Copy the other block into this one. Uses copy, not reference, semantics.
   Block(const Block<T> &other)
-    : npts(other.npts), array(npts > 0 ? new T[npts] : 0), destroyPointer(True)
-    { objcopy(array, other.array, npts); }
+    : npts(other.npts), array(0), destroyPointer(True), alloc(other.alloc)
+    { array = allocStorage(npts); objcopy(array, other.array, npts); }
   
   // Assign other to this. this resizes itself to the size of other, so after
   // the assignment, this->nelements() == other.elements() always.
@@ -135,7 +153,7 @@ public:
     return *this; }
   
   // Frees up the storage pointed contained in the Block.
-  ~Block() { if (array && destroyPointer) { delete [] array; array = 0;} }
+  ~Block() { if (array && destroyPointer) { freeStorage(array, npts); array = 0;} }
 
   // Resizes the Block. If <src>n == nelements()</src> resize just returns. If
   // a larger size is requested (<src>n > nelements()</src>) the Block always
@@ -160,13 +178,13 @@ public:
   // <group>
   void resize(size_t n, Bool forceSmaller=False, Bool copyElements=True) {
     if (!(n == npts || (n < npts && forceSmaller == False))) {
-      T *tp = n > 0 ? new T[n] : 0;
+      T *tp = allocStorage(n);
       if (copyElements) {
 	size_t nmin = npts < n ? npts : n;  // Don't copy too much!
 	objcopy(tp, array, nmin);
       };
       if (array && destroyPointer) { // delete...
-	delete [] array;
+	freeStorage(array, npts);
 	array = 0;
       };
       npts = n;
@@ -193,11 +211,11 @@ public:
 #endif
     };
     if (forceSmaller == True) {
-      T *tp = new T[npts - 1];
+      T *tp = allocStorage(npts - 1);
       objcopy(tp, array, whichOne);
       objcopy(tp+whichOne, array + whichOne + 1, npts - whichOne - 1);
       if (array && destroyPointer) {
-	delete [] array;
+	freeStorage(array, npts);
 	array = 0;
       };
       npts--;
@@ -212,11 +230,13 @@ public:
   // owns the pointer, i.e. that it is safe to <src>delete[]</src> it when the 
   // <src>Block</src>is destructed, otherwise the actual storage is not destroyed.
   // If true, storagePointer is set to <src>NULL</src>.
+  // The Block does not use its allocator anymore.
   void replaceStorage(size_t n, T *&storagePointer, Bool takeOverStorage=True) {
     if (array && destroyPointer) {
-      delete [] array;
+      freeStorage(array, npts);
       array = 0;
     };
+    alloc = 0;
     npts = n;
     array = storagePointer;
     destroyPointer = takeOverStorage;
@@ -288,6 +308,10 @@ public:
   // Is the block empty (i.e. no elements)?
   Bool empty() const {return npts == 0;}
 
+  // Get the allocator used for the storage.
+  // A null pointer means that <src>new[]</src> is used.
+  const StorageAllocator* allocator() const {return alloc;}
+
   // Define the STL-style iterators.
   // It makes it possible to iterate through all data elements.
   // <srcblock>
@@ -329,6 +353,44 @@ public:
   T *array;
   // Can we delete the storage upon destruction?
   Bool destroyPointer;
+  // The allocator of the storage (0 means new[]).
+  const StorageAllocator* alloc;
+
+  // Allocate the storage for n elements and construct them if needed.
+  T *allocStorage(size_t n) const {
+    if (n == 0) return 0;
+    if (alloc == 0) return new T[n];
+    T *tp = static_cast<T*>(alloc->allocate(n*sizeof(T)));
+    if (! AllocPOD<T>::value) {
+      size_t i = 0;
+      try {
+        for (; i<n; ++i) {
+          ::new (static_cast<void*>(tp+i)) T();
+        }
+      } catch (...) {
+        destroyElements(tp, i);
+        alloc->deallocate(tp, n*sizeof(T));
+        throw;
+      }
+    }
+    return tp;
+  }
+  // Destruct the elements and free the storage.
+  void freeStorage(T *tp, size_t n) const {
+    if (alloc == 0) {
+      delete [] tp;
+    } else {
+      destroyElements(tp, n);
+      alloc->deallocate(tp, n*sizeof(T));
+    }
+  }
+  void destroyElements(T *tp, size_t n) const {
+    if (! AllocPOD<T>::value) {
+      for (size_t i=0; i<n; ++i) {
+        tp[i].~T();
+      }
+    }
+  }
 };
 
 // <summary>
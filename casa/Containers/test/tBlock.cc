@@ -35,6 +35,7 @@
 #include <casa/aips.h>
 #include <casa/Containers/Block.h>
 #include <casa/Containers/BlockIO.h>
+#include <casa/Containers/Allocator.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
@@ -203,10 +204,65 @@ void testIO()
   }
 }
 
+void testAllocator()
+{
+  {
+    // Aligned storage; the allocator is kept when resizing and copying.
+    Block<Double> bl(100, AlignedAllocator::instance());
+    AlwaysAssertExit (bl.allocator() == &AlignedAllocator::instance());
+    AlwaysAssertExit (size_t(bl.storage()) % AlignedAllocator::alignment == 0);
+    for (uInt i=0; i<bl.size(); ++i) {
+      bl[i] = i;
+    }
+    bl.resize (1000);
+    AlwaysAssertExit (bl.allocator() == &AlignedAllocator::instance());
+    AlwaysAssertExit (size_t(bl.storage()) % AlignedAllocator::alignment == 0);
+    AlwaysAssertExit (bl[99] == 99);
+    Block<Double> bl2(bl);
+    AlwaysAssertExit (bl2.allocator() == &AlignedAllocator::instance());
+    AlwaysAssertExit (bl2[99] == 99);
+    bl2.remove (0);
+    AlwaysAssertExit (bl2.size() == 999  &&  bl2[98] == 99);
+    // User storage is not allocated by the allocator.
+    Double* ptr = new Double[10];
+    bl2.replaceStorage (10, ptr);
+    AlwaysAssertExit (bl2.allocator() == 0);
+  }
+  {
+    // Non-POD elements are constructed and destructed.
+    Block<std::vector<Int> > bl(10, AlignedAllocator::instance());
+    AlwaysAssertExit (bl[9].empty());
+    bl[9].resize (5, 3);
+    bl.resize (20);
+    AlwaysAssertExit (bl[9].size() == 5  &&  bl[19].empty());
+  }
+  {
+    // Freed storage is reused by the pool allocator.
+    PoolAllocator::releaseCache();
+    Block<Float>* bl = new Block<Float>(100, PoolAllocator::instance());
+    Float* ptr = bl->storage();
+    AlwaysAssertExit (size_t(ptr) % AlignedAllocator::alignment == 0);
+    delete bl;
+    AlwaysAssertExit (PoolAllocator::nCached() == 1);
+    // Same size class (512 bytes).
+    Block<Int> bl2(120, PoolAllocator::instance());
+    AlwaysAssertExit (static_cast<void*>(bl2.storage()) ==
+                      static_cast<void*>(ptr));
+    AlwaysAssertExit (PoolAllocator::nCached() == 0);
+    // Large blocks are not pooled.
+    {
+      Block<Double> bl3(100000, PoolAllocator::instance());
+    }
+    AlwaysAssertExit (PoolAllocator::nCached() == 0);
+  }
+  PoolAllocator::releaseCache();
+}
+
 int main()
 {
     doit();
     testIO();
+    testAllocator();
     cout << "OK\n";
     return 0;
 }
@@ -30,6 +30,7 @@
 #include <casa/IO/CanonicalIO.h>
 #include <casa/IO/ByteIO.h>
 #include <casa/IO/RegularFileIO.h>
+#include <casa/IO/MFFileIO.h>
 #include <casa/OS/RegularFile.h>
 #include <casa/BasicSL/Complex.h>
 #include <casa/Utilities/Assert.h>
@@ -57,7 +58,7 @@ AipsIO::AipsIO()
 {}
 
 AipsIO::AipsIO (const String& fileName, ByteIO::OpenOption fop,
-		uInt filebufSize)
+		uInt filebufSize, MultiFile* mfile)
 : opened_p (0),
   maxlev_p (10),
   objlen_p (10),
@@ -65,7 +66,7 @@ AipsIO::AipsIO (const String& fileName, ByteIO::OpenOption fop,
   objptr_p (10)
 {
     // Open the file.
-    open (fileName, fop, filebufSize);
+    open (fileName, fop, filebufSize, mfile);
 }
 
 AipsIO::AipsIO (ByteIO* file)
@@ -98,11 +99,20 @@ AipsIO::~AipsIO()
 
 
 void AipsIO::open (const String& fileName, ByteIO::OpenOption fop,
-		   uInt filebufSize)
+		   uInt filebufSize, MultiFile* mfile)
 {
     // Initialize everything for the open.
     openInit (fop);
-    file_p = new RegularFileIO (fileName, fopt_p, filebufSize);
+    if (mfile != 0) {
+        MFFileIO* mfio = new MFFileIO (*mfile, fileName, fopt_p);
+        fileName_p = mfio->fileName();
+        file_p = mfio;
+    } else {
+        RegularFileIO* regio = new RegularFileIO (fileName, fopt_p,
+                                                  filebufSize);
+        fileName_p = regio->fileName();
+        file_p = regio;
+    }
     AlwaysAssert (file_p != 0, AipsError);
     io_p   = new CanonicalIO (file_p);
     AlwaysAssert (io_p != 0, AipsError);
@@ -909,7 +919,7 @@ const String& AipsIO::getNextType()
 {
     if (opened_p == 0  ||  swget_p < 0  ||  swput_p > 0) {
         String message;
-        if (file_p) message = file_p->fileName() + " - ";
+        if (file_p) message = fileName_p + " - ";
 	throw (AipsError ("AipsIO::getNextType: " + message + 
                           "not opened or not readable"));
     }
@@ -924,7 +934,7 @@ const String& AipsIO::getNextType()
 	operator>> (mval);
 	if (mval != magicval_p) {
             String message;
-            if (file_p) message = file_p->fileName() + " - ";
+            if (file_p) message = fileName_p + " - ";
 	    throw (AipsError ("AipsIO::getNextType: " + message + 
                               "no magic value found"));
 	}
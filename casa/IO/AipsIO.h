@@ -42,7 +42,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //# Forward Declarations
 class TypeIO;
 class ByteIO;
-class RegularFileIO;
+class MultiFile;
 
 
 // <summary> 
@@ -173,9 +173,12 @@ public:
     // Construct and open/create a file with the given name.
     // The actual IO is done via a CanonicalIO object using a filebuf
     // with a buffer of the given size.
+    // If a MultiFile is given, the file is a virtual file in it
+    // (see <linkto class=MFFileIO>MFFileIO</linkto>) and the filebuf size
+    // is ignored.
     explicit AipsIO (const String& fileName,
 		     ByteIO::OpenOption = ByteIO::Old,
-		     uInt filebufSize=65536);
+		     uInt filebufSize=65536, MultiFile* mfile=0);
 ////		     uInt filebufSize=1048576);
 
     // Construct and open/create a file with the given name.
@@ -193,10 +196,10 @@ public:
     // Close if not done yet
     ~AipsIO();
 
-    // Open/create file.
+    // Open/create file (possibly as a virtual file in a MultiFile).
     // An exception is thrown if the object contains an already open file.
     void open (const String& fileName, ByteIO::OpenOption = ByteIO::Old,
-	       uInt filebufSize=65536);
+	       uInt filebufSize=65536, MultiFile* mfile=0);
 
     // Open by connecting to the given byte stream.
     // This can for instance by used to use AipsIO on a file descriptor
@@ -449,7 +452,9 @@ private:
     // The cached object type.
     String       objectType_p;
     // The file object.
-    RegularFileIO* file_p;
+    ByteIO*      file_p;
+    // The name of the file object.
+    String       fileName_p;
     // The actual IO object.
     TypeIO*      io_p;
     // Is the file is seekable?
@@ -28,12 +28,21 @@
 
 //# Includes
 #include <casa/IO/BucketCache.h>
+#include <casa/Utilities/GenSort.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
+#include <algorithm>
+#include <vector>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+const uInt BucketCache::defaultReadAhead;
+const uInt BucketCache::maxWriteSize;
+
 BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
 			  uInt bucketSize, uInt nrOfBuckets,
 			  uInt cacheSize, void* ownerObject,
@@ -58,8 +67,17 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
   its_SlotNr        (nrOfBuckets, Int(-1)),
   its_BucketNr      (cacheSize, uInt(0)),
   its_Dirty         (cacheSize, uInt(0)),
-  its_LRU           (cacheSize, uInt(0)),
-  its_LRUCounter    (0),
+  its_Policy        (LRU),
+  its_LRUPrev       (cacheSize, Int(-1)),
+  its_LRUNext       (cacheSize, Int(-1)),
+  its_LRUHead       (-1),
+  its_LRUTail       (-1),
+  its_RefBit        (cacheSize, uChar(0)),
+  its_ClockHand     (0),
+  its_Pinned        (cacheSize, uChar(0)),
+  its_ReadAhead     (defaultReadAhead),
+  its_LastRead      (-1),
+  its_PrefetchEnd   (0),
   its_Buffer        (0),
   its_NrOfFree      (0),
   its_FirstFree     (-1)
@@ -109,14 +127,20 @@ void BucketCache::clear (uInt fromSlot, Bool doFlush)
 	its_DeleteCallBack (its_Owner, its_Cache[i]);
 	its_Cache[i] = 0;
 	its_SlotNr[its_BucketNr[i]] = -1;
+	unlinkSlot (i);
+	its_RefBit[i] = 0;
     }
     if (fromSlot == 0) {
-	its_LRUCounter = 0;
+	its_LastRead    = -1;
+	its_PrefetchEnd = 0;
 	initStatistics();
     }
     if (fromSlot < its_CacheSizeUsed) {
 	its_CacheSizeUsed = fromSlot;
     }
+    if (its_ClockHand >= its_CacheSizeUsed) {
+	its_ClockHand = 0;
+    }
 }
 
 Bool BucketCache::flush (uInt fromSlot)
@@ -125,14 +149,33 @@ Bool BucketCache::flush (uInt fromSlot)
     if (fromSlot == 0  &&  its_NewNrOfBuckets > 0) {
 	initializeBuckets (its_NewNrOfBuckets - 1);
     }
-    Bool hasWritten = False;
+    // Collect the dirty slots and sort them in order of bucket number,
+    // so buckets are written in file order and consecutive ones can be
+    // written in a single call.
+    Block<uInt64> keys(its_CacheSizeUsed);
+    uInt nrDirty = 0;
     for (uInt i=fromSlot; i<its_CacheSizeUsed; i++) {
 	if (its_Dirty[i]) {
-	    writeBucket (i);
-	    hasWritten = True;
+	    keys[nrDirty++] = (uInt64(its_BucketNr[i]) << 32) + i;
+	}
+    }
+    if (nrDirty == 0) {
+	return False;
+    }
+    GenSort<uInt64>::sort (keys.storage(), nrDirty);
+    uInt maxRun = std::max (maxWriteSize / its_BucketSize, 1u);
+    uInt st = 0;
+    while (st < nrDirty) {
+	uInt firstBucket = keys[st] >> 32;
+	uInt nr = 1;
+	while (st+nr < nrDirty  &&  nr < maxRun
+	   &&  uInt(keys[st+nr] >> 32) == firstBucket + nr) {
+	    nr++;
 	}
+	writeBuckets (keys.storage() + st, nr);
+	st += nr;
     }
-    return hasWritten;
+    return True;
 }
 
 void BucketCache::resize (uInt cacheSize)
@@ -150,13 +193,19 @@ void BucketCache::resize (uInt cacheSize)
     // Resize the cache.
     its_Cache.resize    (cacheSize);
     its_BucketNr.resize (cacheSize);
-    its_LRU.resize      (cacheSize);
+    its_LRUPrev.resize  (cacheSize);
+    its_LRUNext.resize  (cacheSize);
+    its_RefBit.resize   (cacheSize);
+    its_Pinned.resize   (cacheSize);
     its_Dirty.resize    (cacheSize);
     // Initialize the new part of the cache.
     for (uInt i=its_CacheSize; i<cacheSize; i++) {
 	its_Cache[i]    = 0;
 	its_BucketNr[i] = 0;
-	its_LRU[i]      = 0;
+	its_LRUPrev[i]  = -1;
+	its_LRUNext[i]  = -1;
+	its_RefBit[i]   = 0;
+	its_Pinned[i]   = 0;
 	its_Dirty[i]    = 0;
     }
     its_CacheSize = cacheSize;
@@ -193,16 +242,114 @@ void BucketCache::setDirty()
 }
 
 
+void BucketCache::setReadAhead (uInt nrBucket)
+{
+    its_ReadAhead   = nrBucket;
+    its_PrefetchEnd = 0;
+}
+
+void BucketCache::setPolicy (Policy policy)
+{
+    if (policy != its_Policy) {
+        // Start the new policy with the LRU order of the slots as is,
+        // but without any reference bits.
+        its_Policy = policy;
+        for (uInt i=0; i<its_CacheSizeUsed; i++) {
+	    its_RefBit[i] = 0;
+	}
+	its_ClockHand = 0;
+    }
+}
+
+void BucketCache::unlinkSlot (uInt slotNr)
+{
+    Int prev = its_LRUPrev[slotNr];
+    Int next = its_LRUNext[slotNr];
+    if (prev >= 0) {
+	its_LRUNext[prev] = next;
+    } else if (its_LRUHead == Int(slotNr)) {
+	its_LRUHead = next;
+    }
+    if (next >= 0) {
+	its_LRUPrev[next] = prev;
+    } else if (its_LRUTail == Int(slotNr)) {
+	its_LRUTail = prev;
+    }
+    its_LRUPrev[slotNr] = -1;
+    its_LRUNext[slotNr] = -1;
+}
+
+void BucketCache::linkHead (uInt slotNr)
+{
+    its_LRUPrev[slotNr] = -1;
+    its_LRUNext[slotNr] = its_LRUHead;
+    if (its_LRUHead >= 0) {
+	its_LRUPrev[its_LRUHead] = slotNr;
+    }
+    its_LRUHead = slotNr;
+    if (its_LRUTail < 0) {
+	its_LRUTail = slotNr;
+    }
+}
+
+void BucketCache::linkTail (uInt slotNr)
+{
+    its_LRUNext[slotNr] = -1;
+    its_LRUPrev[slotNr] = its_LRUTail;
+    if (its_LRUTail >= 0) {
+	its_LRUNext[its_LRUTail] = slotNr;
+    }
+    its_LRUTail = slotNr;
+    if (its_LRUHead < 0) {
+	its_LRUHead = slotNr;
+    }
+}
+
 void BucketCache::setLRU()
 {
-    // When the LRU counter would wrap, clear all LRU info in the cache.
-    if (its_LRUCounter == 4294967295u) {
-	its_LRUCounter = 0;
-	for (uInt i=0; i<its_CacheSizeUsed; i++) {
-	    its_LRU[i] = 0;
+    if (its_Policy == Clock) {
+	its_RefBit[its_ActualSlot] = 1;
+    } else if (its_LRUHead != Int(its_ActualSlot)) {
+	unlinkSlot (its_ActualSlot);
+	linkHead (its_ActualSlot);
+    }
+}
+
+void BucketCache::setFirstVictim (uInt slotNr)
+{
+    if (its_Policy == Clock) {
+	its_RefBit[slotNr] = 0;
+	its_ClockHand = slotNr;
+    } else {
+	unlinkSlot (slotNr);
+	linkTail (slotNr);
+    }
+}
+
+uInt BucketCache::findVictim()
+{
+    if (its_Policy == Clock) {
+        // Sweep the clock hand until a slot without reference bit is found.
+        // This ends after at most one full revolution (two if slots are
+        // pinned by getBuckets; at least one slot is never pinned).
+	while (its_RefBit[its_ClockHand] != 0  ||  its_Pinned[its_ClockHand]) {
+	    its_RefBit[its_ClockHand] = 0;
+	    if (++its_ClockHand >= its_CacheSizeUsed) {
+		its_ClockHand = 0;
+	    }
+	}
+	uInt slotNr = its_ClockHand;
+	if (++its_ClockHand >= its_CacheSizeUsed) {
+	    its_ClockHand = 0;
 	}
+	return slotNr;
     }
-    its_LRU[its_ActualSlot] = ++its_LRUCounter;
+    // Skip the slots pinned by getBuckets.
+    Int slotNr = its_LRUTail;
+    while (its_Pinned[slotNr]) {
+	slotNr = its_LRUPrev[slotNr];
+    }
+    return slotNr;
 }
 
 char* BucketCache::getBucket (uInt bucketNr)
@@ -234,6 +381,118 @@ char* BucketCache::getBucket (uInt bucketNr)
     return its_Cache[its_ActualSlot];
 }
 
+void BucketCache::getBuckets (char** data, const uInt* bucketNrs,
+			      uInt nrBucket, Bool dirty)
+{
+    if (nrBucket > its_CacheSize) {
+	throw AipsError ("BucketCache::getBuckets: " +
+			 String::toString(nrBucket) +
+			 " buckets do not fit in cache of size " +
+			 String::toString(its_CacheSize));
+    }
+    // First find or assign a slot for all buckets. A slot is pinned to
+    // prevent it from being reused for another bucket in this call.
+    // Evicting (and writing) buckets to free slots is done serially.
+    std::vector<uInt64> keys;
+    keys.reserve (nrBucket);
+    Block<uInt> slots(nrBucket);
+    uInt nrPinned = 0;
+    try {
+	for (; nrPinned<nrBucket; nrPinned++) {
+	    uInt bucketNr = bucketNrs[nrPinned];
+	    if (bucketNr >= its_NewNrOfBuckets) {
+		throw (indexError<Int> (bucketNr));
+	    }
+	    naccess_p++;
+	    if (its_SlotNr[bucketNr] >= 0) {
+		its_ActualSlot = its_SlotNr[bucketNr];
+		setLRU();
+	    } else if (bucketNr < its_CurNrOfBuckets) {
+		getSlot (bucketNr);
+		keys.push_back ((uInt64(bucketNr) << 32) + its_ActualSlot);
+	    } else {
+		if (! its_file->isWritable()) {
+		    throw AipsError ("BucketCache::getBuckets: bucket " +
+				     String::toString(bucketNr) +
+				     " exceeds nr of buckets");
+		}
+		initializeBuckets (bucketNr);
+	    }
+	    slots[nrPinned] = its_ActualSlot;
+	    its_Pinned[its_ActualSlot] = 1;
+	}
+    } catch (AipsError&) {
+	for (uInt i=0; i<nrPinned; i++) {
+	    its_Pinned[slots[i]] = 0;
+	}
+	throw;
+    }
+    // Read the missing buckets in file order.
+    // The reads are serialized, but the conversions are done in parallel,
+    // so reading a bucket overlaps with converting the previous ones.
+    String errMsg;
+    Int nrRead = keys.size();
+    if (nrRead > 0) {
+	std::sort (keys.begin(), keys.end());
+	its_LastRead = keys[nrRead-1] >> 32;
+	Int nthr = 1;
+#ifdef _OPENMP
+	nthr = std::min (omp_get_max_threads(), nrRead);
+#endif
+	Block<char> buffers (Int64(nthr) * its_BucketSize);
+#ifdef _OPENMP
+# pragma omp parallel for schedule(dynamic) num_threads(nthr)
+#endif
+	for (Int i=0; i<nrRead; i++) {
+	    Int thr = 0;
+#ifdef _OPENMP
+	    thr = omp_get_thread_num();
+#endif
+	    char* buf = buffers.storage() + Int64(thr) * its_BucketSize;
+	    uInt bucketNr = keys[i] >> 32;
+	    uInt slotNr = keys[i] & 0xffffffff;
+	    try {
+#ifdef _OPENMP
+# pragma omp critical (BucketCache_getBuckets)
+#endif
+		{
+		    its_file->seek (its_StartOffset +
+				    Int64(bucketNr) * its_BucketSize);
+		    its_file->read (buf, its_BucketSize);
+		}
+		its_Cache[slotNr] = its_ReadCallBack (its_Owner, buf);
+	    } catch (AipsError& x) {
+#ifdef _OPENMP
+# pragma omp critical (BucketCache_getBuckets_err)
+#endif
+		errMsg = x.getMesg();
+	    }
+	}
+	nread_p += nrRead;
+	if (! errMsg.empty()) {
+	    // Make the slots of buckets that could not be read free.
+	    for (Int i=0; i<nrRead; i++) {
+		uInt slotNr = keys[i] & 0xffffffff;
+		if (its_Cache[slotNr] == 0) {
+		    its_SlotNr[keys[i] >> 32] = -1;
+		    its_Pinned[slotNr] = 0;
+		    setFirstVictim (slotNr);
+		}
+	    }
+	}
+    }
+    for (uInt i=0; i<nrBucket; i++) {
+	its_Pinned[slots[i]] = 0;
+	if (dirty) {
+	    its_Dirty[slots[i]] = 1;
+	}
+	data[i] = its_Cache[slots[i]];
+    }
+    if (! errMsg.empty()) {
+	throw AipsError (errMsg);
+    }
+}
+
 void BucketCache::extend (uInt nrBucket)
 {
     its_NewNrOfBuckets += nrBucket;
@@ -290,11 +549,11 @@ void BucketCache::removeBucket()
     its_FirstFree = bucketNr;
     its_NrOfFree++;
     // Delete the stuff for this bucket.
-    // Set the LRU to zero, so it will be reused first.
+    // Mark the slot such that it will be reused first.
     its_DeleteCallBack (its_Owner, its_Cache[its_ActualSlot]);
     its_Cache[its_ActualSlot] = 0;
     its_SlotNr[bucketNr] = -1;
-    its_LRU[its_ActualSlot] = 0;
+    setFirstVictim (its_ActualSlot);
     its_ActualSlot = 0;
 }
 
@@ -325,15 +584,9 @@ void BucketCache::getSlot (uInt bucketNr)
 {
     if (its_CacheSizeUsed < its_CacheSize) {
 	its_ActualSlot = its_CacheSizeUsed++;
+	linkHead (its_ActualSlot);
     }else{
-	its_ActualSlot = 0;
-	uInt least = its_LRU[0];
-	for (uInt i=1; i<its_CacheSizeUsed; i++) {
-	    if (its_LRU[i] < least) {
-		least = its_LRU[i];
-		its_ActualSlot = i;
-	    }
-	}
+	its_ActualSlot = findVictim();
 	if (its_Dirty[its_ActualSlot]) {
 	    writeBucket (its_ActualSlot);
 	}
@@ -341,6 +594,7 @@ void BucketCache::getSlot (uInt bucketNr)
 	    its_DeleteCallBack (its_Owner, its_Cache[its_ActualSlot]);
 	    its_Cache[its_ActualSlot] = 0;
 	    its_SlotNr[its_BucketNr[its_ActualSlot]] = -1;
+	    nevict_p++;
 	}
     }
     setLRU();
@@ -358,10 +612,54 @@ void BucketCache::writeBucket (uInt slotNr)
     its_file->write (its_Buffer, its_BucketSize);
     its_Dirty[slotNr] = 0;
     nwrite_p++;
+    nwritecall_p++;
+}
+void BucketCache::writeBuckets (const uInt64* keys, uInt nrBucket)
+{
+    if (nrBucket == 1) {
+	writeBucket (keys[0] & 0xffffffff);
+	return;
+    }
+    its_WriteBuffer.resize (nrBucket * its_BucketSize, False, False);
+    char* buf = its_WriteBuffer.storage();
+    for (uInt i=0; i<nrBucket; i++) {
+	uInt slotNr = keys[i] & 0xffffffff;
+	its_WriteCallBack (its_Owner, buf + i*its_BucketSize,
+			   its_Cache[slotNr]);
+	its_Dirty[slotNr] = 0;
+    }
+    its_file->seek (its_StartOffset + Int64(keys[0] >> 32) * its_BucketSize);
+    its_file->write (buf, nrBucket * its_BucketSize);
+    nwrite_p += nrBucket;
+    nwritecall_p++;
 }
+
+void BucketCache::doReadAhead (uInt bucketNr)
+{
+    // Sequential access is assumed if the previous bucket was read last.
+    // Advise to read the next buckets when the end of the range advised
+    // before is getting near. In this way the advise is not given for
+    // each bucket read, while the system can stay ahead of the reads.
+    if (its_LastRead >= 0  &&  bucketNr == uInt(its_LastRead) + 1
+    &&  bucketNr + its_ReadAhead/2 >= its_PrefetchEnd) {
+	uInt st  = std::max (bucketNr + 1, its_PrefetchEnd);
+	uInt end = std::min (bucketNr + 1 + its_ReadAhead, its_CurNrOfBuckets);
+	if (st < end) {
+	    its_file->prefetch (its_StartOffset + Int64(st) * its_BucketSize,
+				Int64(end - st) * its_BucketSize);
+	    its_PrefetchEnd = end;
+	    nprefetch_p++;
+	}
+    }
+    its_LastRead = bucketNr;
+}
+
 void BucketCache::readBucket (uInt slotNr)
 {
 ///    cout << "read " << its_BucketNr[slotNr] << " " << slotNr;
+    if (its_ReadAhead > 0) {
+	doReadAhead (its_BucketNr[slotNr]);
+    }
     its_file->seek (its_StartOffset +
 		    Int64(its_BucketNr[slotNr]) * its_BucketSize);
     its_file->read (its_Buffer, its_BucketSize);
@@ -403,13 +701,14 @@ void BucketCache::showStatistics (ostream& os) const
     if (nwrite_p > 0) {
 	os << "#writes:   " << nwrite_p << endl;
     }
+    if (nevict_p > 0) {
+	os << "#evicts:   " << nevict_p << endl;
+    }
     os << "#accesses: " << naccess_p;
     if (naccess_p > 0) {
-	os << "        hit-rate:  "
-	   << 100 * float(naccess_p - nread_p - ninit_p) /
-	                               float(naccess_p) << "%";
+	os << "        hit-rate:  " << 100 * hitRate() << "%";
     }
-    cout << endl;
+    os << endl;
 }
 
 void BucketCache::initStatistics()
@@ -418,6 +717,17 @@ void BucketCache::initStatistics()
     nread_p   = 0;
     ninit_p   = 0;
     nwrite_p  = 0;
+    nevict_p  = 0;
+    nwritecall_p = 0;
+    nprefetch_p  = 0;
+}
+
+Double BucketCache::hitRate() const
+{
+    if (naccess_p == 0) {
+	return 0;
+    }
+    return Double(nHit()) / Double(naccess_p);
 }
 
 } //# NAMESPACE CASA - END
@@ -127,8 +127,27 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // to allocate/delete buffers and to convert the data to/from local format.
 // <p>
 // When a new bucket is needed and all slots in the cache are used,
-// BucketCache will remove the least recently used bucket from the
-// cache. When the dirty flag is set, it will first be written.
+// BucketCache will remove a bucket from the cache. When its dirty flag
+// is set, it will first be written. The bucket to remove is chosen by the
+// eviction policy (see <src>BucketCache::Policy</src>):
+// <ul>
+//  <li> <src>LRU</src> (default) removes the least recently used bucket.
+//       The slots are kept in a doubly linked list ordered by access time,
+//       so finding the least recently used slot takes constant time.
+//  <li> <src>Clock</src> uses the CLOCK (second chance) algorithm.
+//       Each slot has a reference bit which is set on access. A clock hand
+//       sweeps over the slots, clearing reference bits until it finds a
+//       slot without it. It has a lower bookkeeping overhead per access
+//       than LRU, while giving a similar hit rate.
+// </ul>
+// Looking up the cache slot of a bucket is a direct index operation.
+// <p>
+// BucketCache detects sequential access to the buckets. When two successive
+// misses are for consecutive buckets, it advises the system to read the
+// next buckets asynchronously (see <src>setReadAhead</src>), so a
+// sequential scan does not have to wait for each bucket read.
+// When flushing, the dirty buckets are written in order of bucket number,
+// whereby consecutive buckets are combined into a single write.
 // <p>
 // BucketCache maintains a list of free buckets. Initially this list is
 // empty. When a bucket is removed, it is added to the free list.
@@ -142,7 +161,10 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // in the same file.
 // <p>
 // Statistics are kept to know how efficient the cache is working.
-// It is possible to initialize and show the statistics.
+// It is possible to initialize and show the statistics. The counters
+// can also be obtained individually (e.g. <src>nAccess()</src>,
+// <src>nRead()</src>, <src>nEvict()</src>), so a storage manager can
+// report them in its own way.
 // </synopsis> 
 
 // <motivation>
@@ -209,14 +231,23 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // </srcblock>
 // </example>
 
-// <todo asof="$DATE:$">
-//   <li> When ready, use HashMap for the internal maps.
-// </todo>
-
-
 class BucketCache
 {
 public:
+    // The default number of buckets to read ahead.
+    static const uInt defaultReadAhead = 16;
+
+    // The maximum number of bytes combined in a single write when flushing.
+    static const uInt maxWriteSize = 4194304;
+
+    // Define the possible policies to select the bucket to remove
+    // from a full cache.
+    enum Policy {
+        // Remove the least recently used bucket.
+        LRU,
+        // Use the CLOCK (second chance) approximation of LRU.
+        Clock
+    };
 
     // Create the cache for (a part of) a file.
     // The file part used starts at startOffset. Its length is
@@ -276,6 +307,18 @@ public:
     // A pointer to the data in converted format is returned.
     char* getBucket (uInt bucketNr);
 
+    // Get multiple buckets at once and store the pointers to their data
+    // in <src>data</src>. The buckets are marked dirty if <src>dirty</src>
+    // is set. All buckets have to fit in the cache at the same time,
+    // so <src>nrBucket</src> cannot exceed the cache size; the pointers
+    // stay valid until the next call of a function accessing the cache.
+    // <br>The buckets not in the cache are read in order of bucket number.
+    // Reading them is serialized, but they are converted to local format
+    // in parallel (if OpenMP is used), so the ToLocal callback function
+    // has to be thread-safe.
+    void getBuckets (char** data, const uInt* bucketNrs, uInt nrBucket,
+		     Bool dirty);
+
     // Extend the file with the given number of buckets.
     // The buckets get initialized when they are acquired
     // (using getBucket) for the first time.
@@ -313,12 +356,55 @@ public:
     // Get the number of free buckets.
     uInt nFreeBucket() const;
 
+    // Get the number of buckets to read ahead when sequential access is
+    // detected.
+    uInt readAhead() const;
+
+    // Set the number of buckets to read ahead when sequential access is
+    // detected. 0 means no read-ahead.
+    // The default is <src>BucketCache::defaultReadAhead</src>.
+    void setReadAhead (uInt nrBucket);
+
+    // Get the eviction policy.
+    Policy policy() const;
+
+    // Set the eviction policy.
+    // The buckets in the cache are kept; their access history is reset.
+    void setPolicy (Policy policy);
+
     // (Re)initialize the cache statistics.
     void initStatistics();
 
     // Show the statistics.
     void showStatistics (ostream& os) const;
 
+    // Get the individual statistics.
+    // <group>
+    // Get the number of getBucket calls.
+    uInt64 nAccess() const;
+    // Get the number of getBucket calls not needing a read or initialize.
+    uInt64 nHit() const;
+    // Get the number of buckets read from the file.
+    uInt64 nRead() const;
+    // Get the number of buckets written to the file.
+    uInt64 nWrite() const;
+    // Get the number of buckets initialized (i.e. added to the file).
+    uInt64 nInit() const;
+    // Get the number of buckets removed from the cache to make room.
+    uInt64 nEvict() const;
+    // Get the number of bytes read from the file for buckets.
+    uInt64 nBytesRead() const;
+    // Get the number of bytes written to the file for buckets.
+    uInt64 nBytesWritten() const;
+    // Get the number of write calls done for buckets. It is less than
+    // <src>nWrite()</src> if consecutive buckets were combined.
+    uInt64 nWriteCall() const;
+    // Get the number of times read-ahead was advised to the file.
+    uInt64 nPrefetch() const;
+    // Get the hit rate as a fraction (0 if no accesses were done yet).
+    Double hitRate() const;
+    // </group>
+
 private:
     // The file used.
     BucketFile* its_file;
@@ -354,10 +440,28 @@ private:
     Block<uInt>  its_BucketNr;
     // Determine if a block is dirty (i.e. changed) (1=dirty).
     Block<uInt>  its_Dirty;
-    // Determine when a block is used for the last time.
-    Block<uInt>  its_LRU;
-    // The Least Recently Used counter.
-    uInt         its_LRUCounter;
+    // The eviction policy.
+    Policy       its_Policy;
+    // The LRU list of the slots as a doubly linked list (-1 = end).
+    // The head is the most recently used slot, the tail the least.
+    Block<Int>   its_LRUPrev;
+    Block<Int>   its_LRUNext;
+    Int          its_LRUHead;
+    Int          its_LRUTail;
+    // The reference bits for the CLOCK policy.
+    Block<uChar> its_RefBit;
+    // The position of the clock hand.
+    uInt         its_ClockHand;
+    // The slots which cannot be reused (set temporarily by getBuckets).
+    Block<uChar> its_Pinned;
+    // The number of buckets to read ahead.
+    uInt         its_ReadAhead;
+    // The bucket last read from the file (-1 = none).
+    Int          its_LastRead;
+    // The end of the bucket range advised to be read ahead.
+    uInt         its_PrefetchEnd;
+    // The buffer used to combine buckets into a single write.
+    Block<char>  its_WriteBuffer;
     // The internal buffer.
     char*        its_Buffer;
     // The number of free buckets.
@@ -365,10 +469,13 @@ private:
     // The first free bucket (-1 = no free buckets).
     Int  its_FirstFree;
     // The statistics.
-    uInt naccess_p;
-    uInt nread_p;
-    uInt ninit_p;
-    uInt nwrite_p;
+    uInt64 naccess_p;
+    uInt64 nread_p;
+    uInt64 ninit_p;
+    uInt64 nwrite_p;
+    uInt64 nevict_p;
+    uInt64 nwritecall_p;
+    uInt64 nprefetch_p;
 
 
     // Copy constructor is not possible.
@@ -380,12 +487,35 @@ private:
     // Set the LRU information for the current slot.
     void setLRU();
 
+    // Remove a slot from the LRU list.
+    void unlinkSlot (uInt slotNr);
+
+    // Add a slot to the LRU list as most or least recently used.
+    // <group>
+    void linkHead (uInt slotNr);
+    void linkTail (uInt slotNr);
+    // </group>
+
+    // Mark a slot as the first one to be reused.
+    void setFirstVictim (uInt slotNr);
+
+    // Find the slot to reuse when the cache is full.
+    uInt findVictim();
+
     // Get a cache slot for the bucket.
     void getSlot (uInt bucketNr);
 
     // Write a bucket.
     void writeBucket (uInt slotNr);
 
+    // Write a number of buckets with consecutive bucket numbers.
+    // The sort keys contain the bucket number in the upper 32 bits and
+    // the slot number in the lower 32 bits.
+    void writeBuckets (const uInt64* keys, uInt nrBucket);
+
+    // Advise the file to read the next buckets in case of sequential access.
+    void doReadAhead (uInt bucketNr);
+
     // Read a bucket.
     void readBucket (uInt slotNr);
 
@@ -409,6 +539,43 @@ inline Int BucketCache::firstFreeBucket() const
 inline uInt BucketCache::nFreeBucket() const
     { return its_NrOfFree; }
 
+inline uInt BucketCache::readAhead() const
+    { return its_ReadAhead; }
+
+inline BucketCache::Policy BucketCache::policy() const
+    { return its_Policy; }
+
+inline uInt64 BucketCache::nAccess() const
+    { return naccess_p; }
+
+inline uInt64 BucketCache::nHit() const
+    { return (naccess_p > nread_p + ninit_p  ?
+              naccess_p - nread_p - ninit_p : 0); }
+
+inline uInt64 BucketCache::nRead() const
+    { return nread_p; }
+
+inline uInt64 BucketCache::nWrite() const
+    { return nwrite_p; }
+
+inline uInt64 BucketCache::nInit() const
+    { return ninit_p; }
+
+inline uInt64 BucketCache::nEvict() const
+    { return nevict_p; }
+
+inline uInt64 BucketCache::nBytesRead() const
+    { return nread_p * its_BucketSize; }
+
+inline uInt64 BucketCache::nBytesWritten() const
+    { return nwrite_p * its_BucketSize; }
+
+inline uInt64 BucketCache::nWriteCall() const
+    { return nwritecall_p; }
+
+inline uInt64 BucketCache::nPrefetch() const
+    { return nprefetch_p; }
+
 
 
 
@@ -31,6 +31,10 @@
 #include <casa/IO/BucketFile.h>
 #include <casa/IO/MMapfdIO.h>
 #include <casa/IO/LargeFilebufIO.h>
+#include <casa/IO/FiledesIO.h>
+#include <casa/IO/FilebufIO.h>
+#include <casa/IO/MFFileIO.h>
+#include <casa/IO/MultiFile.h>
 #include <casa/OS/Path.h>
 #include <casa/OS/DOos.h>
 #include <casa/Logging/LogIO.h>
@@ -40,6 +44,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>                // needed for errno
+#include <stdlib.h>               // needed for posix_memalign
 #include <casa/string.h>          // needed for strerror
 
 #if defined(AIPS_DARWIN) || defined(AIPS_BSD)
@@ -53,18 +58,32 @@
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+const uInt BucketFile::theirDirectAlign;
+
 BucketFile::BucketFile (const String& fileName,
-                        uInt bufSizeFile, Bool mappedFile)
-: name_p         (Path(fileName).expandedName()),
-  isWritable_p   (True),
-  isMapped_p     (mappedFile),
-  bufSize_p      (bufSizeFile),
-  fd_p           (-1),
-  mappedFile_p   (0),
-  bufferedFile_p (0)
+                        uInt bufSizeFile, Bool mappedFile, MultiFile* mfile,
+                        Bool directIO)
+: name_p          (Path(fileName).expandedName()),
+  isWritable_p    (True),
+  isMapped_p      (mappedFile  &&  mfile == 0),
+  bufSize_p       (mfile == 0  ?  bufSizeFile : 0),
+  fd_p            (-1),
+  mappedFile_p    (0),
+  bufferedFile_p  (0),
+  mfile_p         (mfile),
+  mfFile_p        (0),
+  isDirect_p      (directIO && mfile == 0 && !isMapped_p && bufSize_p == 0),
+  directBuf_p     (0),
+  directBufSize_p (0),
+  directSize_p    (0),
+  directPadEnd_p  (0)
 {
     // Create the file.
-    fd_p = ::trace3OPEN ((Char *)name_p.chars(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if (mfile_p != 0) {
+        mfFile_p = new MFFileIO (*mfile_p, name_p, ByteIO::New);
+        return;
+    }
+    fd_p = openFile (O_RDWR | O_CREAT | O_TRUNC);
     if (fd_p < 0) {
 	throw (AipsError ("BucketFile: create error on file " + name_p +
 			  ": " + strerror(errno)));
@@ -73,26 +92,76 @@ BucketFile::BucketFile (const String& fileName,
 }
 
 BucketFile::BucketFile (const String& fileName, Bool isWritable,
-                        uInt bufSizeFile, Bool mappedFile)
-: name_p         (Path(fileName).expandedName()),
-  isWritable_p   (isWritable),
-  isMapped_p     (mappedFile),
-  bufSize_p      (bufSizeFile),
-  fd_p           (-1),
-  mappedFile_p   (0),
-  bufferedFile_p (0)
+                        uInt bufSizeFile, Bool mappedFile, MultiFile* mfile,
+                        Bool directIO)
+: name_p          (Path(fileName).expandedName()),
+  isWritable_p    (isWritable),
+  isMapped_p      (mappedFile  &&  mfile == 0),
+  bufSize_p       (mfile == 0  ?  bufSizeFile : 0),
+  fd_p            (-1),
+  mappedFile_p    (0),
+  bufferedFile_p  (0),
+  mfile_p         (mfile),
+  mfFile_p        (0),
+  isDirect_p      (directIO && mfile == 0 && !isMapped_p && bufSize_p == 0),
+  directBuf_p     (0),
+  directBufSize_p (0),
+  directSize_p    (0),
+  directPadEnd_p  (0)
 {}
 
 BucketFile::~BucketFile()
 {
     close();
+    free (directBuf_p);
+}
+
+int BucketFile::openFile (int flags)
+{
+#if defined(O_DIRECT)
+    if (isDirect_p) {
+        int fd = ::trace3OPEN ((Char *)name_p.chars(), flags | O_DIRECT, 0666);
+        if (fd >= 0  ||  errno != EINVAL) {
+            return fd;
+        }
+        // The file system does not support direct IO, so use normal IO.
+        isDirect_p = False;
+    }
+#endif
+    int fd = ::trace3OPEN ((Char *)name_p.chars(), flags, 0666);
+#if !defined(O_DIRECT) && defined(F_NOCACHE)
+    // Without O_DIRECT (e.g. OS-X) the file cache can still be bypassed;
+    // it does not require aligned IO.
+    if (isDirect_p) {
+        if (fd >= 0) {
+            ::fcntl (fd, F_NOCACHE, 1);
+        }
+        isDirect_p = False;
+    }
+#else
+    isDirect_p = False;
+#endif
+    return fd;
 }
 
 
 void BucketFile::close()
 {
+    delete mfFile_p;
+    mfFile_p = 0;
     if (fd_p >= 0) {
         deleteMapBuf();
+        // Direct writes can have padded the last block; remove the padding.
+        // Only do it if the file has not been extended by another process
+        // since the padding was written.
+        if (isDirect_p  &&  isWritable_p  &&  directPadEnd_p > directSize_p
+        &&  ::traceLSEEK (fd_p, 0, SEEK_END) == directPadEnd_p) {
+            if (::ftruncate (fd_p, directSize_p) != 0) {
+                LogIO logIo (LogOrigin ("BucketFile", "close"));
+                logIo << LogIO::WARN << "ftruncate failed for " << name_p
+                      << ": " << strerror(errno) << LogIO::POST;
+            }
+        }
 	::traceCLOSE (fd_p);
 	fd_p = -1;
     }
@@ -101,16 +170,28 @@ void BucketFile::close()
 
 void BucketFile::open()
 {
+    if (mfile_p != 0) {
+        if (mfFile_p == 0) {
+            mfFile_p = new MFFileIO (*mfile_p, name_p,
+                                     isWritable_p ? ByteIO::Update : ByteIO::Old);
+        }
+        return;
+    }
     if (fd_p < 0) {
 	if (isWritable_p) {
-	    fd_p = ::trace2OPEN ((Char *)name_p.chars(), O_RDWR);
+	    fd_p = openFile (O_RDWR);
 	}else{
-	    fd_p = ::trace2OPEN ((Char *)name_p.chars(), O_RDONLY);
+	    fd_p = openFile (O_RDONLY);
 	}
 	if (fd_p == -1) {
 	    throw (AipsError ("BucketFile: open error on file " + name_p +
 			      ": " + strerror(errno)));
 	}
+        if (isDirect_p) {
+            directSize_p   = ::traceLSEEK (fd_p, 0, SEEK_END);
+            directPadEnd_p = 0;
+            ::traceLSEEK (fd_p, 0, SEEK_SET);
+        }
         createMapBuf();
     }
 }
@@ -137,13 +218,23 @@ void BucketFile::deleteMapBuf()
 void BucketFile::remove()
 {
     close();
-    DOos::remove (name_p, False, False);
+    if (mfile_p != 0) {
+        Int id = mfile_p->fileId (name_p, False);
+        if (id >= 0) {
+            mfile_p->deleteFile (id);
+        }
+    } else {
+        DOos::remove (name_p, False, False);
+    }
 }
 
 
 void BucketFile::fsync()
 {
-    if (fd_p >= 0) {
+    if (mfFile_p != 0) {
+        mfile_p->flush();
+        mfile_p->fsync();
+    } else if (fd_p >= 0) {
 	::fsync (fd_p);
     }
 }
@@ -157,8 +248,10 @@ void BucketFile::setRW()
     }
     // Try to reopen the file as read/write.
     // Throw an exception if it fails.
-    if (fd_p >= 0) {
-	int fd = ::trace2OPEN ((Char *)name_p.chars(), O_RDWR);
+    if (mfile_p != 0) {
+        mfile_p->reopenRW();
+    } else if (fd_p >= 0) {
+	int fd = openFile (O_RDWR);
 	if (fd == -1) {
 	    throw (AipsError ("BucketFile: reopenRW error on file " + name_p +
 			      ": " + strerror(errno)));
@@ -174,6 +267,14 @@ void BucketFile::setRW()
 
 uInt BucketFile::read (void* buffer, uInt length) const
 {
+    if (mfFile_p != 0) {
+        mfFile_p->read (length, buffer);
+        return length;
+    }
+    if (isDirect_p) {
+        directRead (buffer, length);
+        return length;
+    }
     if (::traceREAD (fd_p, (Char *)buffer, length)  !=  Int(length)) {
 	throw (AipsError ("BucketFile: read error on file " + name_p +
 	                  ": " + strerror(errno)));
@@ -183,6 +284,14 @@ uInt BucketFile::read (void* buffer, uInt length) const
 
 uInt BucketFile::write (const void* buffer, uInt length)
 {
+    if (mfFile_p != 0) {
+        mfFile_p->write (length, buffer);
+        return length;
+    }
+    if (isDirect_p) {
+        directWrite (buffer, length);
+        return length;
+    }
     if (::traceWRITE (fd_p, (Char *)buffer, length)  !=  Int(length)) {
 	throw (AipsError ("BucketFile: write error on file " + name_p +
 	                  ": " + strerror(errno)));
@@ -193,7 +302,24 @@ uInt BucketFile::write (const void* buffer, uInt length)
 void BucketFile::seek (Int64 offset) const
 {
     AlwaysAssert (bufferedFile_p == 0, AipsError);
-    ::traceLSEEK (fd_p, offset, SEEK_SET);
+    if (mfFile_p != 0) {
+        mfFile_p->seek (offset);
+    } else {
+        ::traceLSEEK (fd_p, offset, SEEK_SET);
+    }
+}
+
+void BucketFile::prefetch (Int64 offset, Int64 length) const
+{
+#if defined(POSIX_FADV_WILLNEED)
+    // Reading ahead would fill the page cache, which direct IO bypasses.
+    if (fd_p >= 0  &&  length > 0  &&  !isDirect_p) {
+        ::posix_fadvise (fd_p, offset, length, POSIX_FADV_WILLNEED);
+    }
+#else
+    (void)offset;
+    (void)length;
+#endif
 }
 
 Int64 BucketFile::fileSize () const
@@ -201,7 +327,19 @@ Int64 BucketFile::fileSize () const
     // If a buffered file is used, seek in there. Otherwise its internal
     // offset is wrong.
     Int64 size;
-    if (bufferedFile_p != 0) {
+    if (mfFile_p != 0) {
+        size = mfFile_p->seek (0, ByteIO::End);
+    } else if (isDirect_p) {
+        size = ::traceLSEEK (fd_p, 0, SEEK_END);
+        if (size != directPadEnd_p) {
+            // Not padded by this object, so another process can have
+            // changed the file; its physical size is the logical size.
+            directSize_p   = size;
+            directPadEnd_p = 0;
+        } else {
+            size = directSize_p;
+        }
+    } else if (bufferedFile_p != 0) {
         size = bufferedFile_p->seek (0, ByteIO::End);
     } else {
         size = ::traceLSEEK (fd_p, 0, SEEK_END);
@@ -216,5 +354,111 @@ Int64 BucketFile::fileSize () const
     return size;
 }
 
+CountedPtr<ByteIO> BucketFile::makeByteIO (uInt bufferSize)
+{
+    if (mfFile_p != 0) {
+        return CountedPtr<ByteIO>
+          (new MFFileIO (*mfile_p, name_p,
+                         isWritable_p ? ByteIO::Update : ByteIO::Old));
+    }
+    if (isDirect_p) {
+        throw AipsError ("BucketFile: no ByteIO can be made for file " +
+                         name_p + " using direct IO");
+    }
+    if (bufferSize > 0) {
+        return CountedPtr<ByteIO> (new FilebufIO (fd_p, bufferSize));
+    }
+    CountedPtr<ByteIO> fio (new FiledesIO (fd_p, name_p));
+    fio->seek (Int64(0));
+    return fio;
+}
+
+char* BucketFile::directBuffer (uInt size) const
+{
+    if (size > directBufSize_p) {
+        free (directBuf_p);
+        directBuf_p = 0;
+        directBufSize_p = 0;
+        void* ptr;
+        if (::posix_memalign (&ptr, theirDirectAlign, size) != 0) {
+            throw AipsError ("BucketFile: cannot allocate aligned buffer for "
+                             "direct IO on file " + name_p);
+        }
+        directBuf_p = static_cast<char*>(ptr);
+        directBufSize_p = size;
+    }
+    return directBuf_p;
+}
+
+void BucketFile::directReadBlock (char* buffer, Int64 offset) const
+{
+    ::traceLSEEK (fd_p, offset, SEEK_SET);
+    Int nread = ::traceREAD (fd_p, buffer, theirDirectAlign);
+    if (nread < 0) {
+	throw (AipsError ("BucketFile: read error on file " + name_p +
+	                  ": " + strerror(errno)));
+    }
+    memset (buffer + nread, 0, theirDirectAlign - nread);
+}
+
+void BucketFile::directRead (void* buffer, uInt length) const
+{
+    // Read all blocks containing the requested bytes.
+    Int64 offset = ::traceLSEEK (fd_p, 0, SEEK_CUR);
+    Int64 start  = offset / theirDirectAlign * theirDirectAlign;
+    Int64 end    = ((offset + length + theirDirectAlign - 1) /
+                    theirDirectAlign * theirDirectAlign);
+    char* buf = directBuffer (end - start);
+    ::traceLSEEK (fd_p, start, SEEK_SET);
+    Int nread = ::traceREAD (fd_p, buf, end - start);
+    if (nread < offset + length - start) {
+	throw (AipsError ("BucketFile: read error on file " + name_p +
+	                  ": " + strerror(errno)));
+    }
+    memcpy (buffer, buf + (offset - start), length);
+    ::traceLSEEK (fd_p, offset + length, SEEK_SET);
+}
+
+void BucketFile::directWrite (const void* buffer, uInt length)
+{
+    Int64 offset = ::traceLSEEK (fd_p, 0, SEEK_CUR);
+    Int64 start  = offset / theirDirectAlign * theirDirectAlign;
+    Int64 end    = ((offset + length + theirDirectAlign - 1) /
+                    theirDirectAlign * theirDirectAlign);
+    // If the file end is not the padding written by this object, the file
+    // has been changed by another process and its size is the logical size.
+    Int64 fileEnd = ::traceLSEEK (fd_p, 0, SEEK_END);
+    if (fileEnd != directPadEnd_p) {
+        directPadEnd_p = 0;
+        if (fileEnd > directSize_p) {
+            directSize_p = fileEnd;
+        }
+    }
+    char* buf = directBuffer (end - start);
+    // Blocks only partially written have to be read first.
+    if (offset > start) {
+        directReadBlock (buf, start);
+    }
+    if (offset + length < end  &&
+        (end - theirDirectAlign > start  ||  offset == start)) {
+        directReadBlock (buf + (end - start - theirDirectAlign),
+                         end - theirDirectAlign);
+    }
+    memcpy (buf + (offset - start), buffer, length);
+    ::traceLSEEK (fd_p, start, SEEK_SET);
+    if (::traceWRITE (fd_p, buf, end - start)  !=  end - start) {
+	throw (AipsError ("BucketFile: write error on file " + name_p +
+	                  ": " + strerror(errno)));
+    }
+    ::traceLSEEK (fd_p, offset + length, SEEK_SET);
+    if (offset + length > directSize_p) {
+        directSize_p = offset + length;
+    }
+    // Remember the padding if this write defines the end of the file.
+    if (end >= fileEnd) {
+        directPadEnd_p = (end > directSize_p  ?  end : 0);
+    }
+}
+
 } //# NAMESPACE CASA - END
 
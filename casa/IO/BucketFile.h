@@ -33,6 +33,7 @@
 #include <casa/IO/MMapfdIO.h>
 #include <casa/IO/LargeFilebufIO.h>
 #include <casa/BasicSL/String.h>
+#include <casa/Utilities/CountedPtr.h>
 #include <unistd.h>
 
 
@@ -41,6 +42,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 // Forward Declarations.
 class MMapfdIO;
 class LargeFilebufIO;
+class MultiFile;
+class MFFileIO;
+class ByteIO;
 
 
 // <summary>
@@ -70,6 +74,21 @@ class LargeFilebufIO;
 // <p>
 // Underneath it uses a file descriptor to access the file.
 // It is straightforward to replace this by a mapped file or a filebuf.
+// <p>
+// The file can also be a virtual file in a
+// <linkto class=MultiFile>MultiFile</linkto> container. In that case
+// the file is accessed via an <linkto class=MFFileIO>MFFileIO</linkto>
+// object and a mapped or buffered file cannot be used.
+// <p>
+// A regular file can be accessed using direct IO (O_DIRECT), so the data
+// do not pollute the kernel's file cache. This is useful for streaming
+// through large files where the caller (e.g. the
+// <linkto class=BucketCache>BucketCache</linkto>) keeps its own cache.
+// Direct IO requires that offsets and sizes are aligned, thus reads and
+// writes are done via an aligned buffer covering the blocks containing the
+// requested bytes; partially written blocks are read first.
+// If the file system does not support direct IO, normal IO is used.
+// Direct IO cannot be combined with a mapped or buffered file.
 // </synopsis> 
 
 // <motivation>
@@ -101,16 +120,22 @@ public:
     // The file with the given name will be created.
     // It can be indicated if a MMapfdIO and/or LargeFilebufIO object must be
     // created for the file.
+    // If a MultiFile is given, the file is created as a virtual file in it.
+    // Otherwise it can be indicated if direct IO has to be used.
     explicit BucketFile (const String& fileName,
-                         uInt bufSizeFile=0, Bool mappedFile=False);
+                         uInt bufSizeFile=0, Bool mappedFile=False,
+                         MultiFile* mfile=0, Bool directIO=False);
 
     // Create a BucketFile object for an existing file.
     // The file should be opened by the <src>open</src>.
     // Tell if the file must be opened writable.
     // It can be indicated if a MMapfdIO and/or LargeFilebufIO object must be
     // created for the file.
+    // If a MultiFile is given, the file is a virtual file in it.
+    // Otherwise it can be indicated if direct IO has to be used.
     BucketFile (const String& fileName, Bool writable,
-                uInt bufSizeFile=0, Bool mappedFile=False);
+                uInt bufSizeFile=0, Bool mappedFile=False,
+                MultiFile* mfile=0, Bool directIO=False);
 
     // The destructor closes the file (if open).
     ~BucketFile();
@@ -157,13 +182,36 @@ public:
     void seek (Int offset) const;
     // </group>
 
+    // Tell the system that the given part of the file will be read soon.
+    // It is only an advice; the system can read the data asynchronously
+    // in the background, so a subsequent read does not have to wait.
+    // It does nothing if the system does not support it or if direct IO
+    // is used.
+    void prefetch (Int64 offset, Int64 length) const;
+
     // Get the (physical) size of the file.
     // This is doing a seek and sets the file pointer to end-of-file.
+    // For direct IO it is the logical size, which can be less than the
+    // physical size if this object padded the last block. If the file has
+    // been extended by another process, its physical size is used.
     Int64 fileSize() const;
 
     // Get the file descriptor of the internal file.
+    // It is -1 if the file is not open or is a virtual file in a MultiFile.
     int fd();
 
+    // Get the MultiFile the file is in (0 if a regular file).
+    MultiFile* multiFile()
+      { return mfile_p; }
+
+    // Make a (temporary) ByteIO object for the file. It accesses the file
+    // as a virtual file in the MultiFile or via the file descriptor, where
+    // a FilebufIO with the given buffer size is used if the size > 0.
+    // It is positioned at the start of the file. The object should not be
+    // used anymore once the BucketFile is closed.
+    // An exception is thrown if direct IO is used.
+    CountedPtr<ByteIO> makeByteIO (uInt bufferSize=0);
+
     // Is the file cached, mapped, or buffered?
     // <group>
     Bool isCached() const;
@@ -171,6 +219,10 @@ public:
     Bool isBuffered() const;
     // </group>
 
+    // Is direct IO used for the file?
+    // It is False if the file system does not support it.
+    Bool isDirect() const;
+
 private:
     // The file name.
     String name_p;
@@ -184,7 +236,20 @@ private:
     MMapfdIO* mappedFile_p;
     // The optional buffered file.
     LargeFilebufIO* bufferedFile_p;
-	    
+    // The optional MultiFile and the virtual file in it.
+    MultiFile* mfile_p;
+    MFFileIO*  mfFile_p;
+    // Direct IO: the aligned buffer used, the logical file size, and the
+    // file end after the padded last block written by this object
+    // (0 if no padding was written).
+    Bool          isDirect_p;
+    mutable char* directBuf_p;
+    mutable uInt  directBufSize_p;
+    mutable Int64 directSize_p;
+    mutable Int64 directPadEnd_p;
+    // The alignment needed for direct IO.
+    static const uInt theirDirectAlign = 4096;
+
 
     // Forbid copy constructor.
     BucketFile (const BucketFile&);
@@ -197,6 +262,24 @@ private:
 
     // Delete the possible mapped or buffered file object.
     void deleteMapBuf();
+
+    // Open the file with the given flags. If direct IO is requested,
+    // it is tried first; if not supported, the file is opened normally.
+    // It returns -1 if the file could not be opened.
+    int openFile (int flags);
+
+    // Get the aligned buffer for direct IO with at least the given size.
+    char* directBuffer (uInt size) const;
+
+    // Read the aligned block at the given offset into the buffer.
+    // Bytes beyond the end of the file are set to zero.
+    void directReadBlock (char* buffer, Int64 offset) const;
+
+    // Read or write using direct IO at the current file position.
+    // <group>
+    void directRead (void* buffer, uInt length) const;
+    void directWrite (const void* buffer, uInt length);
+    // </group>
 };
 
 
@@ -218,6 +301,8 @@ inline Bool BucketFile::isMapped() const
     { return isMapped_p; }
 inline Bool BucketFile::isBuffered() const
     { return bufSize_p>0; }
+inline Bool BucketFile::isDirect() const
+    { return isDirect_p; }
 
 
 } //# NAMESPACE CASA - END
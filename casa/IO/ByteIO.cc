@@ -42,5 +42,11 @@ void ByteIO::reopenRW()
     }
 }
 
+void ByteIO::flush()
+{}
+
+void ByteIO::resync()
+{}
+
 } //# NAMESPACE CASA - END
 
@@ -110,6 +110,15 @@ public:
     // exception if a reopen has to be done.
     virtual void reopenRW();
 
+    // Flush the data to the underlying IO stream.
+    // The default implementation in this base class does nothing.
+    virtual void flush();
+
+    // Resync the IO stream, i.e. clear possible buffered data, so data
+    // written by another process will be seen.
+    // The default implementation in this base class does nothing.
+    virtual void resync();
+
     // This function sets the position on the given offset.
     // The seek option defines from which file position the seek is done.
     // -1 is returned if not seekable.
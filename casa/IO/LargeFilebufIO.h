@@ -123,10 +123,10 @@ public:
     virtual Int read (uInt size, void* buf, Bool throwException=True);    
 
     // Flush the current buffer.
-    void flush();
+    virtual void flush();
 
     // Resync the file (i.e. empty the current buffer).
-    void resync();
+    virtual void resync();
   
     // Get the length of the byte stream.
     virtual Int64 length();
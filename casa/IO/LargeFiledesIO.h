@@ -101,6 +101,9 @@ public:
     // The file name is only used in error messages.
     void attach (int fd, const String& fileName);
 
+    // Detach from the file descriptor. It is not closed.
+    void detach();
+
     // The destructor does not close the file.
     ~LargeFiledesIO();
 
@@ -145,9 +148,6 @@ protected:
     int fd() const
       { return itsFile; }
 
-    // Detach from the file descriptor. It is not closed.
-    void detach();
-
     // Determine if the file descriptor is readable and/or writable.
     void fillRWFlags (int fd);
 
@@ -0,0 +1,142 @@
+//# MFFileIO.cc: A single file in a MultiFile
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casa/IO/MFFileIO.h>
+#include <casa/IO/MultiFile.h>
+#include <casa/Exceptions/Error.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+  MFFileIO::MFFileIO (MultiFile& file, const String& name,
+                      ByteIO::OpenOption opt)
+    : itsFile     (file),
+      itsPosition (0),
+      itsName     (name)
+  {
+    if (opt == ByteIO::New  ||  opt == ByteIO::NewNoReplace  ||
+        opt == ByteIO::Scratch) {
+      if (! itsFile.isWritable()) {
+        throw AipsError ("MFFileIO: cannot create " + name + " in readonly "
+                         "MultiFile " + itsFile.fileName());
+      }
+      itsId = itsFile.fileId (name, False);
+      if (itsId >= 0) {
+        if (opt == ByteIO::NewNoReplace) {
+          throw AipsError ("MFFileIO: file " + name + " already exists in "
+                           "MultiFile " + itsFile.fileName());
+        }
+        itsFile.deleteFile (itsId);
+      }
+      itsId = itsFile.add (name);
+    } else {
+      if (opt != ByteIO::Old  &&  ! itsFile.isWritable()) {
+        throw AipsError ("MFFileIO: cannot open " + name + " for write in "
+                         "readonly MultiFile " + itsFile.fileName());
+      }
+      itsId = itsFile.fileId (name);
+      if (opt == ByteIO::Append) {
+        itsPosition = length();
+      }
+    }
+  }
+
+  MFFileIO::~MFFileIO()
+  {}
+
+  void MFFileIO::remove()
+  {
+    itsFile.deleteFile (itsId);
+    itsId = -1;
+  }
+
+  Int MFFileIO::read (uInt size, void* buffer, Bool throwException)
+  {
+    Int64 n = itsFile.read (itsId, buffer, size, itsPosition);
+    itsPosition += n;
+    if (throwException  &&  n < Int64(size)) {
+      throw AipsError ("MFFileIO::read - " + itsName + " incorrect number "
+                       "of bytes read");
+    }
+    return n;
+  }
+
+  void MFFileIO::write (uInt size, const void* buffer)
+  {
+    itsFile.write (itsId, buffer, size, itsPosition);
+    itsPosition += size;
+  }
+
+  void MFFileIO::reopenRW()
+  {
+    itsFile.reopenRW();
+  }
+
+  void MFFileIO::flush()
+  {
+    itsFile.flush();
+  }
+
+  Int64 MFFileIO::length()
+  {
+    return itsFile.fileSize (itsId);
+  }
+
+  Bool MFFileIO::isReadable() const
+  {
+    return True;
+  }
+
+  Bool MFFileIO::isWritable() const
+  {
+    return itsFile.isWritable();
+  }
+
+  Bool MFFileIO::isSeekable() const
+  {
+    return True;
+  }
+
+  Int64 MFFileIO::doSeek (Int64 offset, ByteIO::SeekOption dir)
+  {
+    switch (dir) {
+    case ByteIO::Begin:
+      itsPosition = offset;
+      break;
+    case ByteIO::Current:
+      itsPosition += offset;
+      break;
+    case ByteIO::End:
+      itsPosition = length() + offset;
+      break;
+    }
+    return itsPosition;
+  }
+
+
+} //# NAMESPACE CASA - END
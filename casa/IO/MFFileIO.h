@@ -0,0 +1,163 @@
+//# MFFileIO.h: A single file in a MultiFile
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_MFFILEIO_H
+#define CASA_MFFILEIO_H
+
+//# Includes
+#include <casa/aips.h>
+#include <casa/IO/ByteIO.h>
+#include <casa/BasicSL/String.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Forward declaration.
+class MultiFile;
+
+
+// <summary> 
+// Class for IO on a virtual file in a MultiFile
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tMFFileIO" demos="">
+// </reviewed>
+
+// <synopsis> 
+// This class is a specialization of class
+// <linkto class=ByteIO>ByteIO</linkto>. It uses a virtual file in a
+// <linkto class=MultiFile>MultiFile</linkto> container as the data store.
+// <p>
+// Similar to a regular file it is possible to read and write data and to
+// seek in the file. The object keeps track of the current file position.
+// The buffering is done by the MultiFile object, which is shared by all
+// virtual files in it.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    // Create a new MultiFile using a block size of 1 MB.
+//    MultiFile mfile("file.mf", ByteIO::New, 1048576);
+//    // Create a virtual file in it.
+//    MFFileIO mf1(mfile, "mf1", ByteIO::New);
+//    // Use it (for example) as the sink of AipsIO.
+//    AipsIO stream (&mf1);
+//    // Write values.
+//    stream << (Int)10;
+//    stream << True;
+//    // Seek to beginning of file and read data in.
+//    stream.setpos (0);
+//    Int vali;
+//    Bool valb;
+//    stream >> vali >> valb;
+// </srcblock>
+// </example>
+
+
+class MFFileIO: public ByteIO
+{
+public:
+    // Open or create a virtual file with the given name. Note that only the
+    // basename of the file name is used.
+    // New, NewNoReplace and Scratch create the file (deleting an existing
+    // one for New and Scratch); the other options require the file to exist.
+    // An exception is thrown if the MultiFile is not writable while
+    // writing is needed.
+    MFFileIO (MultiFile&, const String& name,
+              ByteIO::OpenOption = ByteIO::Old);
+
+    // The destructor does not flush; the data are flushed by
+    // the MultiFile object (explicitly or when it is destructed).
+    virtual ~MFFileIO();
+
+    // Read <src>size</src> bytes from the virtual file. Returns the number
+    // of bytes actually read. Will throw an exception (AipsError) if the
+    // requested number of bytes could not be read unless throwException is
+    // set to False.
+    virtual Int read (uInt size, void* buffer, Bool throwException=True);
+
+    // Write a block at the given offset.
+    virtual void write (uInt size, const void* buffer);
+
+    // Reopen the file (and possibly underlying MultiFile) for read/write access.
+    // Nothing will be done if the stream is writable already.
+    // An exception will be thrown if it is not possible to reopen it for
+    // read/write access.
+    virtual void reopenRW();
+
+    // Flush the data of all virtual files in the MultiFile.
+    virtual void flush();
+
+    // Get the length of the virtual file.
+    virtual Int64 length();
+       
+    // It is always readable.
+    virtual Bool isReadable() const;
+
+    // Is the file writable?
+    virtual Bool isWritable() const;
+
+    // It is always seekable.
+    virtual Bool isSeekable() const;
+
+    // Get the name of the virtual file.
+    const String& fileName() const
+      { return itsName; }
+
+    // Get the id of the virtual file in the MultiFile.
+    Int fileId() const
+      { return itsId; }
+
+    // Remove the virtual file from the MultiFile.
+    // The object cannot be used anymore thereafter.
+    void remove();
+
+protected:
+    // Reset the position pointer to the given value. It returns the
+    // new position.
+    virtual Int64 doSeek (Int64 offset, ByteIO::SeekOption);
+
+private:
+    // Forbid copy constructor and assignment.
+    // <group>
+    MFFileIO (const MFFileIO&);
+    MFFileIO& operator= (const MFFileIO&);
+    // </group>
+
+    //# Data members
+    MultiFile& itsFile;
+    Int64      itsPosition;
+    String     itsName;
+    Int        itsId;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
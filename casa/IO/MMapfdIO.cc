@@ -89,6 +89,18 @@ namespace casa
     ::madvise (itsPtr, itsFileSize, MADV_SEQUENTIAL);
   }
 
+  void MMapfdIO::remap()
+  {
+    Int64 fileSize = length();
+    if (fileSize != itsFileSize) {
+      unmapFile();
+      itsFileSize = fileSize;
+      if (itsFileSize > 0) {
+        mapFile();
+      }
+    }
+  }
+
   void MMapfdIO::unmapFile()
   {
     if (itsPtr != 0) {
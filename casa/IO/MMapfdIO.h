@@ -85,9 +85,12 @@ public:
   // Remapping is needed if the file has grown elsewhere.
   void mapFile();
 
+  // Remap the entire file if its size has changed elsewhere.
+  void remap();
+
   // Flush changed mapped data to the file.
   // Nothing is done if the file is readonly.
-  void flush();
+  virtual void flush();
 
   // Write the number of bytes from the seek position on.
   // The file will be extended and remapped if writing beyond end-of-file.
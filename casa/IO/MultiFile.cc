@@ -42,25 +42,25 @@
 namespace casa { //# NAMESPACE CASA - BEGIN
 
   void operator<< (ostream& ios, const MultiFileInfo& info)
-    { ios << info.name << ' ' << info.blockNrs << ' '
+    { ios << info.name << ' ' << info.fsize << ' ' << info.blockNrs << ' '
           << info.curBlock << ' ' << info.dirty << endl; }
   void operator<< (AipsIO& ios, const MultiFileInfo& info)
-    { ios << info.name << info.blockNrs; }
+    { ios << info.name << info.blockNrs << info.fsize; }
   void operator>> (AipsIO& ios, MultiFileInfo& info)
-    { ios >> info.name >> info.blockNrs; }
+    { ios >> info.name >> info.blockNrs >> info.fsize; }
 
 
   MultiFile::MultiFile (const String& name, ByteIO::OpenOption option,
                         Int blockSize)
     : itsBlockSize (blockSize),
-      itsAdded     (False)
+      itsChanged   (False)
   {
     itsFD = LargeRegularFileIO::openCreate (name, option);
     itsIO.attach (itsFD, name);
     if (option == ByteIO::New  ||  option == ByteIO::NewNoReplace) {
       // New file; first block is for administration.
       itsNrBlock = 1;
-      itsAdded   = True;
+      itsChanged = True;
       // Use file system block size, but not less than given size.
       if (itsBlockSize <= 0) {
         struct fileSTAT sfs;
@@ -85,21 +85,67 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     LargeFiledesIO::close (itsFD);
   }
 
+  void MultiFile::reopenRW()
+  {
+    if (isWritable()) {
+      return;
+    }
+    // First open the file for read/write; it throws if not possible.
+    String name = fileName();
+    int fd = LargeRegularFileIO::openCreate (name, ByteIO::Update);
+    // Now replace the readonly file descriptor.
+    itsIO.detach();
+    LargeFiledesIO::close (itsFD);
+    itsFD = fd;
+    itsIO.attach (itsFD, name);
+  }
+
   void MultiFile::flush()
   {
     // Flush all buffers if needed.
     for (vector<MultiFileInfo>::iterator iter=itsInfo.begin();
          iter!=itsInfo.end(); ++iter) {
-      if (iter->dirty) {
-        itsIO.seek (iter->curBlock * itsBlockSize);
-        itsIO.write (itsBlockSize, &(iter->buffer[0]));
-        iter->dirty = False;
-      }
+      writeDirty (*iter);
     }
-    // Header only needs to be written if blocks were added since last flush.
-    if (itsAdded) {
+    // Header only needs to be written if it was changed since last flush.
+    if (itsChanged) {
       writeHeader();
-      itsAdded = False;
+      itsChanged = False;
+    }
+  }
+
+  void MultiFile::fsync()
+  {
+    ::fsync (itsFD);
+  }
+
+  void MultiFile::resync()
+  {
+    // Write possibly changed data (there should be none, because the
+    // data should have been flushed before another process could write).
+    // Thereafter reread the header, which also clears all buffers.
+    flush();
+    readHeader();
+  }
+
+  void MultiFile::writeDirty (MultiFileInfo& info)
+  {
+    if (info.dirty) {
+      itsIO.seek (info.blockNrs[info.curBlock] * itsBlockSize);
+      itsIO.write (itsBlockSize, &(info.buffer[0]));
+      info.dirty = False;
+    }
+  }
+
+  void MultiFile::readBlock (Int64 blockNr, char* buffer)
+  {
+    // A block might not have been written yet (e.g. if a file is written
+    // non-sequentially), so reading can be beyond the end of the file.
+    itsIO.seek (blockNr * itsBlockSize);
+    Int64 nread = itsIO.read (itsBlockSize, buffer, False);
+    if (nread < itsBlockSize) {
+      memset (buffer + std::max(nread, Int64(0)), 0,
+              itsBlockSize - std::max(nread, Int64(0)));
     }
   }
 
@@ -115,8 +161,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     cio.write (1, &next);         // possible link to subsequent header block
     cio.write (1, &next);         // reserve space for header size
     cio.write (1, &itsBlockSize);
-    aio.putstart ("MultiFile", 1);
-    aio << itsNrBlock << itsInfo;
+    aio.putstart ("MultiFile", 2);
+    aio << itsNrBlock << itsInfo << itsFreeBlocks;
     aio.putend();
     Int64 todo = mio.length();
     uChar* buf = const_cast<uChar*>(mio.getBuffer());
@@ -162,8 +208,27 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     CanonicalIO cio(&mio);
     AipsIO aio(&cio);
     Int version = aio.getstart ("MultiFile");
-    AlwaysAssert (version==1, AipsError);
-    aio >> itsNrBlock >> itsInfo;
+    if (version > 2) {
+      throw AipsError ("MultiFile " + fileName() + " has an unknown version " +
+                       String::toString(version));
+    }
+    aio >> itsNrBlock;
+    if (version == 1) {
+      // Version 1 did not keep the file sizes and the free blocks.
+      // A file size was a multiple of the block size.
+      aio.getstart ("Block");
+      uInt nr;
+      aio >> nr;
+      itsInfo.resize (nr);
+      for (uInt i=0; i<nr; ++i) {
+        aio >> itsInfo[i].name >> itsInfo[i].blockNrs;
+        itsInfo[i].fsize = itsInfo[i].blockNrs.size() * itsBlockSize;
+      }
+      aio.getend();
+      itsFreeBlocks.clear();
+    } else {
+      aio >> itsInfo >> itsFreeBlocks;
+    }
     aio.getend();
     // Initialize remaining info fields.
     for (vector<MultiFileInfo>::iterator iter=itsInfo.begin();
@@ -174,124 +239,165 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     }
   }
 
-  Int MultiFile::add (const String& fname)
+  String MultiFile::baseName (const String& name)
   {
-    // Check that file name is not used yet.
-    for (vector<MultiFileInfo>::iterator iter=itsInfo.begin();
-         iter!=itsInfo.end(); ++iter) {
-      if (fname == iter->name) {
-        throw AipsError ("MultiFile::add - file name " + fname +
-                         " already in use");
-      }
+    String::size_type pos = name.rfind ('/');
+    if (pos == String::npos) {
+      return name;
+    }
+    return name.substr (pos+1);
+  }
+
+  Int MultiFile::add (const String& name)
+  {
+    String fname = baseName (name);
+    // Check that file name is valid and not used yet.
+    if (fname.empty()) {
+      throw AipsError ("MultiFile::add - empty file name " + name);
+    }
+    if (fileId (fname, False) >= 0) {
+      throw AipsError ("MultiFile::add - file name " + fname +
+                       " already in use");
+    }
+    // Add a new file entry. Reuse the entry of a deleted file if possible.
+    Int inx = fileId ("", False);
+    if (inx < 0) {
+      inx = itsInfo.size();
+      itsInfo.push_back (MultiFileInfo());
     }
-    // Add a new file entry.
-    Int inx = itsInfo.size();
-    itsInfo.push_back (MultiFileInfo());
     itsInfo[inx].buffer.resize (itsBlockSize);
     itsInfo[inx].curBlock = -1;
+    itsInfo[inx].fsize = 0;
     itsInfo[inx].name = fname;
-    itsAdded = True;
+    itsInfo[inx].dirty = False;
+    itsChanged = True;
     return inx;
   }
 
-  Int MultiFile::fileId (const String& fname) const
+  Int MultiFile::fileId (const String& name, Bool throwExcp) const
   {
+    String fname = baseName (name);
     for (size_t i=0; i<itsInfo.size(); ++i) {
       if (fname == itsInfo[i].name) {
         return i;
       }
     }
-    throw AipsError ("MultiFile::fileId - file name " + fname +
-                     " is unknown");
+    if (throwExcp) {
+      throw AipsError ("MultiFile::fileId - file name " + fname +
+                       " is unknown");
+    }
+    return -1;
+  }
+
+  void MultiFile::deleteFile (Int fileId)
+  {
+    AlwaysAssert (itsIO.isWritable(), AipsError);
+    AlwaysAssert (fileId >= 0  &&  fileId < Int(itsInfo.size()), AipsError);
+    MultiFileInfo& info = itsInfo[fileId];
+    // Keep the (empty) entry to retain the file ids of other files.
+    // It will be reused by a new file.
+    itsFreeBlocks.insert (itsFreeBlocks.end(),
+                          info.blockNrs.begin(), info.blockNrs.end());
+    info.blockNrs.clear();
+    info.name     = String();
+    info.fsize    = 0;
+    info.curBlock = -1;
+    info.dirty    = False;
+    itsChanged    = True;
   }
 
   Int64 MultiFile::read (Int fileId, void* buf, Int64 size, Int64 offset)
   {
     char* buffer = static_cast<char*>(buf);
-    DebugAssert (fileId < itsInfo.size(), AipsError);
+    DebugAssert (fileId < Int(itsInfo.size()), AipsError);
     MultiFileInfo& info = itsInfo[fileId];
+    // Do not read beyond the end of the file.
+    size = std::min (size, info.fsize - offset);
     // Determine the logical block to read and the start offset in that block.
-    Int64 nrblk = info.blockNrs.size();
     Int64 blknr = offset/itsBlockSize;
     Int64 start = offset - blknr*itsBlockSize;
     Int64 done  = 0;
-    // Read until all done or EOF.
-    while (done < size  &&  blknr < nrblk) {
-      Int64 todo  = std::min(size-done, itsBlockSize-start);
-      // If already in buffer, copy from there.
+    // Read until all done.
+    while (done < size) {
+      Int64 todo = std::min(size-done, itsBlockSize-start);
       if (blknr == info.curBlock) {
+        // Already in buffer, so copy from there.
         memcpy (buffer, &(info.buffer[start]), todo);
-      } else {
-        // Seek to the correct physical offset.
-        itsIO.seek (info.blockNrs[blknr] * itsBlockSize);
+      } else if (todo == itsBlockSize) {
         // Read directly into buffer if it fits exactly.
-        if (todo == itsBlockSize  &&  start == 0) {
-          itsIO.read (itsBlockSize, buffer);
-          cout<<"direct read of "<<info.blockNrs[blknr]<<endl;
-        } else {
-          // Read into file buffer and copy correct part.
-          itsIO.read (itsBlockSize, &(info.buffer[0]));
-          info.curBlock = blknr;
-          memcpy (buffer, &(info.buffer[start]), todo);
-        }
-        // Increment counters.
-        done += todo;
-        buffer += todo;
-        blknr++;
-        start = 0;
+        readBlock (info.blockNrs[blknr], buffer);
+      } else {
+        // Read into file buffer and copy correct part.
+        writeDirty (info);
+        readBlock (info.blockNrs[blknr], &(info.buffer[0]));
+        info.curBlock = blknr;
+        memcpy (buffer, &(info.buffer[start]), todo);
       }
+      done += todo;
+      buffer += todo;
+      blknr++;
+      start = 0;
     }
-    return done;
+    return std::max (done, Int64(0));
   }
 
   Int64 MultiFile::write (Int fileId, const void* buf, Int64 size, Int64 offset)
   {
     const char* buffer = static_cast<const char*>(buf);
     AlwaysAssert (itsIO.isWritable(), AipsError);
-    DebugAssert (fileId < itsInfo.size(), AipsError);
+    DebugAssert (fileId < Int(itsInfo.size()), AipsError);
     MultiFileInfo& info = itsInfo[fileId];
     // Determine the logical block to write and the start offset in that block.
     Int64 blknr = offset/itsBlockSize;
     Int64 start = offset - blknr*itsBlockSize;
     Int64 done  = 0;
-    // If beyond EOF, add blocks as needed.
-    Int64 lastblk = blknr + (start+size+itsBlockSize-1) / itsBlockSize;
+    // If beyond EOF, add blocks as needed (reusing free blocks first).
+    Int64 nrblk  = (offset + size + itsBlockSize - 1) / itsBlockSize;
     Int64 curnrb = info.blockNrs.size();
-    if (lastblk >= curnrb) {
-      info.blockNrs.resize (lastblk);
-      for (Int64 i=curnrb; i<lastblk; ++i) {
-        info.blockNrs[i] = itsNrBlock;
-        itsNrBlock++;
+    if (nrblk > curnrb) {
+      vector<char> zeroBuf;
+      info.blockNrs.resize (nrblk);
+      for (Int64 i=curnrb; i<nrblk; ++i) {
+        if (itsFreeBlocks.empty()) {
+          info.blockNrs[i] = itsNrBlock;
+          itsNrBlock++;
+        } else {
+          info.blockNrs[i] = itsFreeBlocks.back();
+          itsFreeBlocks.pop_back();
+        }
+        // A block not written below (i.e. if written sparsely) has to be
+        // cleared, because it can contain data of a deleted file or
+        // (at the end of the file) the last part of an old header.
+        if (i < blknr) {
+          if (zeroBuf.empty()) {
+            zeroBuf.resize (itsBlockSize, 0);
+          }
+          itsIO.seek (info.blockNrs[i] * itsBlockSize);
+          itsIO.write (itsBlockSize, &(zeroBuf[0]));
+        }
       }
-      itsAdded = True;
+      itsChanged = True;
     }
     // Write until all done.
     while (done < size) {
       Int64 todo = std::min(size-done, itsBlockSize-start);
-      // Favor sequential writing, thus write current buffer first.
       if (blknr == info.curBlock) {
+        // Favor sequential writing, thus keep the block in the buffer.
         memcpy (&(info.buffer[start]), buffer, todo);
         info.dirty = True;
-        if (done+todo >= size) {
-          itsIO.seek (info.curBlock * itsBlockSize);
-          itsIO.write (itsBlockSize, &(info.buffer[0]));
-          info.dirty = False;
-          info.curBlock = -1;
-        }
-      } else if (todo == itsBlockSize  &&  start == 0) {
+      } else if (todo == itsBlockSize) {
         // Write directly from buffer if it fits exactly.
         itsIO.seek (info.blockNrs[blknr] * itsBlockSize);
         itsIO.write (itsBlockSize, buffer);
-        cout<<"direct write of "<<info.blockNrs[blknr]<<endl;
       } else {
-        // Write into temporary buffer and copy correct part.
+        // Read into the file buffer (unless a new block) and copy the data.
         // First write possibly dirty buffer.
-        if (info.dirty) {
-          itsIO.seek (info.curBlock * itsBlockSize);
-          itsIO.write (itsBlockSize, &(info.buffer[0]));
-          }
-        itsIO.seek (info.blockNrs[blknr] * itsBlockSize);
-        itsIO.read (itsBlockSize, &(info.buffer[0]));
+        writeDirty (info);
+        if (blknr < curnrb) {
+          readBlock (info.blockNrs[blknr], &(info.buffer[0]));
+        } else {
+          memset (&(info.buffer[0]), 0, itsBlockSize);
+        }
         info.curBlock = blknr;
         memcpy (&(info.buffer[start]), buffer, todo);
         info.dirty = True;
@@ -301,6 +407,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
       blknr++;
       start = 0;
     }
+    if (offset + size > info.fsize) {
+      info.fsize = offset + size;
+      itsChanged = True;
+    }
     return done;
   }
 
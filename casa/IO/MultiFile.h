@@ -48,6 +48,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     vector<Int64> blockNrs;     // physical blocknrs for this logical file
     vector<char>  buffer;
     Int64         curBlock;     // the logical block held in buffer
+    Int64         fsize;        // the logical file size
     String        name;         // the logical file name
     Bool          dirty;        // has data in buffer been changed?
   };
@@ -56,39 +57,49 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   void operator>> (AipsIO&, MultiFileInfo&);
 
   // <summary> 
-  // Class for IO on a regular file.
+  // Class to combine multiple files in a single one.
   // </summary>
 
   // <use visibility=export>
 
-  // <reviewed reviewer="Friso Olnon" date="1996/11/06" tests="tByteIO" demos="">
+  // <reviewed reviewer="" date="" tests="tMultiFile" demos="">
   // </reviewed>
 
   // <synopsis> 
-  // This class is a specialization of class
-  // <linkto class=ByteIO>ByteIO</linkto>. It uses a
-  // <linkto class=RegularFile>regular file</linkto> as the data store.
+  // This class is a container file holding multiple virtual files. It is
+  // primarily meant as a container file for the storage manager files of a
+  // table to reduce the number of files used (especially for Lustre) and to
+  // reduce the number of open files (especially when concatenating tables).
+  // <br>A virtual file is spread over multiple (fixed size) data blocks
+  // which are stored in the container file. A data block always starts at
+  // a file offset that is a multiple of the block size, so if the block
+  // size is a multiple of the disk sector size the container is suitable
+  // for direct IO.
+  // A data block is never shared by multiple files.
+  // For each virtual file MultiFile keeps a MultiFileInfo object telling
+  // the file name, its logical size and the physical blocks used for it.
+  // The info is stored in the header of the container file (at the
+  // beginning or, if it does not fit there, also at the end).
+  // Blocks of a deleted file are kept in a free list and reused when
+  // another file needs to be extended.
   // <p>
-  // The class is derived from <linkto class=FilebufIO>FilebufIO</linkto>,
-  // which contains all functions to access the file. The description of
-  // this class explains the use of the <src>filebufSize</src> argument
-  // in the constructor.
+  // A MultiFile can only be written by a single process at a time. The
+  // caller (e.g. the table system) should use locking to synchronize
+  // access by multiple processes. After another process has written the
+  // container, <src>resync</src> should be called to reread the header.
+  // <p>
+  // The class <linkto class=MFFileIO>MFFileIO</linkto> can be used to
+  // access a virtual file as a ByteIO object.
   // </synopsis>
 
   // <example>
   // <srcblock>
-  //    // Create a file (which should not exist yet).
-  //    RegularFileIO regio (RegularFile("file.name"), ByeIO::NewNoReplace);
-  //    // Use that as the sink of AipsIO.
-  //    AipsIO stream (&regio);
-  //    // Write values.
-  //    stream << (Int)10;
-  //    stream << True;
-  //    // Seek to beginning of file and read data in.
-  //    stream.setpos (0);
-  //    Int vali;
-  //    Bool valb;
-  //    stream >> vali >> valb;
+  //    // Create the container file with a block size of 64 KB.
+  //    MultiFile mfile ("file.mf", ByteIO::New, 65536);
+  //    // Add a virtual file and write some data in it.
+  //    Int fid = mfile.add ("file1");
+  //    Int64 vals[128];
+  //    mfile.write (fid, vals, sizeof(vals), 0);
   // </srcblock>
   // </example>
 
@@ -106,29 +117,48 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
     // Add a file to the MultiFile object. It returns the file id.
     // The given name must be a basename or have the same directory as the
-    // MultiFile object.
+    // MultiFile object. Only the basename is used.
+    // An exception is thrown if the name is already in use.
     Int add (const String& name);
 
     // Return the file id of a file in the MultiFile object.
-    // An exception is thrown if the name is unknown.
-    Int fileId (const String& name) const;
+    // If the name is unknown, an exception is thrown if throwExcp is set.
+    // Otherwise it returns -1.
+    Int fileId (const String& name, Bool throwExcp=True) const;
+
+    // Delete a file. Its blocks are added to the free list to be reused.
+    // The file id of the other files does not change; the file id of the
+    // deleted file will be reused by the next file added.
+    void deleteFile (Int fileId);
 
-    // Read a block at the given offset. It returns the actual size read.
+    // Read a block at the given offset. It returns the actual size read,
+    // which is less than the size if reading beyond the end of the file.
     Int64 read (Int fileId, void* buffer, Int64 size, Int64 offset);
 
     // Write a block at the given offset. It returns the actual size written.
+    // The file is extended as needed.
     Int64 write (Int fileId, const void* buffer, Int64 size, Int64 offset);
 
+    // Get the logical size of a file.
+    Int64 fileSize (Int fileId) const
+      { return itsInfo[fileId].fsize; }
+
     // Reopen the underlying file for read/write access.
     // Nothing will be done if the stream is writable already.
     // Otherwise it will be reopened and an exception will be thrown
     // if it is not possible to reopen it for read/write access.
-    void reopenRW()
-      { itsIO.reopenRW(); }
+    void reopenRW();
 
     // Flush the file by writing all dirty data and all header info.
     void flush();
 
+    // Fsync the file (i.e. force the data to be physically written).
+    void fsync();
+
+    // Resync with another process by clearing the buffers and rereading
+    // the header.
+    void resync();
+
     // Get the file name of the file attached.
     String fileName() const
       { return itsIO.fileName(); }
@@ -141,7 +171,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     Int64 blockSize() const
       { return itsBlockSize; }
 
-    // Get the nr of internal files.
+    // Get the nr of internal files (including deleted ones not reused yet).
     Int nfile() const
       { return itsInfo.size(); }
 
@@ -153,18 +183,30 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     const vector<MultiFileInfo>& info() const
       { return itsInfo; }
 
+    // Get the free blocks (for test purposes).
+    const vector<Int64>& freeBlocks() const
+      { return itsFreeBlocks; }
+
   private:
     void close();
     void writeHeader();
     void readHeader();
+    // Write the buffer of a file if it has been changed.
+    void writeDirty (MultiFileInfo& info);
+    // Read the given physical block into the buffer.
+    // Data beyond the end of the container file are cleared.
+    void readBlock (Int64 blockNr, char* buffer);
+    // Get the basename of a file name.
+    static String baseName (const String& name);
 
     //# Data members
     Int64 itsBlockSize;  // The blocksize used
     Int64 itsNrBlock;    // The total nr of blocks actually used
     vector<MultiFileInfo> itsInfo;
+    vector<Int64>         itsFreeBlocks; // Blocks of deleted files
     LargeFiledesIO        itsIO;
     int                   itsFD;
-    Bool                  itsAdded; // Has blocks been added since last flush?
+    Bool                  itsChanged; // Has header info changed since last flush?
   };
 
 
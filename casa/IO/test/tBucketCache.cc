@@ -28,6 +28,7 @@
 #include <casa/IO/BucketCache.h>
 #include <casa/IO/BucketFile.h>
 #include <casa/Exceptions/Error.h>
+#include <casa/Utilities/Assert.h>
 #include <casa/OS/Timer.h>
 #include <casa/iostream.h>
 
@@ -40,6 +41,8 @@ void a (Bool);
 void b (Bool);
 void c (uInt bufSize);
 void d (uInt bufSize);
+void e (BucketCache::Policy);
+void f();
 
 int main (int argc, const char*[])
 {
@@ -54,6 +57,9 @@ int main (int argc, const char*[])
 //	d (1024);
 //	d (32768);
 //	d (327680);
+	e (BucketCache::LRU);
+	e (BucketCache::Clock);
+	f();
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
 	return 1;
@@ -256,3 +262,103 @@ void d (uInt)
     timer.show();
     cout << "<<<" << endl;
 }
+
+void e (BucketCache::Policy policy)
+{
+    // Open the file.
+    BucketFile file("tBucketCache_tmp.data", False);
+    file.open();
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    BucketCache cache (&file, 512, 32768, rec[0], 10, 0, aToLocal, aFromLocal,
+		       aInitBuffer, aDeleteBuffer);
+    cache.setPolicy (policy);
+    AlwaysAssertExit (cache.policy() == policy);
+    AlwaysAssertExit (cache.readAhead() == BucketCache::defaultReadAhead);
+    cache.setReadAhead (4);
+    AlwaysAssertExit (cache.readAhead() == 4);
+    // A working set fitting in the cache only gives misses the first time.
+    for (uInt j=0; j<10; j++) {
+	for (uInt i=0; i<8; i++) {
+	    char* buf = cache.getBucket(i+5);
+	    AlwaysAssertExit (*(Int*)buf == Int(i+1));
+	}
+    }
+    AlwaysAssertExit (cache.nAccess() == 80);
+    AlwaysAssertExit (cache.nRead() == 8);
+    AlwaysAssertExit (cache.nHit() == 72);
+    AlwaysAssertExit (cache.nEvict() == 0);
+    // Cycling through more buckets than fit in the cache only gives misses.
+    for (uInt j=0; j<3; j++) {
+	for (uInt i=0; i<20; i++) {
+	    char* buf = cache.getBucket(i+5);
+	    AlwaysAssertExit (*(Int*)buf == Int(i+1));
+	}
+    }
+    AlwaysAssertExit (cache.nAccess() == 140);
+    AlwaysAssertExit (cache.nHit() == 80);
+    AlwaysAssertExit (cache.nRead() == 60);
+    AlwaysAssertExit (cache.nEvict() == 50);
+    AlwaysAssertExit (cache.nBytesRead() == 60*32768);
+    AlwaysAssertExit (cache.nWrite() == 0);
+    cache.showStatistics (cout);
+    cache.initStatistics();
+    AlwaysAssertExit (cache.nAccess() == 0  &&  cache.hitRate() == 0);
+}
+
+void f()
+{
+    // Open the file.
+    BucketFile file("tBucketCache_tmp.data", False);
+    file.open();
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    {
+	// Consecutive dirty buckets are written in a single call.
+	BucketFile wfile("tBucketCache_tmp.data", True);
+	wfile.open();
+	BucketCache cache (&wfile, 512, 32768, rec[0], 10, 0,
+			   aToLocal, aFromLocal, aInitBuffer, aDeleteBuffer);
+	uInt bucketNrs[] = {23, 40, 21, 20, 22, 42};
+	for (uInt i=0; i<6; i++) {
+	    cache.getBucket (bucketNrs[i]);
+	    cache.setDirty();
+	}
+	AlwaysAssertExit (cache.nWrite() == 0);
+	cache.flush();
+	AlwaysAssertExit (cache.nWrite() == 6);
+	AlwaysAssertExit (cache.nWriteCall() == 3);
+	AlwaysAssertExit (cache.nBytesWritten() == 6*32768);
+	// Nothing is dirty anymore.
+	cache.flush();
+	AlwaysAssertExit (cache.nWriteCall() == 3);
+    }
+    {
+	BucketCache cache (&file, 512, 32768, rec[0], 10, 0,
+			   aToLocal, aFromLocal, aInitBuffer, aDeleteBuffer);
+	cache.setReadAhead (4);
+	// Random access does not read ahead.
+	uInt bucketNrs[] = {50, 20, 80, 35, 90, 70, 9, 60};
+	for (uInt i=0; i<8; i++) {
+	    char* buf = cache.getBucket (bucketNrs[i]);
+	    AlwaysAssertExit (*(Int*)buf == Int(bucketNrs[i]-4));
+	}
+	AlwaysAssertExit (cache.nRead() == 8);
+	AlwaysAssertExit (cache.nPrefetch() == 0);
+	// A sequential scan does, but not for each bucket.
+	for (uInt i=0; i<30; i++) {
+	    char* buf = cache.getBucket (i+10);
+	    AlwaysAssertExit (*(Int*)buf == Int(i+6));
+	}
+	AlwaysAssertExit (cache.nPrefetch() > 0);
+	AlwaysAssertExit (cache.nPrefetch() < 30);
+	// Switching read-ahead off.
+	cache.initStatistics();
+	cache.setReadAhead (0);
+	for (uInt i=0; i<30; i++) {
+	    cache.getBucket (i+50);
+	}
+	AlwaysAssertExit (cache.nRead() == 30);
+	AlwaysAssertExit (cache.nPrefetch() == 0);
+    }
+}
@@ -29,6 +29,7 @@
 #include <casa/Exceptions/Error.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/OS/RegularFile.h>
+#include <casa/string.h>
 #include <casa/iostream.h>
 
 #include <casa/namespace.h>
@@ -39,12 +40,14 @@
 void a();
 void b();
 void c();
+void d();
 
 int main (int argc, const char*[])
 {
     try {
 	a();
 	b();
+	d();
 	// Do exceptional things only when needed.
 	if (argc < 2) {
 	    cout << ">>>" << endl;
@@ -117,6 +120,89 @@ void b()
     AlwaysAssertExit (fval2 == fval);
 }
 
+// Test direct IO using unaligned offsets and lengths.
+void d()
+{
+    // Direct IO is only used if the file system supports it; otherwise
+    // normal IO is used. The data checks are done in both cases.
+    const uInt nval = 3000;
+    Int buf[nval];
+    Int exp[nval];
+    for (uInt i=0; i<nval; i++) {
+	buf[i] = i+1;
+	exp[i] = 0;
+    }
+    Bool direct;
+    {
+	BucketFile file ("tBucketFile_tmp.direct", 0, False, 0, True);
+	file.open();
+	direct = file.isDirect();
+	// Write a part spanning an alignment boundary, thereafter the start.
+	file.seek (Int64(1000*sizeof(Int)));
+	file.write (buf, 1234*sizeof(Int));
+	for (uInt i=0; i<1234; i++) {
+	    exp[1000+i] = buf[i];
+	}
+	file.seek (Int64(3));
+	file.write (buf+10, 5);
+	memcpy ((char*)exp + 3, buf+10, 5);
+	AlwaysAssertExit (file.fileSize() == Int64(2234*sizeof(Int)));
+	// Read the data back from an unaligned offset.
+	Int res[nval];
+	file.seek (Int64(1));
+	file.read ((char*)res + 1, 2234*sizeof(Int) - 1);
+	AlwaysAssertExit (memcmp ((char*)res + 1, (char*)exp + 1,
+				  2234*sizeof(Int) - 1) == 0);
+    }
+    // After closing the file should have its logical size.
+    AlwaysAssertExit (RegularFile("tBucketFile_tmp.direct").size() ==
+		      Int64(2234*sizeof(Int)));
+    {
+	BucketFile file ("tBucketFile_tmp.direct", False, 0, False, 0, True);
+	file.open();
+	AlwaysAssertExit (file.isDirect() == direct);
+	AlwaysAssertExit (file.fileSize() == Int64(2234*sizeof(Int)));
+	Int res[nval];
+	file.seek (Int64(4097));
+	file.read (res, 1000);
+	AlwaysAssertExit (memcmp (res, (char*)exp + 4097, 1000) == 0);
+    }
+    {
+	// Let another writer extend the file after this one padded it.
+	// Closing should not truncate the data of the other writer.
+	BucketFile file ("tBucketFile_tmp.direct", True, 0, False, 0, True);
+	file.open();
+	file.seek (Int64(2234*sizeof(Int)));
+	file.write (buf, 10*sizeof(Int));
+	AlwaysAssertExit (file.fileSize() == Int64(2244*sizeof(Int)));
+	if (direct) {
+	    AlwaysAssertExit (RegularFile("tBucketFile_tmp.direct").size() ==
+			      Int64(3*4096));
+	}
+	{
+	    BucketFile other ("tBucketFile_tmp.direct", True);
+	    other.open();
+	    other.seek (Int64(3*4096));
+	    other.write (buf, 100*sizeof(Int));
+	}
+	AlwaysAssertExit (file.fileSize() == Int64(3*4096 + 100*sizeof(Int)));
+    }
+    AlwaysAssertExit (RegularFile("tBucketFile_tmp.direct").size() ==
+		      Int64(3*4096 + 100*sizeof(Int)));
+    {
+	// The padding is removed if the file was not changed by others.
+	BucketFile file ("tBucketFile_tmp.direct", True, 0, False, 0, True);
+	file.open();
+	file.seek (Int64(3*4096 + 100*sizeof(Int)));
+	file.write (buf, 3);
+	AlwaysAssertExit (file.fileSize() ==
+			  Int64(3*4096 + 100*sizeof(Int) + 3));
+    }
+    AlwaysAssertExit (RegularFile("tBucketFile_tmp.direct").size() ==
+		      Int64(3*4096 + 100*sizeof(Int) + 3));
+    BucketFile ("tBucketFile_tmp.direct", False).remove();
+}
+
 void c()
 {
     // Do some erronous calls.
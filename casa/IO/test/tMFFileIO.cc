@@ -0,0 +1,155 @@
+//# tMFFileIO.cc: Test program for class MFFileIO
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casa/IO/MFFileIO.h>
+#include <casa/IO/MultiFile.h>
+#include <casa/IO/AipsIO.h>
+#include <casa/IO/BucketFile.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <iostream>
+
+using namespace casa;
+using namespace std;
+
+void writeFiles()
+{
+  MultiFile mfile("tMFFileIO_tmp.dat", ByteIO::New, 512);
+  // Write with AipsIO into a virtual file.
+  {
+    AipsIO aio("tMFFileIO_tmp.aio", ByteIO::New, 0, &mfile);
+    aio.putstart ("test", 1);
+    for (Int i=0; i<200; ++i) {
+      aio << i;
+    }
+    aio << String("end");
+    aio.putend();
+  }
+  // Write directly into another file.
+  MFFileIO mfio(mfile, "tMFFileIO_tmp.raw", ByteIO::New);
+  AlwaysAssertExit (mfio.isWritable()  &&  mfio.length() == 0);
+  for (Int i=0; i<300; ++i) {
+    mfio.write (sizeof(Int), &i);
+  }
+  AlwaysAssertExit (mfio.length() == Int64(300*sizeof(Int)));
+  // Seek and overwrite.
+  Int val = -1;
+  mfio.seek (Int64(10*sizeof(Int)));
+  mfio.write (sizeof(Int), &val);
+  AlwaysAssertExit (mfio.seek (Int64(0), ByteIO::Current) == Int64(11*sizeof(Int)));
+  // A new file cannot replace an existing one if NewNoReplace.
+  Bool failed = False;
+  try {
+    MFFileIO mfio2(mfile, "tMFFileIO_tmp.raw", ByteIO::NewNoReplace);
+  } catch (AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  // Append to the file.
+  MFFileIO mfio3(mfile, "tMFFileIO_tmp.raw", ByteIO::Append);
+  mfio3.write (sizeof(Int), &val);
+  AlwaysAssertExit (mfio.length() == Int64(301*sizeof(Int)));
+  // Use a BucketFile in the MultiFile.
+  BucketFile bfile("tMFFileIO_tmp.bf", 0, False, &mfile);
+  AlwaysAssertExit (bfile.multiFile() == &mfile  &&  bfile.fd() < 0);
+  bfile.seek (Int64(100));
+  bfile.write ("abcdef", 6);
+  AlwaysAssertExit (bfile.fileSize() == 106);
+}
+
+void readFiles()
+{
+  MultiFile mfile("tMFFileIO_tmp.dat", ByteIO::Old);
+  AlwaysAssertExit (mfile.nfile() == 3);
+  {
+    AipsIO aio("tMFFileIO_tmp.aio", ByteIO::Old, 0, &mfile);
+    AlwaysAssertExit (aio.getstart ("test") == 1);
+    Int val;
+    for (Int i=0; i<200; ++i) {
+      aio >> val;
+      AlwaysAssertExit (val == i);
+    }
+    String str;
+    aio >> str;
+    AlwaysAssertExit (str == "end");
+    aio.getend();
+  }
+  MFFileIO mfio(mfile, "tMFFileIO_tmp.raw");
+  AlwaysAssertExit (!mfio.isWritable()  &&  mfio.length() == Int64(301*sizeof(Int)));
+  Int vals[301];
+  AlwaysAssertExit (mfio.read (sizeof(vals), vals) == Int(sizeof(vals)));
+  for (Int i=0; i<300; ++i) {
+    AlwaysAssertExit (vals[i] == (i==10 ? -1 : i));
+  }
+  AlwaysAssertExit (vals[300] == -1);
+  // Reading beyond the end fails.
+  Bool failed = False;
+  try {
+    mfio.read (sizeof(Int), vals);
+  } catch (AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  AlwaysAssertExit (mfio.read (sizeof(Int), vals, False) == 0);
+  // A file cannot be written in a readonly MultiFile.
+  failed = False;
+  try {
+    MFFileIO mfio2(mfile, "tMFFileIO_tmp.raw", ByteIO::Update);
+  } catch (AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  BucketFile bfile("tMFFileIO_tmp.bf", False, 0, False, &mfile);
+  bfile.open();
+  char buf[6];
+  bfile.seek (Int64(100));
+  bfile.read (buf, 6);
+  AlwaysAssertExit (String(buf, 6) == "abcdef");
+  // After reopening for read/write the file can be updated.
+  mfio.reopenRW();
+  AlwaysAssertExit (mfio.isWritable()  &&  mfile.isWritable());
+  mfio.seek (Int64(10*sizeof(Int)));
+  Int val = 10;
+  mfio.write (sizeof(Int), &val);
+  mfio.seek (Int64(10*sizeof(Int)));
+  val = -1;
+  mfio.read (sizeof(Int), &val);
+  AlwaysAssertExit (val == 10);
+}
+
+int main()
+{
+  try {
+    writeFiles();
+    readFiles();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
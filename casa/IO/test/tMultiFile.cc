@@ -33,6 +33,11 @@
 #include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/ArrayIO.h>
 #include <casa/BasicSL/STLIO.h>
+#include <casa/IO/MemoryIO.h>
+#include <casa/IO/CanonicalIO.h>
+#include <casa/IO/AipsIO.h>
+#include <casa/IO/RegularFileIO.h>
+#include <casa/OS/CanonicalConversion.h>
 #include <iostream>
 #include <stdexcept>
 
@@ -128,6 +133,118 @@ void checkFiles1()
   AlwaysAssertExit (buff[380]==509 && buff[381]==509);   // check not overwritten
 }
 
+void deleteAndReuse()
+{
+  MultiFile mfile("tMultiFile_tmp.dat", ByteIO::Update);
+  AlwaysAssertExit (mfile.fileSize(1) == 2048);
+  mfile.deleteFile (1);
+  AlwaysAssertExit (mfile.fileId("file1", False) == -1);
+  AlwaysAssertExit (mfile.freeBlocks().size() == 2);
+  // The blocks of the deleted file are reused.
+  Int fid = mfile.add ("tMultiFile_tmp.dir/file3");
+  AlwaysAssertExit (fid == 1  &&  mfile.fileId("file3") == 1);
+  // Do small unaligned writes.
+  Vector<Int64> buf(300);
+  indgen (buf);
+  for (uInt i=0; i<300; i+=10) {
+    mfile.write (fid, buf.data()+i, 80, 100 + 8*i);
+  }
+  AlwaysAssertExit (mfile.fileSize(fid) == 2500);
+  AlwaysAssertExit (mfile.freeBlocks().empty()  &&  mfile.size() == 9);
+  // Data can be read back before being flushed.
+  Vector<Int64> buf1(300);
+  AlwaysAssertExit (mfile.read (fid, buf1.data(), 2400, 100) == 2400);
+  AlwaysAssertExit (allEQ(buf, buf1));
+}
+
+void checkFiles2()
+{
+  MultiFile mfile("tMultiFile_tmp.dat", ByteIO::Old);
+  AlwaysAssertExit (mfile.nfile() == 3  &&  mfile.size() == 9);
+  AlwaysAssertExit (mfile.fileSize(0) == 3072  &&  mfile.fileSize(1) == 2500);
+  Vector<Int64> buf(300), buf1(300);
+  indgen (buf);
+  AlwaysAssertExit (mfile.read (1, buf1.data(), 2400, 100) == 2400);
+  AlwaysAssertExit (allEQ(buf, buf1));
+  // The unwritten start of the file is zero.
+  char cbuf[100];
+  AlwaysAssertExit (mfile.read (1, cbuf, 100, 0) == 100);
+  for (uInt i=0; i<100; ++i) {
+    AlwaysAssertExit (cbuf[i] == 0);
+  }
+  // Reading beyond the end gives a short read.
+  AlwaysAssertExit (mfile.read (1, buf1.data(), 2400, 200) == 2300);
+  AlwaysAssertExit (mfile.read (1, buf1.data(), 2400, 3000) == 0);
+}
+
+void sparseReuse()
+{
+  MultiFile mfile("tMultiFile_tmp.dat", ByteIO::Update);
+  // Delete file2 having 2 blocks with non-zero data.
+  mfile.deleteFile (2);
+  AlwaysAssertExit (mfile.freeBlocks().size() == 2);
+  Int fid = mfile.add ("file4");
+  // Write only in the second block; the reused first block must be zero.
+  Int64 val = 12345;
+  mfile.write (fid, &val, sizeof(Int64), 1500);
+  AlwaysAssertExit (mfile.freeBlocks().empty()  &&  mfile.size() == 9);
+  mfile.flush();
+  Vector<Int64> buf(128);
+  AlwaysAssertExit (mfile.read (fid, buf.data(), 1024, 0) == 1024);
+  AlwaysAssertExit (allEQ(buf, Int64(0)));
+  val = 0;
+  AlwaysAssertExit (mfile.read (fid, &val, sizeof(Int64), 1500) == 8);
+  AlwaysAssertExit (val == 12345);
+}
+
+// Write a container in the old format (version 1) containing a single
+// file with the given blocks.
+void makeVersion1 (const vector<Int64>& blockNrs)
+{
+  const Int64 blockSize = 1024;
+  MemoryIO mio(blockSize, blockSize);
+  CanonicalIO cio(&mio);
+  AipsIO aio(&cio);
+  Int64 next=0;
+  cio.write (1, &next);
+  cio.write (1, &next);
+  cio.write (1, &blockSize);
+  aio.putstart ("MultiFile", 1);
+  aio << Int64(blockNrs.size() + 1);
+  aio.putstart ("Block", 1);
+  aio << uInt(1) << String("file1") << blockNrs;
+  aio.putend();
+  aio.putend();
+  Int64 size = mio.length();
+  uChar* buf = const_cast<uChar*>(mio.getBuffer());
+  CanonicalConversion::fromLocal (buf + sizeof(next), size);
+  RegularFileIO file(RegularFile("tMultiFile_tmp.v1"), ByteIO::New);
+  file.write (blockSize, buf);
+  Vector<Int64> data(128);
+  for (uInt i=0; i<blockNrs.size(); ++i) {
+    indgen (data, Int64(128*i));
+    file.seek (blockNrs[i] * blockSize);
+    file.write (blockSize, data.data());
+  }
+}
+
+void readVersion1()
+{
+  vector<Int64> blockNrs(2);
+  blockNrs[0] = 2;
+  blockNrs[1] = 1;
+  makeVersion1 (blockNrs);
+  MultiFile mfile("tMultiFile_tmp.v1", ByteIO::Old);
+  AlwaysAssertExit (mfile.nfile() == 1  &&  mfile.size() == 3);
+  AlwaysAssertExit (mfile.fileId("file1") == 0);
+  AlwaysAssertExit (mfile.fileSize(0) == 2048);
+  AlwaysAssertExit (mfile.freeBlocks().empty());
+  Vector<Int64> buf(256), buf1(256);
+  indgen (buf1);
+  AlwaysAssertExit (mfile.read (0, buf.data(), 2048, 0) == 2048);
+  AlwaysAssertExit (allEQ(buf, buf1));
+}
+
 int main()
 {
   try {
@@ -138,6 +255,10 @@ int main()
     writeFiles1();
     readFile();
     checkFiles1();
+    deleteAndReuse();
+    checkFiles2();
+    sparseReuse();
+    readVersion1();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
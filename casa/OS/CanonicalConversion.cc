@@ -127,7 +127,7 @@ Conversion::ByteFunction* CanonicalConversion::getByteFromLocal
 
 
 
-#define CANONICALCONVERSION_DO(CONVERT,SIZE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,T) \
+#define CANONICALCONVERSION_DO(CONVERT,SIZE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,SWAP,T) \
 unsigned int CanonicalConversion::TOLOCAL (void* to, const void* from, \
 				           unsigned int nr) \
 { \
@@ -135,6 +135,9 @@ unsigned int CanonicalConversion::TOLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	/* Only the bytes have to be reversed; use the vectorized kernel. */ \
+	SWAP (to, from, nr); \
     }else{ \
 	const char* data = (const char*)from; \
         T* dest = (T*)to; \
@@ -153,6 +156,8 @@ unsigned int CanonicalConversion::FROMLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	SWAP (to, from, nr); \
     }else{ \
 	char* data = (char*)to; \
 	const T* src = (const T*)from; \
@@ -196,28 +201,36 @@ Conversion::ByteFunction* CanonicalConversion::getByteFromLocal (const T*) \
 
 CANONICALCONVERSION_DO (CONVERT_CAN_SHORT,  SIZE_CAN_SHORT,
 			toLocalShort,  fromLocalShort,
-			byteToLocalShort,  byteFromLocalShort,  short)
+			byteToLocalShort,  byteFromLocalShort,
+			Conversion::swapBytes2, short)
 CANONICALCONVERSION_DO (CONVERT_CAN_USHORT, SIZE_CAN_USHORT,
 			toLocalUShort, fromLocalUShort,
-			byteToLocalUShort, byteFromLocalUShort, unsigned short)
+			byteToLocalUShort, byteFromLocalUShort,
+			Conversion::swapBytes2, unsigned short)
 CANONICALCONVERSION_DO (CONVERT_CAN_INT,    SIZE_CAN_INT,
 			toLocalInt,    fromLocalInt,
-			byteToLocalInt,    byteFromLocalInt,    int)
+			byteToLocalInt,    byteFromLocalInt,
+			Conversion::swapBytes4, int)
 CANONICALCONVERSION_DO (CONVERT_CAN_UINT,   SIZE_CAN_UINT,
 			toLocalUInt,   fromLocalUInt,
-			byteToLocalUInt,   byteFromLocalUInt,   unsigned int)
+			byteToLocalUInt,   byteFromLocalUInt,
+			Conversion::swapBytes4, unsigned int)
 CANONICALCONVERSION_DO (CONVERT_CAN_INT64,  SIZE_CAN_INT64,
 			toLocalInt64,  fromLocalInt64,
-			byteToLocalInt64,  byteFromLocalInt64,  Int64)
+			byteToLocalInt64,  byteFromLocalInt64,
+			Conversion::swapBytes8, Int64)
 CANONICALCONVERSION_DO (CONVERT_CAN_UINT64, SIZE_CAN_UINT64,
 			toLocalUInt64, fromLocalUInt64,
-			byteToLocalUInt64, byteFromLocalUInt64, uInt64)
+			byteToLocalUInt64, byteFromLocalUInt64,
+			Conversion::swapBytes8, uInt64)
 CANONICALCONVERSION_DO (CONVERT_CAN_FLOAT,  SIZE_CAN_FLOAT,
 			toLocalFloat,  fromLocalFloat,
-			byteToLocalFloat,  byteFromLocalFloat,  float)
+			byteToLocalFloat,  byteFromLocalFloat,
+			Conversion::swapBytes4, float)
 CANONICALCONVERSION_DO (CONVERT_CAN_DOUBLE, SIZE_CAN_DOUBLE,
 			toLocalDouble, fromLocalDouble,
-			byteToLocalDouble, byteFromLocalDouble, double)
+			byteToLocalDouble, byteFromLocalDouble,
+			Conversion::swapBytes8, double)
 
 } //# NAMESPACE CASA - END
 
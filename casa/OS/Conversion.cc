@@ -31,125 +31,21 @@
 #include <casa/aips.h>
 #include <casa/OS/Conversion.h>
 #include <casa/iostream.h>
+#include <cstring>
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+//# AVX2 kernels are compiled using the target attribute and are only
+//# used if the CPU supports AVX2 (tested at run time).
+#if defined(__x86_64__) && defined(__GNUC__) && \
+    (defined(__clang__) || __GNUC__ >= 5)
+# define CASA_CONVERSION_AVX2
+# include <immintrin.h>
+#endif
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
-unsigned int Conversion::boolToBit (void* to, const void* from,
-				    unsigned int nvalues)
-{
-    const Bool* data = (const Bool*)from;
-    unsigned char* bits = (unsigned char*)to;
-    //# Fill as many bytes as needed.
-    unsigned int nbytes = (nvalues + 7) / 8;
-    unsigned int i,j;
-    unsigned int index = 0;
-    for (i=0; i<nbytes; i++) {
-	unsigned char& ch = bits[i];
-	ch = 0;
-	unsigned char mask = 1;
-	//# Take care of correct number of bits in last byte.
-	unsigned int nbits = (nvalues-index < 8  ?  nvalues-index : 8);
-	for (j=0; j<nbits; j++) {
-	    if (data[index++]) {
-		ch |= mask;
-	    }
-	    mask <<= 1;
-	}
-    }
-    return nbytes;
-}
-
-void Conversion::boolToBit (void* to, const void* from,
-			    unsigned int startBit,
-			    unsigned int nvalues)
-{
-    const Bool* data = (const Bool*)from;
-    unsigned char* bits = (unsigned char*)to;
-    //# Determine the first and last byte to be set
-    //# and the first and last bit in the first and last byte.
-    unsigned int startByte = startBit / 8;
-    unsigned int startBit1 = startBit - 8 * startByte;
-    unsigned int endByte   = (startBit + nvalues) / 8;
-    unsigned int endBit1   = 8;
-    unsigned int endBit2   = startBit + nvalues - 8 * endByte;
-    //# Take care if only one byte has to be handled.
-    if (startByte == endByte) {
-	endBit1 = endBit2;
-	endBit2 = 0;
-    }
-    unsigned int i, j, index;
-    //# Set the bits in the last byte (if needed).
-    if (endBit2 > 0) {
-	index = endByte * 8 - startBit;
-	unsigned char& ch = bits[endByte];
-	unsigned char mask = 1;
-	for (i=0; i<endBit2; i++) {
-	    if (data[index++]) {
-		ch |= mask;
-	    }else{
-		ch &= (~mask);
-	    }
-	    mask <<= 1;
-	}
-    }
-    index = 0;
-    //# Set the bits in the first byte (if needed).
-    if (startBit1 > 0  ||  endBit1 < 8) {
-	unsigned char& ch = bits[startByte++];
-	unsigned char mask = (1 << startBit1);
-	for (i=startBit1; i<endBit1; i++) {
-	    if (data[index++]) {
-		ch |= mask;
-	    }else{
-		ch &= (~mask);
-	    }
-	    mask <<= 1;
-	}
-    }
-    //# Set the bits in all 'full' bytes.
-    //# Note that the index in the Bool array is correct.
-    for (i=startByte; i<endByte; i++) {
-	unsigned char& ch = bits[i];
-	ch = 0;
-	unsigned char mask = 1;
-	for (j=0; j<8; j++) {
-	    if (data[index++]) {
-		ch |= mask;
-	    }
-	    mask <<= 1;
-	}
-    }
-}
-
-unsigned int Conversion::bitToBool_ (void* to, const void* from,
-                                     unsigned int nvalues)
-{
-    Bool* data = (Bool*)to;
-    const unsigned char* bits = (const unsigned char*)from;
-    //# Fill as many bytes as needed.
-    unsigned int nbytes = (nvalues + 7) / 8;
-    unsigned int i,j;
-    unsigned int index = 0;
-    for (i=0; i<nbytes; i++) {
-	const unsigned int ch = bits[i];
-	unsigned int mask = 1;
-	//# Take care of correct number of bits in last byte.
-	unsigned int nbits = (nvalues-index < 8  ?  nvalues-index : 8);
-	for (j=0; j<nbits; j++) {
-	    if (ch & mask) {
-		data[index] = True;
-	    }else{
-		data[index] = False;
-	    }
-	    mask <<= 1;
-	    index++;
-	}
-    }
-    return nbytes;
-}
-
-
 //# July 2011: Optimization made by Kohji Nakamura
 //# and slightly adapted by Ger van Diepen
 
@@ -421,35 +317,171 @@ static m64d_t conv_tab[256] __attribute__ ((aligned (8))) = {
 };
 
 
-unsigned int Conversion::bitToBool (void* to, const void* from,
-				    unsigned int nvalues)
+// Unpack whole bytes into 8 Bools each.
+// Copying a table entry with memcpy results in a single (unaligned)
+// 8-byte store per byte, which is faster than unpacking with SSE2.
+inline static void unpackBytes (Bool* data, const uChar* bits,
+                                size_t nbytes)
 {
-    if (sizeof(Bool) != sizeof(char)  ||  (7 & (unsigned long long)to)) {
-	return bitToBool_ (to, from, nvalues);
+    if (sizeof(Bool) == 1) {
+	for (size_t i=0; i<nbytes; i++) {
+	    memcpy (data + 8*i, conv_tab[bits[i]].b, 8);
+	}
+    } else {
+	for (size_t i=0; i<8*nbytes; i++) {
+	    data[i] = (bits[i/8] & (1 << (i%8))) != 0;
+	}
     }
-#ifdef __clang__
-    double* __attribute__ ((aligned (8))) data = (double *)to;
-#else
-    double* __attribute__ ((aligned (8))) data =
- 	(double __attribute__ ((aligned (8)))*)to;
+}
+
+// Tell if the AVX2 kernels can be used.
+// The CPU is tested only once.
+#if defined(CASA_CONVERSION_AVX2)
+static bool hasAVX2()
+{
+    static const bool avx2 = (__builtin_cpu_init(),
+			      __builtin_cpu_supports ("avx2") != 0);
+    return avx2;
+}
+
+// Pack 32 Bools at a time into 4 bytes using AVX2.
+// It returns the number of bytes done.
+__attribute__ ((target ("avx2")))
+static size_t packBytesAVX2 (uChar* bits, const Bool* data, size_t nbytes)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i+4 <= nbytes; i+=4) {
+	__m256i v = _mm256_loadu_si256 ((const __m256i*)(data + 8*i));
+	uInt mask = ~uInt(_mm256_movemask_epi8 (_mm256_cmpeq_epi8 (v, zero)));
+	memcpy (bits+i, &mask, 4);
+    }
+    return i;
+}
 #endif
-    const uint8_t* bits = (const uint8_t*)from;
-    const size_t bits_per_loop = 8;
-    const size_t nwords = nvalues / bits_per_loop;
-#ifdef _OPENMP
-# pragma omp parallel if (nwords >= 1024*2)
+
+// Pack 8 Bools into each byte.
+// If the CPU supports AVX2, 32 Bools are done at a time.
+// With SSE2 16 Bools are compared to zero and the results are gathered
+// into 16 bits in a single instruction. Otherwise 8 Bools are read as a
+// 64-bit word; the multiplication moves bit 0 of byte i to bit 56+i.
+inline static void packBytes (uChar* bits, const Bool* data, size_t nbytes)
+{
+    size_t i = 0;
+    if (sizeof(Bool) == 1) {
+#if defined(CASA_CONVERSION_AVX2) && defined(AIPS_LITTLE_ENDIAN)
+	if (nbytes >= 4  &&  hasAVX2()) {
+	    i = packBytesAVX2 (bits, data, nbytes);
+	}
 #endif
-    {
-#ifdef _OPENMP
-# pragma omp for
+#if defined(__SSE2__)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i+2 <= nbytes; i+=2) {
+	    __m128i v = _mm_loadu_si128 ((const __m128i*)(data + 8*i));
+	    int mask = ~_mm_movemask_epi8 (_mm_cmpeq_epi8 (v, zero));
+	    bits[i]   = mask & 0xff;
+	    bits[i+1] = (mask >> 8) & 0xff;
+	}
 #endif
-	for (size_t i = 0; i < nwords; i++) {
-	    data[i] = conv_tab[bits[i]].d;
+#if defined(AIPS_LITTLE_ENDIAN)
+	for (; i<nbytes; i++) {
+	    uint64_t word;
+	    memcpy (&word, data + 8*i, 8);
+	    bits[i] = ((word & 0x0101010101010101ULL) *
+		       0x0102040810204080ULL) >> 56;
 	}
+#endif
+    }
+    for (; i<nbytes; i++) {
+	uChar ch = 0;
+	for (uInt j=0; j<8; j++) {
+	    if (data[8*i + j]) {
+		ch |= (1 << j);
+	    }
+	}
+	bits[i] = ch;
     }
-    return nwords * (bits_per_loop / 8)
-	+ bitToBool_ (&data[nwords], &bits[nwords],
-                      nvalues - (nwords * bits_per_loop));
+}
+
+// Set or get bits one by one (for the partial bytes at the edges).
+// Other bits in the bytes are left untouched.
+// <group>
+inline static void setBits (uChar* bits, size_t startBit,
+                            const Bool* data, size_t nvalues)
+{
+    for (size_t i=0; i<nvalues; i++) {
+	size_t bit = startBit + i;
+	uChar mask = 1 << (bit%8);
+	if (data[i]) {
+	    bits[bit/8] |= mask;
+	} else {
+	    bits[bit/8] &= ~mask;
+	}
+    }
+}
+inline static void getBits (Bool* data, const uChar* bits,
+                            size_t startBit, size_t nvalues)
+{
+    for (size_t i=0; i<nvalues; i++) {
+	size_t bit = startBit + i;
+	data[i] = (bits[bit/8] & (1 << (bit%8))) != 0;
+    }
+}
+// </group>
+
+
+unsigned int Conversion::boolToBit (void* to, const void* from,
+				    unsigned int nvalues)
+{
+    const Bool* data = (const Bool*)from;
+    uChar* bits = (uChar*)to;
+    unsigned int nfull = nvalues / 8;
+    packBytes (bits, data, nfull);
+    //# The unused bits in the last byte are cleared.
+    if (nvalues > 8*nfull) {
+	bits[nfull] = 0;
+	setBits (bits, 8*nfull, data + 8*nfull, nvalues - 8*nfull);
+    }
+    return (nvalues + 7) / 8;
+}
+
+void Conversion::boolToBit (void* to, const void* from,
+			    unsigned int startBit,
+			    unsigned int nvalues)
+{
+    const Bool* data = (const Bool*)from;
+    uChar* bits = (uChar*)to;
+    //# Set the bits up to the first byte boundary one by one,
+    //# thereafter pack entire bytes and finally set the remaining bits.
+    unsigned int nhead = (8 - startBit%8) % 8;
+    if (nhead > nvalues) {
+	nhead = nvalues;
+    }
+    setBits (bits, startBit, data, nhead);
+    unsigned int nfull = (nvalues - nhead) / 8;
+    packBytes (bits + (startBit + nhead) / 8, data + nhead, nfull);
+    unsigned int ndone = nhead + 8*nfull;
+    setBits (bits, startBit + ndone, data + ndone, nvalues - ndone);
+}
+
+unsigned int Conversion::bitToBool (void* to, const void* from,
+				    unsigned int nvalues)
+{
+    Bool* data = (Bool*)to;
+    const uChar* bits = (const uChar*)from;
+    const size_t nfull = nvalues / 8;
+    //# Large arrays are unpacked in parallel in blocks of 4096 bytes.
+    const size_t blockSize = 4096;
+    const size_t nblock = (nfull + blockSize - 1) / blockSize;
+#ifdef _OPENMP
+# pragma omp parallel for if (nfull >= 1024*2)
+#endif
+    for (size_t i = 0; i < nblock; i++) {
+	size_t nr = (i == nblock-1  ?  nfull - i*blockSize : blockSize);
+	unpackBytes (data + 8*i*blockSize, bits + i*blockSize, nr);
+    }
+    getBits (data + 8*nfull, bits + nfull, 0, nvalues - 8*nfull);
+    return (nvalues + 7) / 8;
 }
 
 void Conversion::bitToBool (void* to, const void* from,
@@ -457,66 +489,149 @@ void Conversion::bitToBool (void* to, const void* from,
 			    unsigned int nvalues)
 {
     Bool* data = (Bool*)to;
-    const unsigned char* bits = (const unsigned char*)from;
-    //# Determine the first and last byte to be read
-    //# and the first and last bit in the first and last byte.
-    unsigned int startByte = startBit / 8;
-    unsigned int startBit1 = startBit - 8 * startByte;
-    unsigned int endByte   = (startBit + nvalues) / 8;
-    unsigned int endBit1   = 8;
-    unsigned int endBit2   = startBit + nvalues - 8 * endByte;
-    //# Take care if only one byte has to be handled.
-    if (startByte == endByte) {
-	endBit1 = endBit2;
-	endBit2 = 0;
+    const uChar* bits = (const uChar*)from;
+    //# Get the bits up to the first byte boundary one by one,
+    //# thereafter unpack entire bytes and finally get the remaining bits.
+    unsigned int nhead = (8 - startBit%8) % 8;
+    if (nhead > nvalues) {
+	nhead = nvalues;
     }
-    unsigned int i, j, index;
-    //# Get the bits in the last byte (if needed).
-    if (endBit2 > 0) {
-	index = endByte * 8 - startBit;
-	const unsigned char& ch = bits[endByte];
-	unsigned char mask = 1;
-	for (i=0; i<endBit2; i++) {
-	    if (ch & mask) {
-		data[index] = True;
-	    }else{
-		data[index] = False;
-	    }
-	    mask <<= 1;
-	    index++;
-	}
+    getBits (data, bits, startBit, nhead);
+    unsigned int nfull = (nvalues - nhead) / 8;
+    unpackBytes (data + nhead, bits + (startBit + nhead) / 8, nfull);
+    unsigned int ndone = nhead + 8*nfull;
+    getBits (data + ndone, bits, startBit + ndone, nvalues - ndone);
+}
+
+
+// Reverse the bytes of 2, 4 and 8-byte values one by one.
+// The values are copied with memcpy, because they need not be aligned.
+// <group>
+inline static void swapValues2 (char* to, const char* from, size_t n)
+{
+    for (size_t i=0; i<n; i++) {
+	uint16_t v;
+	memcpy (&v, from + 2*i, 2);
+	v = (v << 8) | (v >> 8);
+	memcpy (to + 2*i, &v, 2);
     }
-    index = 0;
-    //# Set the bits in the first byte (if needed).
-    if (startBit1 > 0  ||  endBit1 < 8) {
-	const unsigned char& ch = bits[startByte++];
-	unsigned char mask = (1 << startBit1);
-	for (i=startBit1; i<endBit1; i++) {
-	    if (ch & mask) {
-		data[index] = True;
-	    }else{
-		data[index] = False;
-	    }
-	    mask <<= 1;
-	    index++;
-	}
+}
+inline static void swapValues4 (char* to, const char* from, size_t n)
+{
+    for (size_t i=0; i<n; i++) {
+	uint32_t v;
+	memcpy (&v, from + 4*i, 4);
+#if defined(__GNUC__)
+	v = __builtin_bswap32 (v);
+#else
+	v = (v << 24) | ((v << 8) & 0xff0000) | ((v >> 8) & 0xff00) | (v >> 24);
+#endif
+	memcpy (to + 4*i, &v, 4);
     }
-    //# Set the bits in all 'full' bytes.
-    //# Note that the index in the Bool array is correct.
-    for (i=startByte; i<endByte; i++) {
-	const unsigned char& ch = bits[i];
-	unsigned char mask = 1;
-	for (j=0; j<8; j++) {
-	    if (ch & mask) {
-		data[index] = True;
-	    }else{
-		data[index] = False;
-	    }
-	    mask <<= 1;
-	    index++;
-	}
+}
+inline static void swapValues8 (char* to, const char* from, size_t n)
+{
+    for (size_t i=0; i<n; i++) {
+	uint64_t v;
+	memcpy (&v, from + 8*i, 8);
+#if defined(__GNUC__)
+	v = __builtin_bswap64 (v);
+#else
+	v = ((v << 56)                        | ((v << 40) & 0xff000000000000ULL) |
+	     ((v << 24) & 0xff0000000000ULL)  | ((v <<  8) & 0xff00000000ULL) |
+	     ((v >>  8) & 0xff000000ULL)      | ((v >> 24) & 0xff0000ULL) |
+	     ((v >> 40) & 0xff00ULL)          |  (v >> 56));
+#endif
+	memcpy (to + 8*i, &v, 8);
+    }
+}
+// </group>
+
+#if defined(CASA_CONVERSION_AVX2)
+// Reverse the bytes of the values in 32-byte vectors using a byte shuffle.
+// The shuffle mask tells for each byte in a 16-byte lane where to get it.
+// It returns the number of values done.
+__attribute__ ((target ("avx2")))
+static size_t swapAVX2 (char* to, const char* from, size_t nbytes,
+			const char* mask16)
+{
+    const __m128i m = _mm_loadu_si128 ((const __m128i*)mask16);
+    const __m256i mask = _mm256_broadcastsi128_si256 (m);
+    size_t i = 0;
+    for (; i+32 <= nbytes; i+=32) {
+	__m256i v = _mm256_loadu_si256 ((const __m256i*)(from + i));
+	_mm256_storeu_si256 ((__m256i*)(to + i),
+			     _mm256_shuffle_epi8 (v, mask));
     }
+    return i;
 }
+static const char swapMask2[16] = {1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14};
+static const char swapMask4[16] = {3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12};
+static const char swapMask8[16] = {7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8};
+#endif
+
+#if defined(__SSE2__)
+// Reverse the bytes in 16-byte vectors using SSE2, which has no byte
+// shuffle. The bytes in each 16-bit word are swapped using shifts;
+// for 4 and 8-byte values the 16-bit words are reversed first.
+// <group>
+inline static __m128i swapWords (__m128i v)
+{
+    return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+}
+inline static __m128i swapSSE2_2 (__m128i v)
+{
+    return swapWords (v);
+}
+inline static __m128i swapSSE2_4 (__m128i v)
+{
+    v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE(2,3,0,1));
+    v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE(2,3,0,1));
+    return swapWords (v);
+}
+inline static __m128i swapSSE2_8 (__m128i v)
+{
+    v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE(0,1,2,3));
+    v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE(0,1,2,3));
+    return swapWords (v);
+}
+// </group>
+# define CASA_SWAPSSE2(SIZE) \
+    for (; i+16 <= nbytes; i+=16) { \
+	__m128i v = _mm_loadu_si128 ((const __m128i*)(from + i)); \
+	_mm_storeu_si128 ((__m128i*)(to + i), swapSSE2_##SIZE (v)); \
+    }
+#else
+# define CASA_SWAPSSE2(SIZE)
+#endif
+
+//# Define the byte swap functions. First the AVX2 kernel is used
+//# if available, thereafter SSE2 and the remaining values are done
+//# one by one.
+#if defined(CASA_CONVERSION_AVX2)
+# define CASA_SWAPAVX2(SIZE) \
+    if (nbytes >= 32  &&  hasAVX2()) { \
+	i = swapAVX2 (to, from, nbytes, swapMask##SIZE); \
+    }
+#else
+# define CASA_SWAPAVX2(SIZE)
+#endif
+#define CASA_SWAPBYTES(SIZE) \
+void Conversion::swapBytes##SIZE (void* toPtr, const void* fromPtr, \
+				  size_t nvalues) \
+{ \
+    char* to = (char*)toPtr; \
+    const char* from = (const char*)fromPtr; \
+    const size_t nbytes = SIZE*nvalues; \
+    size_t i = 0; \
+    CASA_SWAPAVX2(SIZE) \
+    CASA_SWAPSSE2(SIZE) \
+    swapValues##SIZE (to + i, from + i, (nbytes - i) / SIZE); \
+}
+
+CASA_SWAPBYTES(2)
+CASA_SWAPBYTES(4)
+CASA_SWAPBYTES(8)
 
 
 unsigned int Conversion::valueCopy (void* to, const void* from,
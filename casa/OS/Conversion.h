@@ -110,6 +110,9 @@ public:
     // Convert a stream of Bools to output format (as bits).
     // The variable <src>startBit</src> (0-relative) indicates
     // where to start in the <src>to</src> buffer.
+    // <br>Entire bytes are packed a word at a time (16 Bools at a time
+    // using SSE2 if available); only the bits in partially filled bytes
+    // are handled one by one.
     // <group>
     static unsigned int boolToBit (void* to, const void* from,
 				   unsigned int nvalues);
@@ -118,9 +121,11 @@ public:
 			   unsigned int nvalues);
     // </group>
 
-    // Convert a stream of Bools to output format (as bits).
+    // Convert a stream of bits to Bools.
     // The variable <src>startBit</src> (0-relative) indicates
     // where to start in the <src>from</src> buffer.
+    // <br>Entire bytes are unpacked using a lookup table giving the
+    // 8 Bools for each byte value.
     // <group>
     static unsigned int bitToBool (void* to, const void* from,
 				   unsigned int nvalues);
@@ -129,6 +134,20 @@ public:
 			   unsigned int nvalues);
     // </group>
 
+    // Reverse the bytes of <src>nvalues</src> values of 2, 4 or 8 bytes.
+    // The buffers need not be aligned, but should not overlap unless
+    // <src>to</src> and <src>from</src> are the same.
+    // <br>They are used by the canonical conversion functions on machines
+    // where the canonical byte order differs from the local one.
+    // The bytes are swapped using AVX2 if the CPU supports it (tested at
+    // run time), otherwise using SSE2 if available; the remaining
+    // values are swapped one by one.
+    // <group>
+    static void swapBytes2 (void* to, const void* from, size_t nvalues);
+    static void swapBytes4 (void* to, const void* from, size_t nvalues);
+    static void swapBytes8 (void* to, const void* from, size_t nvalues);
+    // </group>
+
     // Copy a value using memcpy.
     // It differs from memcpy in the return value.
     // <note> This version has the <src>ValueFunction</src> signature,
@@ -145,11 +164,6 @@ public:
     // (because they do not use an unsigned int for nbytes).
     static void* mymemcpy (void* to, const void* from, unsigned int nbytes);
 
-private:
-    // Copy bits to Bool in an unoptimized way needed when 'to' is not
-    // aligned properly.
-    static unsigned int bitToBool_ (void* to, const void* from,
-                                    unsigned int nvalues);
 };
 
 
@@ -127,7 +127,7 @@ Conversion::ByteFunction* LECanonicalConversion::getByteFromLocal
 
 
 
-#define LECANONICALCONVERSION_DO(CONVERT,SIZE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,T) \
+#define LECANONICALCONVERSION_DO(CONVERT,SIZE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,SWAP,T) \
 unsigned int LECanonicalConversion::TOLOCAL (void* to, const void* from, \
 				             unsigned int nr) \
 { \
@@ -135,6 +135,9 @@ unsigned int LECanonicalConversion::TOLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	/* Only the bytes have to be reversed; use the vectorized kernel. */ \
+	SWAP (to, from, nr); \
     }else{ \
 	const char* data = (const char*)from; \
         T* dest = (T*)to; \
@@ -153,6 +156,8 @@ unsigned int LECanonicalConversion::FROMLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	SWAP (to, from, nr); \
     }else{ \
 	char* data = (char*)to; \
 	const T* src = (const T*)from; \
@@ -196,29 +201,36 @@ Conversion::ByteFunction* LECanonicalConversion::getByteFromLocal (const T*) \
 
 LECANONICALCONVERSION_DO (CONVERT_LECAN_SHORT,  SIZE_LECAN_SHORT,
 			  toLocalShort,  fromLocalShort,
-			  byteToLocalShort,  byteFromLocalShort,  short)
+			  byteToLocalShort,  byteFromLocalShort,
+			  Conversion::swapBytes2, short)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_USHORT, SIZE_LECAN_USHORT,
 			  toLocalUShort, fromLocalUShort,
 			  byteToLocalUShort, byteFromLocalUShort,
-			  unsigned short)
+			  Conversion::swapBytes2, unsigned short)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_INT,    SIZE_LECAN_INT,
 			  toLocalInt,    fromLocalInt,
-			  byteToLocalInt,    byteFromLocalInt,    int)
+			  byteToLocalInt,    byteFromLocalInt,
+			  Conversion::swapBytes4, int)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_UINT,   SIZE_LECAN_UINT,
 			  toLocalUInt,   fromLocalUInt,
-			  byteToLocalUInt,   byteFromLocalUInt,   unsigned int)
+			  byteToLocalUInt,   byteFromLocalUInt,
+			  Conversion::swapBytes4, unsigned int)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_INT64,  SIZE_LECAN_INT64,
 			  toLocalInt64,  fromLocalInt64,
-			  byteToLocalInt64,  byteFromLocalInt64,  Int64)
+			  byteToLocalInt64,  byteFromLocalInt64,
+			  Conversion::swapBytes8, Int64)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_UINT64, SIZE_LECAN_UINT64,
 			  toLocalUInt64, fromLocalUInt64,
-			  byteToLocalUInt64, byteFromLocalUInt64, uInt64)
+			  byteToLocalUInt64, byteFromLocalUInt64,
+			  Conversion::swapBytes8, uInt64)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_FLOAT,  SIZE_LECAN_FLOAT,
 			  toLocalFloat,  fromLocalFloat,
-			  byteToLocalFloat,  byteFromLocalFloat,  float)
+			  byteToLocalFloat,  byteFromLocalFloat,
+			  Conversion::swapBytes4, float)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_DOUBLE, SIZE_LECAN_DOUBLE,
 			  toLocalDouble, fromLocalDouble,
-			  byteToLocalDouble, byteFromLocalDouble, double)
+			  byteToLocalDouble, byteFromLocalDouble,
+			  Conversion::swapBytes8, double)
 
 } //# NAMESPACE CASA - END
 
@@ -28,10 +28,12 @@
 
 #include <casa/aips.h>
 #include <casa/OS/Conversion.h>
+#include <casa/OS/CanonicalConversion.h>
 #include <casa/OS/Timer.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
+#include <cstring>
 
 
 #include <casa/namespace.h>
@@ -83,6 +85,171 @@ void checkAll()
     }
     timer.show("aligned  ");
   }
+  {
+    Timer timer;
+    for (int i=0; i<100000; ++i) {
+      Conversion::boolToBit (out, flags, 8*256);
+    }
+    timer.show("pack     ");
+  }
+}
+
+// Check the conversions for all start bits and many lengths
+// against a straightforward implementation.
+void checkPartial()
+{
+  cout << "checkPartial ..." << endl;
+  const uInt nbool = 200;
+  Bool data[nbool+16];
+  Bool result[nbool+16];
+  uChar bits[(nbool+16)/8 + 1];
+  uChar expBits[(nbool+16)/8 + 1];
+  uInt seed = 1;
+  for (uInt i=0; i<nbool; i++) {
+    seed = seed * 1103515245 + 12345;
+    data[i] = (seed >> 16) & 1;
+  }
+  for (uInt start=0; start<16; start++) {
+    for (uInt nr=0; nr<nbool; nr++) {
+      // Preset the buffers with a pattern to check bits are not touched.
+      for (uInt i=0; i<sizeof(bits); i++) {
+        bits[i] = expBits[i] = 0xa5;
+      }
+      for (uInt i=0; i<nr; i++) {
+        uInt bit = start+i;
+        if (data[i]) {
+          expBits[bit/8] |= (1 << (bit%8));
+        } else {
+          expBits[bit/8] &= ~(1 << (bit%8));
+        }
+      }
+      Conversion::boolToBit (bits, data, start, nr);
+      AlwaysAssertExit (memcmp (bits, expBits, sizeof(bits)) == 0);
+      for (uInt i=0; i<nbool+16; i++) {
+        result[i] = True;
+      }
+      // Use an odd offset to get an unaligned output buffer.
+      Conversion::bitToBool (result+1, bits, start, nr);
+      AlwaysAssertExit (result[0]  &&  result[nr+1]);
+      for (uInt i=0; i<nr; i++) {
+        AlwaysAssertExit (result[i+1] == data[i]);
+      }
+      if (start == 0) {
+        AlwaysAssertExit (Conversion::boolToBit (bits, data, nr) ==
+                          (nr+7)/8);
+        for (uInt i=0; i<nr; i++) {
+          AlwaysAssertExit (((bits[i/8] >> (i%8)) & 1) == data[i]);
+        }
+        // The unused bits in the last byte have to be cleared.
+        if (nr%8 != 0) {
+          AlwaysAssertExit ((bits[nr/8] >> (nr%8)) == 0);
+        }
+        AlwaysAssertExit (Conversion::bitToBool (result+1, bits, nr) ==
+                          (nr+7)/8);
+        for (uInt i=0; i<nr; i++) {
+          AlwaysAssertExit (result[i+1] == data[i]);
+        }
+      }
+    }
+  }
+}
+
+// Check the byte swap functions for all sizes, many lengths and
+// unaligned buffers against a byte by byte reversal.
+void checkSwapSize (uInt size)
+{
+  const uInt nval = 100;
+  char from[8*nval + 8];
+  char to[8*nval + 8];
+  char exp[8*nval + 8];
+  for (uInt i=0; i<sizeof(from); i++) {
+    from[i] = i*7 + 3;
+  }
+  for (uInt off=0; off<8; off++) {
+    for (uInt nr=0; nr<nval; nr++) {
+      memset (to, 0x5a, sizeof(to));
+      memset (exp, 0x5a, sizeof(exp));
+      for (uInt i=0; i<nr; i++) {
+        for (uInt j=0; j<size; j++) {
+          exp[off + i*size + j] = from[off + i*size + size-1-j];
+        }
+      }
+      switch (size) {
+      case 2:
+        Conversion::swapBytes2 (to+off, from+off, nr);
+        break;
+      case 4:
+        Conversion::swapBytes4 (to+off, from+off, nr);
+        break;
+      default:
+        Conversion::swapBytes8 (to+off, from+off, nr);
+        break;
+      }
+      AlwaysAssertExit (memcmp (to, exp, sizeof(to)) == 0);
+      // Swapping in place has to give the original values.
+      switch (size) {
+      case 2:
+        Conversion::swapBytes2 (to+off, to+off, nr);
+        break;
+      case 4:
+        Conversion::swapBytes4 (to+off, to+off, nr);
+        break;
+      default:
+        Conversion::swapBytes8 (to+off, to+off, nr);
+        break;
+      }
+      AlwaysAssertExit (memcmp (to+off, from+off, nr*size) == 0);
+    }
+  }
+}
+
+void checkSwap()
+{
+  cout << "checkSwap ..." << endl;
+  checkSwapSize (2);
+  checkSwapSize (4);
+  checkSwapSize (8);
+  // Compare the speed with reversing the values one by one.
+  const uInt nval = 32768;
+  double* from = new double[nval];
+  double* to = new double[nval];
+  for (uInt i=0; i<nval; i++) {
+    from[i] = i;
+  }
+  {
+    Timer timer;
+    for (int j=0; j<1000; ++j) {
+      for (uInt i=0; i<nval; i++) {
+        CanonicalConversion::reverse8 (to+i, from+i);
+      }
+    }
+    timer.show("reverse8 ");
+  }
+  {
+    Timer timer;
+    for (int j=0; j<1000; ++j) {
+      Conversion::swapBytes8 (to, from, nval);
+    }
+    timer.show("swap8    ");
+  }
+  {
+    Timer timer;
+    for (int j=0; j<1000; ++j) {
+      for (uInt i=0; i<2*nval; i++) {
+        CanonicalConversion::reverse4 ((float*)to+i, (float*)from+i);
+      }
+    }
+    timer.show("reverse4 ");
+  }
+  {
+    Timer timer;
+    for (int j=0; j<1000; ++j) {
+      Conversion::swapBytes4 (to, from, 2*nval);
+    }
+    timer.show("swap4    ");
+  }
+  delete [] from;
+  delete [] to;
 }
 
 int main()
@@ -170,6 +337,8 @@ int main()
     delete [] bits;
 
     checkAll();
+    checkPartial();
+    checkSwap();
     cout << "OK" << endl;
     return 0;
 }
@@ -336,6 +336,66 @@ uInt Sort::sort (Vector<uInt>& indexVector, uInt nrrec, int opt,
     return n;
 }
 
+uInt Sort::partialSort (Vector<uInt>& indexVector, uInt nrrec,
+			uInt nrSorted, int opt) const
+{
+    // Do a full sort if most records are needed anyway.
+    if ((opt & NoDuplicates) != 0  ||  nrSorted >= nrrec/4) {
+	uInt n = sort (indexVector, nrrec, opt);
+	if (n > nrSorted) {
+	    indexVector.resize (nrSorted, True);
+	    n = nrSorted;
+	}
+	return n;
+    }
+    indexVector.resize (nrSorted);
+    if (nrSorted == 0) {
+	return 0;
+    }
+    Bool del;
+    uInt* heap = indexVector.getStorage (del);
+    // Build a heap of the first records, where the top is the record
+    // coming last. A following record replaces the top if it comes
+    // before the top.
+    for (uInt i=0; i<nrSorted; i++) {
+	heap[i] = i;
+    }
+    for (uInt i=nrSorted/2; i>0; i--) {
+	siftDownLast (i-1, nrSorted, heap);
+    }
+    for (uInt i=nrSorted; i<nrrec; i++) {
+	if (compare (i, heap[0]) > 0) {
+	    heap[0] = i;
+	    siftDownLast (0, nrSorted, heap);
+	}
+    }
+    // Sort the remaining records.
+    // compare uses the index as the last key, so the order is the same as
+    // for a full sort.
+    qkSort (nrSorted, heap);
+    insSort (nrSorted, heap);
+    indexVector.putStorage (heap, del);
+    return nrSorted;
+}
+
+void Sort::siftDownLast (uInt i, uInt nr, uInt* heap) const
+{
+    uInt sav = heap[i];
+    uInt c;
+    while ((c = 2*i+1) < nr) {
+	// Take the child coming last.
+	if (c+1 < nr  &&  compare (heap[c], heap[c+1]) > 0) {
+	    c++;
+	}
+	if (compare (sav, heap[c]) <= 0) {
+	    break;
+	}
+	heap[i] = heap[c];
+	i = c;
+    }
+    heap[i] = sav;
+}
+
 uInt Sort::parSort (int nthr, uInt nrrec, uInt* inx) const
 {
   Block<uInt> index(nrrec+1);
@@ -330,6 +330,20 @@ public:
     uInt sort (Vector<uInt>& indexVector, uInt nrrec,
 	       int options = DefaultSort, Bool tryGenSort = True) const;
 
+    // Partially sort the data array of <src>nrrec</src> records.
+    // It gives the indices of the first <src>nrSorted</src> records
+    // in the requested order, thus the same as the first part of the
+    // result of function <src>sort</src>. The indices array is resized
+    // to the number of indices returned (which is
+    // <src>min(nrSorted,nrrec)</src>).
+    // <br>If <src>nrSorted</src> is small compared to <src>nrrec</src>, a
+    // bounded heap holding the <src>nrSorted</src> first records found
+    // so far is used, which takes O(nrrec*log(nrSorted)) time.
+    // Otherwise (or if option <src>NoDuplicates</src> is given) a full
+    // sort is done using the given options.
+    uInt partialSort (Vector<uInt>& indexVector, uInt nrrec, uInt nrSorted,
+		      int options = DefaultSort) const;
+
     // Get all unique records in a sorted array. The array order is
     // given in the indexVector (as possibly returned by the sort function).
     // The default indexVector is 0..nrrec-1.
@@ -388,6 +402,10 @@ private:
     // Siftdown algorithm for heapsort.
     void siftDown (Int low, Int up, uInt* indices) const;
 
+    // Siftdown algorithm for the bounded heap used in partialSort.
+    // The top of the heap is the record coming last in the sort order.
+    void siftDownLast (uInt i, uInt nr, uInt* heap) const;
+
     // Compare the keys of 2 records.
     int compare (uInt index1, uInt index2) const;
 
@@ -233,6 +233,47 @@ void sortall (int options, Sort::Order order)
     sortdo (options, sort2, order, data, nrdata);
 }
 
+// Check that a partial sort gives the first part of a full sort.
+void checkPartial (Sort::Order order)
+{
+    const uInt nrdata = 1000;
+    Int data[nrdata];
+    Double data2[nrdata];
+    for (uInt i=0; i<nrdata; i++) {
+      data[i] = rand()%50;
+      data2[i] = rand()%7;
+    }
+    Sort sort;
+    sort.sortKey (data, TpInt, 0, order);
+    Sort sort2;
+    sort2.sortKey (data, TpInt, 0, order);
+    sort2.sortKey (data2, TpDouble, 0, Sort::Descending);
+    Vector<uInt> inx, inx2, pinx, pinx2;
+    sort.sort (inx, nrdata, Sort::HeapSort);
+    sort2.sort (inx2, nrdata, Sort::HeapSort);
+    uInt nrs[] = {0, 1, 2, 10, 17, 249, 250, 999, 1000, 2000};
+    for (uInt j=0; j<sizeof(nrs)/sizeof(uInt); j++) {
+      uInt nr = nrs[j];
+      uInt nrexp = std::min(nr, nrdata);
+      AlwaysAssertExit (sort.partialSort (pinx, nrdata, nr) == nrexp);
+      AlwaysAssertExit (sort2.partialSort (pinx2, nrdata, nr) == nrexp);
+      AlwaysAssertExit (pinx.nelements() == nrexp);
+      AlwaysAssertExit (pinx2.nelements() == nrexp);
+      for (uInt i=0; i<nrexp; i++) {
+        AlwaysAssertExit (pinx[i] == inx[i]);
+        AlwaysAssertExit (pinx2[i] == inx2[i]);
+      }
+    }
+    // With NoDuplicates a full sort is done.
+    uInt nr = sort.sort (inx, nrdata, Sort::NoDuplicates);
+    AlwaysAssertExit (sort.partialSort (pinx, nrdata, 10,
+                                        Sort::NoDuplicates) == 10);
+    AlwaysAssertExit (nr == 50);
+    for (uInt i=0; i<10; i++) {
+      AlwaysAssertExit (pinx[i] == inx[i]);
+    }
+}
+
 
 int main()
 {
@@ -259,5 +300,8 @@ int main()
     sortall (Sort::QuickSort | Sort::NoDuplicates, Sort::Descending);
     sortall (Sort::HeapSort | Sort::NoDuplicates, Sort::Descending);
 
+    checkPartial (Sort::Ascending);
+    checkPartial (Sort::Descending);
+
     return 0;                              // exit with success status
 }
@@ -176,6 +176,51 @@ void LattStatsSpecialize::accumulate (
 	}
 }
 
+void LattStatsSpecialize::merge (
+	Double& nPts, Double& sum, Double& mean,
+	Double& nvariance, Double& variance, Double& sumSq,
+	Double otherNPts, Double otherSum, Double otherMean,
+	Double otherNVariance, Double otherSumSq
+) {
+	if (otherNPts <= 0) {
+		return;
+	}
+	// Combine the running means and variances as given by Chan et al.
+	Double n = nPts + otherNPts;
+	Double delta = otherMean - mean;
+	mean += delta*otherNPts/n;
+	nvariance += otherNVariance + delta*delta*nPts*otherNPts/n;
+	variance = (n <= 1) ? 0 : nvariance/(n-1);
+	nPts = n;
+	sum += otherSum;
+	sumSq += otherSumSq;
+}
+
+void LattStatsSpecialize::merge (
+	DComplex& nPts, DComplex& sum, DComplex& mean,
+	DComplex& nvariance, DComplex& variance, DComplex& sumSq,
+	DComplex otherNPts, DComplex otherSum, DComplex otherMean,
+	DComplex otherNVariance, DComplex otherSumSq
+) {
+	// The real and imaginary parts are accumulated independently.
+	Double rn = real(nPts), rs = real(sum), rm = real(mean);
+	Double rnv = real(nvariance), rv = real(variance), rsq = real(sumSq);
+	merge (rn, rs, rm, rnv, rv, rsq,
+	       real(otherNPts), real(otherSum), real(otherMean),
+	       real(otherNVariance), real(otherSumSq));
+	Double in = imag(nPts), is = imag(sum), im = imag(mean);
+	Double inv = imag(nvariance), iv = imag(variance), isq = imag(sumSq);
+	merge (in, is, im, inv, iv, isq,
+	       imag(otherNPts), imag(otherSum), imag(otherMean),
+	       imag(otherNVariance), imag(otherSumSq));
+	nPts = DComplex(rn, in);
+	sum = DComplex(rs, is);
+	mean = DComplex(rm, im);
+	nvariance = DComplex(rnv, inv);
+	variance = DComplex(rv, iv);
+	sumSq = DComplex(rsq, isq);
+}
+
 Double LattStatsSpecialize::getMean (Double sum, Double n)
 {
    Double tmp = 0.0;
@@ -91,6 +91,21 @@ public:
                            const Bool fixedMinMax, const Complex datum,
                            const uInt& pos, const Complex useIt);
 
+   // Merge the sums and the running mean and variance of a partial
+   // accumulation (e.g. done by another thread) into the given ones.
+   // <group>
+   static void merge (Double& nPts, Double& sum, Double& mean,
+                      Double& nvariance, Double& variance, Double& sumSq,
+                      Double otherNPts, Double otherSum, Double otherMean,
+                      Double otherNVariance, Double otherSumSq);
+   static void merge (DComplex& nPts, DComplex& sum, DComplex& mean,
+                      DComplex& nvariance, DComplex& variance,
+                      DComplex& sumSq,
+                      DComplex otherNPts, DComplex otherSum,
+                      DComplex otherMean, DComplex otherNVariance,
+                      DComplex otherSumSq);
+   // </group>
+
    static Bool hasSomePoints (Double npts);
    static Bool hasSomePoints (DComplex npts);
 //
@@ -41,6 +41,7 @@ template <class T, class U> class TiledCollapser;
 template <class T, class U> class LineCollapser;
 template <class T> class Lattice;
 template <class T> class MaskedLattice;
+template <class T> class Array;
 class LatticeProgress;
 class IPosition;
 class LatticeRegion;
@@ -97,6 +98,10 @@ class LatticeRegion;
 // so whenever possible this one should be used. Another advantage of
 // this function is that it is possible to operate per line, plane, etc.
 // or even for the entire lattice.
+// If the collapser can be cloned (see
+// <linkto class=TiledCollapser>TiledCollapser</linkto>), the tiles are
+// processed in parallel by multiple threads (if built with OpenMP).
+// The tiles are still read sequentially.
 // </ol>
 // The user has to supply a function object derived from the abstract base
 // class <linkto class=LineCollapser>LineCollapser</linkto> or 
@@ -247,6 +252,16 @@ private:
 			      const IPosition& shapeOut,
 			      const IPosition& collapseAxes,
 			      Int newOutAxis);
+
+    // Apply the collapser to all chunks in the data of a tile at the
+    // given lattice position. It is used by <src>tiledApply</src>.
+    static void processTile (TiledCollapser<T,U>& collapser,
+			     const Array<T>& cursor,
+			     const Array<Bool>& mask, Bool useMask,
+			     const IPosition& pos,
+			     const IPosition& collapseAxes, uInt collStart,
+			     const IPosition& iterAxes,
+			     const IPosition& ioMap, uInt resultAxis);
 };
 
 
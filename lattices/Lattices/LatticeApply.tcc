@@ -42,9 +42,14 @@
 #include <casa/Arrays/Vector.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/Utilities/Assert.h>
+#include <casa/Utilities/CountedPtr.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -455,6 +460,37 @@ void LatticeApply<T,U>::tiledApply (MaskedLattice<U>& latticeOut,
 	}
     }
 
+// Use a clone of the collapser for each extra thread if the collapser
+// supports it. The tiles are read sequentially (lattice access is not
+// thread-safe), but are processed in parallel in batches of a few
+// tiles per thread. Otherwise the tiles are processed one by one.
+
+    Int nthread = 1;
+#ifdef _OPENMP
+    nthread = min (omp_get_max_threads(), Int(nsteps));
+#endif
+// The clones are owned by a CountedPtr, so they are deleted in case of
+// an exception.
+    PtrBlock<TiledCollapser<T,U>*> collapsers(1, &collapser);
+    Block<CountedPtr<TiledCollapser<T,U> > > clones;
+    for (Int thr=1; thr<nthread; thr++) {
+	TiledCollapser<T,U>* clone = collapser.clone();
+	if (clone == 0) {
+	    break;
+	}
+	clones.resize (thr);
+	clones[thr-1] = clone;
+	clone->init (outShape.product());
+	collapsers.resize (thr+1);
+	collapsers[thr] = clone;
+    }
+    nthread = collapsers.nelements();
+    const uInt batchSize = (nthread == 1  ?  0 : 4*nthread);
+    Block<Array<T> >    batchData (batchSize);
+    Block<Array<Bool> > batchMask (batchSize);
+    Block<IPosition>    batchPos  (batchSize);
+    uInt nbatch = 0;
+
 // Iterate through all the tiles.
 // TileStepper is set up in such a way that the collapse axes are iterated
 // fastest. When all collapse axes are handled, thus when the iter axes
@@ -463,38 +499,79 @@ void LatticeApply<T,U>::tiledApply (MaskedLattice<U>& latticeOut,
     Bool firstTime = True;
     IPosition outPos(outDim, 0);
     IPosition iterPos(outDim, 0);
-    while (! inIter.atEnd()) {
+    while (True) {
+	const Bool atEnd = inIter.atEnd();
+	if (!atEnd) {
+	    const IPosition& pos = inIter.position();
+	    for (j=0; j<outDim; j++) {
+		if (ioMap(j) >= 0) {
+		    iterPos(j) = pos(ioMap(j));
+		}
+	    }
+	}
+	const Bool endGroup = !firstTime  &&  (atEnd  ||  outPos != iterPos);
+
+// Process the batched tiles when the batch is full or the group of tiles
+// for the current output position is complete.
+
+// An exception cannot leave a parallel region, so it is caught and
+// rethrown thereafter.
+
+	if (nbatch > 0  &&  (nbatch == batchSize  ||  endGroup)) {
+	    Bool failed = False;
+	    String errorMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+#endif
+	    for (Int k=0; k<Int(nbatch); k++) {
+		Int thr = 0;
+#ifdef _OPENMP
+		thr = omp_get_thread_num();
+#endif
+		try {
+		    processTile (*collapsers[thr], batchData[k], batchMask[k],
+				 useMask, batchPos[k], collapseAxes, collStart,
+				 iterAxes, ioMap, resultAxis);
+		} catch (std::exception& x) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeApply_tiledApply)
+#endif
+		    {
+			if (!failed) {
+			    failed = True;
+			    errorMsg = x.what();
+			}
+		    }
+		}
+	    }
+	    nbatch = 0;
+	    if (failed) {
+		throw AipsError ("LatticeApply::tiledApply: " + errorMsg);
+	    }
+	}
+	if (endGroup) {
+	    for (Int thr=1; thr<nthread; thr++) {
+		collapser.mergeAccumulator (*collapsers[thr]);
+	    }
+	    Array<U> result;
+	    Array<Bool> resultMask;
+	    collapser.endAccumulator (result, resultMask, outShape);
+	    latticeOut.putSlice (result, outPos);
+	    if (maskOut != 0) {
+		maskOut->putSlice (resultMask, outPos);
+	    }
+	}
+	if (atEnd) {
+	    break;
+	}
 
 // Calculate the size of each chunk of output data.
 // Each chunk contains the data of a tile in each IterAxis.
-// Determine the index of the first element to take from the cursor.
 
 	const Array<T>& cursor = inIter.cursor();
 	const IPosition& cursorShape = cursor.shape();
-	IPosition pos = inIter.position();
-	IPosition latPos = pos;
-	Array<Bool> mask;
-	if (useMask) {
-	    // Casting const away is innocent.
-	    ((MaskedLattice<T>&)latticeIn).getMaskSlice
-                                          (mask, Slicer(pos, cursorShape));
-	}
-	for (j=0; j<outDim; j++) {
-	    if (ioMap(j) >= 0) {
-		uInt axis = ioMap(j);
-		iterPos(j) = pos(axis);
-	    }
-	}
-	if (firstTime  ||  outPos != iterPos) {
-	    if (!firstTime) {
-		Array<U> result;
-		Array<Bool> resultMask;
-		collapser.endAccumulator (result, resultMask, outShape);
-		latticeOut.putSlice (result, outPos);
-		if (maskOut != 0) {
-		    maskOut->putSlice (resultMask, outPos);
-		}
-	    }
+	const IPosition& pos = inIter.position();
+	if (firstTime  ||  endGroup) {
 	    firstTime = False;
 	    outPos = iterPos;
 	    uInt n1 = 1;
@@ -509,103 +586,126 @@ void LatticeApply<T,U>::tiledApply (MaskedLattice<U>& latticeOut,
 		    }
 		}
 	    }
-	    collapser.initAccumulator (n1, n3);
+	    for (Int thr=0; thr<nthread; thr++) {
+		collapsers[thr]->initAccumulator (n1, n3);
+	    }
+	}
+	Array<Bool> mask;
+	if (useMask) {
+	    // Casting const away is innocent.
+	    ((MaskedLattice<T>&)latticeIn).getMaskSlice
+                                          (mask, Slicer(pos, cursorShape));
 	}
+	if (nthread == 1) {
+	    processTile (collapser, cursor, mask, useMask, pos,
+			 collapseAxes, collStart, iterAxes, ioMap, resultAxis);
+	} else {
+	    // The cursor buffer is reused by the iterator, so copy it.
+	    batchData[nbatch].reference (cursor.copy());
+	    batchMask[nbatch].reference (mask);
+	    batchPos[nbatch].resize (pos.nelements());
+	    batchPos[nbatch] = pos;
+	    nbatch++;
+	}
+	inIter++;
+	if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
+    }
+    if (tellProgress != 0) tellProgress->done();
+}
+
+
+template <class T, class U>
+void LatticeApply<T,U>::processTile (TiledCollapser<T,U>& collapser,
+				     const Array<T>& cursor,
+				     const Array<Bool>& mask, Bool useMask,
+				     const IPosition& pos,
+				     const IPosition& collapseAxes,
+				     uInt collStart,
+				     const IPosition& iterAxes,
+				     const IPosition& ioMap, uInt resultAxis)
+{
+    uInt j;
+    const IPosition& cursorShape = cursor.shape();
+    const uInt inDim = cursorShape.nelements();
+    const uInt collDim = collapseAxes.nelements();
+    const uInt iterDim = iterAxes.nelements();
+    IPosition latPos = pos;
 
 // Put the collapsed lines into an output buffer
 // Initialize the cursor position needed in the loop.
 
-	IPosition curPos (inDim, 0);
+    IPosition curPos (inDim, 0);
 
 // Determine the increment for the first collapse axes.
 // This is done by taking the difference between the adresses of two pixels
 // in the cursor (if there are 2 pixels).
 
-	IPosition chunkShape (inDim, 1);
-	for (j=0; j<collStart; j++) {
-	    const uInt axis = collapseAxes(j);
-	    chunkShape(axis) = cursorShape(axis);
-	}
-	uInt nval = chunkShape.product();
-	const uInt axis = collapseAxes(0);
-
-	IPosition p0(inDim, 0);
-	IPosition p1(inDim, 0);
-	p1[axis] = 1;
-	// general for Arrays with contiguous or non-contiguous storage.
-	uInt dataIncr = &(cursor(p1)) - &(cursor(p0));
-	uInt maskIncr = useMask ? &(mask(p1)) - &(mask(p0)) : 0;
+    IPosition chunkShape (inDim, 1);
+    for (j=0; j<collStart; j++) {
+	const uInt axis = collapseAxes(j);
+	chunkShape(axis) = cursorShape(axis);
+    }
+    uInt nval = chunkShape.product();
+    const uInt axis = collapseAxes(0);
 
-//	cout << " cursorShape " << cursorShape << endl;
-//	cout << " chunkShape  " << chunkShape << endl;
-//	cout << " incr        " << incr << endl;
-//	cout << " nval        " << nval << endl;
+    IPosition p0(inDim, 0);
+    IPosition p1(inDim, 0);
+    p1[axis] = 1;
+    // general for Arrays with contiguous or non-contiguous storage.
+    uInt dataIncr = &(cursor(p1)) - &(cursor(p0));
+    uInt maskIncr = useMask ? &(mask(p1)) - &(mask(p0)) : 0;
 
 // Iterate in the outer loop through the iterator axes.
 // Iterate in the inner loop through the collapse axes.
 
-	uInt index1 = 0;
-	uInt index3 = 0;
+    uInt index1 = 0;
+    uInt index3 = 0;
+    for (;;) {
 	for (;;) {
-	    for (;;) {
-//	        cout << curPos << ' ' << collPos << endl;
-		if (useMask) {
-		    collapser.process (index1, index3,
-				       &(cursor(curPos)), &(mask(curPos)),
-				       dataIncr, maskIncr, nval, latPos, chunkShape);
-		} else {
-		    collapser.process (index1, index3,
-				       &(cursor(curPos)), 0,
-				       dataIncr, maskIncr, nval, latPos, chunkShape);
-		}
-		// Increment a collapse axis until all axes are handled.
-		for (j=collStart; j<collDim; j++) {
-		    uInt axis = collapseAxes(j);
-		    if (++curPos(axis) < cursorShape(axis)) {
-			break;
-		    }
-		    curPos(axis) = 0;               // restart this axis
-		}
-		if (j == collDim) {
-		    break;                          // all axes are handled
-		}
+	    if (useMask) {
+		collapser.process (index1, index3,
+				   &(cursor(curPos)), &(mask(curPos)),
+				   dataIncr, maskIncr, nval, latPos, chunkShape);
+	    } else {
+		collapser.process (index1, index3,
+				   &(cursor(curPos)), 0,
+				   dataIncr, maskIncr, nval, latPos, chunkShape);
 	    }
-	
-// Increment an iteration axis until all iteration axes are handled.
-	
-	    for (j=0; j<iterDim; j++) {
-		uInt arraxis = iterAxes(j);
-		uInt axis = ioMap(arraxis);
-		++latPos(axis);
+	    // Increment a collapse axis until all axes are handled.
+	    for (j=collStart; j<collDim; j++) {
+		uInt axis = collapseAxes(j);
 		if (++curPos(axis) < cursorShape(axis)) {
-		    if (arraxis < resultAxis) {
-		        index1++;
-		    } else {
-		        index3++;
-			index1 = 0;
-		    }
 		    break;
 		}
-		curPos(axis) = 0;
-		latPos(axis) = pos(axis);
+		curPos(axis) = 0;               // restart this axis
 	    }
-	    if (j == iterDim) {
-		break;
+	    if (j == collDim) {
+		break;                          // all axes are handled
 	    }
 	}
-	inIter++;
-	if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
-    }
 
-// Write out the last output array.
-    Array<U> result;
-    Array<Bool> resultMask;
-    collapser.endAccumulator (result, resultMask, outShape);
-    latticeOut.putSlice (result, outPos);
-    if (maskOut != 0) {
-        maskOut->putSlice (resultMask, outPos);
+// Increment an iteration axis until all iteration axes are handled.
+
+	for (j=0; j<iterDim; j++) {
+	    uInt arraxis = iterAxes(j);
+	    uInt axis = ioMap(arraxis);
+	    ++latPos(axis);
+	    if (++curPos(axis) < cursorShape(axis)) {
+		if (arraxis < resultAxis) {
+		    index1++;
+		} else {
+		    index3++;
+		    index1 = 0;
+		}
+		break;
+	    }
+	    curPos(axis) = 0;
+	    latPos(axis) = pos(axis);
+	}
+	if (j == iterDim) {
+	    break;
+	}
     }
-    if (tellProgress != 0) tellProgress->done();
 }
 
 
@@ -488,6 +488,12 @@ public:
 // Can handle null mask
    virtual Bool canHandleNullMask() const {return True;};
 
+// Make a copy to be used by another thread.
+   virtual TiledCollapser<T,T>* clone() const;
+
+// Add the histograms of a clone to this one.
+   virtual void mergeAccumulator (TiledCollapser<T,T>& other);
+
 private:
     LatticeStatistics<T>* pStats_p;
     Block<T>* pHist_p;
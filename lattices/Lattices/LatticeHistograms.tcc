@@ -1284,6 +1284,10 @@ void HistTiledCollapser<T>::process (
 
    typedef typename NumericTraits<T>::PrecisionType AccumType; 
    Vector<AccumType> stats;
+// The statistics object is shared by the clones of this collapser.
+#ifdef _OPENMP
+#pragma omp critical(HistTiledCollapser_getStats)
+#endif
    pStats_p->getStats(stats, startPos, True);
 
 // Assignment from AccumType to T ok (e.g. Double to FLoat)
@@ -1340,5 +1344,25 @@ void HistTiledCollapser<T>::endAccumulator(Array<T>& result,
     delete pHist_p;
 }      
 
+template <class T>
+TiledCollapser<T,T>* HistTiledCollapser<T>::clone() const
+{
+    return new HistTiledCollapser<T> (pStats_p, nBins_p);
+}
+
+template <class T>
+void HistTiledCollapser<T>::mergeAccumulator (TiledCollapser<T,T>& other)
+{
+    HistTiledCollapser<T>& that = dynamic_cast<HistTiledCollapser<T>&>(other);
+    AlwaysAssert (that.pHist_p->nelements() == pHist_p->nelements(),
+                  AipsError);
+    T* histPtr = pHist_p->storage();
+    const T* otherPtr = that.pHist_p->storage();
+    for (uInt k=0; k<nBins_p*n1_p*n3_p; k++) {
+       *histPtr++ += *otherPtr++;
+    }
+    delete that.pHist_p;
+}
+
 } //# NAMESPACE CASA - END
 
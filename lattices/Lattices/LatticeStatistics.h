@@ -660,6 +660,12 @@ public:
 // Can handle null mask
    virtual Bool canHandleNullMask() const {return True;};
 
+// Make a copy to be used by another thread.
+   virtual TiledCollapser<T,U>* clone() const;
+
+// Merge the accumulator of a clone into this one.
+   virtual void mergeAccumulator (TiledCollapser<T,U>& other);
+
 // Find the location of the minimum and maximum data values
 // in the input lattice.
    void minMaxPos(IPosition& minPos, IPosition& maxPos);
@@ -3407,6 +3407,75 @@ void StatsTiledCollapser<T,U>::endAccumulator(Array<U>& result,
 }
 
 
+template <class T, class U>
+TiledCollapser<T,U>* StatsTiledCollapser<T,U>::clone() const
+{
+    return new StatsTiledCollapser<T,U> (range_p, noInclude_p, noExclude_p,
+                                         fixedMinMax_p);
+}
+
+template <class T, class U>
+void StatsTiledCollapser<T,U>::mergeAccumulator (TiledCollapser<T,U>& other)
+{
+    StatsTiledCollapser<T,U>& that =
+                           dynamic_cast<StatsTiledCollapser<T,U>&>(other);
+    AlwaysAssert (that.n1_p == n1_p  &&  that.n3_p == n3_p, AipsError);
+    for (uInt i=0; i<n1_p*n3_p; i++) {
+       LattStatsSpecialize::merge ((*pNPts_p)[i], (*pSum_p)[i], (*pMean_p)[i],
+                                   (*pNVariance_p)[i], (*pVariance_p)[i],
+                                   (*pSumSq_p)[i],
+                                   (*that.pNPts_p)[i], (*that.pSum_p)[i],
+                                   (*that.pMean_p)[i], (*that.pNVariance_p)[i],
+                                   (*that.pSumSq_p)[i]);
+       T& dataMin = (*pMin_p)[i];
+       T& dataMax = (*pMax_p)[i];
+       const T& otherMin = (*that.pMin_p)[i];
+       const T& otherMax = (*that.pMax_p)[i];
+       if (fixedMinMax_p) {
+// The min and max are set to the range if any chunk was processed.
+          if (otherMin == range_p(0)  &&  otherMax == range_p(1)) {
+             dataMin = otherMin;
+             dataMax = otherMax;
+          }
+       } else if (! (*that.pInitMinMax_p)[i]) {
+// Take the min and max (and their positions) from the other one
+// if it has a more extreme value.
+          Bool newMin = True;
+          Bool newMax = True;
+          if ((*pInitMinMax_p)[i]) {
+             dataMin = otherMin;
+             dataMax = otherMax;
+             (*pInitMinMax_p)[i] = False;
+          } else {
+             T minVal = LattStatsSpecialize::min(dataMin, otherMin);
+             T maxVal = LattStatsSpecialize::max(dataMax, otherMax);
+             newMin = (minVal != dataMin);
+             newMax = (maxVal != dataMax);
+             dataMin = minVal;
+             dataMax = maxVal;
+          }
+          if (newMin  &&  that.minPos_p.nelements() > 0) {
+             minPos_p.resize (that.minPos_p.nelements());
+             minPos_p = that.minPos_p;
+          }
+          if (newMax  &&  that.maxPos_p.nelements() > 0) {
+             maxPos_p.resize (that.maxPos_p.nelements());
+             maxPos_p = that.maxPos_p;
+          }
+       }
+    }
+    delete that.pSum_p;
+    delete that.pSumSq_p;
+    delete that.pNPts_p;
+    delete that.pMin_p;
+    delete that.pMax_p;
+    delete that.pInitMinMax_p;
+    delete that.pMean_p;
+    delete that.pVariance_p;
+    delete that.pNVariance_p;
+}
+
+
 template <class T, class U>
 void StatsTiledCollapser<T,U>::minMaxPos(IPosition& minPos, IPosition& maxPos)
 {
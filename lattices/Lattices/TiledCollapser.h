@@ -70,6 +70,12 @@ class IPosition;
 // <br> The main function is <src>process</src>, which needs to do the
 // calculation.
 // <br> Other functions make it possible to perform an initial check.
+// <br> Optionally the functions <src>clone</src> and
+// <src>mergeAccumulator</src> can be implemented. In that case
+// <src>tiledApply</src> divides the tiles over multiple threads (if
+// built with OpenMP) with a clone of the collapser per thread. The
+// accumulators of the clones are merged before <src>endAccumulator</src>
+// is called.
 // <p>
 // The class is Doubly templated.  Ths first template type
 // is for the data type you are processing.  The second type is
@@ -155,6 +161,23 @@ public:
     virtual void endAccumulator (Array<U>& result, 
                                  Array<Bool>& resultMask,
 				 const IPosition& shape) = 0;
+
+// Make a copy of this collapser to be used by another thread.
+// The copy must have its own accumulator, so its <src>process</src>
+// function can be called in parallel with the one of this collapser.
+// Any other shared state must be accessed in a thread-safe way.
+// <br>The default implementation returns a null pointer, which means that
+// the collapser cannot be used in parallel. In that case
+// <src>LatticeApply::tiledApply</src> processes the tiles sequentially.
+    virtual TiledCollapser<T,U>* clone() const;
+
+// Merge the accumulator of a collapser made by <src>clone</src> into
+// the accumulator of this collapser and delete the accumulator of
+// the other one. Both accumulators have been initialized with the same
+// <src>n1</src> and <src>n3</src>.
+// <br>The default implementation throws an exception, because it should
+// only be called if <src>clone</src> is implemented.
+    virtual void mergeAccumulator (TiledCollapser<T,U>& other);
 };
 
 
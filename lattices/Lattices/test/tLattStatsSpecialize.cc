@@ -120,6 +120,88 @@ int main() {
 			AlwaysAssert(maxPos == 9, AipsError);
 			*/
 		}
+		{
+			// Accumulate the samples in two parts and merge them.
+			Double nPts[2] = {0, 0};
+			Double sum[2] = {0, 0};
+			Double mean[2] = {0, 0};
+			Double nvariance[2] = {0, 0};
+			Double variance[2] = {0, 0};
+			Double sumSq[2] = {0, 0};
+			Float dataMin[2], dataMax[2];
+			Int minPos[2], maxPos[2];
+			Bool minMaxInit[2] = {True, True};
+			Bool useIt = True;
+			for (uInt i=0; i<10; i++) {
+				uInt part = (i < 3  ?  0 : 1);
+				Float datum = 2*i;
+				LattStatsSpecialize::accumulate (
+						nPts[part], sum[part], mean[part], nvariance[part],
+						variance[part], sumSq[part], dataMin[part],
+						dataMax[part], minPos[part], maxPos[part],
+						minMaxInit[part], False, datum, i, useIt
+				);
+			}
+			LattStatsSpecialize::merge (
+					nPts[0], sum[0], mean[0], nvariance[0], variance[0],
+					sumSq[0], nPts[1], sum[1], mean[1], nvariance[1], sumSq[1]
+			);
+			AlwaysAssert(nPts[0] == 10, AipsError);
+			AlwaysAssert(sum[0] == 90, AipsError);
+			AlwaysAssert(near(mean[0], 9., 1e-13), AipsError);
+			AlwaysAssert(near(variance[0], 36.6666666666, 1e-11), AipsError);
+			AlwaysAssert(sumSq[0] == 1140, AipsError);
+			// Merging an empty part does not change anything.
+			LattStatsSpecialize::merge (
+					nPts[0], sum[0], mean[0], nvariance[0], variance[0],
+					sumSq[0], 0, 0, 0, 0, 0
+			);
+			AlwaysAssert(nPts[0] == 10, AipsError);
+			AlwaysAssert(near(variance[0], 36.6666666666, 1e-11), AipsError);
+			// Merging into an empty part gives the other part.
+			Double n = 0, s = 0, m = 0, nv = 0, v = 0, sq = 0;
+			LattStatsSpecialize::merge (
+					n, s, m, nv, v, sq,
+					nPts[0], sum[0], mean[0], nvariance[0], sumSq[0]
+			);
+			AlwaysAssert(n == 10, AipsError);
+			AlwaysAssert(near(m, 9., 1e-13), AipsError);
+			AlwaysAssert(near(v, 36.6666666666, 1e-11), AipsError);
+		}
+		{
+			// The same for complex values.
+			DComplex nPts[2];
+			DComplex sum[2];
+			DComplex mean[2];
+			DComplex nvariance[2];
+			DComplex variance[2];
+			DComplex sumSq[2];
+			Complex dataMin[2], dataMax[2];
+			Int minPos[2], maxPos[2];
+			Bool minMaxInit[2] = {True, True};
+			Complex useIt(1, 1);
+			for (uInt i=0; i<10; i++) {
+				uInt part = (i < 6  ?  0 : 1);
+				Complex datum(2*i, i);
+				LattStatsSpecialize::accumulate (
+						nPts[part], sum[part], mean[part], nvariance[part],
+						variance[part], sumSq[part], dataMin[part],
+						dataMax[part], minPos[part], maxPos[part],
+						minMaxInit[part], False, datum, i, useIt
+				);
+			}
+			LattStatsSpecialize::merge (
+					nPts[0], sum[0], mean[0], nvariance[0], variance[0],
+					sumSq[0], nPts[1], sum[1], mean[1], nvariance[1], sumSq[1]
+			);
+			AlwaysAssert(nPts[0] == DComplex(10, 10), AipsError);
+			AlwaysAssert(sum[0] == DComplex(90, 45), AipsError);
+			AlwaysAssert(near(mean[0].real(), 9., 1e-13), AipsError);
+			AlwaysAssert(near(mean[0].imag(), 4.5, 1e-13), AipsError);
+			AlwaysAssert(near(variance[0].real(), 36.6666666666, 1e-11), AipsError);
+			AlwaysAssert(near(variance[0].imag(), 9.166666666, 1e-10), AipsError);
+			AlwaysAssert(sumSq[0] == DComplex(1140, 285), AipsError);
+		}
 	}
 	catch (AipsError x) {
 		cerr << "aipserror: error " << x.getMesg() << endl;
@@ -132,6 +132,8 @@ public:
     virtual void endAccumulator (Array<Int>& result,
 				 Array<Bool>& resultMask,
 				 const IPosition& shape);
+    virtual TiledCollapser<Int>* clone() const;
+    virtual void mergeAccumulator (TiledCollapser<Int>& other);
 private:
     Matrix<uInt>* itsSum1;
     Block<Int>*   itsSum2;
@@ -222,6 +224,27 @@ void MyTiledCollapser::endAccumulator (Array<Int>& result,
     delete itsNpts;
     itsNpts = 0;
 }
+TiledCollapser<Int>* MyTiledCollapser::clone() const
+{
+    return new MyTiledCollapser();
+}
+void MyTiledCollapser::mergeAccumulator (TiledCollapser<Int>& other)
+{
+    MyTiledCollapser& that = dynamic_cast<MyTiledCollapser&>(other);
+    for (uInt i=0; i<itsn3; i++) {
+        for (uInt j=0; j<itsn1; j++) {
+	    (*itsSum1)(j,i) += (*that.itsSum1)(j,i);
+	    (*itsSum2)[j + i*itsn1] += (*that.itsSum2)[j + i*itsn1];
+	    (*itsNpts)(j,i) += (*that.itsNpts)(j,i);
+	}
+    }
+    delete that.itsSum1;
+    that.itsSum1 = 0;
+    delete that.itsSum2;
+    that.itsSum2 = 0;
+    delete that.itsNpts;
+    that.itsNpts = 0;
+}
 
 
 class MyLatticeProgress : public LatticeProgress
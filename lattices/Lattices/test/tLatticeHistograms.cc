@@ -53,6 +53,7 @@ void do1DFloat (const Array<Float>& inArr,
 void do2DFloat (const Array<Float>& inArr, LogIO& os);
 void test1DFloat (LatticeHistograms<Float>& histo, const IPosition& shape, uInt nBin);
 void test2DFloat (LatticeHistograms<Float>& histo,  const IPosition& shape, uInt nBin);
+void doMergeFloat (const Array<Float>& inArr, LogIO& os, uInt nsplit);
 
 
 int main()
@@ -62,6 +63,11 @@ int main()
       LogIO os(lor);
 //
       doitFloat(os);
+//
+      Array<Float> inArr(IPosition(1,40));
+      indgen(inArr);
+      doMergeFloat (inArr, os, 20);
+      doMergeFloat (inArr, os, 7);
    } catch (AipsError x) {
      cerr << "aipserror: error " << x.getMesg() << endl;
      return 1;
@@ -244,3 +250,51 @@ void test2DFloat (LatticeHistograms<Float>& histo, const IPosition& shape, uInt
       }
    }
 }
+
+
+void doMergeFloat (const Array<Float>& inArr, LogIO& os, uInt nsplit)
+//
+// Process the data with a single HistTiledCollapser and with a clone
+// processing the second part of the data, which is merged thereafter
+// (as done by LatticeApply::tiledApply when using multiple threads).
+// The histograms must be the same.
+//
+{
+   const Vector<Float> data(inArr);
+   const uInt n = data.nelements();
+   const uInt nBin = 8;
+   const IPosition outShape(1, nBin);
+   ArrayLattice<Float> inLat(inArr);
+   SubLattice<Float> subLat(inLat);
+   LatticeStatistics<Float> stats(subLat, os, False, False);
+//
+   HistTiledCollapser<Float> serial(&stats, nBin);
+   serial.init (nBin);
+   serial.initAccumulator (1, 1);
+   serial.process (0, 0, data.data(), 0, 1, 1, nsplit,
+                   IPosition(1,0), IPosition(1,nsplit));
+   serial.process (0, 0, data.data()+nsplit, 0, 1, 1, n-nsplit,
+                   IPosition(1,nsplit), IPosition(1,n-nsplit));
+   Array<Float> serialResult;
+   Array<Bool> serialMask;
+   serial.endAccumulator (serialResult, serialMask, outShape);
+//
+   HistTiledCollapser<Float> first(&stats, nBin);
+   first.init (nBin);
+   TiledCollapser<Float,Float>* second = first.clone();
+   first.initAccumulator (1, 1);
+   second->initAccumulator (1, 1);
+   first.process (0, 0, data.data(), 0, 1, 1, nsplit,
+                  IPosition(1,0), IPosition(1,nsplit));
+   second->process (0, 0, data.data()+nsplit, 0, 1, 1, n-nsplit,
+                    IPosition(1,nsplit), IPosition(1,n-nsplit));
+   first.mergeAccumulator (*second);
+   delete second;
+   Array<Float> result;
+   Array<Bool> resultMask;
+   first.endAccumulator (result, resultMask, outShape);
+//
+   AlwaysAssertExit (allEQ (result, serialResult));
+   AlwaysAssertExit (allEQ (resultMask, serialMask));
+   AlwaysAssertExit (sum(result) == Float(n));
+}
@@ -28,6 +28,8 @@
 #include <casa/aips.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/Vector.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/Inputs/Input.h>
 #include <casa/Logging.h>
@@ -59,6 +61,7 @@ void test1DFloat (LatticeStatistics<Float>& stats, const Vector<Float>& results,
                   const Vector<Bool>& hasResult, const IPosition& shape);
 void test2DFloat (LatticeStatistics<Float>& stats, const Vector<Float>& results,
                   const Vector<Bool>& hasResult, const IPosition& shape);
+void doMergeFloat (const Vector<Float>& data, uInt nsplit);
 
 
 int main()
@@ -68,6 +71,17 @@ int main()
       LogIO os(lor);
 //
       doitFloat(os);
+//
+      Vector<Float> data(100);
+      indgen(data);
+      data(20) = 1000;
+      data(70) = -1000;
+      doMergeFloat (data, 50);
+      data(20) = -1000;
+      data(70) = 1000;
+      doMergeFloat (data, 50);
+      doMergeFloat (data, 10);
+      doMergeFloat (data, 90);
    } catch (AipsError x) {
      cerr << "aipserror: error " << x.getMesg() << endl;
      return 1;
@@ -334,3 +348,63 @@ void test2DFloat (LatticeStatistics<Float>& stats, const Vector<Float>& results,
    }
 }
 
+
+
+void doMergeFloat (const Vector<Float>& data, uInt nsplit)
+//
+// Process the data with a single StatsTiledCollapser and with a clone
+// processing the second part of the data, which is merged thereafter
+// (as done by LatticeApply::tiledApply when using multiple threads).
+// The results (including the positions of min and max) must be the same.
+//
+{
+   const uInt n = data.nelements();
+   const IPosition outShape(1, LatticeStatsBase::NACCUM);
+   Vector<Float> range(2, 0);
+   StatsTiledCollapser<Float,Double> serial(range, True, True, False);
+   serial.init (LatticeStatsBase::NACCUM);
+   serial.initAccumulator (1, 1);
+   serial.process (0, 0, data.data(), 0, 1, 1, nsplit,
+                   IPosition(1,0), IPosition(1,nsplit));
+   serial.process (0, 0, data.data()+nsplit, 0, 1, 1, n-nsplit,
+                   IPosition(1,nsplit), IPosition(1,n-nsplit));
+   Array<Double> serialResult;
+   Array<Bool> serialMask;
+   serial.endAccumulator (serialResult, serialMask, outShape);
+   IPosition serialMinPos, serialMaxPos;
+   serial.minMaxPos (serialMinPos, serialMaxPos);
+//
+   StatsTiledCollapser<Float,Double> first(range, True, True, False);
+   first.init (LatticeStatsBase::NACCUM);
+   TiledCollapser<Float,Double>* second = first.clone();
+   first.initAccumulator (1, 1);
+   second->initAccumulator (1, 1);
+   first.process (0, 0, data.data(), 0, 1, 1, nsplit,
+                  IPosition(1,0), IPosition(1,nsplit));
+   second->process (0, 0, data.data()+nsplit, 0, 1, 1, n-nsplit,
+                    IPosition(1,nsplit), IPosition(1,n-nsplit));
+   first.mergeAccumulator (*second);
+   delete second;
+   Array<Double> result;
+   Array<Bool> resultMask;
+   first.endAccumulator (result, resultMask, outShape);
+   IPosition minPos, maxPos;
+   first.minMaxPos (minPos, maxPos);
+//
+   const LatticeStatsBase::StatisticsTypes fields[] = {
+      LatticeStatsBase::NPTS, LatticeStatsBase::SUM, LatticeStatsBase::SUMSQ,
+      LatticeStatsBase::MIN, LatticeStatsBase::MAX, LatticeStatsBase::MEAN,
+      LatticeStatsBase::VARIANCE};
+   for (uInt i=0; i<7; i++) {
+      IPosition pos(1, fields[i]);
+      AlwaysAssertExit (near (result(pos), serialResult(pos), 1e-10));
+   }
+   AlwaysAssertExit (allEQ (resultMask, serialMask));
+   AlwaysAssertExit (result(IPosition(1,LatticeStatsBase::NPTS)) == n);
+   AlwaysAssertExit (result(IPosition(1,LatticeStatsBase::MIN)) == min(data));
+   AlwaysAssertExit (result(IPosition(1,LatticeStatsBase::MAX)) == max(data));
+   AlwaysAssertExit (minPos.isEqual (serialMinPos));
+   AlwaysAssertExit (maxPos.isEqual (serialMaxPos));
+   AlwaysAssertExit (data(minPos(0)) == min(data));
+   AlwaysAssertExit (data(maxPos(0)) == max(data));
+}
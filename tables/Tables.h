@@ -48,6 +48,7 @@
 #include <tables/Tables/TiledColumnStMan.h>
 #include <tables/Tables/TiledShapeStMan.h>
 #include <tables/Tables/MemoryStMan.h>
+#include <tables/Tables/CompressedStMan.h>
 
 //#   virtual column engines
 #include <tables/Tables/RetypedArrayEngine.h>
@@ -1108,6 +1109,12 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //   normal tables. Note, however, that if a table is accessed
 //   concurrently from multiple processes, MemoryStMan data cannot be
 //   synchronized.
+//
+//  <li>
+//   <linkto class="CompressedStMan:description">CompressedStMan</linkto>
+//   stores the data of scalars and fixed shaped arrays in chunks that are
+//   compressed losslessly (by default using byte shuffling and LZ4).
+//   It is meant for data that compress well, like flags and weights.
 // </ol>
 //
 // The storage manager framework makes it possible to support arbitrary files
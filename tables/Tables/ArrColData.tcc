@@ -133,16 +133,19 @@ void ArrayColumnData<T>::setShapeColumn (const IPosition& shp)
 template<class T>
 Bool ArrayColumnData<T>::isDefined (uInt rownr) const
 {
+    ConcurrentReadLock locker(*colSetPtr_p);
     return dataColPtr_p->isShapeDefined(rownr);
 }
 template<class T>
 uInt ArrayColumnData<T>::ndim (uInt rownr) const
 {
+    ConcurrentReadLock locker(*colSetPtr_p);
     return dataColPtr_p->ndim(rownr);
 }
 template<class T>
 IPosition ArrayColumnData<T>::shape (uInt rownr) const
 {
+    ConcurrentReadLock locker(*colSetPtr_p);
     return dataColPtr_p->shape(rownr);
 }
 
@@ -151,6 +154,7 @@ template<class T>
 void ArrayColumnData<T>::setShape (uInt rownr, const IPosition& shp)
 {
     checkShape (shp);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->setShape (rownr, shp);
     autoReleaseLock();
@@ -160,6 +164,7 @@ void ArrayColumnData<T>::setShape (uInt rownr, const IPosition& shp,
 				   const IPosition& tileShp)
 {
     checkShape (shp);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->setShapeTiled (rownr, shp, tileShp);
     autoReleaseLock();
@@ -200,6 +205,7 @@ void ArrayColumnData<T>::get (uInt rownr, void* arrayPtr) const
       TableTrace::trace (traceId(), columnDesc().name(), 'r', rownr,
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getArrayV (rownr, (Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -214,6 +220,7 @@ void ArrayColumnData<T>::getSlice (uInt rownr, const Slicer& ns,
                          static_cast<const Array<T>*>(arrayPtr)->shape(),
                          ns.start(), ns.end(), ns.stride());
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getSliceV (rownr, ns, (Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -228,6 +235,7 @@ void ArrayColumnData<T>::put (uInt rownr, const void* arrayPtr)
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
     checkValueLength ((const Array<T>*)arrayPtr);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putArrayV (rownr, (const Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -243,6 +251,7 @@ void ArrayColumnData<T>::putSlice (uInt rownr, const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkValueLength ((const Array<T>*)arrayPtr);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putSliceV (rownr, ns, (const Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -260,6 +269,7 @@ void ArrayColumnData<T>::getArrayColumn (void* arrayPtr) const
       TableTrace::trace (traceId(), columnDesc().name(), 'r',
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getArrayColumnV ((Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -274,6 +284,7 @@ void ArrayColumnData<T>::getArrayColumnCells (const RefRows& rownrs,
       TableTrace::trace (traceId(), columnDesc().name(), 'r', rownrs,
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getArrayColumnCellsV (rownrs, arrayPtr);
     autoReleaseLock();
@@ -288,6 +299,7 @@ void ArrayColumnData<T>::getColumnSlice (const Slicer& ns,
                          static_cast<const Array<T>*>(arrayPtr)->shape(),
                          ns.start(), ns.end(), ns.stride());
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getColumnSliceV (ns, (Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -303,6 +315,7 @@ void ArrayColumnData<T>::getColumnSliceCells (const RefRows& rownrs,
                          static_cast<const Array<T>*>(arrayPtr)->shape(),
                          ns.start(), ns.end(), ns.stride());
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getColumnSliceCellsV (rownrs, ns, arrayPtr);
     autoReleaseLock();
@@ -316,6 +329,7 @@ void ArrayColumnData<T>::putArrayColumn (const void* arrayPtr)
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
     checkValueLength ((const Array<T>*)arrayPtr);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putArrayColumnV ((const Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -330,6 +344,7 @@ void ArrayColumnData<T>::putArrayColumnCells (const RefRows& rownrs,
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
     checkValueLength ((const Array<T>*)arrayPtr);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putArrayColumnCellsV (rownrs, arrayPtr);
     autoReleaseLock();
@@ -345,6 +360,7 @@ void ArrayColumnData<T>::putColumnSlice (const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkValueLength ((const Array<T>*)arrayPtr);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putColumnSliceV (ns, (const Array<T>*)arrayPtr);
     autoReleaseLock();
@@ -361,6 +377,7 @@ void ArrayColumnData<T>::putColumnSliceCells (const RefRows& rownrs,
                          ns.start(), ns.end(), ns.stride());
     }
     checkValueLength ((const Array<T>*)arrayPtr);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putColumnSliceCellsV (rownrs, ns, arrayPtr);
     autoReleaseLock();
@@ -92,6 +92,11 @@ Bool BaseColumn::canChangeShape() const
     return False;                      // can not be changed
 }
 
+Bool BaseColumn::getRangeRows (Double, Double, Vector<uInt>&)
+{
+    return False;
+}
+
 Bool BaseColumn::canAccessScalarColumn (Bool& reask) const
 {
     reask = False;                     // By default an entire column
@@ -149,6 +149,12 @@ public:
     // Default is no.
     virtual Bool canChangeShape() const;
 
+    // Ask the data manager for the rows that might contain a value in the
+    // interval [minValue,maxValue].
+    // Default is that it cannot be done (thus False is returned).
+    virtual Bool getRangeRows (Double minValue, Double maxValue,
+                               Vector<uInt>& rownrs);
+
     // Ask if the data manager can handle a scalar column.
     // Default is never.
     virtual Bool canAccessScalarColumn (Bool& reask) const;
@@ -34,6 +34,10 @@
 #include <tables/Tables/TableDesc.h>
 #include <tables/Tables/BaseColumn.h>
 #include <tables/Tables/ExprNode.h>
+#include <tables/Tables/ExprRange.h>
+#include <tables/Tables/ColumnsIndex.h>
+#include <tables/Tables/TableColumn.h>
+#include <tables/Tables/ColumnDesc.h>
 #include <tables/Tables/BaseTabIter.h>
 #include <tables/Tables/DataManager.h>
 #include <tables/Tables/TableError.h>
@@ -52,6 +56,9 @@
 #include <casa/OS/RegularFile.h>
 #include <casa/OS/Directory.h>
 #include <casa/Utilities/Assert.h>
+#include <algorithm>
+#include <limits>
+#include <cmath>
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -68,7 +75,8 @@ BaseTable::BaseTable (const String& name, int option, uInt nrrow)
   noWrite_p   (False),
   delete_p    (False),
   madeDir_p   (True),
-  itsTraceId  (-1)
+  itsTraceId  (-1),
+  concurrentRead_p (False)
 {
     if (name_p.empty()) {
 	name_p = File::newUniqueName ("", "tab").originalName();
@@ -234,6 +242,11 @@ TableInfo BaseTable::tableInfo (const String& tableName)
 {
     return TableInfo (tableName + "/table.info");
 }
+void BaseTable::setConcurrentRead (Bool concurrentRead)
+{
+    concurrentRead_p = concurrentRead;
+}
+
 void BaseTable::getTableInfo()
 {
     AlwaysAssert (!isNull(), AipsError);
@@ -676,6 +689,153 @@ BaseTable* BaseTable::select (uInt maxRow, uInt offset)
     return select(rownrs);
 }
 
+// Define the key range in the index for the given values.
+// It returns False if no values of the data type are in the range.
+template<typename T>
+static Bool defineKeyRange (ColumnsIndex& index, Double st, Double end)
+{
+  Double maxVal = std::numeric_limits<T>::max();
+  Double minVal = -maxVal;
+  if (std::numeric_limits<T>::is_integer) {
+    minVal = std::numeric_limits<T>::min();
+    st  = std::ceil (st);
+    end = std::floor (end);
+  } else {
+    // A bound at or beyond the largest finite value (e.g. an open bound
+    // given as -/+DBL_MAX) must also find the infinite values.
+    minVal = -std::numeric_limits<T>::infinity();
+    maxVal = std::numeric_limits<T>::infinity();
+    if (st <= -std::numeric_limits<T>::max()) {
+      st = minVal;
+    }
+    if (end >= std::numeric_limits<T>::max()) {
+      end = maxVal;
+    }
+  }
+  st  = std::max (st, minVal);
+  end = std::min (end, maxVal);
+  if (st > end) {
+    return False;
+  }
+  index.accessLowerKey().define (0, T(st));
+  index.accessUpperKey().define (0, T(end));
+  return True;
+}
+
+// Use the data manager (e.g. the zone maps of StandardStMan) to find the
+// rows of a column possibly containing a value in one of the ranges.
+// The resulting row numbers are in ascending order.
+// It returns False if the data manager cannot do it.
+static Bool getZoneMapRows (const TableColumn& column,
+                            const TableExprRange& range,
+                            Vector<uInt>& rownrs)
+{
+  const Vector<Double>& st  = range.start();
+  const Vector<Double>& end = range.end();
+  if (st.nelements() == 1) {
+    return column.getRangeRows (st[0], end[0], rownrs);
+  }
+  Block<uInt> rows;
+  uInt nrow = 0;
+  for (uInt j=0; j<st.nelements(); j++) {
+    Vector<uInt> found;
+    if (! column.getRangeRows (st[j], end[j], found)) {
+      return False;
+    }
+    rows.resize (nrow + found.nelements(), True, True);
+    for (uInt k=0; k<found.nelements(); k++) {
+      rows[nrow++] = found[k];
+    }
+  }
+  nrow = genSort (rows, nrow, Sort::Ascending, Sort::NoDuplicates);
+  rownrs.resize (nrow);
+  for (uInt k=0; k<nrow; k++) {
+    rownrs[k] = rows[k];
+  }
+  return True;
+}
+
+// Use a persistent index of a column in the given table to find the rows
+// possibly matching the expression.
+// It is only done for a readonly table, otherwise the index might not
+// reflect changes not flushed yet (see class ColumnsIndex).
+// If no persistent index can be used, the zone maps of the data manager
+// are tried (which are always up-to-date).
+// The ranges of the column values derived from the expression are looked
+// up in the index. The resulting row numbers are in ascending order.
+// It returns False if no index or zone map can be used.
+static Bool getIndexedRows (const TableExprNode& node,
+                            const String& tableName, uInt nrrow,
+                            Vector<uInt>& rownrs)
+{
+  Block<TableExprRange> ranges;
+  TableExprNode expr(node);
+  expr.ranges (ranges);
+  for (uInt i=0; i<ranges.nelements(); i++) {
+    const TableColumn& column = ranges[i].getColumn();
+    Table tab = column.table();
+    if (tab.tableName() != tableName  ||  !tab.isRootTable()
+    ||  tab.nrow() != nrrow) {
+      continue;
+    }
+    Vector<String> colNames(1, column.columnDesc().name());
+    if (tab.isWritable()
+    ||  ! ColumnsIndex::hasPersistentIndex (tab, colNames)) {
+      if (getZoneMapRows (column, ranges[i], rownrs)) {
+        return True;
+      }
+      continue;
+    }
+    DataType dtype = column.columnDesc().dataType();
+    if (dtype != TpUChar  &&  dtype != TpShort  &&  dtype != TpInt
+    &&  dtype != TpUInt   &&  dtype != TpFloat  &&  dtype != TpDouble) {
+      continue;
+    }
+    ColumnsIndex index (tab, colNames);
+    const Vector<Double>& st  = ranges[i].start();
+    const Vector<Double>& end = ranges[i].end();
+    Block<uInt> rows;
+    uInt nrow = 0;
+    for (uInt j=0; j<st.nelements(); j++) {
+      Bool valid = False;
+      switch (dtype) {
+      case TpUChar:
+        valid = defineKeyRange<uChar> (index, st[j], end[j]);
+        break;
+      case TpShort:
+        valid = defineKeyRange<Short> (index, st[j], end[j]);
+        break;
+      case TpInt:
+        valid = defineKeyRange<Int> (index, st[j], end[j]);
+        break;
+      case TpUInt:
+        valid = defineKeyRange<uInt> (index, st[j], end[j]);
+        break;
+      case TpFloat:
+        valid = defineKeyRange<Float> (index, st[j], end[j]);
+        break;
+      default:
+        valid = defineKeyRange<Double> (index, st[j], end[j]);
+        break;
+      }
+      if (valid) {
+        Vector<uInt> found = index.getRowNumbers (True, True);
+        rows.resize (nrow + found.nelements(), True, True);
+        for (uInt k=0; k<found.nelements(); k++) {
+          rows[nrow++] = found[k];
+        }
+      }
+    }
+    nrow = genSort (rows, nrow, Sort::Ascending, Sort::NoDuplicates);
+    rownrs.resize (nrow);
+    for (uInt k=0; k<nrow; k++) {
+      rownrs[k] = rows[k];
+    }
+    return True;
+  }
+  return False;
+}
+
 // Do the row selection.
 BaseTable* BaseTable::select (const TableExprNode& node,
                               uInt maxRow, uInt offset)
@@ -712,27 +872,94 @@ BaseTable* BaseTable::select (const TableExprNode& node,
     //# Loop through all rows and add to reference table if true.
     //# Add the rownr of the root table (one may search a reference table).
     //# Adjust the row numbers to reflect row numbers in the root table.
+    //# The expression is evaluated for a block of rows at a time, which
+    //# makes it possible for the nodes to read the columns in bulk and
+    //# avoids a virtual function call per node per row.
+    //# Use small blocks if only a few rows are needed.
+    //# If a persistent index can be used, only the rows found in the
+    //# index need to be evaluated.
+    //# The selected rows are collected as ranges of consecutive rows, so
+    //# no vector of all row numbers is needed for a selection consisting
+    //# of a few long runs. The rows are added one by one if the ranges
+    //# would take more memory than a vector.
     SPtrHolder<RefTable> resultTable (makeRefTable (True, 0));
-    Bool val;
     uInt nrrow = nrow();
-    TableExprId id;
-    for (uInt i=0; i<nrrow; i++) {
-      id.setRownr (i);
-      node.get (id, val);
-      if (val) {
-        if (offset == 0) {
-          resultTable->addRownr (i);                  // add row
-          // Stop if max #rows reached (note that maxRow==0 means no limit).
-          if (resultTable->nrow() == maxRow) {
-            break;
+    Vector<uInt> indexRows;
+    Bool useIndex = getIndexedRows (node, name_p, nrrow, indexRows);
+    uInt nrsel = (useIndex  ?  indexRows.nelements() : nrrow);
+    uInt blockSize = 4096;
+    if (maxRow > 0  &&  maxRow + offset < blockSize) {
+      blockSize = std::max (maxRow + offset, 16u);
+    }
+    Vector<uInt> rownrs;
+    Vector<Bool> vals;
+    Block<uInt> rangeStarts;
+    Block<uInt> rangeEnds;
+    uInt nrrange = 0;
+    Bool useRanges = True;
+    uInt nrfound = 0;
+    Bool done = False;
+    for (uInt st=0; st<nrsel  &&  !done; st+=blockSize) {
+      uInt nr = std::min (blockSize, nrsel-st);
+      if (nr != rownrs.nelements()) {
+        rownrs.resize (nr);
+        vals.resize (nr);
+      }
+      if (useIndex) {
+        rownrs = indexRows(Slice(st, nr));
+      } else {
+        indgen (rownrs, st);
+      }
+      node.getBoolRows (rownrs, vals);
+      for (uInt i=0; i<nr; i++) {
+        if (vals[i]) {
+          if (offset == 0) {
+            uInt rownr = rownrs[i];
+            if (!useRanges) {
+              resultTable->addRownr (rownr);          // add row
+            } else if (nrrange > 0  &&  rownr == rangeEnds[nrrange-1] + 1) {
+              rangeEnds[nrrange-1]++;                 // extend last range
+            } else if (nrrange < 1024  ||  2*nrrange < nrfound) {
+              if (nrrange == rangeStarts.nelements()) {
+                rangeStarts.resize (std::max(64u, 2*nrrange), True, True);
+                rangeEnds.resize (rangeStarts.nelements(), True, True);
+              }
+              rangeStarts[nrrange] = rownr;           // start new range
+              rangeEnds[nrrange]   = rownr;
+              nrrange++;
+            } else {
+              // The ranges do not save memory, so add the rows instead.
+              for (uInt j=0; j<nrrange; j++) {
+                for (uInt k=rangeStarts[j]; k<=rangeEnds[j]; k++) {
+                  resultTable->addRownr (k);
+                }
+              }
+              resultTable->addRownr (rownr);
+              rangeStarts.resize (0, True, False);
+              rangeEnds.resize (0, True, False);
+              nrrange = 0;
+              useRanges = False;
+            }
+            nrfound++;
+            // Stop if max #rows reached (note that maxRow==0 means no limit).
+            if (nrfound == maxRow) {
+              done = True;
+              break;
+            }
+          } else {
+            // Skip first offset matching rows.
+            offset--;
           }
-        } else {
-          // Skip first offset matching rows.
-          offset--;
         }
       }
     }
-    adjustRownrs (resultTable->nrow(), *(resultTable->rowStorage()), False);
+    if (useRanges) {
+      resultTable->setRows (*this, rangeStarts, rangeEnds, nrrange);
+    } else {
+      adjustRownrs (resultTable->nrow(), *(resultTable->rowStorage()),
+                    False);
+      resultTable->compactRows();
+    }
     return resultTable.transfer();
 }
 
@@ -772,6 +999,15 @@ BaseTable* BaseTable::tabAnd (BaseTable* that)
 	return this;                                  // that is root
     }
     //# There is no root table involved, so we have to deal with RefTables.
+    //# If both hold their rows as ranges in row order, use the ranges.
+    RefTable* rtp1 = dynamic_cast<RefTable*>(this);
+    RefTable* rtp2 = dynamic_cast<RefTable*>(that);
+    if (rtp1 != 0  &&  rtp2 != 0  &&  rtp1->hasRowRanges()
+    &&  rtp2->hasRowRanges()  &&  rowOrder()  &&  that->rowOrder()) {
+	RefTable* rtp = makeRefTable (True, 0);
+	rtp->refAnd (*rtp1, *rtp2);
+	return rtp;
+    }
     //# Get both rownr arrays and sort them if not in row order.
     //# Sorting means that the array is allocated on the heap, which has
     //# to be deleted afterwards.
@@ -803,6 +1039,15 @@ BaseTable* BaseTable::tabOr (BaseTable* that)
 	return root();
     }
     //# There is no root table involved, so we have to deal with RefTables.
+    //# If both hold their rows as ranges in row order, use the ranges.
+    RefTable* rtp1 = dynamic_cast<RefTable*>(this);
+    RefTable* rtp2 = dynamic_cast<RefTable*>(that);
+    if (rtp1 != 0  &&  rtp2 != 0  &&  rtp1->hasRowRanges()
+    &&  rtp2->hasRowRanges()  &&  rowOrder()  &&  that->rowOrder()) {
+	RefTable* rtp = makeRefTable (True, 0);
+	rtp->refOr (*rtp1, *rtp2);
+	return rtp;
+    }
     //# Get both rownr arrays and sort them if not in row order.
     //# Sorting means that the array is allocated on the heap, which has
     //# to be deleted afterwards.
@@ -923,12 +1168,25 @@ void BaseTable::logicCheck (BaseTable* that)
 //# Get the rownrs from the reference table.
 //# Note that rowStorage() throws an exception if it is not a RefTable.
 //# Sort them if not in row order.
+//# If the RefTable holds its rows as ranges, a copy is made to avoid
+//# that the table has to store all row numbers.
 uInt BaseTable::logicRows (uInt*& inx, Bool& allsw)
 {
     AlwaysAssert (!isNull(), AipsError);
     allsw = False;
-    inx = RefTable::getStorage (*rowStorage());
     uInt nr = nrow();
+    RefTable* rtp = dynamic_cast<RefTable*>(this);
+    if (rtp != 0  &&  rtp->hasRowRanges()) {
+	Vector<uInt> rows (rowNumbers());
+	inx = new uInt[nr];
+	objcopy (inx, rows.data(), nr);
+	allsw = True;
+	if (!rowOrder()) {
+	    GenSort<uInt>::sort (inx, nr);
+	}
+	return nr;
+    }
+    inx = RefTable::getStorage (*rowStorage());
     if (!rowOrder()) {
 	//# rows are not in order, so sort them.
 	//# They have to be copied, because the original should not be changed.
@@ -37,6 +37,7 @@
 #include <casa/Utilities/CountedPtr.h>
 #include <casa/BasicSL/String.h>
 #include <casa/IO/FileLocker.h>
+#include <map>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -468,6 +469,22 @@ public:
     int traceId() const
         { return itsTraceId; }
 
+    // Set or get the concurrent read mode
+    // (implementation of Table::setConcurrentRead).
+    // The default implementation only sets the flag. Derived classes
+    // set the mode in their ColumnSet or in their underlying tables.
+    // <group>
+    virtual void setConcurrentRead (Bool concurrentRead);
+    Bool concurrentRead() const
+        { return concurrentRead_p; }
+    // </group>
+
+    // Get access to the cache telling which persistent index files
+    // (see class ColumnsIndex) exist in the table directory.
+    // It avoids testing the file system for each selection.
+    std::map<String,Bool>& persistentIndexCache()
+        { return persIndexCache_p; }
+
 
 protected:
     uInt           nrlink_p;            //# #references to this table
@@ -481,6 +498,8 @@ protected:
     TableInfo      info_p;              //# Table information (type, etc.)
     Bool           madeDir_p;           //# True = table dir has been created
     int            itsTraceId;          //# table-id for TableTrace tracing
+    Bool           concurrentRead_p;    //# True = read by multiple threads
+    std::map<String,Bool> persIndexCache_p; //# cached existence of indices
 
 
     // Do the callback for scratch tables (if callback is set).
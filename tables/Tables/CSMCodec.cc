@@ -0,0 +1,336 @@
+//# CSMCodec.cc: Lossless codecs for the Compressed Storage Manager
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <tables/Tables/CSMCodec.h>
+#include <tables/Tables/DataManError.h>
+#include <casa/stdvector.h>
+#include <cstring>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Initialize the static map of codecs.
+SimpleOrderedMap<String,CSMCodec::Ctor*> CSMCodec::theirCodecMap (0);
+MutexedInit CSMCodec::theirMutexedInit (CSMCodec::doRegisterCodecs, 0,
+                                        Mutex::Recursive);
+
+CSMCodec::~CSMCodec()
+{}
+
+void CSMCodec::doRegisterCodecs (void*)
+{
+  theirCodecMap.define ("none", CSMNoCodec::makeObject);
+  theirCodecMap.define ("lz4",  CSMLZ4Codec::makeObject);
+}
+
+void CSMCodec::registerCodec (const String& name, Ctor* func)
+{
+  theirMutexedInit.exec();
+  ScopedMutexLock lock(theirMutexedInit.mutex());
+  theirCodecMap.define (name, func);
+}
+
+CSMCodec* CSMCodec::create (const String& name)
+{
+  theirMutexedInit.exec();
+  Ctor* func;
+  {
+    ScopedMutexLock lock(theirMutexedInit.mutex());
+    func = theirCodecMap(name);
+  }
+  if (func == 0) {
+    throw DataManError ("CSMCodec: codec " + name + " is unknown");
+  }
+  return func();
+}
+
+void CSMCodec::shuffle (uChar* out, const uChar* in,
+                        uInt nelem, uInt elemSize)
+{
+  if (elemSize <= 1) {
+    memcpy (out, in, nelem);
+    return;
+  }
+  for (uInt j=0; j<elemSize; j++) {
+    const uChar* from = in + j;
+    for (uInt i=0; i<nelem; i++) {
+      *out++ = *from;
+      from += elemSize;
+    }
+  }
+}
+
+void CSMCodec::unshuffle (uChar* out, const uChar* in,
+                          uInt nelem, uInt elemSize)
+{
+  if (elemSize <= 1) {
+    memcpy (out, in, nelem);
+    return;
+  }
+  for (uInt j=0; j<elemSize; j++) {
+    uChar* to = out + j;
+    for (uInt i=0; i<nelem; i++) {
+      *to = *in++;
+      to += elemSize;
+    }
+  }
+}
+
+
+CSMNoCodec::~CSMNoCodec()
+{}
+
+String CSMNoCodec::name() const
+{
+  return "none";
+}
+
+uInt CSMNoCodec::compress (const uChar*, uInt, uChar*) const
+{
+  return 0;
+}
+
+void CSMNoCodec::decompress (const uChar* in, uInt nin,
+                             uChar* out, uInt nout) const
+{
+  if (nin != nout) {
+    throw DataManError ("CSMNoCodec: invalid data length");
+  }
+  memcpy (out, in, nout);
+}
+
+CSMCodec* CSMNoCodec::makeObject()
+{
+  return new CSMNoCodec();
+}
+
+
+//# Constants of the LZ4 block format.
+//# A match is at least 4 bytes; the last 5 bytes are always literals and
+//# the last match has to start at least 12 bytes before the end.
+#define LZ4_MINMATCH     4
+#define LZ4_LASTLITERALS 5
+#define LZ4_MFLIMIT      12
+#define LZ4_MAXOFFSET    65535
+#define LZ4_HASHLOG      14
+
+// Read 4 (unaligned) bytes.
+inline static uInt lz4Read32 (const uChar* p)
+{
+  uInt v;
+  memcpy (&v, p, sizeof(uInt));
+  return v;
+}
+
+inline static uInt lz4Hash (uInt v)
+{
+  return (v * 2654435761U) >> (32 - LZ4_HASHLOG);
+}
+
+// Write a length in the LZ4 way (255 per extra byte).
+inline static uChar* lz4PutLength (uChar* op, uInt length)
+{
+  while (length >= 255) {
+    *op++ = 255;
+    length -= 255;
+  }
+  *op++ = length;
+  return op;
+}
+
+// Write a sequence of literals followed by a match (if matchLength>=4).
+// It returns 0 if the output buffer is too small.
+static uChar* lz4PutSequence (uChar* op, const uChar* oend,
+                              const uChar* literals, uInt nlit,
+                              uInt offset, uInt matchLength)
+{
+  // Check the worst case length of the sequence.
+  if (op + 1 + nlit/255 + 1 + nlit + 2 + matchLength/255 + 1 > oend) {
+    return 0;
+  }
+  uChar* token = op++;
+  *token = 0;
+  if (nlit >= 15) {
+    *token = 15<<4;
+    op = lz4PutLength (op, nlit-15);
+  } else {
+    *token = nlit<<4;
+  }
+  memcpy (op, literals, nlit);
+  op += nlit;
+  if (matchLength >= LZ4_MINMATCH) {
+    *op++ = offset & 0xff;
+    *op++ = (offset >> 8) & 0xff;
+    uInt ml = matchLength - LZ4_MINMATCH;
+    if (ml >= 15) {
+      *token |= 15;
+      op = lz4PutLength (op, ml-15);
+    } else {
+      *token |= ml;
+    }
+  }
+  return op;
+}
+
+CSMLZ4Codec::~CSMLZ4Codec()
+{}
+
+String CSMLZ4Codec::name() const
+{
+  return "lz4";
+}
+
+uInt CSMLZ4Codec::compress (const uChar* in, uInt nin, uChar* out) const
+{
+  const uChar* ip     = in;
+  const uChar* anchor = in;
+  const uChar* iend   = in + nin;
+  uChar*       op     = out;
+  const uChar* oend   = out + nin;
+  if (nin > LZ4_MFLIMIT) {
+    const uChar* mflimit    = iend - LZ4_MFLIMIT;
+    const uChar* matchlimit = iend - LZ4_LASTLITERALS;
+    // The hash table contains the last position of a 4-byte sequence.
+    std::vector<Int> table (1<<LZ4_HASHLOG, -1);
+    while (ip < mflimit) {
+      uInt seq = lz4Read32 (ip);
+      uInt h = lz4Hash (seq);
+      Int ref = table[h];
+      table[h] = ip - in;
+      if (ref < 0  ||  ip - (in+ref) > LZ4_MAXOFFSET
+      ||  lz4Read32 (in+ref) != seq) {
+        // No match; skip faster in incompressible data.
+        ip += 1 + ((ip - anchor) >> 6);
+        continue;
+      }
+      const uChar* match = in + ref;
+      // Extend the match backwards and forwards.
+      while (ip > anchor  &&  match > in  &&  ip[-1] == match[-1]) {
+        ip--;
+        match--;
+      }
+      const uChar* mp = ip + LZ4_MINMATCH;
+      const uChar* mm = match + LZ4_MINMATCH;
+      while (mp < matchlimit  &&  *mp == *mm) {
+        mp++;
+        mm++;
+      }
+      op = lz4PutSequence (op, oend, anchor, ip-anchor, ip-match, mp-ip);
+      if (op == 0) {
+        return 0;
+      }
+      ip = mp;
+      anchor = ip;
+      // Add a position inside the match to the hash table.
+      if (ip < mflimit) {
+        table[lz4Hash (lz4Read32 (ip-2))] = ip - 2 - in;
+      }
+    }
+  }
+  // Write the last literals.
+  op = lz4PutSequence (op, oend, anchor, iend-anchor, 0, 0);
+  if (op == 0  ||  op >= oend) {
+    return 0;
+  }
+  return op - out;
+}
+
+// Read a length in the LZ4 way.
+inline static Bool lz4GetLength (const uChar*& ip, const uChar* iend,
+                                 uInt& length)
+{
+  uInt s;
+  do {
+    if (ip >= iend) {
+      return False;
+    }
+    s = *ip++;
+    length += s;
+  } while (s == 255);
+  return True;
+}
+
+void CSMLZ4Codec::decompress (const uChar* in, uInt nin,
+                              uChar* out, uInt nout) const
+{
+  const uChar* ip   = in;
+  const uChar* iend = in + nin;
+  uChar*       op   = out;
+  uChar*       oend = out + nout;
+  Bool ok = True;
+  while (ok  &&  ip < iend) {
+    uInt token = *ip++;
+    // Copy the literals.
+    uInt nlit = token >> 4;
+    if (nlit == 15) {
+      ok = lz4GetLength (ip, iend, nlit);
+    }
+    if (!ok  ||  nlit > uInt(iend-ip)  ||  nlit > uInt(oend-op)) {
+      ok = False;
+      break;
+    }
+    memcpy (op, ip, nlit);
+    op += nlit;
+    ip += nlit;
+    // The last sequence has no match.
+    if (ip == iend) {
+      break;
+    }
+    if (iend - ip < 2) {
+      ok = False;
+      break;
+    }
+    uInt offset = ip[0] | (uInt(ip[1]) << 8);
+    ip += 2;
+    uInt ml = token & 15;
+    if (ml == 15) {
+      ok = lz4GetLength (ip, iend, ml);
+    }
+    ml += LZ4_MINMATCH;
+    if (!ok  ||  offset == 0  ||  offset > uInt(op-out)
+    ||  ml > uInt(oend-op)) {
+      ok = False;
+      break;
+    }
+    // The match can overlap the output, so copy byte by byte.
+    const uChar* match = op - offset;
+    for (uInt i=0; i<ml; i++) {
+      op[i] = match[i];
+    }
+    op += ml;
+  }
+  if (!ok  ||  op != oend) {
+    throw DataManError ("CSMLZ4Codec: compressed data are corrupt");
+  }
+}
+
+CSMCodec* CSMLZ4Codec::makeObject()
+{
+  return new CSMLZ4Codec();
+}
+
+} //# NAMESPACE CASA - END
@@ -0,0 +1,196 @@
+//# CSMCodec.h: Lossless codecs for the Compressed Storage Manager
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_CSMCODEC_H
+#define TABLES_CSMCODEC_H
+
+
+//# Includes
+#include <casa/aips.h>
+#include <casa/BasicSL/String.h>
+#include <casa/Containers/SimOrdMap.h>
+#include <casa/OS/Mutex.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+
+// <summary>
+// Abstract base class for lossless codecs used by CompressedStMan
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tCompressedStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=CompressedStMan>CompressedStMan</linkto>
+// </prerequisite>
+
+// <synopsis>
+// CSMCodec defines the interface of a lossless codec compressing and
+// decompressing a buffer of bytes. It is used by
+// <linkto class=CompressedStMan>CompressedStMan</linkto> to compress
+// the chunks of its columns.
+// <p>
+// Codecs are created by name using the static function <src>create</src>.
+// The codecs <src>none</src> (no compression) and <src>lz4</src>
+// (a bundled implementation of the LZ4 block format) are always available.
+// Other codecs (e.g. using an external library) can be added by deriving
+// a class from CSMCodec and registering a function creating it using
+// <src>registerCodec</src>. Note that a table using such a codec can only
+// be read if the codec has been registered.
+// <p>
+// The class also offers the byte shuffle filter. It regroups the bytes
+// of an array of values, such that all first bytes are stored first,
+// thereafter all second bytes, etc. For numeric data that do not vary
+// much this gives long runs of equal bytes, which compress much better.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   CountedPtr<CSMCodec> codec (CSMCodec::create ("lz4"));
+//   Block<uChar> buf(nbytes);
+//   uInt n = codec->compress (data, nbytes, buf.storage());
+//   if (n > 0) {
+//     // data are compressed to n bytes.
+//   }
+// </srcblock>
+// </example>
+
+// <motivation>
+// The compression engines like CompressFloat are lossy. Data like flags,
+// weights and indices often compress very well losslessly.
+// </motivation>
+
+class CSMCodec
+{
+public:
+  // Define the signature of a function creating a codec.
+  typedef CSMCodec* Ctor();
+
+  virtual ~CSMCodec();
+
+  // Get the name of the codec (as used in <src>create</src>).
+  virtual String name() const = 0;
+
+  // Compress <src>nin</src> bytes into the output buffer, which has to
+  // have room for (at least) <src>nin</src> bytes.
+  // It returns the length of the compressed data. It returns 0 if the
+  // compressed data would not be shorter than the input, in which case
+  // the caller should store the data uncompressed.
+  // The function has to be thread-safe.
+  virtual uInt compress (const uChar* in, uInt nin, uChar* out) const = 0;
+
+  // Decompress <src>nin</src> bytes into exactly <src>nout</src> bytes.
+  // The function has to be thread-safe.
+  // <br>A DataManError exception is thrown if the data are corrupt.
+  virtual void decompress (const uChar* in, uInt nin,
+                           uChar* out, uInt nout) const = 0;
+
+  // Register a function creating the codec with the given name.
+  static void registerCodec (const String& name, Ctor* func);
+
+  // Create the codec with the given name.
+  // The caller has to delete the object.
+  // <br>A DataManError exception is thrown if the codec is unknown.
+  static CSMCodec* create (const String& name);
+
+  // Byte shuffle or unshuffle <src>nelem</src> values of
+  // <src>elemSize</src> bytes each.
+  // <group>
+  static void shuffle   (uChar* out, const uChar* in,
+                         uInt nelem, uInt elemSize);
+  static void unshuffle (uChar* out, const uChar* in,
+                         uInt nelem, uInt elemSize);
+  // </group>
+
+private:
+  // Register the standard codecs.
+  static void doRegisterCodecs (void*);
+
+  //# The map of registered codecs.
+  static SimpleOrderedMap<String,Ctor*> theirCodecMap;
+  static MutexedInit theirMutexedInit;
+};
+
+
+// <summary>
+// Codec copying the data (no compression)
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// This codec does not compress, so the data are always stored as is.
+// It is useful if only the byte shuffle is wanted or to disable
+// the compression.
+// </synopsis>
+
+class CSMNoCodec : public CSMCodec
+{
+public:
+  virtual ~CSMNoCodec();
+  virtual String name() const;
+  virtual uInt compress (const uChar* in, uInt nin, uChar* out) const;
+  virtual void decompress (const uChar* in, uInt nin,
+                           uChar* out, uInt nout) const;
+  static CSMCodec* makeObject();
+};
+
+
+// <summary>
+// Codec using the LZ4 block format
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// This codec is a bundled implementation of the LZ4 block format
+// (see http://lz4.github.io/lz4). It is a byte-oriented LZ77 variant
+// using a hash table of 4-byte sequences to find matches in the
+// previous 64 KB. It favours speed over compression ratio; in particular
+// decompression is very fast.
+// </synopsis>
+
+class CSMLZ4Codec : public CSMCodec
+{
+public:
+  virtual ~CSMLZ4Codec();
+  virtual String name() const;
+  virtual uInt compress (const uChar* in, uInt nin, uChar* out) const;
+  virtual void decompress (const uChar* in, uInt nin,
+                           uChar* out, uInt nout) const;
+  static CSMCodec* makeObject();
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -0,0 +1,518 @@
+//# CSMColumn.cc: A column in the Compressed Storage Manager
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <tables/Tables/CSMColumn.h>
+#include <tables/Tables/CompressedStMan.h>
+#include <tables/Tables/CSMCodec.h>
+#include <tables/Tables/DataManError.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/Containers/BlockIO.h>
+#include <casa/BasicSL/Complex.h>
+#include <casa/BasicMath/Math.h>
+#include <casa/IO/AipsIO.h>
+#include <casa/IO/BucketFile.h>
+#include <casa/Utilities/ValType.h>
+#include <cstring>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+CSMColumn::CSMColumn (CompressedStMan* aParent, int aDataType, Bool isArray)
+: StManColumn      (aDataType),
+  itsStMan         (aParent),
+  itsIsArray       (isArray),
+  itsNrElem        (1),
+  itsRowSize       (0),
+  itsRowsPerChunk  (1),
+  itsChunkSize     (0),
+  itsExtLength     (0),
+  itsNrConvert     (0),
+  itsShuffleSize   (1),
+  itsReadFunc      (0),
+  itsWriteFunc     (0),
+  itsChunkNr       (-1),
+  itsDirty         (False)
+{
+  itsRowSize = ValType::getTypeSize (static_cast<DataType>(aDataType));
+}
+
+CSMColumn::~CSMColumn()
+{}
+
+void CSMColumn::setShapeColumn (const IPosition& aShape)
+{
+  itsShape   = aShape;
+  itsNrElem  = aShape.product();
+  itsRowSize = itsNrElem *
+               ValType::getTypeSize (static_cast<DataType>(dataType()));
+}
+
+uInt CSMColumn::ndim (uInt)
+{
+  return itsShape.nelements();
+}
+
+IPosition CSMColumn::shape (uInt)
+{
+  return itsShape;
+}
+
+Bool CSMColumn::canAccessScalarColumn (Bool& reask) const
+{
+  reask = False;
+  return True;
+}
+Bool CSMColumn::canAccessArrayColumn (Bool& reask) const
+{
+  reask = False;
+  return True;
+}
+Bool CSMColumn::canAccessSlice (Bool& reask) const
+{
+  reask = False;
+  return True;
+}
+
+
+void CSMColumn::init()
+{
+  DataType aDT = static_cast<DataType>(dataType());
+  uInt nrValues = itsRowsPerChunk * itsNrElem;
+  itsChunkSize = itsRowsPerChunk * itsRowSize;
+  if (aDT == TpBool) {
+    // Bools are stored as bits, so shuffling is useless.
+    itsNrConvert   = nrValues;
+    itsExtLength   = (nrValues + 7) / 8;
+    itsShuffleSize = 1;
+    itsReadFunc    = &Conversion::bitToBool;
+    itsWriteFunc   = &Conversion::boolToBit;
+  } else {
+    uInt aNRel;
+    ValType::getCanonicalFunc (aDT, itsReadFunc, itsWriteFunc, aNRel,
+                               itsStMan->bigEndian());
+    uInt extSize = ValType::getCanonicalSize (aDT, itsStMan->bigEndian());
+    itsNrConvert = nrValues * aNRel;
+    itsExtLength = nrValues * extSize;
+    // Complex values are shuffled as pairs of float or double.
+    itsShuffleSize = (itsStMan->shuffle()  ?  extSize / aNRel : 1);
+  }
+  itsChunk.resize (itsChunkSize, True, False);
+  itsChunkNr = -1;
+  itsDirty   = False;
+  columnCache().invalidate();
+}
+
+void CSMColumn::doCreate (uInt aNrRows)
+{
+  if (itsIsArray  &&  itsShape.nelements() == 0) {
+    throw DataManError ("CompressedStMan can only handle fixed shaped "
+                        "arrays (column " + columnName() + ")");
+  }
+  itsRowsPerChunk = max (uInt(1), itsStMan->chunkSize() / max(uInt(1),
+                                                               itsRowSize));
+  init();
+  uInt nrch = nrChunks (aNrRows);
+  itsOffset.resize (nrch, True, False);
+  itsLength.resize (nrch, True, False);
+  itsAllocated.resize (nrch, True, False);
+  itsOffset    = Int64(-1);
+  itsLength    = uInt(0);
+  itsAllocated = uInt(0);
+}
+
+void CSMColumn::addRow (uInt aNewNrRows, uInt anOldNrRows)
+{
+  // The new rows in the last chunk are already zero.
+  uInt nrold = nrChunks (anOldNrRows);
+  uInt nrch  = nrChunks (aNewNrRows);
+  if (nrch > nrold) {
+    itsOffset.resize (nrch);
+    itsLength.resize (nrch);
+    itsAllocated.resize (nrch);
+    for (uInt i=nrold; i<nrch; i++) {
+      itsOffset[i]    = -1;
+      itsLength[i]    = 0;
+      itsAllocated[i] = 0;
+    }
+  }
+}
+
+void CSMColumn::remove (uInt aRowNr)
+{
+  columnCache().invalidate();
+  uInt nrrow = itsStMan->nrow();
+  uInt first = aRowNr / itsRowsPerChunk;
+  uInt last  = nrChunks (nrrow+1) - 1;
+  Block<char> nextRow (itsRowSize);
+  // Shift the rows after the removed row, one chunk at a time.
+  // The first row of the next chunk moves to the end of the chunk.
+  for (uInt i=first; i<=last; i++) {
+    if (i < last) {
+      memcpy (nextRow.storage(), getRowPtr ((i+1) * itsRowsPerChunk, False),
+              itsRowSize);
+    } else {
+      memset (nextRow.storage(), 0, itsRowSize);
+    }
+    char* data = getRowPtr (i * itsRowsPerChunk, True);
+    uInt start = (i == first  ?  aRowNr - i * itsRowsPerChunk : 0);
+    memmove (data + start * itsRowSize, data + (start+1) * itsRowSize,
+             (itsRowsPerChunk - start - 1) * itsRowSize);
+    memcpy (data + (itsRowsPerChunk-1) * itsRowSize, nextRow.storage(),
+            itsRowSize);
+  }
+  // Remove the last chunk if it has become empty.
+  uInt nrch = nrChunks (nrrow);
+  if (nrch <= last) {
+    if (itsChunkNr >= Int(nrch)) {
+      itsChunkNr = -1;
+      itsDirty   = False;
+    }
+    itsOffset.resize (nrch, True, True);
+    itsLength.resize (nrch, True, True);
+    itsAllocated.resize (nrch, True, True);
+  }
+}
+
+
+void CSMColumn::putIndex (AipsIO& anOs) const
+{
+  uInt nrch = nrChunks (itsStMan->nrow());
+  anOs << itsRowsPerChunk;
+  putBlock (anOs, itsOffset, nrch);
+  putBlock (anOs, itsLength, nrch);
+  putBlock (anOs, itsAllocated, nrch);
+}
+
+void CSMColumn::getIndex (AipsIO& anOs)
+{
+  anOs >> itsRowsPerChunk;
+  getBlock (anOs, itsOffset);
+  getBlock (anOs, itsLength);
+  getBlock (anOs, itsAllocated);
+  init();
+}
+
+
+char* CSMColumn::getRowPtr (uInt aRowNr, Bool forPut)
+{
+  uInt chunkNr = aRowNr / itsRowsPerChunk;
+  if (Int(chunkNr) != itsChunkNr) {
+    readChunk (chunkNr);
+  }
+  if (forPut) {
+    itsDirty = True;
+  }
+  return itsChunk.storage() + (aRowNr - chunkNr * itsRowsPerChunk) *
+                              itsRowSize;
+}
+
+void CSMColumn::readChunk (uInt aChunkNr)
+{
+  flushChunk();
+  columnCache().invalidate();
+  itsChunkNr = -1;
+  Block<uChar> buf (itsLength[aChunkNr]);
+  if (itsLength[aChunkNr] > 0) {
+    readRaw (aChunkNr, buf.storage());
+  }
+  decode (buf.storage(), itsLength[aChunkNr], itsChunk.storage());
+  itsChunkNr = aChunkNr;
+}
+
+void CSMColumn::flushChunk()
+{
+  if (itsDirty  &&  itsChunkNr >= 0) {
+    Block<uChar> buf (itsExtLength);
+    uInt length = encode (itsChunk.storage(), buf.storage());
+    writeRaw (itsChunkNr, buf.storage(), length);
+  }
+  itsDirty = False;
+}
+
+void CSMColumn::dropChunk()
+{
+  columnCache().invalidate();
+  itsChunkNr = -1;
+  itsDirty   = False;
+}
+
+void CSMColumn::readRaw (uInt aChunkNr, uChar* aBuf)
+{
+  BucketFile* file = itsStMan->file();
+  file->seek (itsOffset[aChunkNr]);
+  file->read (aBuf, itsLength[aChunkNr]);
+}
+
+void CSMColumn::writeRaw (uInt aChunkNr, const uChar* aBuf, uInt aLength)
+{
+  if (aLength > 0) {
+    if (itsOffset[aChunkNr] < 0  ||  aLength > itsAllocated[aChunkNr]) {
+      itsOffset[aChunkNr]    = itsStMan->allocate (aLength);
+      itsAllocated[aChunkNr] = aLength;
+    }
+    BucketFile* file = itsStMan->file();
+    file->seek (itsOffset[aChunkNr]);
+    file->write (aBuf, aLength);
+  }
+  itsLength[aChunkNr] = aLength;
+  itsStMan->setHasPut();
+}
+
+void CSMColumn::decode (const uChar* anInBuf, uInt aLength,
+                        char* aChunk) const
+{
+  if (aLength == 0) {
+    memset (aChunk, 0, itsChunkSize);
+    return;
+  }
+  // A chunk having the full length is stored uncompressed.
+  if (aLength > itsExtLength) {
+    throw DataManError ("CompressedStMan: invalid chunk length");
+  }
+  Block<uChar> ext;
+  const uChar* data = anInBuf;
+  if (aLength < itsExtLength) {
+    ext.resize (itsExtLength);
+    itsStMan->codec().decompress (anInBuf, aLength,
+                                  ext.storage(), itsExtLength);
+    data = ext.storage();
+  }
+  Block<uChar> unshuffled;
+  if (itsShuffleSize > 1) {
+    unshuffled.resize (itsExtLength);
+    CSMCodec::unshuffle (unshuffled.storage(), data,
+                         itsExtLength / itsShuffleSize, itsShuffleSize);
+    data = unshuffled.storage();
+  }
+  itsReadFunc (aChunk, data, itsNrConvert);
+}
+
+uInt CSMColumn::encode (const char* aChunk, uChar* anOutBuf) const
+{
+  if (itsExtLength == 0) {
+    return 0;
+  }
+  Block<uChar> ext (itsExtLength);
+  itsWriteFunc (ext.storage(), aChunk, itsNrConvert);
+  const uChar* data = ext.storage();
+  Block<uChar> shuffled;
+  if (itsShuffleSize > 1) {
+    shuffled.resize (itsExtLength);
+    CSMCodec::shuffle (shuffled.storage(), data,
+                       itsExtLength / itsShuffleSize, itsShuffleSize);
+    data = shuffled.storage();
+  }
+  uInt length = itsStMan->codec().compress (data, itsExtLength, anOutBuf);
+  if (length == 0) {
+    memcpy (anOutBuf, data, itsExtLength);
+    length = itsExtLength;
+  }
+  return length;
+}
+
+
+void CSMColumn::getColumnData (char* aData)
+{
+  // Make sure the file contains the latest data.
+  flushChunk();
+  uInt nrrow = itsStMan->nrow();
+  uInt nrch  = nrChunks (nrrow);
+  // Reading the file is done sequentially.
+  Block<uInt64> pos (nrch+1);
+  pos[0] = 0;
+  for (uInt i=0; i<nrch; i++) {
+    pos[i+1] = pos[i] + itsLength[i];
+  }
+  Block<uChar> buf (pos[nrch]);
+  for (uInt i=0; i<nrch; i++) {
+    if (itsLength[i] > 0) {
+      readRaw (i, buf.storage() + pos[i]);
+    }
+  }
+  // Decompress the chunks in parallel.
+  // An exception cannot leave a parallel region, so keep its message.
+  String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (Int i=0; i<Int(nrch); i++) {
+    try {
+      uInt startRow = i * itsRowsPerChunk;
+      uInt nr = min (itsRowsPerChunk, nrrow - startRow);
+      char* target = aData + size_t(startRow) * itsRowSize;
+      if (nr == itsRowsPerChunk) {
+        decode (buf.storage() + pos[i], itsLength[i], target);
+      } else {
+        Block<char> chunk (itsChunkSize);
+        decode (buf.storage() + pos[i], itsLength[i], chunk.storage());
+        memcpy (target, chunk.storage(), size_t(nr) * itsRowSize);
+      }
+    } catch (AipsError& x) {
+#ifdef _OPENMP
+#pragma omp critical(CSMColumn_getColumnData)
+#endif
+      errMsg = x.getMesg();
+    }
+  }
+  if (! errMsg.empty()) {
+    throw DataManError (errMsg);
+  }
+}
+
+void CSMColumn::putColumnData (const char* aData)
+{
+  // All chunks are rewritten, so the chunk in memory can be discarded.
+  dropChunk();
+  uInt nrrow = itsStMan->nrow();
+  uInt nrch  = nrChunks (nrrow);
+  Block<uChar> buf (size_t(nrch) * itsExtLength);
+  Block<uInt>  length (nrch);
+  // Compress the chunks in parallel.
+  String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (Int i=0; i<Int(nrch); i++) {
+    try {
+      uInt startRow = i * itsRowsPerChunk;
+      uInt nr = min (itsRowsPerChunk, nrrow - startRow);
+      const char* source = aData + size_t(startRow) * itsRowSize;
+      uChar* out = buf.storage() + size_t(i) * itsExtLength;
+      if (nr == itsRowsPerChunk) {
+        length[i] = encode (source, out);
+      } else {
+        // Pad the last chunk with zeroes.
+        Block<char> chunk (itsChunkSize);
+        memcpy (chunk.storage(), source, size_t(nr) * itsRowSize);
+        memset (chunk.storage() + size_t(nr) * itsRowSize, 0,
+                itsChunkSize - size_t(nr) * itsRowSize);
+        length[i] = encode (chunk.storage(), out);
+      }
+    } catch (AipsError& x) {
+#ifdef _OPENMP
+#pragma omp critical(CSMColumn_putColumnData)
+#endif
+      errMsg = x.getMesg();
+    }
+  }
+  if (! errMsg.empty()) {
+    throw DataManError (errMsg);
+  }
+  // Writing the file is done sequentially.
+  for (uInt i=0; i<nrch; i++) {
+    writeRaw (i, buf.storage() + size_t(i) * itsExtLength, length[i]);
+  }
+}
+
+
+//# Define the get/put functions for all data types.
+#define CSMCOLUMN_GETPUT(T,NM) \
+void CSMColumn::aips_name2(get,NM) (uInt aRowNr, T* aValue) \
+{ \
+  *aValue = *(const T*)(getRowPtr (aRowNr, False)); \
+  uInt start = itsChunkNr * itsRowsPerChunk; \
+  uInt end = min (start + itsRowsPerChunk, itsStMan->nrow()); \
+  columnCache().set (start, end-1, itsChunk.storage()); \
+} \
+void CSMColumn::aips_name2(put,NM) (uInt aRowNr, const T* aValue) \
+{ \
+  *(T*)(getRowPtr (aRowNr, True)) = *aValue; \
+} \
+void CSMColumn::aips_name2(getScalarColumn,NM) (Vector<T>* aDataPtr) \
+{ \
+  Bool deleteIt; \
+  T* data = aDataPtr->getStorage (deleteIt); \
+  getColumnData ((char*)data); \
+  aDataPtr->putStorage (data, deleteIt); \
+} \
+void CSMColumn::aips_name2(putScalarColumn,NM) (const Vector<T>* aDataPtr) \
+{ \
+  Bool deleteIt; \
+  const T* data = aDataPtr->getStorage (deleteIt); \
+  putColumnData ((const char*)data); \
+  aDataPtr->freeStorage (data, deleteIt); \
+} \
+void CSMColumn::aips_name2(getArray,NM) (uInt aRowNr, Array<T>* anArray) \
+{ \
+  Bool deleteIt; \
+  T* data = anArray->getStorage (deleteIt); \
+  memcpy (data, getRowPtr (aRowNr, False), itsRowSize); \
+  anArray->putStorage (data, deleteIt); \
+} \
+void CSMColumn::aips_name2(putArray,NM) (uInt aRowNr, \
+                                         const Array<T>* anArray) \
+{ \
+  Bool deleteIt; \
+  const T* data = anArray->getStorage (deleteIt); \
+  memcpy (getRowPtr (aRowNr, True), data, itsRowSize); \
+  anArray->freeStorage (data, deleteIt); \
+} \
+void CSMColumn::aips_name2(getSlice,NM) (uInt aRowNr, const Slicer& aSlicer, \
+                                         Array<T>* anArray) \
+{ \
+  Array<T> tabarr (itsShape, (T*)(getRowPtr (aRowNr, False)), SHARE); \
+  IPosition blc, trc, inc; \
+  aSlicer.inferShapeFromSource (itsShape, blc, trc, inc); \
+  *anArray = tabarr(blc, trc, inc); \
+} \
+void CSMColumn::aips_name2(putSlice,NM) (uInt aRowNr, const Slicer& aSlicer, \
+                                         const Array<T>* anArray) \
+{ \
+  Array<T> tabarr (itsShape, (T*)(getRowPtr (aRowNr, True)), SHARE); \
+  IPosition blc, trc, inc; \
+  aSlicer.inferShapeFromSource (itsShape, blc, trc, inc); \
+  tabarr(blc, trc, inc) = *anArray; \
+} \
+void CSMColumn::aips_name2(getArrayColumn,NM) (Array<T>* anArray) \
+{ \
+  Bool deleteIt; \
+  T* data = anArray->getStorage (deleteIt); \
+  getColumnData ((char*)data); \
+  anArray->putStorage (data, deleteIt); \
+} \
+void CSMColumn::aips_name2(putArrayColumn,NM) (const Array<T>* anArray) \
+{ \
+  Bool deleteIt; \
+  const T* data = anArray->getStorage (deleteIt); \
+  putColumnData ((const char*)data); \
+  anArray->freeStorage (data, deleteIt); \
+}
+
+CSMCOLUMN_GETPUT(Bool,BoolV)
+CSMCOLUMN_GETPUT(uChar,uCharV)
+CSMCOLUMN_GETPUT(Short,ShortV)
+CSMCOLUMN_GETPUT(uShort,uShortV)
+CSMCOLUMN_GETPUT(Int,IntV)
+CSMCOLUMN_GETPUT(uInt,uIntV)
+CSMCOLUMN_GETPUT(float,floatV)
+CSMCOLUMN_GETPUT(double,doubleV)
+CSMCOLUMN_GETPUT(Complex,ComplexV)
+CSMCOLUMN_GETPUT(DComplex,DComplexV)
+
+} //# NAMESPACE CASA - END
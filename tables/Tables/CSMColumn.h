@@ -0,0 +1,376 @@
+//# CSMColumn.h: A column in the Compressed Storage Manager
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_CSMCOLUMN_H
+#define TABLES_CSMCOLUMN_H
+
+
+//# Includes
+#include <casa/aips.h>
+#include <tables/Tables/StManColumn.h>
+#include <casa/Arrays/IPosition.h>
+#include <casa/Containers/Block.h>
+#include <casa/OS/Conversion.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Forward Declarations
+class CompressedStMan;
+class AipsIO;
+
+
+// <summary>
+// A column in the Compressed Storage Manager
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tCompressedStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=CompressedStMan>CompressedStMan</linkto>
+//   <li> <linkto class=CSMCodec>CSMCodec</linkto>
+// </prerequisite>
+
+// <etymology>
+// CSMColumn represents a Column in the Compressed Storage Manager.
+// </etymology>
+
+// <synopsis>
+// CSMColumn handles the access to a scalar or fixed shaped array column
+// in a <linkto class=CompressedStMan>CompressedStMan</linkto>.
+// <p>
+// The values of a column are stored in chunks of a fixed number of rows.
+// Each chunk is converted to canonical format, byte shuffled (if
+// required) and compressed with the codec of the storage manager.
+// A Bool chunk is stored as bits. If a chunk does not compress,
+// it is stored as is. The position and length of each chunk in the data
+// file are kept in an index that is written by the storage manager.
+// <p>
+// One uncompressed chunk is held in memory. It is written back when
+// another chunk is needed or when the storage manager is flushed.
+// For scalar columns the column cache is set to the chunk, so scalar
+// gets of rows in that chunk do not need a virtual function call.
+// <br>Getting or putting an entire column (de)compresses the chunks in
+// parallel if OpenMP is used.
+// </synopsis>
+
+// <motivation>
+// CSMColumn handles the compression and caching of a single column,
+// so CompressedStMan only needs to manage the file and the index.
+// </motivation>
+
+//# <todo asof="$DATE:$">
+//# A List of bugs, limitations, extensions or planned refinements.
+//#   <li> Support variable shaped arrays and strings.
+//# </todo>
+
+
+class CSMColumn : public StManColumn
+{
+public:
+  // Create a CSMColumn object with the given parent.
+  // It initializes the various variables.
+  CSMColumn (CompressedStMan* aParent, int aDataType, Bool isArray);
+
+  ~CSMColumn();
+
+  // Set the shape of an array in the column.
+  // It is only called (right after the constructor) if the array has
+  // a fixed shape.
+  virtual void setShapeColumn (const IPosition& aShape);
+
+  // Get the dimensionality of the item in the given row.
+  virtual uInt ndim (uInt aRowNr);
+
+  // Get the shape of the array in the given row.
+  virtual IPosition shape (uInt aRowNr);
+
+  // The column can handle access to an entire column, a slice of a cell
+  // and to an entire array column.
+  // <group>
+  virtual Bool canAccessScalarColumn (Bool& reask) const;
+  virtual Bool canAccessArrayColumn (Bool& reask) const;
+  virtual Bool canAccessSlice (Bool& reask) const;
+  // </group>
+
+  // Get a scalar value in the given row.
+  // The buffer pointed to by dataPtr has to have the correct length
+  // (which is guaranteed by the Scalar/ArrayColumn get function).
+  // <group>
+  virtual void getBoolV     (uInt aRowNr, Bool* aDataPtr);
+  virtual void getuCharV    (uInt aRowNr, uChar* aDataPtr);
+  virtual void getShortV    (uInt aRowNr, Short* aDataPtr);
+  virtual void getuShortV   (uInt aRowNr, uShort* aDataPtr);
+  virtual void getIntV      (uInt aRowNr, Int* aDataPtr);
+  virtual void getuIntV     (uInt aRowNr, uInt* aDataPtr);
+  virtual void getfloatV    (uInt aRowNr, float* aDataPtr);
+  virtual void getdoubleV   (uInt aRowNr, double* aDataPtr);
+  virtual void getComplexV  (uInt aRowNr, Complex* aDataPtr);
+  virtual void getDComplexV (uInt aRowNr, DComplex* aDataPtr);
+  // </group>
+
+  // Put a scalar value in the given row.
+  // <group>
+  virtual void putBoolV     (uInt aRowNr, const Bool* aDataPtr);
+  virtual void putuCharV    (uInt aRowNr, const uChar* aDataPtr);
+  virtual void putShortV    (uInt aRowNr, const Short* aDataPtr);
+  virtual void putuShortV   (uInt aRowNr, const uShort* aDataPtr);
+  virtual void putIntV      (uInt aRowNr, const Int* aDataPtr);
+  virtual void putuIntV     (uInt aRowNr, const uInt* aDataPtr);
+  virtual void putfloatV    (uInt aRowNr, const float* aDataPtr);
+  virtual void putdoubleV   (uInt aRowNr, const double* aDataPtr);
+  virtual void putComplexV  (uInt aRowNr, const Complex* aDataPtr);
+  virtual void putDComplexV (uInt aRowNr, const DComplex* aDataPtr);
+  // </group>
+
+  // Get or put all scalar values in the column.
+  // The vector given in <src>aDataPtr</src> has to have the correct length
+  // (which is guaranteed by the ScalarColumn getColumn function).
+  // <group>
+  virtual void getScalarColumnBoolV     (Vector<Bool>* aDataPtr);
+  virtual void getScalarColumnuCharV    (Vector<uChar>* aDataPtr);
+  virtual void getScalarColumnShortV    (Vector<Short>* aDataPtr);
+  virtual void getScalarColumnuShortV   (Vector<uShort>* aDataPtr);
+  virtual void getScalarColumnIntV      (Vector<Int>* aDataPtr);
+  virtual void getScalarColumnuIntV     (Vector<uInt>* aDataPtr);
+  virtual void getScalarColumnfloatV    (Vector<float>* aDataPtr);
+  virtual void getScalarColumndoubleV   (Vector<double>* aDataPtr);
+  virtual void getScalarColumnComplexV  (Vector<Complex>* aDataPtr);
+  virtual void getScalarColumnDComplexV (Vector<DComplex>* aDataPtr);
+  virtual void putScalarColumnBoolV     (const Vector<Bool>* aDataPtr);
+  virtual void putScalarColumnuCharV    (const Vector<uChar>* aDataPtr);
+  virtual void putScalarColumnShortV    (const Vector<Short>* aDataPtr);
+  virtual void putScalarColumnuShortV   (const Vector<uShort>* aDataPtr);
+  virtual void putScalarColumnIntV      (const Vector<Int>* aDataPtr);
+  virtual void putScalarColumnuIntV     (const Vector<uInt>* aDataPtr);
+  virtual void putScalarColumnfloatV    (const Vector<float>* aDataPtr);
+  virtual void putScalarColumndoubleV   (const Vector<double>* aDataPtr);
+  virtual void putScalarColumnComplexV  (const Vector<Complex>* aDataPtr);
+  virtual void putScalarColumnDComplexV (const Vector<DComplex>* aDataPtr);
+  // </group>
+
+  // Get or put an array value in the given row.
+  // <group>
+  virtual void getArrayBoolV     (uInt aRowNr, Array<Bool>* aDataPtr);
+  virtual void getArrayuCharV    (uInt aRowNr, Array<uChar>* aDataPtr);
+  virtual void getArrayShortV    (uInt aRowNr, Array<Short>* aDataPtr);
+  virtual void getArrayuShortV   (uInt aRowNr, Array<uShort>* aDataPtr);
+  virtual void getArrayIntV      (uInt aRowNr, Array<Int>* aDataPtr);
+  virtual void getArrayuIntV     (uInt aRowNr, Array<uInt>* aDataPtr);
+  virtual void getArrayfloatV    (uInt aRowNr, Array<float>* aDataPtr);
+  virtual void getArraydoubleV   (uInt aRowNr, Array<double>* aDataPtr);
+  virtual void getArrayComplexV  (uInt aRowNr, Array<Complex>* aDataPtr);
+  virtual void getArrayDComplexV (uInt aRowNr, Array<DComplex>* aDataPtr);
+  virtual void putArrayBoolV     (uInt aRowNr, const Array<Bool>* aDataPtr);
+  virtual void putArrayuCharV    (uInt aRowNr, const Array<uChar>* aDataPtr);
+  virtual void putArrayShortV    (uInt aRowNr, const Array<Short>* aDataPtr);
+  virtual void putArrayuShortV   (uInt aRowNr, const Array<uShort>* aDataPtr);
+  virtual void putArrayIntV      (uInt aRowNr, const Array<Int>* aDataPtr);
+  virtual void putArrayuIntV     (uInt aRowNr, const Array<uInt>* aDataPtr);
+  virtual void putArrayfloatV    (uInt aRowNr, const Array<float>* aDataPtr);
+  virtual void putArraydoubleV   (uInt aRowNr, const Array<double>* aDataPtr);
+  virtual void putArrayComplexV  (uInt aRowNr, const Array<Complex>* aDataPtr);
+  virtual void putArrayDComplexV (uInt aRowNr,
+                                  const Array<DComplex>* aDataPtr);
+  // </group>
+
+  // Get or put a slice of an array in the given row.
+  // <group>
+  virtual void getSliceBoolV     (uInt aRowNr, const Slicer&,
+                                  Array<Bool>* aDataPtr);
+  virtual void getSliceuCharV    (uInt aRowNr, const Slicer&,
+                                  Array<uChar>* aDataPtr);
+  virtual void getSliceShortV    (uInt aRowNr, const Slicer&,
+                                  Array<Short>* aDataPtr);
+  virtual void getSliceuShortV   (uInt aRowNr, const Slicer&,
+                                  Array<uShort>* aDataPtr);
+  virtual void getSliceIntV      (uInt aRowNr, const Slicer&,
+                                  Array<Int>* aDataPtr);
+  virtual void getSliceuIntV     (uInt aRowNr, const Slicer&,
+                                  Array<uInt>* aDataPtr);
+  virtual void getSlicefloatV    (uInt aRowNr, const Slicer&,
+                                  Array<float>* aDataPtr);
+  virtual void getSlicedoubleV   (uInt aRowNr, const Slicer&,
+                                  Array<double>* aDataPtr);
+  virtual void getSliceComplexV  (uInt aRowNr, const Slicer&,
+                                  Array<Complex>* aDataPtr);
+  virtual void getSliceDComplexV (uInt aRowNr, const Slicer&,
+                                  Array<DComplex>* aDataPtr);
+  virtual void putSliceBoolV     (uInt aRowNr, const Slicer&,
+                                  const Array<Bool>* aDataPtr);
+  virtual void putSliceuCharV    (uInt aRowNr, const Slicer&,
+                                  const Array<uChar>* aDataPtr);
+  virtual void putSliceShortV    (uInt aRowNr, const Slicer&,
+                                  const Array<Short>* aDataPtr);
+  virtual void putSliceuShortV   (uInt aRowNr, const Slicer&,
+                                  const Array<uShort>* aDataPtr);
+  virtual void putSliceIntV      (uInt aRowNr, const Slicer&,
+                                  const Array<Int>* aDataPtr);
+  virtual void putSliceuIntV     (uInt aRowNr, const Slicer&,
+                                  const Array<uInt>* aDataPtr);
+  virtual void putSlicefloatV    (uInt aRowNr, const Slicer&,
+                                  const Array<float>* aDataPtr);
+  virtual void putSlicedoubleV   (uInt aRowNr, const Slicer&,
+                                  const Array<double>* aDataPtr);
+  virtual void putSliceComplexV  (uInt aRowNr, const Slicer&,
+                                  const Array<Complex>* aDataPtr);
+  virtual void putSliceDComplexV (uInt aRowNr, const Slicer&,
+                                  const Array<DComplex>* aDataPtr);
+  // </group>
+
+  // Get or put all arrays in the column.
+  // <group>
+  virtual void getArrayColumnBoolV     (Array<Bool>* aDataPtr);
+  virtual void getArrayColumnuCharV    (Array<uChar>* aDataPtr);
+  virtual void getArrayColumnShortV    (Array<Short>* aDataPtr);
+  virtual void getArrayColumnuShortV   (Array<uShort>* aDataPtr);
+  virtual void getArrayColumnIntV      (Array<Int>* aDataPtr);
+  virtual void getArrayColumnuIntV     (Array<uInt>* aDataPtr);
+  virtual void getArrayColumnfloatV    (Array<float>* aDataPtr);
+  virtual void getArrayColumndoubleV   (Array<double>* aDataPtr);
+  virtual void getArrayColumnComplexV  (Array<Complex>* aDataPtr);
+  virtual void getArrayColumnDComplexV (Array<DComplex>* aDataPtr);
+  virtual void putArrayColumnBoolV     (const Array<Bool>* aDataPtr);
+  virtual void putArrayColumnuCharV    (const Array<uChar>* aDataPtr);
+  virtual void putArrayColumnShortV    (const Array<Short>* aDataPtr);
+  virtual void putArrayColumnuShortV   (const Array<uShort>* aDataPtr);
+  virtual void putArrayColumnIntV      (const Array<Int>* aDataPtr);
+  virtual void putArrayColumnuIntV     (const Array<uInt>* aDataPtr);
+  virtual void putArrayColumnfloatV    (const Array<float>* aDataPtr);
+  virtual void putArrayColumndoubleV   (const Array<double>* aDataPtr);
+  virtual void putArrayColumnComplexV  (const Array<Complex>* aDataPtr);
+  virtual void putArrayColumnDComplexV (const Array<DComplex>* aDataPtr);
+  // </group>
+
+  // Initialize the column for a new table.
+  // It determines the number of rows per chunk.
+  void doCreate (uInt aNrRows);
+
+  // Add (aNewNrRows-anOldNrRows) rows to the column.
+  // The new rows get the value 0 or False.
+  virtual void addRow (uInt aNewNrRows, uInt anOldNrRows);
+
+  // Remove the given row from the column.
+  // The storage manager has already decremented its number of rows.
+  void remove (uInt aRowNr);
+
+  // Write the chunk held in memory if it has been changed.
+  void flushChunk();
+
+  // Clear the chunk held in memory (after flushing it).
+  void dropChunk();
+
+  // Write or read the index of the column.
+  // <group>
+  void putIndex (AipsIO& anOs) const;
+  void getIndex (AipsIO& anOs);
+  // </group>
+
+private:
+  // Forbid copy constructor.
+  CSMColumn (const CSMColumn&);
+
+  // Forbid assignment.
+  CSMColumn& operator= (const CSMColumn&);
+
+  // Initialize the conversion variables.
+  void init();
+
+  // Get the number of chunks needed for the given number of rows.
+  uInt nrChunks (uInt aNrRows) const
+    { return (aNrRows + itsRowsPerChunk - 1) / itsRowsPerChunk; }
+
+  // Get a pointer to the row in the chunk held in memory.
+  // The chunk containing the row is read if needed.
+  // If <src>forPut</src> is True, the chunk is marked as changed.
+  char* getRowPtr (uInt aRowNr, Bool forPut);
+
+  // Read the given chunk into memory (after flushing the current one).
+  void readChunk (uInt aChunkNr);
+
+  // Read the compressed data of a chunk into the given buffer.
+  void readRaw (uInt aChunkNr, uChar* aBuf);
+
+  // Write the compressed data of a chunk. The chunk is written at its
+  // current place in the file if it fits, otherwise at the end.
+  void writeRaw (uInt aChunkNr, const uChar* aBuf, uInt aLength);
+
+  // Decode a chunk of compressed data into a full chunk in local format.
+  // An empty chunk (length 0) is decoded as zeroes.
+  void decode (const uChar* anInBuf, uInt aLength, char* aChunk) const;
+
+  // Encode a full chunk into the given buffer (of itsExtLength bytes).
+  // It returns the length of the encoded data.
+  uInt encode (const char* aChunk, uChar* anOutBuf) const;
+
+  // Get or put all values in the column (in local format).
+  // <group>
+  void getColumnData (char* aData);
+  void putColumnData (const char* aData);
+  // </group>
+
+
+  //# The storage manager the column belongs to.
+  CompressedStMan* itsStMan;
+  //# Is the column an array column?
+  Bool itsIsArray;
+  //# Shape and number of elements of the array in a row.
+  IPosition itsShape;
+  uInt itsNrElem;
+  //# Number of bytes of a row in local format.
+  uInt itsRowSize;
+  //# Number of rows in a chunk.
+  uInt itsRowsPerChunk;
+  //# Number of bytes of a chunk in local and canonical format.
+  uInt itsChunkSize;
+  uInt itsExtLength;
+  //# Number of values to convert in a chunk.
+  uInt itsNrConvert;
+  //# Size of an element to use in the byte shuffle.
+  uInt itsShuffleSize;
+  //# Conversion functions from/to canonical format.
+  Conversion::ValueFunction* itsReadFunc;
+  Conversion::ValueFunction* itsWriteFunc;
+  //# Offset, length and allocated size of each chunk in the file.
+  //# An offset -1 means that the chunk has not been written yet.
+  Block<Int64> itsOffset;
+  Block<uInt>  itsLength;
+  Block<uInt>  itsAllocated;
+  //# The chunk held in memory (in local format).
+  Int         itsChunkNr;
+  Block<char> itsChunk;
+  Bool        itsDirty;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
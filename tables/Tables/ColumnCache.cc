@@ -33,7 +33,8 @@
 namespace casa { //# NAMESPACE CASA - BEGIN
 
 ColumnCache::ColumnCache()
-: itsIncr (1)
+: itsIncr     (1),
+  itsDisabled (False)
 {
     invalidate();
 }
@@ -46,5 +47,10 @@ void ColumnCache::set (uInt startRow, uInt endRow, const void* dataPtr)
     itsData  = dataPtr;
 }
 
+void ColumnCache::setDisabled (Bool disabled)
+{
+    itsDisabled = disabled;
+}
+
 } //# NAMESPACE CASA - END
 
@@ -68,6 +68,14 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 // The <src>invalidate</src> function can be used to invalidate the
 // cache. This is for instance needed when a table lock is acquired
 // or released to be sure that the cache gets refreshed.
+// <p>
+// The cache can be disabled, in which case <src>offset</src> always
+// returns -1, so the table column classes do not use the cached data.
+// A data manager can still use the cache for its own bookkeeping.
+// It is used in the concurrent read mode of a table (see
+// <src>Table::setConcurrentRead</src>), because otherwise the data manager
+// of one thread can change the cache while it is being used by another
+// thread.
 // </synopsis> 
 
 // <motivation>
@@ -98,8 +106,16 @@ public:
     // This clears the data pointer and sets startRow>endRow.
     void invalidate();
 
+    // Disable or enable the use of the cache by the table column classes.
+    void setDisabled (Bool disabled);
+
+    // Is the cache disabled?
+    Bool isDisabled() const
+      { return itsDisabled; }
+
     // Calculate the offset in the cached data for the given row.
-    // -1 is returned if the row is not within the cached rows.
+    // -1 is returned if the row is not within the cached rows
+    // or if the cache is disabled.
     Int offset (uInt rownr) const;
 
     // Give a pointer to the data.
@@ -118,6 +134,7 @@ private:
     uInt  itsEnd;
     uInt  itsIncr;
     const void* itsData;
+    Bool  itsDisabled;
 };
 
 
@@ -133,7 +150,7 @@ inline void ColumnCache::invalidate()
 
 inline Int ColumnCache::offset (uInt rownr) const
 {
-    return rownr<itsStart || rownr>itsEnd  ?  -1 :
+    return itsDisabled || rownr<itsStart || rownr>itsEnd  ?  -1 :
 	                                      Int((rownr-itsStart)*itsIncr);
 }
 
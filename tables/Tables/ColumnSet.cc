@@ -33,6 +33,9 @@
 #include <tables/Tables/ColumnDesc.h>
 #include <tables/Tables/DataManager.h>
 #include <tables/Tables/TableError.h>
+#include <tables/Tables/StorageOption.h>
+#include <casa/IO/MultiFile.h>
+#include <casa/OS/File.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Containers/Record.h>
 #include <casa/IO/MemoryIO.h>
@@ -52,7 +55,10 @@ ColumnSet::ColumnSet (TableDesc* tdesc)
   lockPtr_p       (0),
   colMap_p        (static_cast<void *>(0), tdesc->ncolumn()),
   seqCount_p      (0),
-  blockDataMan_p  (0)
+  blockDataMan_p  (0),
+  multiFile_p     (0),
+  itsMutex        (Mutex::Recursive),
+  concurrentRead_p(False)
 {
     //# Loop through all columns in the description and create
     //# a column out of them.
@@ -72,6 +78,8 @@ ColumnSet::~ColumnSet()
     for (i=0; i<blockDataMan_p.nelements(); i++) {
 	delete BLOCKDATAMANVAL(i);
     }
+    //# The data managers might use the MultiFile, so delete it last.
+    delete multiFile_p;
 }
 
 
@@ -106,6 +114,16 @@ void ColumnSet::removeLastDataManager()
     seqCount_p--;
 }
 
+void ColumnSet::createMultiFile (const String& tableName,
+                                 const StorageOption& storageOption)
+{
+    if (storageOption.option() == StorageOption::MultiFile) {
+        AlwaysAssert (multiFile_p == 0, AipsError);
+        multiFile_p = new MultiFile (tableName + "/table.mf", ByteIO::New,
+                                     storageOption.blockSize());
+    }
+}
+
 void ColumnSet::initDataManagers (uInt nrrow, Bool bigEndian,
                                   const TSMOption& tsmOption, Table& tab)
 {
@@ -113,6 +131,7 @@ void ColumnSet::initDataManagers (uInt nrrow, Bool bigEndian,
     for (i=0; i<blockDataMan_p.nelements(); i++) {
 	BLOCKDATAMANVAL(i)->setEndian (bigEndian);
 	BLOCKDATAMANVAL(i)->setTsmOption (tsmOption);
+	BLOCKDATAMANVAL(i)->setMultiFile (multiFile_p);
     }
     for (i=0; i<colMap_p.ndefined(); i++) {
 	getColumn(i)->createDataManagerColumn();
@@ -172,6 +191,17 @@ uInt ColumnSet::resync (uInt nrrow, Bool forceSync)
     if (dataManChanged_p.nelements() > 0) {
 	AlwaysAssert (dataManChanged_p.nelements() ==
 		                   blockDataMan_p.nelements(), AipsError);
+        //# Reread the MultiFile header if another process has changed
+        //# its files, so the data managers see the new file sizes.
+        if (multiFile_p != 0) {
+            Bool changed = (nrrow != nrrow_p  ||  forceSync);
+            for (uInt i=0; i<dataManChanged_p.nelements(); i++) {
+                changed = changed || dataManChanged_p[i];
+            }
+            if (changed) {
+                multiFile_p->resync();
+            }
+        }
 	for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
 	    if (dataManChanged_p[i]  ||  nrrow != nrrow_p  ||  forceSync) {
                 uInt nrr = BLOCKDATAMANVAL(i)->resync1 (nrrow);
@@ -194,6 +224,14 @@ void ColumnSet::invalidateColumnCaches()
     }
 }
 
+void ColumnSet::setConcurrentRead (Bool concurrentRead)
+{
+    for (uInt i=0; i<colMap_p.ndefined(); i++) {
+	COLMAPVAL(i)->columnCache().setDisabled (concurrentRead);
+    }
+    concurrentRead_p = concurrentRead;
+}
+
 
 //# Do all data managers allow to add and remove rows and columns?
 Bool ColumnSet::canAddRow() const
@@ -420,6 +458,7 @@ void ColumnSet::addColumn (const TableDesc& tableDesc,
     DataManager* dmptr = dataManager.clone();
     dmptr->setEndian (bigEndian);
     dmptr->setTsmOption (tsmOption);
+    dmptr->setMultiFile (multiFile_p);
     addDataManager (dmptr);
     // Loop through all new columns and construct column objects for them.
     // We have to use the column description in our table description.
@@ -688,6 +727,10 @@ void ColumnSet::initialize (uInt startRow, uInt endRow)
 void ColumnSet::reopenRW()
 {
     uInt i;
+    // The MultiFile has to be writable before the data managers.
+    if (multiFile_p != 0) {
+        multiFile_p->reopenRW();
+    }
     // Reopen all data managers.
     for (i=0; i<blockDataMan_p.nelements(); i++) {
 	BLOCKDATAMANVAL(i)->reopenRW();
@@ -768,6 +811,13 @@ Bool ColumnSet::putFile (Bool writeTable, AipsIO& ios,
 	}
 	memio.clear();
     }
+    //# The data managers wrote into the MultiFile, so flush that as well.
+    if (multiFile_p != 0) {
+        multiFile_p->flush();
+        if (fsync) {
+            multiFile_p->fsync();
+        }
+    }
     return written;
 }
 
@@ -790,6 +840,12 @@ uInt ColumnSet::getFile (AipsIO& ios, Table& tab, uInt nrrow, Bool bigEndian,
     }
     //# Use nrrow from caller, since that is most accurate.
     nrrow_p = nrrow;
+    //# Open the MultiFile if the storage manager files are kept in it.
+    String mfName (baseTablePtr_p->tableName() + "/table.mf");
+    if (multiFile_p == 0  &&  File(mfName).exists()) {
+        multiFile_p = new MultiFile (mfName, (baseTablePtr_p->isWritable() ?
+                                              ByteIO::Update : ByteIO::Old));
+    }
     ios >> nrman;
     ios >> nr;
     //# Construct the various data managers.
@@ -804,6 +860,7 @@ uInt ColumnSet::getFile (AipsIO& ios, Table& tab, uInt nrrow, Bool bigEndian,
         dmp->setSeqnr (seqnr);
 	dmp->setEndian (bigEndian);
 	dmp->setTsmOption (tsmOption);
+	dmp->setMultiFile (multiFile_p);
     }
     //# Now set seqCount_p (because that was changed by addDataManager).
     seqCount_p = nrman;
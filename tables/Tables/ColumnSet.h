@@ -35,6 +35,7 @@
 #include <tables/Tables/BaseTable.h>
 #include <casa/Containers/SimOrdMap.h>
 #include <casa/BasicSL/String.h>
+#include <casa/OS/Mutex.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -43,6 +44,8 @@ class SetupNewTable;
 class Table;
 class TableDesc;
 class TSMOption;
+class StorageOption;
+class MultiFile;
 class BaseTable;
 class TableAttr;
 class ColumnDesc;
@@ -81,6 +84,14 @@ template<class T> class Vector;
 // The main purpose of the class is to deal with constructing, writing
 // and reading the column objects. It is used by classes SetupNewTable
 // and Table.
+// <p>
+// ColumnSet contains a (recursive) mutex which is locked by the column
+// objects while accessing their data manager if the table is in concurrent
+// read mode (see <src>Table::setConcurrentRead</src>). In this way the data
+// managers (and their caches) of a table are never accessed by multiple
+// threads at the same time. In that mode the column caches of the data
+// managers are disabled, because the column objects use them without
+// locking. Outside this mode no locking is done at all.
 // </synopsis> 
 
 // <todo asof="$DATE:$">
@@ -126,12 +137,32 @@ public:
                            const TSMOption& tsmOption,
                            Table& tab);
 
+    // Create the MultiFile containing the storage manager files of a
+    // new table if the storage option tells so.
+    // It has to be done before the data managers are initialized.
+    void createMultiFile (const String& tableName, const StorageOption&);
+
+    // Get the MultiFile used (0 if the table uses separate files).
+    MultiFile* multiFile() const
+        { return multiFile_p; }
+
     // Link the ColumnSet object to the BaseTable object.
     void linkToTable (BaseTable* baseTableObject);
 
     // Link the ColumnSet object to the TableLockData object.
     void linkToLockObject (TableLockData* lockObject);
 
+    // Get the mutex serializing the access to the data managers.
+    Mutex& mutex();
+
+    // Set or get the concurrent read mode.
+    // Setting it disables or enables the column caches of all columns.
+    // <group>
+    void setConcurrentRead (Bool concurrentRead);
+    Bool concurrentRead() const
+        { return concurrentRead_p; }
+    // </group>
+
     // Check if the table is locked for read or write.
     // If manual or permanent locking is in effect, it checks if the
     // table is properly locked.
@@ -313,6 +344,42 @@ private:
     //#                                                 (used for unique seqnr)
     Block<void*>                    blockDataMan_p; //# list of data managers
     Block<Bool>                     dataManChanged_p; //# data has changed
+    MultiFile*                      multiFile_p;    //# 0 = separate files
+    Mutex                           itsMutex;       //# data manager access
+    Bool                            concurrentRead_p; //# lock the mutex?
+};
+
+
+// <summary>
+// Serialize the data manager access in concurrent read mode
+// </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tTableConcurrentRead.cc">
+// </reviewed>
+// <synopsis>
+// The constructor locks the mutex of the ColumnSet if the table is in
+// concurrent read mode, while the destructor unlocks it. Otherwise nothing
+// is done, so normal table access does not pay for the locking.
+// </synopsis>
+
+class ConcurrentReadLock
+{
+public:
+    explicit ConcurrentReadLock (ColumnSet& colSet)
+      : itsMutex (colSet.concurrentRead()  ?  &colSet.mutex() : 0)
+      { if (itsMutex) itsMutex->lock(); }
+
+    ~ConcurrentReadLock()
+      { if (itsMutex) itsMutex->unlock(); }
+
+private:
+    // Copying is not possible.
+    // <group>
+    ConcurrentReadLock (const ConcurrentReadLock&);
+    ConcurrentReadLock& operator= (const ConcurrentReadLock&);
+    // </group>
+
+    Mutex* itsMutex;
 };
 
 
@@ -333,6 +400,10 @@ inline void ColumnSet::linkToLockObject (TableLockData* lockObject)
 {
     lockPtr_p = lockObject;
 }
+inline Mutex& ColumnSet::mutex()
+{
+    return itsMutex;
+}
 inline void ColumnSet::checkReadLock (Bool wait)
 {
     if (lockPtr_p->readLocking()
@@ -36,11 +36,105 @@
 #include <casa/Utilities/Sort.h>
 #include <casa/Utilities/Copy.h>
 #include <casa/Utilities/Assert.h>
+#include <casa/IO/AipsIO.h>
+#include <casa/OS/File.h>
+#include <casa/OS/RegularFile.h>
+#include <casa/OS/Directory.h>
+#include <casa/OS/DirectoryIterator.h>
+#include <casa/Arrays/ArrayIO.h>
 #include <tables/Tables/TableError.h>
+#include <tables/Tables/BaseTable.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+// Read the data of the rows added to a column and append them.
+template<typename T>
+static void appendColumnData (const ScalarColumn<T>& column, Vector<T>& vec,
+                              uInt nrold, uInt nrnew)
+{
+  vec.resize (nrnew, True);
+  Vector<T> newPart (vec(Slice(nrold, nrnew-nrold)));
+  column.getColumnRange (Slicer(IPosition(1,nrold), IPosition(1,nrnew-nrold)),
+                         newPart);
+}
+
+// Write or read the data vector of a persistent index.
+template<typename T>
+static void putIndexData (AipsIO& ios, const void* vecPtr)
+{
+  const Vector<T>& vec = *static_cast<const Vector<T>*>(vecPtr);
+  Bool deleteIt;
+  const T* data = vec.getStorage (deleteIt);
+  ios.put (vec.nelements(), data);
+  vec.freeStorage (data, deleteIt);
+}
+template<typename T>
+static void getIndexData (AipsIO& ios, void* vecPtr)
+{
+  Vector<T>& vec = *static_cast<Vector<T>*>(vecPtr);
+  uInt nr;
+  ios >> nr;
+  vec.resize (nr);
+  Bool deleteIt;
+  T* data = vec.getStorage (deleteIt);
+  ios.get (nr, data);
+  vec.putStorage (data, deleteIt);
+}
+
+// Get the size and modification time (seconds and nanoseconds) of a file.
+// False is returned if the file does not exist.
+static Bool getFileStatus (const String& fileName, Int64* status)
+{
+  struct stat buf;
+  if (lstat (fileName.chars(), &buf) != 0) {
+    return False;
+  }
+  status[0] = buf.st_size;
+#if defined(__APPLE__)
+  status[1] = buf.st_mtimespec.tv_sec;
+  status[2] = buf.st_mtimespec.tv_nsec;
+#else
+  status[1] = buf.st_mtim.tv_sec;
+  status[2] = buf.st_mtim.tv_nsec;
+#endif
+  return True;
+}
+
+// Get the size and modification time of the data manager files in the
+// table directory. They change whenever column data are flushed, also by
+// processes not using table locking. The table.dat and table.info files
+// are skipped, because they are rewritten each time a writable table
+// is closed; the number of rows is checked separately.
+static void getTableFileStatus (const String& tableName,
+                                Vector<String>& names, Vector<Int64>& status)
+{
+  std::vector<String> fileNames;
+  for (DirectoryIterator iter((Directory(tableName))); !iter.pastEnd();
+       iter++) {
+    String name = iter.name();
+    if (name != "table.dat"  &&  name != "table.info"
+    &&  name != "table.lock"  &&  !name.startsWith ("table.index")
+    &&  iter.file().isRegular (False)) {
+      fileNames.push_back (name);
+    }
+  }
+  std::sort (fileNames.begin(), fileNames.end());
+  names.resize (fileNames.size());
+  status.resize (3*fileNames.size());
+  for (uInt i=0; i<fileNames.size(); i++) {
+    names[i] = fileNames[i];
+    if (! getFileStatus (tableName + '/' + fileNames[i], &status[3*i])) {
+      status[3*i] = -1;
+    }
+  }
+}
+
 ColumnsIndex::ColumnsIndex (const Table& table, const String& columnName,
 			    Compare* compareFunction, Bool noSort)
 : itsLowerKeyPtr (0),
@@ -84,7 +178,14 @@ void ColumnsIndex::copy (const ColumnsIndex& that)
     itsNrrow   = itsTable.nrow();
     itsNoSort  = that.itsNoSort;
     itsCompare = that.itsCompare;
+    itsPersistent = that.itsPersistent;
+    itsReadFromFile = False;
     makeObjects (that.itsLowerKeyPtr->description());
+    // A persistent index of a readonly table can be read quickly.
+    // Otherwise the data are read when needed.
+    if (itsPersistent  &&  !itsTable.isWritable()) {
+      readPersistent();
+    }
   }
 }
 
@@ -189,6 +290,7 @@ void ColumnsIndex::create (const Table& table,
   itsNrrow = itsTable.nrow();
   itsCompare = (compareFunction == 0  ?  compare : compareFunction);
   itsNoSort = noSort;
+  itsReadFromFile = False;
   // Loop through all column names.
   // Always add it to the RecordDesc.
   RecordDesc description;
@@ -198,7 +300,13 @@ void ColumnsIndex::create (const Table& table,
 		     TableColumn (itsTable, columnNames(i)));
   }
   makeObjects (description);
-  readData();
+  // Use the persistent index if existing and up-to-date.
+  // It is not used if the table is writable, because this process
+  // might have changed the data without having flushed them yet.
+  itsPersistent = hasPersistentIndex (itsTable, columnNames);
+  if (!itsPersistent  ||  itsTable.isWritable()  ||  !readPersistent()) {
+    readData();
+  }
 }
 	    
 void ColumnsIndex::makeObjects (const RecordDesc& description)
@@ -220,6 +328,7 @@ void ColumnsIndex::makeObjects (const RecordDesc& description)
   itsColumnChanged.resize (nrfield, False, False);
   itsColumnChanged.set (True);
   itsChanged = True;
+  itsAppended = False;
   // Create the correct column object for each field.
   // Also create a RecordFieldPtr object for each Key.
   // This makes a fast data copy possible.
@@ -307,11 +416,18 @@ void ColumnsIndex::readData()
   // Acquire a lock if needed.
   TableLocker locker(itsTable, FileLocker::Read);
   uInt nrrow = itsTable.nrow();
+  uInt nrold = itsNrrow;
   if (nrrow != itsNrrow) {
-    itsColumnChanged.set (True);
+    // If it is known that rows have only been added, only the new rows
+    // have to be read for the unchanged columns. Otherwise rows might
+    // have been removed, so all columns are reread.
+    if (!itsAppended  ||  nrrow < itsNrrow) {
+      itsColumnChanged.set (True);
+    }
     itsChanged = True;
     itsNrrow = nrrow;
   }
+  itsAppended = False;
   if (!itsChanged) {
     return;
   }
@@ -327,6 +443,9 @@ void ColumnsIndex::readData()
       Vector<Bool>* vecptr = (Vector<Bool>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Bool>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<Bool>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -337,6 +456,9 @@ void ColumnsIndex::readData()
       Vector<uChar>* vecptr = (Vector<uChar>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<uChar>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<uChar>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -347,6 +469,9 @@ void ColumnsIndex::readData()
       Vector<Short>* vecptr = (Vector<Short>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Short>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<Short>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -357,6 +482,9 @@ void ColumnsIndex::readData()
       Vector<Int>* vecptr = (Vector<Int>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Int>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<Int>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -367,6 +495,9 @@ void ColumnsIndex::readData()
       Vector<uInt>* vecptr = (Vector<uInt>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<uInt>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<uInt>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -377,6 +508,9 @@ void ColumnsIndex::readData()
       Vector<Float>* vecptr = (Vector<Float>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Float>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<Float>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -387,6 +521,9 @@ void ColumnsIndex::readData()
       Vector<Double>* vecptr = (Vector<Double>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Double>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<Double>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -397,6 +534,9 @@ void ColumnsIndex::readData()
       Vector<Complex>* vecptr = (Vector<Complex>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Complex>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<Complex>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -407,6 +547,9 @@ void ColumnsIndex::readData()
       Vector<DComplex>* vecptr = (Vector<DComplex>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<DComplex>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<DComplex>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -417,6 +560,9 @@ void ColumnsIndex::readData()
       Vector<String>* vecptr = (Vector<String>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<String>(itsTable, name).getColumn (*vecptr, True);
+      } else if (nrold < itsNrrow) {
+	appendColumnData (ScalarColumn<String>(itsTable, name), *vecptr,
+			  nrold, itsNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -441,6 +587,298 @@ void ColumnsIndex::readData()
   itsDataInx = itsDataIndex.getStorage (deleteIt);
   itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
   itsChanged = False;
+  itsReadFromFile = False;
+  // Keep the persistent index up-to-date.
+  if (itsPersistent) {
+    writePersistent();
+  }
+}
+
+String ColumnsIndex::indexFileName (const Vector<String>& columnNames)
+{
+  String name = "table.index";
+  for (uInt i=0; i<columnNames.nelements(); i++) {
+    name += '_' + columnNames(i);
+  }
+  return name;
+}
+
+String ColumnsIndex::persistentName (const Table& table,
+                                     const Vector<String>& columnNames)
+{
+  return table.tableName() + '/' + indexFileName (columnNames);
+}
+
+Bool ColumnsIndex::hasPersistentIndex (const Table& table,
+                                       const Vector<String>& columnNames)
+{
+  if (!table.isRootTable()  ||  table.tableType() != Table::Plain) {
+    return False;
+  }
+  // Test the file system only once per index; the result is kept in
+  // the table, so selections do not need to test it over and over again.
+  std::map<String,Bool>& cache =
+    table.baseTablePtr()->persistentIndexCache();
+  String fileName = indexFileName (columnNames);
+  std::map<String,Bool>::const_iterator iter = cache.find (fileName);
+  if (iter != cache.end()) {
+    return iter->second;
+  }
+  Bool exists = File(persistentName (table, columnNames)).exists();
+  cache[fileName] = exists;
+  return exists;
+}
+
+void ColumnsIndex::removePersistentIndex (const Table& table,
+                                          const Vector<String>& columnNames)
+{
+  if (hasPersistentIndex (table, columnNames)) {
+    RegularFile(persistentName (table, columnNames)).remove();
+    table.baseTablePtr()->persistentIndexCache()[indexFileName (columnNames)]
+      = False;
+  }
+}
+
+void ColumnsIndex::makePersistent()
+{
+  if (!itsTable.isRootTable()  ||  itsTable.tableType() != Table::Plain
+  ||  !itsTable.isWritable()) {
+    throw (TableError ("ColumnsIndex::makePersistent: table " +
+                       itsTable.tableName() +
+                       " is not a writable persistent root table"));
+  }
+  readData();
+  itsPersistent = True;
+  writePersistent();
+}
+
+Bool ColumnsIndex::openPersistent (AipsIO& ios, Bool& noSort) const
+{
+  if (! hasPersistentIndex (itsTable, columnNames())) {
+    return False;
+  }
+  // The file might have been removed by another process.
+  String name = persistentName (itsTable, columnNames());
+  Int64 indexStatus[3];
+  if (! getFileStatus (name, indexStatus)) {
+    itsTable.baseTablePtr()->persistentIndexCache()[indexFileName
+                                                    (columnNames())] = False;
+    return False;
+  }
+  try {
+    ios.open (name);
+  } catch (AipsError&) {
+    itsTable.baseTablePtr()->persistentIndexCache()[indexFileName
+                                                    (columnNames())] = False;
+    return False;
+  }
+  // Older index files do not contain the status of the table files.
+  if (ios.getstart ("ColumnsIndex") < 2) {
+    return False;
+  }
+  uInt nrrow;
+  Vector<String> names;
+  Vector<Int64> status;
+  ios >> nrrow >> noSort >> names >> status;
+  // The index is out-of-date if a table file has changed since it was
+  // written. A change in the same clock tick as the index file cannot be
+  // detected, so the index cannot be trusted in that case.
+  Vector<String> curNames;
+  Vector<Int64> curStatus;
+  getTableFileStatus (itsTable.tableName(), curNames, curStatus);
+  if (nrrow != itsTable.nrow()  ||
+      names.nelements() != curNames.nelements()  ||
+      !allEQ (names, curNames)  ||  !allEQ (status, curStatus)) {
+    return False;
+  }
+  for (uInt i=0; i<names.nelements(); i++) {
+    if (status[3*i+1] > indexStatus[1]  ||
+        (status[3*i+1] == indexStatus[1]  &&
+         status[3*i+2] >= indexStatus[2])) {
+      return False;
+    }
+  }
+  return True;
+}
+
+void ColumnsIndex::writePersistent()
+{
+  if (!itsTable.isWritable()) {
+    return;
+  }
+  // Flush the table, so the index matches the data in the table files.
+  // Acquire a lock if needed, so no other process changes them meanwhile.
+  TableLocker locker(itsTable, FileLocker::Write);
+  itsTable.flush();
+  // Nothing needs to be written if the file is still up-to-date.
+  {
+    AipsIO ios;
+    Bool noSort;
+    if (openPersistent (ios, noSort)  &&  noSort == itsNoSort) {
+      return;
+    }
+  }
+  // Write into a temporary file and rename it thereafter, so another
+  // process never sees a partially written index.
+  String name = persistentName (itsTable, columnNames());
+  String tmpName = name + "_tmp";
+  Vector<String> names;
+  Vector<Int64> status;
+  getTableFileStatus (itsTable.tableName(), names, status);
+  {
+    AipsIO ios (tmpName, ByteIO::New);
+    ios.putstart ("ColumnsIndex", 2);
+    ios << itsNrrow << itsNoSort << names << status;
+    const RecordDesc& desc = itsLowerKeyPtr->description();
+    uInt nrfield = itsDataTypes.nelements();
+    ios << nrfield;
+    for (uInt i=0; i<nrfield; i++) {
+      ios << desc.name(i) << itsDataTypes[i];
+      switch (itsDataTypes[i]) {
+      case TpBool:
+	putIndexData<Bool> (ios, itsDataVectors[i]);
+	break;
+      case TpUChar:
+	putIndexData<uChar> (ios, itsDataVectors[i]);
+	break;
+      case TpShort:
+	putIndexData<Short> (ios, itsDataVectors[i]);
+	break;
+      case TpInt:
+	putIndexData<Int> (ios, itsDataVectors[i]);
+	break;
+      case TpUInt:
+	putIndexData<uInt> (ios, itsDataVectors[i]);
+	break;
+      case TpFloat:
+	putIndexData<Float> (ios, itsDataVectors[i]);
+	break;
+      case TpDouble:
+	putIndexData<Double> (ios, itsDataVectors[i]);
+	break;
+      case TpComplex:
+	putIndexData<Complex> (ios, itsDataVectors[i]);
+	break;
+      case TpDComplex:
+	putIndexData<DComplex> (ios, itsDataVectors[i]);
+	break;
+      case TpString:
+	putIndexData<String> (ios, itsDataVectors[i]);
+	break;
+      default:
+	throw (TableError ("ColumnsIndex: unknown data type"));
+      }
+    }
+    putIndexData<uInt> (ios, &itsDataIndex);
+    putIndexData<uInt> (ios, &itsUniqueIndex);
+    ios.putend();
+  }
+  // The index can only be validated if it is newer than the table files.
+  // If they were flushed in the same clock tick, wait for the next one.
+  Int64 newest[2] = {0, 0};
+  for (uInt i=0; i<names.nelements(); i++) {
+    if (status[3*i+1] > newest[0]  ||
+        (status[3*i+1] == newest[0]  &&  status[3*i+2] > newest[1])) {
+      newest[0] = status[3*i+1];
+      newest[1] = status[3*i+2];
+    }
+  }
+  Int64 indexStatus[3];
+  for (uInt i=0; i<1000; i++) {
+    getFileStatus (tmpName, indexStatus);
+    if (indexStatus[1] > newest[0]  ||
+        (indexStatus[1] == newest[0]  &&  indexStatus[2] > newest[1])) {
+      break;
+    }
+    usleep (1000);
+    utime (tmpName.chars(), 0);
+  }
+  RegularFile(tmpName).move (name);
+  itsTable.baseTablePtr()->persistentIndexCache()[indexFileName (columnNames())]
+    = True;
+}
+
+Bool ColumnsIndex::readPersistent()
+{
+  // Acquire a lock if needed, so no other process changes the table files
+  // while the index is checked and read.
+  TableLocker locker(itsTable, FileLocker::Read);
+  AipsIO ios;
+  Bool noSort;
+  if (! openPersistent (ios, noSort)) {
+    return False;
+  }
+  uInt nrfield;
+  ios >> nrfield;
+  // An unsorted index can only be used if no sort is needed.
+  if ((noSort  &&  !itsNoSort)  ||
+      nrfield != itsDataTypes.nelements()) {
+    return False;
+  }
+  const RecordDesc& desc = itsLowerKeyPtr->description();
+  Bool deleteIt;
+  for (uInt i=0; i<nrfield; i++) {
+    String colName;
+    Int dtype;
+    ios >> colName >> dtype;
+    if (colName != desc.name(i)  ||  dtype != itsDataTypes[i]) {
+      return False;
+    }
+    switch (itsDataTypes[i]) {
+    case TpBool:
+      getIndexData<Bool> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<Bool>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpUChar:
+      getIndexData<uChar> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<uChar>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpShort:
+      getIndexData<Short> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<Short>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpInt:
+      getIndexData<Int> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<Int>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpUInt:
+      getIndexData<uInt> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<uInt>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpFloat:
+      getIndexData<Float> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<Float>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpDouble:
+      getIndexData<Double> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<Double>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpComplex:
+      getIndexData<Complex> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<Complex>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpDComplex:
+      getIndexData<DComplex> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<DComplex>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    case TpString:
+      getIndexData<String> (ios, itsDataVectors[i]);
+      itsData[i] = ((Vector<String>*)itsDataVectors[i])->getStorage (deleteIt);
+      break;
+    default:
+      throw (TableError ("ColumnsIndex: unknown data type"));
+    }
+  }
+  getIndexData<uInt> (ios, &itsDataIndex);
+  getIndexData<uInt> (ios, &itsUniqueIndex);
+  ios.getend();
+  itsDataInx = itsDataIndex.getStorage (deleteIt);
+  itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
+  itsNrrow = itsTable.nrow();
+  itsColumnChanged.set (False);
+  itsChanged = False;
+  itsReadFromFile = True;
+  return True;
 }
 
 uInt ColumnsIndex::bsearch (Bool& found, const Block<void*>& fieldPtrs) const
@@ -691,6 +1129,11 @@ void ColumnsIndex::setChanged()
   itsChanged = True;
 }
 
+void ColumnsIndex::setAppended()
+{
+  itsAppended = True;
+}
+
 void ColumnsIndex::setChanged (const String& columnName)
 {
   const RecordDesc& desc = itsLowerKeyPtr->description();
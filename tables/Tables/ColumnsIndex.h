@@ -38,6 +38,7 @@
 namespace casa { //# NAMESPACE CASA - BEGIN
 
 //# Forward Declarations
+class AipsIO;
 class String;
 class TableColumn;
 template<typename T> class RecordFieldPtr;
@@ -109,6 +110,30 @@ template<typename T> class RecordFieldPtr;
 // <br>If data have changed, the entire index will be recreated by
 // rereading and optionally resorting the data. This will be deferred
 // until the next key lookup.
+// If the number of rows has changed, the entire index is recreated as well,
+// because rows might have been removed and added. If it is known that
+// rows have only been added, the user can use the <src>setAppended</src>
+// function, so only the data of the new rows are read (unless
+// <src>setChanged</src> has been used).
+// <p>
+// An index can be made persistent using the function
+// <src>makePersistent</src>. In that case the index data (the key values
+// and the sorted row numbers) are stored in a file in the table directory.
+// When an index on the same columns is created thereafter (also in
+// another process) on a readonly table, the index is read from that
+// file instead of reading and sorting the key columns, which is much
+// faster for large tables. The file holds the number of rows and the size
+// and modification time of the data manager files. These change whenever
+// column data are flushed, also by processes not using table locking.
+// If these files have changed since the index was written (or if that
+// cannot be determined), the index is recreated from the columns as usual.
+// If the table is writable, the index is always recreated from the columns,
+// because the process might have changed data without having flushed them.
+// Each time the index is recreated or updated, the table is flushed and
+// the file is rewritten if it is out-of-date (if the table is writable).
+// <br>A persistent index on a single column of a readonly table is used
+// automatically by the table selection (e.g. in TaQL) to preselect the
+// rows for equality, range and IN comparisons of that column with constants.
 // </synopsis>
 
 // <example>
@@ -287,6 +312,12 @@ public:
     void setChanged (const String& columnName);
     // </group>
 
+    // Tell that rows have only been added to the table (and not removed)
+    // since the index was last updated, so only the new rows have to be
+    // read when the index is updated. Otherwise a change in the number of
+    // rows results in rereading all rows.
+    void setAppended();
+
     // Access the key values.
     // These functions allow you to create RecordFieldPtr<T> objects
     // for each field in the key. In this way you can quickly fill in
@@ -338,7 +369,39 @@ public:
     // The data type may differ.
     static void copyKeyField (void* field, int dtype, const Record& key);
 
+    // Make the index persistent by writing it into a file in the
+    // table directory. Thereafter the file is kept up-to-date
+    // when the index is recreated or updated.
+    // <br>An exception is thrown if the table is not a writable
+    // persistent root table.
+    void makePersistent();
+
+    // Is the index persistent?
+    Bool isPersistent() const;
+
+    // Has the index been read from the persistent file
+    // (instead of from the columns)?
+    Bool isReadFromFile() const;
+
+    // Get the name of the file containing the persistent index
+    // for the given columns in the table.
+    static String persistentName (const Table&,
+                                  const Vector<String>& columnNames);
+
+    // Test if a persistent index exists for the given columns in the table.
+    static Bool hasPersistentIndex (const Table&,
+                                    const Vector<String>& columnNames);
+
+    // Remove the persistent index for the given columns in the table.
+    // Nothing is done if it does not exist.
+    static void removePersistentIndex (const Table&,
+                                       const Vector<String>& columnNames);
+
 protected:
+    // Get the name of the file containing the persistent index
+    // for the given columns (without the table directory).
+    static String indexFileName (const Vector<String>& columnNames);
+
     // Copy that object to this.
     void copy (const ColumnsIndex& that);
 
@@ -360,6 +423,19 @@ protected:
     // form the index.
     void readData();
 
+    // Open the persistent file and read its header.
+    // It returns False if the file does not exist or is out-of-date.
+    Bool openPersistent (AipsIO& ios, Bool& noSort) const;
+
+    // Read the index from the persistent file.
+    // It returns False if the file is out-of-date.
+    Bool readPersistent();
+
+    // Flush the table and write the index into the persistent file.
+    // Nothing is done if the table is not writable or if the file
+    // is up-to-date.
+    void writePersistent();
+
     // Do a binary search on <src>itsUniqueIndex</src> for the key in
     // <src>fieldPtrs</src>.
     // If the key is found, <src>found</src> is set to True and the index
@@ -404,7 +480,10 @@ private:
     Block<void*> itsUpperFields;
     Block<Bool>  itsColumnChanged;
     Bool         itsChanged;
+    Bool         itsAppended;          //# True = rows were only added
     Bool         itsNoSort;            //# True = sort is not needed
+    Bool         itsPersistent;        //# True = index is kept in a file
+    Bool         itsReadFromFile;      //# True = index was read from file
     Compare*     itsCompare;           //# Compare function
     Vector<uInt> itsDataIndex;         //# Row numbers of all keys
     //# Indices in itsDataIndex for each unique key
@@ -418,6 +497,14 @@ inline Bool ColumnsIndex::isUnique() const
 {
     return (itsDataIndex.nelements() == itsUniqueIndex.nelements());
 }
+inline Bool ColumnsIndex::isPersistent() const
+{
+    return itsPersistent;
+}
+inline Bool ColumnsIndex::isReadFromFile() const
+{
+    return itsReadFromFile;
+}
 inline const Table& ColumnsIndex::table() const
 {
     return itsTable;
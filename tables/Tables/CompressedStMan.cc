@@ -0,0 +1,358 @@
+//# CompressedStMan.cc: Storage manager compressing columns losslessly
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <tables/Tables/CompressedStMan.h>
+#include <tables/Tables/CSMColumn.h>
+#include <tables/Tables/CSMCodec.h>
+#include <tables/Tables/Table.h>
+#include <tables/Tables/DataManError.h>
+#include <casa/Containers/Record.h>
+#include <casa/IO/AipsIO.h>
+#include <casa/IO/BucketFile.h>
+#include <casa/OS/DOos.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+CompressedStMan::CompressedStMan (const String& dataManagerName,
+                                  const String& codec,
+                                  Bool shuffle,
+                                  uInt chunkSize)
+: DataManager    (),
+  itsDataManName (dataManagerName),
+  itsCodecName   (codec),
+  itsCodec       (0),
+  itsShuffle     (shuffle),
+  itsChunkSize   (chunkSize),
+  itsBigEndian   (True),
+  itsNrRows      (0),
+  itsColumns     (0),
+  itsFile        (0),
+  itsFileEnd     (0),
+  itsHasPut      (False)
+{
+  itsCodec = CSMCodec::create (itsCodecName);
+}
+
+CompressedStMan::CompressedStMan (const String& dataManagerName,
+                                  const Record& spec)
+: DataManager    (),
+  itsDataManName (dataManagerName),
+  itsCodecName   ("lz4"),
+  itsCodec       (0),
+  itsShuffle     (True),
+  itsChunkSize   (262144),
+  itsBigEndian   (True),
+  itsNrRows      (0),
+  itsColumns     (0),
+  itsFile        (0),
+  itsFileEnd     (0),
+  itsHasPut      (False)
+{
+  if (spec.isDefined ("CODEC")) {
+    itsCodecName = spec.asString ("CODEC");
+  }
+  if (spec.isDefined ("SHUFFLE")) {
+    itsShuffle = spec.asBool ("SHUFFLE");
+  }
+  if (spec.isDefined ("CHUNKSIZE")) {
+    itsChunkSize = spec.asInt ("CHUNKSIZE");
+  }
+  itsCodec = CSMCodec::create (itsCodecName);
+}
+
+CompressedStMan::~CompressedStMan()
+{
+  for (uInt i=0; i<ncolumn(); i++) {
+    delete itsColumns[i];
+  }
+  delete itsFile;
+  delete itsCodec;
+}
+
+DataManager* CompressedStMan::clone() const
+{
+  return new CompressedStMan (itsDataManName, itsCodecName,
+                              itsShuffle, itsChunkSize);
+}
+
+DataManager* CompressedStMan::makeObject (const String& group,
+                                          const Record& spec)
+{
+  return new CompressedStMan (group, spec);
+}
+
+String CompressedStMan::dataManagerType() const
+{
+  return "CompressedStMan";
+}
+
+String CompressedStMan::dataManagerName() const
+{
+  return itsDataManName;
+}
+
+Record CompressedStMan::dataManagerSpec() const
+{
+  Record rec;
+  rec.define ("CODEC", itsCodecName);
+  rec.define ("SHUFFLE", itsShuffle);
+  rec.define ("CHUNKSIZE", Int(itsChunkSize));
+  return rec;
+}
+
+Bool CompressedStMan::canAddRow() const
+{
+  return True;
+}
+Bool CompressedStMan::canRemoveRow() const
+{
+  return True;
+}
+Bool CompressedStMan::canAddColumn() const
+{
+  return True;
+}
+Bool CompressedStMan::canRemoveColumn() const
+{
+  return True;
+}
+
+
+DataManagerColumn* CompressedStMan::makeScalarColumn (const String& aName,
+                                                      int aDataType,
+                                                      const String&)
+{
+  return makeColumn (aName, aDataType, False);
+}
+
+DataManagerColumn* CompressedStMan::makeDirArrColumn (const String& aName,
+                                                      int aDataType,
+                                                      const String&)
+{
+  return makeColumn (aName, aDataType, True);
+}
+
+DataManagerColumn* CompressedStMan::makeIndArrColumn (const String& aName,
+                                                      int aDataType,
+                                                      const String&)
+{
+  //# The column checks if the shape is fixed.
+  return makeColumn (aName, aDataType, True);
+}
+
+DataManagerColumn* CompressedStMan::makeColumn (const String& aName,
+                                                int aDataType,
+                                                Bool isArray)
+{
+  switch (aDataType) {
+  case TpBool:
+  case TpUChar:
+  case TpShort:
+  case TpUShort:
+  case TpInt:
+  case TpUInt:
+  case TpFloat:
+  case TpDouble:
+  case TpComplex:
+  case TpDComplex:
+    break;
+  default:
+    throw DataManError ("CompressedStMan does not support the data type "
+                        "of column " + aName);
+  }
+  //# Extend itsColumns block if needed.
+  if (ncolumn() >= itsColumns.nelements()) {
+    itsColumns.resize (itsColumns.nelements() + 32);
+  }
+  CSMColumn* aColumn = new CSMColumn (this, aDataType, isArray);
+  itsColumns[ncolumn()] = aColumn;
+  return aColumn;
+}
+
+// Note that the column has already been added by makeXXColumn.
+// This function is merely for initializing the added column.
+void CompressedStMan::addColumn (DataManagerColumn* aColumn)
+{
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (aColumn == itsColumns[i]) {
+      itsColumns[i]->doCreate (itsNrRows);
+      setHasPut();
+      return;
+    }
+  }
+  throw DataManInternalError ("CompressedStMan::addColumn");
+}
+
+void CompressedStMan::removeColumn (DataManagerColumn* aColumn)
+{
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (aColumn == itsColumns[i]) {
+      delete itsColumns[i];
+      decrementNcolumn();
+      for (uInt j=i; j<ncolumn(); j++) {
+        itsColumns[j] = itsColumns[j+1];
+      }
+      setHasPut();
+      return;
+    }
+  }
+  throw DataManInternalError ("CompressedStMan::removeColumn: no such column");
+}
+
+void CompressedStMan::addRow (uInt aNrRows)
+{
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsColumns[i]->addRow (itsNrRows+aNrRows, itsNrRows);
+  }
+  itsNrRows += aNrRows;
+  setHasPut();
+}
+
+void CompressedStMan::removeRow (uInt aRowNr)
+{
+  itsNrRows--;
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsColumns[i]->remove (aRowNr);
+  }
+  setHasPut();
+}
+
+Int64 CompressedStMan::allocate (uInt aLength)
+{
+  Int64 anOffset = itsFileEnd;
+  itsFileEnd += aLength;
+  setHasPut();
+  return anOffset;
+}
+
+
+Bool CompressedStMan::flush (AipsIO&, Bool doFsync)
+{
+  //# Write the changed chunks; this can change the index.
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsColumns[i]->flushChunk();
+  }
+  //# Do not write the index if nothing has been put.
+  if (! itsHasPut) {
+    return False;
+  }
+  if (doFsync) {
+    itsFile->fsync();
+  }
+  AipsIO anOs (fileName() + 'i', ByteIO::New, 65536, multiFile());
+  anOs.putstart ("CompressedStMan", 1);
+  anOs << itsDataManName;
+  anOs << itsCodecName;
+  anOs << itsShuffle;
+  anOs << itsChunkSize;
+  anOs << itsBigEndian;
+  anOs << itsNrRows;
+  anOs << itsFileEnd;
+  anOs << ncolumn();
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsColumns[i]->putIndex (anOs);
+  }
+  anOs.putend();
+  itsHasPut = False;
+  return True;
+}
+
+void CompressedStMan::create (uInt aNrRows)
+{
+  itsBigEndian = asBigEndian();
+  itsNrRows    = aNrRows;
+  itsFileEnd   = 0;
+  itsFile      = new BucketFile (fileName(), 0, False, multiFile());
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsColumns[i]->doCreate (aNrRows);
+  }
+  setHasPut();
+}
+
+void CompressedStMan::open (uInt aRowNr, AipsIO&)
+{
+  itsFile = new BucketFile (fileName(), table().isWritable(), 0, False,
+                            multiFile());
+  itsFile->open();
+  resync (aRowNr);
+}
+
+void CompressedStMan::resync (uInt aRowNr)
+{
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsColumns[i]->dropChunk();
+  }
+  readIndex();
+  if (aRowNr != itsNrRows) {
+    throw DataManInternalError
+      ("CompressedStMan::open: mismatch in #row; expected " +
+       String::toString(aRowNr) + ", found " + String::toString(itsNrRows));
+  }
+}
+
+void CompressedStMan::readIndex()
+{
+  AipsIO anOs (fileName() + 'i', ByteIO::Old, 65536, multiFile());
+  anOs.getstart ("CompressedStMan");
+  uInt aNrCol;
+  anOs >> itsDataManName;
+  anOs >> itsCodecName;
+  anOs >> itsShuffle;
+  anOs >> itsChunkSize;
+  anOs >> itsBigEndian;
+  anOs >> itsNrRows;
+  anOs >> itsFileEnd;
+  anOs >> aNrCol;
+  if (aNrCol != ncolumn()) {
+    throw DataManInternalError ("CompressedStMan::open: mismatch in #col");
+  }
+  //# The codec can differ from the one given in the constructor.
+  CSMCodec* aCodec = CSMCodec::create (itsCodecName);
+  delete itsCodec;
+  itsCodec = aCodec;
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsColumns[i]->getIndex (anOs);
+  }
+  anOs.getend();
+  itsHasPut = False;
+}
+
+void CompressedStMan::reopenRW()
+{
+  itsFile->setRW();
+}
+
+void CompressedStMan::deleteManager()
+{
+  delete itsFile;
+  itsFile = 0;
+  removeFile (fileName() + 'i');
+  removeFile (fileName());
+}
+
+} //# NAMESPACE CASA - END
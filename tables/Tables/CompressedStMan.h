@@ -0,0 +1,289 @@
+//# CompressedStMan.h: Storage manager compressing columns losslessly
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_COMPRESSEDSTMAN_H
+#define TABLES_COMPRESSEDSTMAN_H
+
+
+//# Includes
+#include <casa/aips.h>
+#include <tables/Tables/DataManager.h>
+#include <casa/Containers/Block.h>
+#include <casa/BasicSL/String.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Forward Declarations
+class CSMColumn;
+class CSMCodec;
+class BucketFile;
+
+
+// <summary>
+// Storage manager compressing the data of its columns losslessly
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tCompressedStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> The Table Data Managers concept as described in module file
+//        <linkto module="Tables:Data Managers">Tables.h</linkto>
+//   <li> <linkto class=CSMCodec>CSMCodec</linkto>
+// </prerequisite>
+
+// <etymology>
+// CompressedStMan is the storage manager storing its data compressed.
+// </etymology>
+
+// <synopsis>
+// CompressedStMan stores the data of its columns in chunks which are
+// compressed losslessly. It can be used for scalar and fixed shaped
+// array columns of all numeric data types and Bool. It is meant for
+// columns that take a lot of space, but compress well, like flags,
+// weights and integer index columns. Unlike the compression engines
+// (e.g. <linkto class=CompressFloat>CompressFloat</linkto>) no precision
+// is lost.
+// <p>
+// Each column is divided in chunks of a fixed number of rows.
+// A chunk is converted to canonical format and is passed through the
+// byte shuffle filter (see <linkto class=CSMCodec>CSMCodec</linkto>)
+// before it is compressed by the codec. Bool values are stored as bits.
+// The codec can be given by name; by default a bundled implementation
+// of the LZ4 block format is used, which decompresses very fast.
+// <p>
+// The compressed chunks are stored in the main file; a chunk that
+// does not fit anymore after it has been changed, is written at the end
+// of the file. The index telling where the chunks are, is kept in memory
+// and written into a separate file when the table is flushed.
+// <br>One chunk per column is held in memory. Accessing the data
+// sequentially (e.g. row by row) is therefore fast, while random access
+// can be slow because a chunk has to be decompressed for each access.
+// Getting or putting an entire column decompresses or compresses the chunks
+// in parallel when OpenMP is used.
+// <p>
+// The following options can be given in the constructor or in the
+// specification record:
+// <ul>
+//  <li> CODEC (string) is the name of the codec (default lz4).
+//  <li> SHUFFLE (bool) tells if the byte shuffle is done (default True).
+//  <li> CHUNKSIZE (int) is the size of an uncompressed chunk in bytes
+//       (default 256 KB). A chunk contains at least one row.
+// </ul>
+// CompressedStMan supports the addition and removal of rows and columns.
+// Note that removing rows or columns does not reclaim file space.
+// </synopsis>
+
+// <motivation>
+// Data like flags and weights can take a lot of disk space while
+// they contain very little information. Compressing them reduces the
+// I/O, which is often the bottleneck.
+// </motivation>
+
+// <example>
+// <srcblock>
+//   SetupNewTable newtab("name.data", tableDesc, Table::New);
+//   CompressedStMan stman("CSM", "lz4");
+//   newtab.bindColumn ("FLAG", stman);
+//   newtab.bindColumn ("WEIGHT", stman);
+//   Table tab(newtab);
+// </srcblock>
+// </example>
+
+//# <todo asof="$DATE:$">
+//# A List of bugs, limitations, extensions or planned refinements.
+//#   <li> Support variable shaped arrays and strings.
+//#   <li> Reuse the file space of chunks that have been moved.
+//# </todo>
+
+
+class CompressedStMan : public DataManager
+{
+public:
+  // Create a CompressedStMan with the given name, codec, shuffle
+  // and chunk size (in bytes).
+  explicit CompressedStMan (const String& dataManagerName = "CSM",
+                            const String& codec = "lz4",
+                            Bool shuffle = True,
+                            uInt chunkSize = 262144);
+
+  // Create a CompressedStMan with the given name and the options
+  // given in the specification record.
+  CompressedStMan (const String& dataManagerName, const Record& spec);
+
+  ~CompressedStMan();
+
+  // Clone this object.
+  virtual DataManager* clone() const;
+
+  // Get the type name of the data manager (i.e. CompressedStMan).
+  virtual String dataManagerType() const;
+
+  // Get the name given to the storage manager (in the constructor).
+  virtual String dataManagerName() const;
+
+  // Record a record containing data manager specifications.
+  virtual Record dataManagerSpec() const;
+
+  // The storage manager can add and remove rows and columns.
+  // <group>
+  virtual Bool canAddRow() const;
+  virtual Bool canRemoveRow() const;
+  virtual Bool canAddColumn() const;
+  virtual Bool canRemoveColumn() const;
+  // </group>
+
+  // Make the object from the type name string.
+  // This function gets registered in the DataManager "constructor" map.
+  static DataManager* makeObject (const String& dataManagerType,
+                                  const Record& spec);
+
+  // Get the number of rows.
+  uInt nrow() const
+    { return itsNrRows; }
+
+  // Get the codec to use.
+  const CSMCodec& codec() const
+    { return *itsCodec; }
+
+  // Tell if the byte shuffle is used.
+  Bool shuffle() const
+    { return itsShuffle; }
+
+  // Get the chunk size in bytes.
+  uInt chunkSize() const
+    { return itsChunkSize; }
+
+  // Tell if the data are stored in big-endian canonical format.
+  Bool bigEndian() const
+    { return itsBigEndian; }
+
+  // Get the data file.
+  BucketFile* file()
+    { return itsFile; }
+
+  // Allocate the given number of bytes at the end of the file.
+  // It returns the offset of the space.
+  Int64 allocate (uInt aLength);
+
+  // Tell that something has changed, so the index has to be written.
+  void setHasPut()
+    { itsHasPut = True; }
+
+private:
+  // Forbid copy constructor.
+  CompressedStMan (const CompressedStMan&);
+
+  // Forbid assignment.
+  CompressedStMan& operator= (const CompressedStMan&);
+
+  // Flush and optionally fsync the data.
+  // It returns False if nothing was changed.
+  virtual Bool flush (AipsIO&, Bool doFsync);
+
+  // Let the storage manager create files as needed for a new table.
+  virtual void create (uInt aNrRows);
+
+  // Open the storage manager file for an existing table and read the index.
+  virtual void open (uInt aRowNr, AipsIO&);
+
+  // Resync the storage manager with the new file contents.
+  virtual void resync (uInt aRowNr);
+
+  // Reopen the storage manager files for read/write.
+  virtual void reopenRW();
+
+  // The data manager will be deleted (because all its columns are
+  // requested to be deleted).
+  // So clean up the things needed (e.g. delete files).
+  virtual void deleteManager();
+
+  // Add rows to all columns.
+  virtual void addRow (uInt aNrRows);
+
+  // Delete a row from all columns.
+  virtual void removeRow (uInt aRowNr);
+
+  // Create a column in the storage manager on behalf of a table column.
+  // Only scalars and fixed shaped arrays of numeric types and Bool
+  // are supported.
+  // <group>
+  virtual DataManagerColumn* makeScalarColumn (const String& aName,
+                                               int aDataType,
+                                               const String& aDataTypeID);
+  virtual DataManagerColumn* makeDirArrColumn (const String& aName,
+                                               int aDataType,
+                                               const String& aDataTypeID);
+  virtual DataManagerColumn* makeIndArrColumn (const String& aName,
+                                               int aDataType,
+                                               const String& aDataTypeID);
+  // </group>
+
+  // Add a column.
+  virtual void addColumn (DataManagerColumn*);
+
+  // Delete a column.
+  virtual void removeColumn (DataManagerColumn*);
+
+  // Make a column object after checking the data type.
+  DataManagerColumn* makeColumn (const String& aName, int aDataType,
+                                 Bool isArray);
+
+  // Read the index file.
+  void readIndex();
+
+
+  //# Name given by user to this storage manager.
+  String itsDataManName;
+  //# The name of the codec and the codec itself.
+  String    itsCodecName;
+  CSMCodec* itsCodec;
+  //# Is the byte shuffle used?
+  Bool itsShuffle;
+  //# The size of a chunk in bytes.
+  uInt itsChunkSize;
+  //# Is the canonical format big-endian?
+  Bool itsBigEndian;
+  //# The number of rows.
+  uInt itsNrRows;
+  //# The columns.
+  PtrBlock<CSMColumn*> itsColumns;
+  //# The data file and its logical end.
+  BucketFile* itsFile;
+  Int64       itsFileEnd;
+  //# Has anything changed since the last flush?
+  Bool itsHasPut;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -231,6 +231,14 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     }
   }
 
+  void ConcatTable::setConcurrentRead (Bool concurrentRead)
+  {
+    BaseTable::setConcurrentRead (concurrentRead);
+    for (uInt i=0; i<baseTabPtr_p.nelements(); ++i) {
+      baseTabPtr_p[i]->setConcurrentRead (concurrentRead);
+    }
+  }
+
   uInt ConcatTable::getModifyCounter() const
   {
     return baseTabPtr_p[0]->getModifyCounter();
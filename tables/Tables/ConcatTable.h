@@ -203,6 +203,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     // Resync the Table object with the table files.
     virtual void resync();
 
+    // Set the concurrent read mode (also in the underlying tables).
+    virtual void setConcurrentRead (Bool concurrentRead);
+
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
@@ -31,6 +31,7 @@
 //# Includes
 #include <casa/aips.h>
 #include <tables/Tables/DataManager.h>
+#include <casa/Containers/Record.h>
 #include <iosfwd>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -113,6 +114,10 @@ public:
     void showCacheStatistics (ostream& os) const
       { itsDataManager->showCacheStatistics (os); }
 
+    // Get the IO statistics as a record.
+    Record getCacheStatistics() const
+      { return itsDataManager->getCacheStatistics(); }
+
 protected:
     // Get the data manager for the given data manager or column name.
     DataManager* baseDataManager() const
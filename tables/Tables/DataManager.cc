@@ -30,6 +30,7 @@
 #include <tables/Tables/DataManager.h>
 #include <tables/Tables/StManAipsIO.h>
 #include <tables/Tables/StandardStMan.h>
+#include <tables/Tables/CompressedStMan.h>
 #include <tables/Tables/IncrementalStMan.h>
 #include <tables/Tables/TiledDataStMan.h>
 #include <tables/Tables/TiledCellStMan.h>
@@ -47,8 +48,11 @@
 #include <tables/Tables/PlainTable.h>
 #include <casa/Arrays/IPosition.h>
 #include <casa/Containers/Record.h>
+#include <casa/IO/BucketCache.h>
+#include <casa/IO/MultiFile.h>
 #include <casa/BasicSL/String.h>
 #include <casa/OS/DynLib.h>
+#include <casa/OS/DOos.h>
 #include <tables/Tables/DataManError.h>
 #include <casa/stdio.h>                     // for sprintf
 
@@ -60,6 +64,7 @@ DataManager::DataManager()
   seqnr_p       (0),
   asBigEndian_p (False),
   tsmOption_p   (TSMOption::Buffer, 0, 0),
+  multiFile_p   (0),
   clone_p       (0)
 {
     table_p = new Table;
@@ -112,6 +117,32 @@ void DataManager::setMaximumCacheSize (uInt)
 void DataManager::showCacheStatistics (ostream&) const
 {}
 
+Record DataManager::getCacheStatistics() const
+{
+    return Record();
+}
+
+void DataManager::addCacheStatistics (Record& rec, const BucketCache& cache)
+{
+    const uInt nfld = 8;
+    static const char* names[nfld] = {"naccess", "nhit", "nread", "nwrite",
+                                      "ninit", "nevict", "nbytesread",
+                                      "nbyteswritten"};
+    uInt64 values[nfld] = {cache.nAccess(), cache.nHit(), cache.nRead(),
+                           cache.nWrite(), cache.nInit(), cache.nEvict(),
+                           cache.nBytesRead(), cache.nBytesWritten()};
+    for (uInt i=0; i<nfld; i++) {
+        Int64 value = values[i];
+        if (rec.isDefined (names[i])) {
+            value += rec.asInt64 (names[i]);
+        }
+        rec.define (names[i], value);
+    }
+    Int64 naccess = rec.asInt64 ("naccess");
+    rec.define ("hitrate", (naccess == 0  ?  0. :
+                            Double(rec.asInt64("nhit")) / naccess));
+}
+
 //# Create a column object for a scalar.
 //# Check its data type.
 DataManagerColumn* DataManager::createScalarColumn (const String& columnName,
@@ -206,6 +237,27 @@ String DataManager::fileName() const
     return table_p->tableName() + "/table" + strc;
 }
 
+void DataManager::setMultiFile (MultiFile* mfile)
+{
+    multiFile_p = mfile;
+    if (mfile != 0  &&  tsmOption_p.option() != TSMOption::Cache) {
+        tsmOption_p = TSMOption (TSMOption::Cache, tsmOption_p.bufferSize(),
+                                 tsmOption_p.maxCacheSizeMB());
+    }
+}
+
+void DataManager::removeFile (const String& fileName)
+{
+    if (multiFile_p != 0) {
+        Int id = multiFile_p->fileId (fileName, False);
+        if (id >= 0) {
+            multiFile_p->deleteFile (id);
+        }
+    } else {
+        DOos::remove (fileName, False, False);
+    }
+}
+
 ByteIO::OpenOption DataManager::fileOption() const
     { return PlainTable::toAipsIOFoption (table_p->tableOption()); }
 
@@ -365,6 +417,11 @@ Bool DataManagerColumn::canChangeShape() const
     return False;
 }
 
+Bool DataManagerColumn::getRangeRows (Double, Double, Vector<uInt>&)
+{
+    return False;
+}
+
 Bool DataManagerColumn::canAccessScalarColumn (Bool& reask) const
 {
     reask = False;
@@ -552,6 +609,7 @@ void DataManager::doRegisterMainCtor (void*)
   unlockedRegisterCtor ("TiledColumnStMan", TiledColumnStMan::makeObject);
   unlockedRegisterCtor ("TiledShapeStMan", TiledShapeStMan::makeObject);
   unlockedRegisterCtor ("MemoryStMan", MemoryStMan::makeObject);
+  unlockedRegisterCtor ("CompressedStMan", CompressedStMan::makeObject);
   unlockedRegisterCtor (CompressFloat::className(),
                         CompressFloat::makeObject);
   unlockedRegisterCtor (CompressComplex::className(),
@@ -53,6 +53,9 @@ class Slicer;
 class RefRows;
 template<class T> class Array;
 class AipsIO;
+class BucketCache;
+class MultiFile;
+template<class T> class Vector;
 
 
 // <summary>
@@ -294,6 +297,11 @@ public:
     const TSMOption& tsmOption() const
       { return tsmOption_p; }
 
+    // Get the MultiFile container the data manager files are stored in.
+    // It returns 0 if the files are stored as separate regular files.
+    MultiFile* multiFile() const
+      { return multiFile_p; }
+
     // Compose a keyword name from the given keyword appended with the
     // sequence number (e.g. key_0).
     // This makes the keyword name unique if multiple data managers
@@ -339,6 +347,17 @@ public:
     // Show the data manager's IO statistics. By default it does nothing.
     virtual void showCacheStatistics (std::ostream&) const;
 
+    // Get the data manager's IO statistics as a record.
+    // Storage managers using a BucketCache fill it using
+    // <src>addCacheStatistics</src>. By default an empty record is returned.
+    virtual Record getCacheStatistics() const;
+
+    // Add the statistics of the given cache to the record.
+    // The counts (fields naccess, nhit, nread, nwrite, ninit, nevict,
+    // nbytesread, and nbyteswritten) are added to possibly existing values
+    // and the field hitrate is recalculated.
+    static void addCacheStatistics (Record& rec, const BucketCache& cache);
+
     // Create a column in the data manager on behalf of a table column.
     // It calls makeXColumn and checks the data type.
     // <group>
@@ -381,6 +400,18 @@ protected:
     void setTsmOption (const TSMOption& tsmOption)
       { tsmOption_p = tsmOption; }
 
+    // Tell the data manager that its files have to be stored in the given
+    // MultiFile (0 means as regular files).
+    // Because a virtual file in a MultiFile cannot be memory-mapped or
+    // buffered, the TSM option is changed to Cache in that case.
+    void setMultiFile (MultiFile* mfile);
+
+    // Remove a file of this data manager (e.g. in deleteManager).
+    // If the files are stored in a MultiFile, the virtual file is removed
+    // from it; otherwise the regular file is removed.
+    // Nothing is done if the file does not exist.
+    void removeFile (const String& fileName);
+
     // Throw an exception in case data type is TpOther, because the
     // storage managers (and maybe other data managers) do not support
     // such columns.
@@ -392,6 +423,7 @@ private:
     uInt         seqnr_p;            //# Unique nr of this st.man. in a Table
     Bool         asBigEndian_p;      //# store data in big or little endian
     TSMOption    tsmOption_p;
+    MultiFile*   multiFile_p;        //# MultiFile to use; 0=no MultiFile
     Table*       table_p;            //# Table this data manager belongs to
     mutable DataManager* clone_p;    //# Pointer to clone (used by SetupNewTab)
 
@@ -669,6 +701,16 @@ public:
     // Default is no.
     virtual Bool canChangeShape() const;
 
+    // Get the numbers of the rows that might contain a value in the closed
+    // interval [minValue,maxValue]. It is meant for data managers keeping
+    // statistics (like the zone maps of StandardStMan) making it possible
+    // to skip parts of a scalar column. The caller still has to test the
+    // values of the returned rows.
+    // It returns False if the data manager cannot do it (which is
+    // the default).
+    virtual Bool getRangeRows (Double minValue, Double maxValue,
+                               Vector<uInt>& rownrs);
+
     // Can the column data manager handle access to a scalar column?
     // If not, the caller should access the column by looping through
     // all cells in the column.
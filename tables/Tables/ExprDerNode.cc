@@ -29,6 +29,7 @@
 #include <tables/Tables/Table.h>
 #include <tables/Tables/TableRecord.h>
 #include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/RefRows.h>
 #include <tables/Tables/ColumnDesc.h>
 #include <tables/Tables/TableError.h>
 #include <casa/Arrays/Vector.h>
@@ -54,6 +55,9 @@ TableExprNodeConstBool::~TableExprNodeConstBool()
 {}
 Bool TableExprNodeConstBool::getBool (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstBool::getBoolRows (const Vector<uInt>&,
+                                          Vector<Bool>& values)
+    { values = value_p; }
 
 TableExprNodeConstInt::TableExprNodeConstInt (const Int64& val)
 : TableExprNodeBinary (NTInt, VTScalar, OtLiteral, Table()),
@@ -67,6 +71,12 @@ Double TableExprNodeConstInt::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstInt::getDComplex (const TableExprId&)
     { return double(value_p); }
+void TableExprNodeConstInt::getIntRows (const Vector<uInt>&,
+                                        Vector<Int64>& values)
+    { values = value_p; }
+void TableExprNodeConstInt::getDoubleRows (const Vector<uInt>&,
+                                           Vector<Double>& values)
+    { values = Double(value_p); }
 
 TableExprNodeConstDouble::TableExprNodeConstDouble (const Double& val)
 : TableExprNodeBinary (NTDouble, VTScalar, OtLiteral, Table()),
@@ -78,6 +88,9 @@ Double TableExprNodeConstDouble::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstDouble::getDComplex (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstDouble::getDoubleRows (const Vector<uInt>&,
+                                              Vector<Double>& values)
+    { values = value_p; }
 
 TableExprNodeConstDComplex::TableExprNodeConstDComplex (const DComplex& val)
 : TableExprNodeBinary (NTComplex, VTScalar, OtLiteral, Table()),
@@ -235,6 +248,86 @@ String TableExprNodeColumn::getString (const TableExprId& id)
     return val;
 }
 
+// Read the values of the given rows from a column with data type T
+// and convert them to type U.
+template<typename T, typename U>
+static void getColumnRows (const TableColumn& tabCol,
+                           const Vector<uInt>& rownrs, Vector<U>& values)
+{
+    ScalarColumn<T> col (tabCol);
+    Vector<T> vec(rownrs.nelements());
+    col.getColumnCells (RefRows(rownrs, False, True), vec);
+    for (uInt i=0; i<vec.nelements(); ++i) {
+        values[i] = vec[i];
+    }
+}
+
+void TableExprNodeColumn::getBoolRows (const Vector<uInt>& rownrs,
+                                       Vector<Bool>& values)
+{
+    if (tabCol_p.columnDesc().dataType() == TpBool) {
+        ScalarColumn<Bool> col (tabCol_p);
+        col.getColumnCells (RefRows(rownrs, False, True), values);
+    } else {
+        TableExprNodeRep::getBoolRows (rownrs, values);
+    }
+}
+void TableExprNodeColumn::getIntRows (const Vector<uInt>& rownrs,
+                                      Vector<Int64>& values)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getColumnRows<uChar> (tabCol_p, rownrs, values);
+        break;
+    case TpShort:
+        getColumnRows<Short> (tabCol_p, rownrs, values);
+        break;
+    case TpUShort:
+        getColumnRows<uShort> (tabCol_p, rownrs, values);
+        break;
+    case TpInt:
+        getColumnRows<Int> (tabCol_p, rownrs, values);
+        break;
+    case TpUInt:
+        getColumnRows<uInt> (tabCol_p, rownrs, values);
+        break;
+    default:
+        TableExprNodeRep::getIntRows (rownrs, values);
+    }
+}
+void TableExprNodeColumn::getDoubleRows (const Vector<uInt>& rownrs,
+                                         Vector<Double>& values)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getColumnRows<uChar> (tabCol_p, rownrs, values);
+        break;
+    case TpShort:
+        getColumnRows<Short> (tabCol_p, rownrs, values);
+        break;
+    case TpUShort:
+        getColumnRows<uShort> (tabCol_p, rownrs, values);
+        break;
+    case TpInt:
+        getColumnRows<Int> (tabCol_p, rownrs, values);
+        break;
+    case TpUInt:
+        getColumnRows<uInt> (tabCol_p, rownrs, values);
+        break;
+    case TpFloat:
+        getColumnRows<Float> (tabCol_p, rownrs, values);
+        break;
+    case TpDouble:
+        {
+            ScalarColumn<Double> col (tabCol_p);
+            col.getColumnCells (RefRows(rownrs, False, True), values);
+        }
+        break;
+    default:
+        TableExprNodeRep::getDoubleRows (rownrs, values);
+    }
+}
+
 Bool TableExprNodeColumn::getColumnDataType (DataType& dt) const
 {
     dt = tabCol_p.columnDesc().dataType();
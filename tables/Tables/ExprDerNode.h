@@ -78,6 +78,7 @@ public:
     TableExprNodeConstBool (const Bool& value);
     ~TableExprNodeConstBool();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
 private:
     Bool value_p;
 };
@@ -111,6 +112,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getIntRows    (const Vector<uInt>& rownrs, Vector<Int64>& values);
+    void getDoubleRows (const Vector<uInt>& rownrs, Vector<Double>& values);
 private:
     Int64 value_p;
 };
@@ -143,6 +146,7 @@ public:
     ~TableExprNodeConstDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubleRows (const Vector<uInt>& rownrs, Vector<Double>& values);
 private:
     Double value_p;
 };
@@ -322,6 +326,13 @@ public:
     String   getString   (const TableExprId& id);
     const TableColumn& getColumn() const;
 
+    // Get the data for the given rows.
+    // The values are read with a single call from the column, so the
+    // storage manager can read them in bulk.
+    void getBoolRows   (const Vector<uInt>& rownrs, Vector<Bool>& values);
+    void getIntRows    (const Vector<uInt>& rownrs, Vector<Int64>& values);
+    void getDoubleRows (const Vector<uInt>& rownrs, Vector<Double>& values);
+
     // Get the data for the given rows.
     Array<Bool>     getColumnBool (const Vector<uInt>& rownrs);
     Array<uChar>    getColumnuChar (const Vector<uInt>& rownrs);
@@ -32,6 +32,7 @@
 #include <tables/Tables/ExprAggrNodeArray.h>
 #include <tables/Tables/TableError.h>
 #include <casa/Utilities/Sort.h>
+#include <casa/string.h>
 #include <limits>
 
 
@@ -69,7 +70,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     case TableExprNodeRep::NTInt:
       return itsInt64 == that.itsInt64;
     case TableExprNodeRep::NTDouble:
-      return itsDouble == that.itsDouble;
+    case TableExprNodeRep::NTDate:
+      // Two NaNs are equal (as for a single key).
+      return groupKeyEqual (itsDouble, that.itsDouble);
     default:
       return itsString == that.itsString;
     }
@@ -83,12 +86,32 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     case TableExprNodeRep::NTInt:
       return itsInt64 < that.itsInt64;
     case TableExprNodeRep::NTDouble:
-      return itsDouble < that.itsDouble;
+    case TableExprNodeRep::NTDate:
+      // NaN is ordered after all other values to be consistent with ==.
+      if (itsDouble != itsDouble) {
+        return false;
+      }
+      return itsDouble < that.itsDouble  ||  that.itsDouble != that.itsDouble;
     default:
       return itsString < that.itsString;
     }
   }
 
+  uInt64 TableExprGroupKey::hash() const
+  {
+    switch (itsDT) {
+    case TableExprNodeRep::NTBool:
+      return groupKeyHash (Int64(itsBool));
+    case TableExprNodeRep::NTInt:
+      return groupKeyHash (itsInt64);
+    case TableExprNodeRep::NTDouble:
+    case TableExprNodeRep::NTDate:
+      return groupKeyHash (itsDouble);
+    default:
+      return groupKeyHash (itsString);
+    }
+  }
+
 
   TableExprGroupKeySet::TableExprGroupKeySet (const vector<TableExprNode>& nodes)
   {
@@ -146,6 +169,51 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   }
 
 
+  uInt64 TableExprGroupKeySet::hash() const
+  {
+    uInt64 h = 0;
+    for (size_t i=0; i<itsKeys.size(); ++i) {
+      h = groupKeyHash (Int64(h ^ (itsKeys[i].hash() + 0x9e3779b97f4a7c15ULL +
+                                   (h << 6) + (h >> 2))));
+    }
+    return h;
+  }
+
+
+  // The finalizer of the SplitMix64 generator is used to mix the bits.
+  uInt64 groupKeyHash (Int64 key)
+  {
+    uInt64 h = key;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+  }
+
+  uInt64 groupKeyHash (Double key)
+  {
+    // Equal values must have the same hash, thus -0 and 0 must be the same.
+    // All NaNs are treated as equal.
+    if (key == 0) {
+      key = 0;
+    } else if (key != key) {
+      key = std::numeric_limits<Double>::quiet_NaN();
+    }
+    Int64 bits;
+    memcpy (&bits, &key, sizeof(bits));
+    return groupKeyHash (bits);
+  }
+
+  uInt64 groupKeyHash (const String& key)
+  {
+    // Use the FNV-1a hash.
+    uInt64 h = 0xcbf29ce484222325ULL;
+    for (String::size_type i=0; i<key.size(); ++i) {
+      h = (h ^ uChar(key[i])) * 0x100000001b3ULL;
+    }
+    return groupKeyHash (Int64(h));
+  }
+
+
   TableExprGroupResult::TableExprGroupResult
   (const vector<CountedPtr<TableExprGroupFuncSet> >& funcSets)
   {
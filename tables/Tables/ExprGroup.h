@@ -78,6 +78,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     bool operator<  (const TableExprGroupKey&) const;
     // </group>
 
+    // Get the hash value of the key.
+    uInt64 hash() const;
+
   private:
     TableExprNodeRep::NodeDataType itsDT;
     Bool   itsBool;
@@ -120,11 +123,129 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     bool operator== (const TableExprGroupKeySet&) const;
     bool operator<  (const TableExprGroupKeySet&) const;
 
+    // Get the hash value of all keys in the set.
+    uInt64 hash() const;
+
   private:
     vector<TableExprGroupKey> itsKeys;
   };
 
 
+  // <summary>
+  // Hash and compare functions for groupby keys
+  // </summary>
+  // <use visibility=local>
+  // <synopsis>
+  // These functions are used by TableExprGroupHashMap.
+  // The hash function mixes all bits of the key, so similar keys
+  // (like consecutive integers) are spread over the hash table.
+  // Doubles compare equal if their values are equal or both are NaN,
+  // which matches the grouping of equal keys in a std::map.
+  // </synopsis>
+  // <group name=groupKeyHash>
+  uInt64 groupKeyHash (Int64 key);
+  uInt64 groupKeyHash (Double key);
+  uInt64 groupKeyHash (const String& key);
+  inline uInt64 groupKeyHash (const TableExprGroupKeySet& key)
+    { return key.hash(); }
+  template<typename T>
+  inline bool groupKeyEqual (const T& left, const T& right)
+    { return left == right; }
+  inline bool groupKeyEqual (Double left, Double right)
+    { return left == right  ||  (left != left  &&  right != right); }
+  // </group>
+
+
+  // <summary>
+  // Hash map giving the group of a groupby key
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tExprGroup">
+  // </reviewed>
+  // <synopsis>
+  // This class maps the value of a groupby key (or a set of keys) to the
+  // sequence number of its group. The groups are numbered in order of
+  // first appearance.
+  // <br>It uses a hash table with open addressing and linear probing.
+  // The table contains the group numbers only; the keys and their hash
+  // values are stored in vectors indexed by group number. In this way a
+  // lookup needs no memory allocation and compares the key itself only
+  // if the hash values match. The table is doubled in size when it gets
+  // more than half full.
+  // <br>The hash function <src>groupKeyHash</src> and comparison function
+  // <src>groupKeyEqual</src> have to be defined for the key type.
+  // They are defined for Int64, Double, String and TableExprGroupKeySet.
+  // </synopsis>
+  // <example>
+  // <srcblock>
+  //   TableExprGroupHashMap<Int64> map;
+  //   Bool isNew;
+  //   Int groupnr = map.find (key, isNew);
+  //   if (isNew) {
+  //     // create the aggregate functions for the new group
+  //   }
+  // </srcblock>
+  // </example>
+  template<typename T>
+  class TableExprGroupHashMap
+  {
+  public:
+    // Create an empty map.
+    TableExprGroupHashMap()
+      : itsMask  (63),
+        itsTable (64, -1)
+    {}
+
+    // Get the number of groups.
+    uInt size() const
+      { return itsKeys.size(); }
+
+    // Get the group number of a key. If not found, the key is added
+    // as a new group and <src>isNew</src> is set to True.
+    Int find (const T& key, Bool& isNew)
+    {
+      uInt64 hash = groupKeyHash (key);
+      uInt64 inx  = hash & itsMask;
+      for (Int group=itsTable[inx]; group>=0; group=itsTable[inx]) {
+        if (itsHashes[group] == hash  &&  groupKeyEqual (itsKeys[group], key)) {
+          isNew = False;
+          return group;
+        }
+        inx = (inx + 1) & itsMask;
+      }
+      Int group = itsKeys.size();
+      itsKeys.push_back (key);
+      itsHashes.push_back (hash);
+      itsTable[inx] = group;
+      if (2*itsKeys.size() > itsTable.size()) {
+        resize (2*itsTable.size());
+      }
+      isNew = True;
+      return group;
+    }
+
+  private:
+    // Resize the hash table and insert the groups again.
+    void resize (size_t newSize)
+    {
+      itsTable.assign (newSize, -1);
+      itsMask = newSize - 1;
+      for (size_t group=0; group<itsHashes.size(); ++group) {
+        uInt64 inx = itsHashes[group] & itsMask;
+        while (itsTable[inx] >= 0) {
+          inx = (inx + 1) & itsMask;
+        }
+        itsTable[inx] = group;
+      }
+    }
+
+    uInt64         itsMask;
+    vector<Int>    itsTable;
+    vector<T>      itsKeys;
+    vector<uInt64> itsHashes;
+  };
+
+
   // <summary>
   // Class holding the results of groupby and aggregation
   // </summary>
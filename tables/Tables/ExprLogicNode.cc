@@ -30,12 +30,115 @@
 #include <tables/Tables/TableColumn.h>
 #include <tables/Tables/ColumnDesc.h>
 #include <casa/Quanta/MVTime.h>
+#include <casa/Arrays/Vector.h>
 #include <float.h>                     // for DBL_MAX
 #include <limits.h>                     // for DBL_MAX
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+// Define the getBoolRows function comparing the values of the children
+// for a block of rows.
+#define TABLEEXPRNODE_COMPARE_ROWS(NODE,T,GET,OPER) \
+void NODE::getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values) \
+{ \
+    uInt nr = rownrs.nelements(); \
+    Vector<T> left(nr); \
+    Vector<T> right(nr); \
+    lnode_p->GET (rownrs, left); \
+    rnode_p->GET (rownrs, right); \
+    for (uInt i=0; i<nr; ++i) { \
+        values[i] = left[i] OPER right[i]; \
+    } \
+}
+
+// Create the range for a comparison of a scalar column with a constant
+// (in any order). The range covers the values of the column for which
+// the comparison can be true.
+static void compareRange (Block<TableExprRange>& blrange,
+                          TableExprNodeRep* lnode, TableExprNodeRep* rnode,
+                          Bool isEqual)
+{
+    Double st = 0;
+    Double end = 0;
+    TableExprNodeRep* tsncol = 0;
+    if (lnode->operType()  == TableExprNodeRep::OtColumn
+    &&  lnode->valueType() == TableExprNodeRep::VTScalar
+    &&  rnode->operType()  == TableExprNodeRep::OtLiteral) {
+	tsncol = lnode;
+	st = rnode->getDouble (0);
+	end = (isEqual  ?  st : DBL_MAX);
+    } else if (rnode->operType()  == TableExprNodeRep::OtColumn
+           &&  rnode->valueType() == TableExprNodeRep::VTScalar
+           &&  lnode->operType()  == TableExprNodeRep::OtLiteral) {
+	tsncol = rnode;
+	end = lnode->getDouble (0);
+	st = (isEqual  ?  end : -DBL_MAX);
+    }
+    TableExprNodeRep::createRange (blrange,
+				   dynamic_cast<TableExprNodeColumn*>(tsncol),
+				   st, end);
+}
+
+// Create the ranges for a scalar column IN a constant array.
+static void inRange (Block<TableExprRange>& blrange,
+                     TableExprNodeRep* lnode, TableExprNodeRep* rnode)
+{
+    blrange.resize (0, True);
+    TableExprNodeColumn* colNode = dynamic_cast<TableExprNodeColumn*>(lnode);
+    if (colNode != 0
+    &&  lnode->valueType() == TableExprNodeRep::VTScalar
+    &&  rnode->isConstant()
+    &&  rnode->valueType() == TableExprNodeRep::VTArray) {
+	Array<Double> values = rnode->getArrayDouble (0);
+	if (values.nelements() > 0) {
+	    const TableColumn& col = colNode->getColumn();
+	    Array<Double>::const_iterator iter = values.begin();
+	    TableExprRange range (col, *iter, *iter);
+	    for (++iter; iter!=values.end(); ++iter) {
+		range.mixOr (TableExprRange (col, *iter, *iter));
+	    }
+	    blrange.resize (1, True);
+	    blrange[0] = range;
+	}
+    }
+}
+
+// Evaluate the node for the rows having the given value and replace
+// the value by the result.
+// It is used to evaluate the right operand of AND and OR for a block of rows
+// only where needed, thus the same as the row-based evaluation does.
+static void getBoolSubset (TableExprNodeRep* node, const Vector<uInt>& rownrs,
+                           Vector<Bool>& values, Bool which)
+{
+    uInt nr = rownrs.nelements();
+    uInt nsub = 0;
+    for (uInt i=0; i<nr; ++i) {
+        if (values[i] == which) {
+            nsub++;
+        }
+    }
+    if (nsub == nr) {
+        node->getBoolRows (rownrs, values);
+    } else if (nsub > 0) {
+        Vector<uInt> subRows(nsub);
+        Vector<Bool> subValues(nsub);
+        nsub = 0;
+        for (uInt i=0; i<nr; ++i) {
+            if (values[i] == which) {
+                subRows[nsub++] = rownrs[i];
+            }
+        }
+        node->getBoolRows (subRows, subValues);
+        nsub = 0;
+        for (uInt i=0; i<nr; ++i) {
+            if (values[i] == which) {
+                values[i] = subValues[nsub++];
+            }
+        }
+    }
+}
+
 // Implement the comparison operators for each data type.
 
 TableExprNodeEQBool::TableExprNodeEQBool (const TableExprNodeRep& node)
@@ -57,6 +160,7 @@ Bool TableExprNodeEQInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) == rnode_p->getInt(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeEQInt,Int64,getIntRows,==)
 
 TableExprNodeEQDouble::TableExprNodeEQDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -67,6 +171,7 @@ Bool TableExprNodeEQDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) == rnode_p->getDouble(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeEQDouble,Double,getDoubleRows,==)
 
 TableExprNodeEQDComplex::TableExprNodeEQDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -128,6 +233,7 @@ Bool TableExprNodeNEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) != rnode_p->getInt(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeNEInt,Int64,getIntRows,!=)
 
 TableExprNodeNEDouble::TableExprNodeNEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -138,6 +244,7 @@ Bool TableExprNodeNEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) != rnode_p->getDouble(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeNEDouble,Double,getDoubleRows,!=)
 
 TableExprNodeNEDComplex::TableExprNodeNEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -189,6 +296,7 @@ Bool TableExprNodeGTInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) > rnode_p->getInt(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeGTInt,Int64,getIntRows,>)
 
 TableExprNodeGTDouble::TableExprNodeGTDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -199,6 +307,7 @@ Bool TableExprNodeGTDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) > rnode_p->getDouble(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeGTDouble,Double,getDoubleRows,>)
 
 TableExprNodeGTDComplex::TableExprNodeGTDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -240,6 +349,7 @@ Bool TableExprNodeGEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) >= rnode_p->getInt(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeGEInt,Int64,getIntRows,>=)
 
 TableExprNodeGEDouble::TableExprNodeGEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -250,6 +360,7 @@ Bool TableExprNodeGEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) >= rnode_p->getDouble(id);
 }
+TABLEEXPRNODE_COMPARE_ROWS(TableExprNodeGEDouble,Double,getDoubleRows,>=)
 
 TableExprNodeGEDComplex::TableExprNodeGEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -342,6 +453,12 @@ Bool TableExprNodeOR::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) || rnode_p->getBool(id);
 }
+void TableExprNodeOR::getBoolRows (const Vector<uInt>& rownrs,
+                                   Vector<Bool>& values)
+{
+    lnode_p->getBoolRows (rownrs, values);
+    getBoolSubset (rnode_p, rownrs, values, False);
+}
 
 
 TableExprNodeAND::TableExprNodeAND (const TableExprNodeRep& node)
@@ -353,6 +470,12 @@ Bool TableExprNodeAND::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) && rnode_p->getBool(id);
 }
+void TableExprNodeAND::getBoolRows (const Vector<uInt>& rownrs,
+                                    Vector<Bool>& values)
+{
+    lnode_p->getBoolRows (rownrs, values);
+    getBoolSubset (rnode_p, rownrs, values, True);
+}
 
 
 TableExprNodeNOT::TableExprNodeNOT (const TableExprNodeRep& node)
@@ -364,6 +487,14 @@ Bool TableExprNodeNOT::getBool (const TableExprId& id)
 {
   return ! lnode_p->getBool(id);
 }
+void TableExprNodeNOT::getBoolRows (const Vector<uInt>& rownrs,
+                                    Vector<Bool>& values)
+{
+  lnode_p->getBoolRows (rownrs, values);
+  for (uInt i=0; i<values.nelements(); ++i) {
+    values[i] = !values[i];
+  }
+}
 
 
 
@@ -452,6 +583,32 @@ void TableExprNodeGTDouble::ranges (Block<TableExprRange>& blrange)
 }
 
 
+void TableExprNodeEQInt::ranges (Block<TableExprRange>& blrange)
+{
+    compareRange (blrange, lnode_p, rnode_p, True);
+}
+
+void TableExprNodeGEInt::ranges (Block<TableExprRange>& blrange)
+{
+    compareRange (blrange, lnode_p, rnode_p, False);
+}
+
+void TableExprNodeGTInt::ranges (Block<TableExprRange>& blrange)
+{
+    compareRange (blrange, lnode_p, rnode_p, False);
+}
+
+void TableExprNodeINInt::ranges (Block<TableExprRange>& blrange)
+{
+    inRange (blrange, lnode_p, rnode_p);
+}
+
+void TableExprNodeINDouble::ranges (Block<TableExprRange>& blrange)
+{
+    inRange (blrange, lnode_p, rnode_p);
+}
+
+
 //# Or two blocks of ranges.
 void TableExprNodeOR::ranges (Block<TableExprRange>& blrange)
 {
@@ -103,6 +103,8 @@ public:
     TableExprNodeEQInt (const TableExprNodeRep&);
     ~TableExprNodeEQInt();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
+    void ranges (Block<TableExprRange>&);
 };
 
 
@@ -133,6 +135,7 @@ public:
     TableExprNodeEQDouble (const TableExprNodeRep&);
     ~TableExprNodeEQDouble();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -315,6 +318,7 @@ public:
     TableExprNodeNEInt (const TableExprNodeRep&);
     ~TableExprNodeNEInt();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
 };
 
 
@@ -345,6 +349,7 @@ public:
     TableExprNodeNEDouble (const TableExprNodeRep&);
     ~TableExprNodeNEDouble();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
 };
 
 
@@ -496,6 +501,8 @@ public:
     TableExprNodeGTInt (const TableExprNodeRep&);
     ~TableExprNodeGTInt();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
+    void ranges (Block<TableExprRange>&);
 };
 
 
@@ -526,6 +533,7 @@ public:
     TableExprNodeGTDouble (const TableExprNodeRep&);
     ~TableExprNodeGTDouble();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -648,6 +656,8 @@ public:
     TableExprNodeGEInt (const TableExprNodeRep&);
     ~TableExprNodeGEInt();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
+    void ranges (Block<TableExprRange>&);
 };
 
 
@@ -678,6 +688,7 @@ public:
     TableExprNodeGEDouble (const TableExprNodeRep&);
     ~TableExprNodeGEDouble();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -800,6 +811,7 @@ public:
     TableExprNodeINInt (const TableExprNodeRep&);
     ~TableExprNodeINInt();
     Bool getBool (const TableExprId& id);
+    void ranges (Block<TableExprRange>&);
 };
 
 
@@ -830,6 +842,7 @@ public:
     TableExprNodeINDouble (const TableExprNodeRep&);
     ~TableExprNodeINDouble();
     Bool getBool (const TableExprId& id);
+    void ranges (Block<TableExprRange>&);
 };
 
 
@@ -949,6 +962,7 @@ public:
     TableExprNodeOR (const TableExprNodeRep&);
     ~TableExprNodeOR();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -978,6 +992,7 @@ public:
     TableExprNodeAND (const TableExprNodeRep&);
     ~TableExprNodeAND();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -1007,6 +1022,7 @@ public:
     TableExprNodeNOT (const TableExprNodeRep&);
     ~TableExprNodeNOT();
     Bool getBool (const TableExprId& id);
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values);
 };
 
 
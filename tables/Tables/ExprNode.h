@@ -944,6 +944,13 @@ public:
     Array<Double>   getArrayDouble   (const TableExprId& id) const;
     Array<DComplex> getArrayDComplex (const TableExprId& id) const;
     Array<String>   getArrayString   (const TableExprId& id) const;
+
+    // Get the Bool scalar values for a block of rows.
+    // It is used by the table selection to evaluate the expression
+    // for many rows at a time.
+    void getBoolRows (const Vector<uInt>& rownrs, Vector<Bool>& values) const
+      { node_p->getBoolRows (rownrs, values); }
+
     // Get a value as an array, even it it is a scalar.
     // This is useful in case one can give an argument as scalar or array.
     // <group>
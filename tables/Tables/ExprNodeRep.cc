@@ -37,6 +37,7 @@
 #include <tables/Tables/TableError.h>
 #include <casa/Containers/Block.h>
 #include <casa/Arrays/Array.h>
+#include <casa/Arrays/Vector.h>
 #include <casa/Arrays/ArrayLogical.h>
 #include <casa/iostream.h>
 
@@ -274,6 +275,34 @@ MVTime TableExprNodeRep::getDate (const TableExprId&)
     TableExprNode::throwInvDT ("(getDate not implemented)");
     return MVTime(0.);
 }
+void TableExprNodeRep::getBoolRows (const Vector<uInt>& rownrs,
+                                    Vector<Bool>& values)
+{
+    TableExprId id;
+    for (uInt i=0; i<rownrs.nelements(); ++i) {
+        id.setRownr (rownrs[i]);
+        values[i] = getBool (id);
+    }
+}
+void TableExprNodeRep::getIntRows (const Vector<uInt>& rownrs,
+                                   Vector<Int64>& values)
+{
+    TableExprId id;
+    for (uInt i=0; i<rownrs.nelements(); ++i) {
+        id.setRownr (rownrs[i]);
+        values[i] = getInt (id);
+    }
+}
+void TableExprNodeRep::getDoubleRows (const Vector<uInt>& rownrs,
+                                      Vector<Double>& values)
+{
+    TableExprId id;
+    for (uInt i=0; i<rownrs.nelements(); ++i) {
+        id.setRownr (rownrs[i]);
+        values[i] = getDouble (id);
+    }
+}
+
 Array<Bool> TableExprNodeRep::getArrayBool (const TableExprId&)
 {
     TableExprNode::throwInvDT ("(getArrayBool not implemented)");
@@ -268,6 +268,23 @@ public:
     virtual MVTime getDate       (const TableExprId& id);
     // </group>
 
+    // Get a scalar value for this node in each of the given rows.
+    // The row numbers must be in ascending order and the vector of values
+    // must have the same length as the vector of row numbers.
+    // <br>The default implementations call the corresponding row-based
+    // get function for each row. Derived classes can implement them to
+    // evaluate the node for all rows at once (e.g. a column node reading
+    // all values in a single call), which avoids a virtual function call
+    // per row and node.
+    // <group>
+    virtual void getBoolRows   (const Vector<uInt>& rownrs,
+                                Vector<Bool>& values);
+    virtual void getIntRows    (const Vector<uInt>& rownrs,
+                                Vector<Int64>& values);
+    virtual void getDoubleRows (const Vector<uInt>& rownrs,
+                                Vector<Double>& values);
+    // </group>
+
     // Get an array value for this node in the given row.
     // The appropriate functions are implemented in the derived classes and
     // will usually invoke the get in their children and apply the
@@ -206,6 +206,15 @@ void ISMBase::showCacheStatistics (ostream& os) const
     }
 }
 
+Record ISMBase::getCacheStatistics() const
+{
+    Record rec;
+    if (cache_p != 0) {
+        addCacheStatistics (rec, *cache_p);
+    }
+    return rec;
+}
+
 void ISMBase::showIndexStatistics (ostream& os)
 {
     if (index_p != 0) {
@@ -313,14 +322,15 @@ void ISMBase::makeIndex()
 void ISMBase::readIndex()
 {
     file_p->seek (0);
-    // Use the file indicated by the fd from the BucketFile object.
-    FiledesIO fio (file_p->fd(), file_p->name());
+    // Use the file indicated by the fd from the BucketFile object
+    // (or the virtual file in the MultiFile).
+    CountedPtr<ByteIO> fio = file_p->makeByteIO();
     TypeIO* tio;
     // It is stored in canonical or local format.
     if (asBigEndian()) {
-	tio = new CanonicalIO (&fio);
+	tio = new CanonicalIO (&(*fio));
     }else{
-	tio = new LECanonicalIO (&fio);
+	tio = new LECanonicalIO (&(*fio));
     }
     AipsIO os (tio);
     uInt version = os.getstart ("IncrementalStMan");
@@ -369,14 +379,15 @@ void ISMBase::writeIndex()
     uInt nbuckets = getCache().nBucket();
     // Write a few items at the beginning of the file.
     file_p->seek (0);
-    // Use the file indicated by the fd from the BucketFile object.
-    FiledesIO fio (file_p->fd(), file_p->name());
+    // Use the file indicated by the fd from the BucketFile object
+    // (or the virtual file in the MultiFile).
+    CountedPtr<ByteIO> fio = file_p->makeByteIO();
     TypeIO* tio;
     // Store it in canonical or local format.
     if (asBigEndian()) {
-	tio = new CanonicalIO (&fio);
+	tio = new CanonicalIO (&(*fio));
     }else{
-	tio = new LECanonicalIO (&fio);
+	tio = new LECanonicalIO (&(*fio));
     }
     AipsIO os (tio);
     // The endian switch is a new feature. So only put it if little endian
@@ -546,7 +557,7 @@ void ISMBase::recreate()
     nbucketInit_p = 1;
     nFreeBucket_p = 0;
     firstFree_p   = -1;
-    file_p = new BucketFile (fileName());
+    file_p = new BucketFile (fileName(), 0, False, multiFile());
     AlwaysAssert (file_p != 0, AipsError);
     index_p = new ISMIndex (this);
     AlwaysAssert (index_p != 0, AipsError);
@@ -621,7 +632,8 @@ void ISMBase::open (uInt tabNrrow, AipsIO& ios)
     ios >> dataManName_p;
     ios.getend();
     init();
-    file_p = new BucketFile (fileName(), table().isWritable());
+    file_p = new BucketFile (fileName(), table().isWritable(), 0, False,
+                             multiFile());
     AlwaysAssert (file_p != 0, AipsError);
     //# Westerbork MSs have a problem, because TMS used for a while
     //# the erronous version of ISMBase.cc.
@@ -641,7 +653,7 @@ StManArrayFile* ISMBase::openArrayFile (ByteIO::OpenOption opt)
 {
     if (iosfile_p == 0) {
 	iosfile_p = new StManArrayFile (fileName() + 'i', opt,
-					1, asBigEndian());
+					1, asBigEndian(), 65536, multiFile());
     }
     return iosfile_p;
 }
@@ -666,7 +678,7 @@ void ISMBase::deleteManager()
     if (file_p != 0) {
       file_p->remove();
     }
-    DOos::remove (fileName(), False, False);
+    removeFile (fileName());
 }
 
 
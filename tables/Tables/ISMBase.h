@@ -153,6 +153,9 @@ public:
     // Show the statistics of all caches used.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // Get the statistics of the cache as a record.
+    virtual Record getCacheStatistics() const;
+
     // Show the index statistics.
     void showIndexStatistics (ostream& os);
 
@@ -37,6 +37,8 @@
 #include <casa/BasicMath/Math.h>
 #include <casa/OS/CanonicalConversion.h>
 #include <casa/OS/LECanonicalConversion.h>
+#include <algorithm>
+#include <cstring>
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -50,11 +52,16 @@ ISMColumn::ISMColumn (ISMBase* parent, int dataType, uInt colnr)
   startRow_p    (-1),
   endRow_p      (-1),
   lastValue_p   (0),
-  lastRowPut_p  (0)
+  lastRowPut_p  (0),
+  nextInterval_p(0)
 {
     //# The increment in the column cache is always 0,
     //# because multiple rows refer to the same value.
     columnCache().setIncrement (0);
+    for (uInt i=0; i<nrCachedIntervals_p; i++) {
+	intervals_p[i].startRow = -1;
+	intervals_p[i].endRow   = -1;
+    }
 }
 
 ISMColumn::~ISMColumn()
@@ -100,6 +107,7 @@ void ISMColumn::clear()
 	break;
     }
     lastValue_p = 0;
+    clearIntervals();
 }
 
 void ISMColumn::setShapeColumn (const IPosition& shape)
@@ -118,9 +126,15 @@ IPosition ISMColumn::shape (uInt)
 }
 
 
-void ISMColumn::addRow (uInt, uInt)
+void ISMColumn::addRow (uInt, uInt oldNrrow)
 {
-    //# Nothing to do.
+    // The new rows get the value of the last row, so the interval
+    // containing the last row gets longer. Invalidate the cached ranges
+    // of that interval, otherwise a put of a row in it would treat the
+    // interval as too short.
+    startRow_p = -1;
+    endRow_p   = -1;
+    clearIntervals (oldNrrow == 0  ?  0 : oldNrrow-1);
 }
 
 void ISMColumn::remove (uInt bucketRownr, ISMBucket* bucket, uInt bucketNrrow,
@@ -141,10 +155,12 @@ void ISMColumn::remove (uInt bucketRownr, ISMBucket* bucket, uInt bucketNrrow,
     Block<uInt>& rowIndex = bucket->rowIndex (colnr_p);
     Block<uInt>& offIndex = bucket->offIndex (colnr_p);
     uInt& nused = bucket->indexUsed (colnr_p);
-    // Invalidate the last value read.
+    // Invalidate the last value read and all cached intervals
+    // (the row numbers of the following rows change).
     columnCache().invalidate();
     startRow_p = -1;
     endRow_p   = -1;
+    clearIntervals();
     // We have to change the bucket, so let the cache set the dirty flag
     // for this bucket.
     stmanPtr_p->setBucketDirty();
@@ -250,128 +266,119 @@ void ISMColumn::getStringV (uInt rownr, String* value)
     *value = *(String*)lastValue_p;
 }
 
-void ISMColumn::getScalarColumnBoolV (Vector<Bool>* dataPtr)
-{
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getBoolV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(Bool*)lastValue_p;
+template<typename T>
+void ISMColumn::getColumnRange (uInt startrow, uInt nrrow, T* values)
+{
+    uInt endrow = startrow + nrrow;
+    uInt rownr  = startrow;
+    while (rownr < endrow) {
+	// Get the bucket and the interval containing the row.
+	uInt bucketStartRow, bucketNrrow;
+	ISMBucket* bucket = stmanPtr_p->getBucket (rownr, bucketStartRow,
+						   bucketNrrow);
+	const Block<uInt>& rowIndex = bucket->rowIndex (colnr_p);
+	const Block<uInt>& offIndex = bucket->offIndex (colnr_p);
+	uInt nused = bucket->indexUsed (colnr_p);
+	uInt start, end, offset;
+	uInt inx = bucket->getInterval (colnr_p, rownr - bucketStartRow,
+					bucketNrrow, start, end, offset);
+	if (inx == nused  ||  rowIndex[inx] != start) {
+	    inx--;
 	}
+	// Walk through the intervals of the bucket and copy each value
+	// to all requested rows in it.
+	uInt bucketEnd = std::min (endrow, bucketStartRow + bucketNrrow);
+	for (; rownr < bucketEnd; inx++) {
+	    readFunc_p (lastValue_p, bucket->get (offIndex[inx]), nrcopy_p);
+	    startRow_p = bucketStartRow + rowIndex[inx];
+	    endRow_p   = bucketStartRow +
+		         (inx+1 < nused  ?  rowIndex[inx+1] : bucketNrrow) - 1;
+	    uInt last = std::min (bucketEnd, uInt(endRow_p) + 1);
+	    const T& value = *static_cast<T*>(lastValue_p);
+	    for (; rownr<last; rownr++) {
+		*values++ = value;
+	    }
+	}
+	columnCache().set (startRow_p, endRow_p, lastValue_p);
     }
 }
+
+void ISMColumn::getScalarColumnBoolV (Vector<Bool>* dataPtr)
+{
+    Bool deleteIt;
+    Bool* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
+}
 void ISMColumn::getScalarColumnuCharV (Vector<uChar>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getuCharV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(uChar*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    uChar* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnShortV (Vector<Short>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getShortV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(Short*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    Short* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnuShortV (Vector<uShort>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getuShortV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(uShort*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    uShort* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnIntV (Vector<Int>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getIntV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(Int*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    Int* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnuIntV (Vector<uInt>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getuIntV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(uInt*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    uInt* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnfloatV (Vector<float>* dataPtr)
 {
-    //# Note: using getStorage/putStorage is about 3 times faster
-    //# if the vector is consecutive, but it is slower if not.
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getfloatV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(float*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    float* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumndoubleV (Vector<double>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getdoubleV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(double*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    double* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnComplexV (Vector<Complex>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getComplexV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(Complex*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    Complex* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnDComplexV (Vector<DComplex>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getDComplexV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(DComplex*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    DComplex* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 void ISMColumn::getScalarColumnStringV (Vector<String>* dataPtr)
 {
-    uInt nrrow = dataPtr->nelements();
-    uInt rownr = 0;
-    while (rownr < nrrow) {
-	getStringV (rownr, &((*dataPtr)(rownr)));
-	for (rownr++; Int(rownr)<=endRow_p; rownr++) {
-	    (*dataPtr)(rownr) = *(String*)lastValue_p;
-	}
-    }
+    Bool deleteIt;
+    String* data = dataPtr->getStorage (deleteIt);
+    getColumnRange (0, dataPtr->nelements(), data);
+    dataPtr->putStorage (data, deleteIt);
 }
 
 #define ISMCOLUMN_GET(T,NM) \
@@ -389,6 +396,11 @@ void ISMColumn::aips_name2(getScalarColumnCells,NM) \
             uInt rownr = iter.sliceStart(); \
             uInt end = iter.sliceEnd(); \
             uInt incr = iter.sliceIncr(); \
+            if (incr == 1) { \
+                getColumnRange (rownr, end-rownr+1, valptr); \
+                valptr += end-rownr+1; \
+                rownr = end+1; \
+            } \
             while (rownr <= end) { \
                 if (rownr < cache.start()  ||  rownr > cache.end()) { \
                     aips_name2(get,NM) (rownr, valptr); \
@@ -446,24 +458,72 @@ ISMCOLUMN_GET(String,StringV)
 
 void ISMColumn::getValue (uInt rownr, void* value, Bool setCache)
 {
-    // Get the bucket with its row number boundaries.
-    uInt bucketStartRow, bucketNrrow;
-    ISMBucket* bucket = stmanPtr_p->getBucket (rownr, bucketStartRow,
-					       bucketNrrow);
-    // Get the interval in the bucket with its rownr boundaries.
-    rownr -= bucketStartRow;
-    uInt offset, stint, endint;
-    bucket->getInterval (colnr_p, rownr, bucketNrrow, stint, endint, offset);
+    // First look in the cache of recently used intervals.
+    Int stint, endint;
+    const char* data = findInterval (rownr, stint, endint);
+    if (data == 0) {
+	// Get the bucket with its row number boundaries.
+	uInt bucketStartRow, bucketNrrow;
+	ISMBucket* bucket = stmanPtr_p->getBucket (rownr, bucketStartRow,
+						   bucketNrrow);
+	// Get the interval in the bucket with its rownr boundaries.
+	uInt offset, start, end;
+	bucket->getInterval (colnr_p, rownr - bucketStartRow, bucketNrrow,
+			     start, end, offset);
+	stint  = bucketStartRow + start;
+	endint = bucketStartRow + end;
+	data   = bucket->get (offset);
+	cacheInterval (stint, endint, data,
+		       bucket->getLength (fixedLength_p, data));
+    }
     // Get the value.
     // Set the start and end rownr for which this value is valid.
-    readFunc_p (value, bucket->get (offset), nrcopy_p);
-    startRow_p = bucketStartRow + stint;
-    endRow_p   = bucketStartRow + endint;
+    readFunc_p (value, data, nrcopy_p);
+    startRow_p = stint;
+    endRow_p   = endint;
     if (setCache) {
 	columnCache().set (startRow_p, endRow_p, lastValue_p);
     }
 }
 
+const char* ISMColumn::findInterval (Int rownr, Int& startRow,
+				     Int& endRow) const
+{
+    for (uInt i=0; i<nrCachedIntervals_p; i++) {
+	const CachedInterval& ci = intervals_p[i];
+	if (rownr >= ci.startRow  &&  rownr <= ci.endRow) {
+	    startRow = ci.startRow;
+	    endRow   = ci.endRow;
+	    return ci.value.storage();
+	}
+    }
+    return 0;
+}
+
+void ISMColumn::cacheInterval (Int startRow, Int endRow, const char* value,
+			       uInt leng)
+{
+    CachedInterval& ci = intervals_p[nextInterval_p];
+    ci.startRow = startRow;
+    ci.endRow   = endRow;
+    ci.value.resize (leng, False, False);
+    memcpy (ci.value.storage(), value, leng);
+    if (++nextInterval_p == nrCachedIntervals_p) {
+	nextInterval_p = 0;
+    }
+}
+
+void ISMColumn::clearIntervals (uInt rownr)
+{
+    for (uInt i=0; i<nrCachedIntervals_p; i++) {
+	CachedInterval& ci = intervals_p[i];
+	if (ci.endRow >= Int(rownr)) {
+	    ci.startRow = -1;
+	    ci.endRow   = -1;
+	}
+    }
+}
+
 void ISMColumn::putBoolV (uInt rownr, const Bool* value)
 {
     putValue (rownr, value);
@@ -789,10 +849,12 @@ void ISMColumn::putValue (uInt rownr, const void* value)
 	afterLastRowPut = True;
 	lastRowPut_p    = rownr+1;
     }
-    // Invalidate the last value read.
+    // Invalidate the last value read and the cached intervals
+    // that can be affected.
     columnCache().invalidate();
     startRow_p = -1;
     endRow_p   = -1;
+    clearIntervals (rownr);
     // Exit if new value equals current value.
     readFunc_p (lastValue_p, bucket->get (offset), nrcopy_p);
     if (compareValue (value, lastValue_p)) {
@@ -1303,6 +1365,7 @@ void ISMColumn::resync (uInt nrrow)
     startRow_p   = -1;
     endRow_p     = -1;
     lastRowPut_p = nrrow;
+    clearIntervals();
 }
 void ISMColumn::reopenRW()
 {}
@@ -312,8 +312,13 @@ protected:
 
     // Get the value for this row.
     // Set the cache if the flag is set.
+    // The value is taken from the interval cache if possible.
     void getValue (uInt rownr, void* value, Bool setCache);
 
+    // Clear the intervals in the interval cache ending at or after
+    // <src>rownr</src>.
+    void clearIntervals (uInt rownr = 0);
+
     // Put the value for this row.
     void putValue (uInt rownr, const void* value);
 
@@ -351,6 +356,16 @@ protected:
 
 
 private:
+    // A recently used interval with its value in external format.
+    struct CachedInterval {
+	Int         startRow;     //# first row of interval (-1 = unused)
+	Int         endRow;       //# last row of interval
+	Block<char> value;
+    };
+
+    // Number of intervals kept in the interval cache.
+    static const uInt nrCachedIntervals_p = 32;
+
     // Forbid copy constructor.
     ISMColumn (const ISMColumn&);
 
@@ -391,9 +406,29 @@ private:
     // Handle the duplicated values after a bucket split.
     void handleSplit (ISMBucket& bucket, const Block<Bool>& duplicated);
 
+    // Find the interval containing the row in the interval cache.
+    // It returns a pointer to its value in external format and sets the
+    // start and end row of the interval. If not found, 0 is returned.
+    const char* findInterval (Int rownr, Int& startRow, Int& endRow) const;
+
+    // Add an interval to the interval cache, replacing the oldest one.
+    void cacheInterval (Int startRow, Int endRow, const char* value,
+			uInt leng);
+
+    // Get the scalar values of <src>nrrow</src> rows starting at
+    // <src>startrow</src>. It walks through the intervals of each bucket,
+    // so each value is converted once and copied to all rows of its
+    // interval.
+    template<typename T>
+    void getColumnRange (uInt startrow, uInt nrrow, T* values);
+
     // Compare the values.
     virtual Bool compareValue (const void* val1, const void* val2) const;
 
+    //# The interval cache and the next entry to replace.
+    CachedInterval    intervals_p[nrCachedIntervals_p];
+    uInt              nextInterval_p;
+
     // Handle a String in copying to/from external format.
     // <group>
     static uInt fromString (void* out, const void* in, uInt n,
@@ -102,8 +102,9 @@ void ISMIndColumn::reopenRW()
     iosfile_p->reopenRW();
 }
 
-void ISMIndColumn::addRow (uInt, uInt oldNrrow)
+void ISMIndColumn::addRow (uInt newNrrow, uInt oldNrrow)
 {
+    ISMColumn::addRow (newNrrow, oldNrrow);
     // If the shape is fixed and if the first row is added, define
     // an array to have an array for all rows.
     // Later rows get the value of a previous row, so we don't have to
@@ -319,7 +320,8 @@ void ISMIndColumn::init (ByteIO::OpenOption fileOption)
         char strc[8];
 	sprintf (strc, "i%i", seqnr_p);
 	iosfile_p = new StManArrayFile (stmanPtr_p->fileName() + strc,
-					fileOption, 1, asBigEndian);
+					fileOption, 1, asBigEndian, 65536,
+					stmanPtr_p->multiFile());
     }
 }
 
@@ -137,6 +137,12 @@ void MemoryTable::flush (Bool, Bool)
 void MemoryTable::resync()
 {}
 
+void MemoryTable::setConcurrentRead (Bool concurrentRead)
+{
+  BaseTable::setConcurrentRead (concurrentRead);
+  colSetPtr_p->setConcurrentRead (concurrentRead);
+}
+
  uInt MemoryTable::getModifyCounter() const
 {
   return 0;
@@ -127,6 +127,9 @@ public:
   // Resyncing the Table is a no-op.
   virtual void resync();
 
+  // Set the concurrent read mode in the ColumnSet.
+  virtual void setConcurrentRead (Bool concurrentRead);
+
   // Get the modify counter. It always returns 0.
   virtual uInt getModifyCounter() const;
 
@@ -95,6 +95,16 @@ Bool PlainColumn::isWritable() const
 Bool PlainColumn::isStored() const
     { return dataManPtr_p->isStorageManager(); }
 
+Bool PlainColumn::getRangeRows (Double minValue, Double maxValue,
+                                Vector<uInt>& rownrs)
+{
+    ConcurrentReadLock locker(*colSetPtr_p);
+    checkReadLock (True);
+    Bool found = dataColPtr_p->getRangeRows (minValue, maxValue, rownrs);
+    autoReleaseLock();
+    return found;
+}
+
 ColumnCache& PlainColumn::columnCache()
     { return dataColPtr_p->columnCache(); }
 
@@ -97,6 +97,11 @@ public:
     // Test if the column is stored (otherwise it is virtual).
     virtual Bool isStored() const;
 
+    // Ask the data manager for the rows that might contain a value in the
+    // interval [minValue,maxValue].
+    virtual Bool getRangeRows (Double minValue, Double maxValue,
+                               Vector<uInt>& rownrs);
+
     // Get access to the column keyword set.
     // <group>
     TableRecord& rwKeywordSet();
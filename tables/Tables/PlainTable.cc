@@ -107,6 +107,11 @@ PlainTable::PlainTable (SetupNewTable& newtab, uInt nrrow, Bool initialize,
     //# Create the table directory (and possibly delete existing files)
     //# as needed.
     makeTableDir();
+    //# Create the MultiFile if the storage manager files have to be
+    //# combined in a single file.
+    StorageOption storageOpt (newtab.storageOption());
+    storageOpt.fillOption();
+    colSetPtr_p->createMultiFile (name_p, storageOpt);
     //# Create the lock object.
     //# When needed, it sets a permanent write lock.
     //# Acquire a write lock.
@@ -474,6 +479,12 @@ void PlainTable::flush (Bool fsync, Bool recursive)
     }
 }
 
+void PlainTable::setConcurrentRead (Bool concurrentRead)
+{
+    BaseTable::setConcurrentRead (concurrentRead);
+    colSetPtr_p->setConcurrentRead (concurrentRead);
+}
+
 void PlainTable::resync()
 {
     TableTrace::traceFile (itsTraceId, "resync");
@@ -160,6 +160,9 @@ public:
     // Resync the Table object with the table file.
     virtual void resync();
 
+    // Set the concurrent read mode in the ColumnSet.
+    virtual void setConcurrentRead (Bool concurrentRead);
+
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
@@ -131,66 +131,66 @@ void RefColumn::putSlice (uInt rownr, const Slicer& ns, const void* dataPtr)
 
 void RefColumn::getScalarColumn (void* dataPtr) const
 {
-    colPtr_p->getScalarColumnCells (refTabPtr_p->rowNumbers(), dataPtr);
+    colPtr_p->getScalarColumnCells (refTabPtr_p->rootRows(), dataPtr);
 }
 void RefColumn::getArrayColumn (void* dataPtr) const
 {
-    colPtr_p->getArrayColumnCells (refTabPtr_p->rowNumbers(), dataPtr);
+    colPtr_p->getArrayColumnCells (refTabPtr_p->rootRows(), dataPtr);
 }
 void RefColumn::getColumnSlice (const Slicer& ns,
 				void* dataPtr) const
 {
-    colPtr_p->getColumnSliceCells (refTabPtr_p->rowNumbers(), ns, dataPtr); 
+    colPtr_p->getColumnSliceCells (refTabPtr_p->rootRows(), ns, dataPtr); 
 }
 void RefColumn::getScalarColumnCells (const RefRows& rownrs,
 				      void* dataPtr) const
 {
-    colPtr_p->getScalarColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->getScalarColumnCells (refTabPtr_p->rootRows(rownrs),
 				    dataPtr);
 }
 void RefColumn::getArrayColumnCells (const RefRows& rownrs,
 				     void* dataPtr) const
 {
-    colPtr_p->getArrayColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->getArrayColumnCells (refTabPtr_p->rootRows(rownrs),
 				   dataPtr);
 }
 void RefColumn::getColumnSliceCells (const RefRows& rownrs,
 				     const Slicer& ns,
 				     void* dataPtr) const
 {
-    colPtr_p->getColumnSliceCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->getColumnSliceCells (refTabPtr_p->rootRows(rownrs),
 				   ns, dataPtr);
 }
 void RefColumn::putScalarColumn (const void* dataPtr)
 {
-    colPtr_p->putScalarColumnCells (refTabPtr_p->rowNumbers(), dataPtr);
+    colPtr_p->putScalarColumnCells (refTabPtr_p->rootRows(), dataPtr);
 }
 void RefColumn::putArrayColumn (const void* dataPtr)
 {
-    colPtr_p->putArrayColumnCells (refTabPtr_p->rowNumbers(), dataPtr);
+    colPtr_p->putArrayColumnCells (refTabPtr_p->rootRows(), dataPtr);
 }
 void RefColumn::putColumnSlice (const Slicer& ns,
 				const void* dataPtr)
 {
-    colPtr_p->putColumnSliceCells (refTabPtr_p->rowNumbers(), ns, dataPtr); 
+    colPtr_p->putColumnSliceCells (refTabPtr_p->rootRows(), ns, dataPtr); 
 }
 void RefColumn::putScalarColumnCells (const RefRows& rownrs,
 				      const void* dataPtr)
 {
-    colPtr_p->putScalarColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->putScalarColumnCells (refTabPtr_p->rootRows(rownrs),
 				    dataPtr);
 }
 void RefColumn::putArrayColumnCells (const RefRows& rownrs,
 				     const void* dataPtr)
 {
-    colPtr_p->putArrayColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->putArrayColumnCells (refTabPtr_p->rootRows(rownrs),
 				   dataPtr);
 }
 void RefColumn::putColumnSliceCells (const RefRows& rownrs,
 				     const Slicer& ns,
 				     const void* dataPtr)
 {
-    colPtr_p->putColumnSliceCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->putColumnSliceCells (refTabPtr_p->rootRows(rownrs),
 				   ns, dataPtr);
 }
 
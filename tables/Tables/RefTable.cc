@@ -27,6 +27,7 @@
 
 #include <tables/Tables/RefTable.h>
 #include <tables/Tables/RefColumn.h>
+#include <tables/Tables/RefRows.h>
 #include <tables/Tables/Table.h>
 #include <tables/Tables/TableDesc.h>
 #include <tables/Tables/TableLock.h>
@@ -40,6 +41,7 @@
 #include <casa/BasicMath/Math.h>
 #include <tables/Tables/TableError.h>
 #include <casa/Utilities/Assert.h>
+#include <algorithm>
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -48,6 +50,7 @@ RefTable::RefTable (AipsIO& ios, const String& name, uInt nrrow, int opt,
 		    const TableLock& lockOptions, const TSMOption& tsmOption)
 : BaseTable    (name, opt, nrrow),
   rowStorage_p (0),              // initially empty vector of rownrs
+  nrrange_p    (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (False)
@@ -68,6 +71,7 @@ RefTable::RefTable (BaseTable* btp, Bool order, uInt nrall)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (order),
   rowStorage_p (nrall),       // allocate vector of rownrs
+  nrrange_p    (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -87,6 +91,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<uInt>& rownrs)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (True),
   rowStorage_p (0),
+  nrrange_p    (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -106,6 +111,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<uInt>& rownrs)
     //# Adjust rownrs in case input table is a reference table.
     //# Link to the root table.
     rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
+    compactRows();
     baseTabPtr_p->link();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
@@ -115,6 +121,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),              // initially empty vector of rownrs
+  nrrange_p    (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -132,6 +139,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
     //# Adjust rownrs in case input table is a reference table.
     //# Link to the root table.
     rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
+    compactRows();
     baseTabPtr_p->link();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
@@ -141,6 +149,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),
+  nrrange_p    (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -158,6 +167,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
     //# Copy them to this table.
     rowStorage_p = btp->rowNumbers();
     rows_p = getStorage (rowStorage_p);
+    compactRows();
     //# Link to the root table.
     baseTabPtr_p->link();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'p');
@@ -254,6 +264,12 @@ void RefTable::resync()
     baseTabPtr_p->resync();
 }
 
+void RefTable::setConcurrentRead (Bool concurrentRead)
+{
+    BaseTable::setConcurrentRead (concurrentRead);
+    baseTabPtr_p->setConcurrentRead (concurrentRead);
+}
+
 uInt RefTable::getModifyCounter() const
 {
     return baseTabPtr_p->getModifyCounter();
@@ -267,7 +283,7 @@ Bool RefTable::adjustRownrs (uInt nr, Vector<uInt>& rowStorage,
     uInt* rownrs = getStorage (rowStorage);
     Bool rowOrder = True;
     for (uInt i=0; i<nr; i++) {
-	rownrs[i] = rows_p[rownrs[i]];
+	rownrs[i] = rootRownr (rownrs[i]);
     }
     if (determineOrder) {
 	for (uInt i=1; i<nr; i++) {
@@ -304,7 +320,12 @@ void RefTable::writeRefTable (Bool)
 	ios << names;
 	ios << baseTabPtr_p->nrow();
 	ios << rowOrd_p;
-	ios.put (nrrow_p, rows_p);
+	if (nrrange_p > 0) {
+	    Vector<uInt> rows (rowNumbers());
+	    ios.put (nrrow_p, rows.data());
+	} else {
+	    ios.put (nrrow_p, rows_p);
+	}
 	ios.putend();
 	writeEnd (ios);
 	changed_p = False;
@@ -337,6 +358,7 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
     rows_p = getStorage (rowStorage_p);
     ios.get (nrrow, rows_p);
     ios.getend();
+    compactRows();
     //# Now read in the root table referenced to.
     //# Check if #rows has not decreased, which is about the only thing
     //# we can do to make sure the referenced rows are still the same.
@@ -488,6 +510,7 @@ void RefTable::addRefCol (const TableDesc& tdesc)
 //# Add a row number of the root table.
 void RefTable::addRownr (uInt rnr)
 {
+    expandRows();
     uInt nrow = rowStorage_p.nelements();
     if (nrrow_p >= nrow) {
         nrow = max ( nrow + 1024, uInt(1.2f * nrow));
@@ -498,12 +521,59 @@ void RefTable::addRownr (uInt rnr)
     changed_p = True;
 }
 
+void RefTable::setRows (const BaseTable& btp, const Block<uInt>& starts,
+                        const Block<uInt>& ends, uInt nrrange)
+{
+    const RefTable* parent = dynamic_cast<const RefTable*>(&btp);
+    if (parent == 0) {
+        setRanges (starts, ends, nrrange);
+    } else {
+        //# Map the ranges to the root table and merge adjacent root rows.
+        //# A range is mapped in parts if the parent holds ranges;
+        //# otherwise each row has to be mapped.
+        Block<uInt> rootStarts(nrrange);
+        Block<uInt> rootEnds(nrrange);
+        uInt nr = 0;
+        uInt inx = 0;
+        for (uInt i=0; i<nrrange; i++) {
+            uInt rownr = starts[i];
+            while (rownr <= ends[i]) {
+                uInt st;
+                uInt n = 1;
+                if (parent->nrrange_p > 0) {
+                    inx = parent->findRange (rownr, inx);
+                    st  = parent->rangeStart_p[inx] + rownr -
+                          parent->rangeRow_p[inx];
+                    n   = min(ends[i]+1, parent->rangeRow_p[inx+1]) - rownr;
+                } else {
+                    st = parent->rows_p[rownr];
+                }
+                if (nr > 0  &&  st == rootEnds[nr-1] + 1) {
+                    rootEnds[nr-1] += n;
+                } else {
+                    if (nr == rootStarts.nelements()) {
+                        rootStarts.resize (2*nr, True, True);
+                        rootEnds.resize (2*nr, True, True);
+                    }
+                    rootStarts[nr] = st;
+                    rootEnds[nr]   = st + n - 1;
+                    nr++;
+                }
+                rownr += n;
+            }
+        }
+        setRanges (rootStarts, rootEnds, nr);
+    }
+    changed_p = True;
+}
+
 //# Set exact number of rows.
 void RefTable::setNrrow (uInt nrrow)
 {
     if (nrrow > nrrow_p) {
 	throw (TableError ("RefTable::setNrrow: exceeds current nrrow"));
     }
+    expandRows();
     rows_p = getStorage (rowStorage_p);
     nrrow_p = nrrow;
     changed_p = True;
@@ -656,18 +726,186 @@ BaseColumn* RefTable::getColumn (uInt columnIndex) const
     
 
 Vector<uInt>* RefTable::rowStorage()
-    { return &rowStorage_p; }
+{
+    expandRows();
+    return &rowStorage_p;
+}
 
 //# Convert a vector of row numbers to row numbers in this table.
 Vector<uInt> RefTable::rootRownr (const Vector<uInt>& rownrs) const
 {
     uInt nrow = rownrs.nelements();
     Vector<uInt> rnr(nrow);
-    for (uInt i=0; i<nrow; i++) {
-	rnr(i) = rows_p[rownrs(i)];
+    if (nrrange_p == 0) {
+	for (uInt i=0; i<nrow; i++) {
+	    rnr(i) = rows_p[rownrs(i)];
+	}
+    } else {
+	uInt inx = 0;
+	for (uInt i=0; i<nrow; i++) {
+	    inx = findRange (rownrs(i), inx);
+	    rnr(i) = rangeStart_p[inx] + rownrs(i) - rangeRow_p[inx];
+	}
     }
     return rnr;
 }
+
+RefRows RefTable::rootRows() const
+{
+    if (nrrange_p == 0) {
+        return RefRows (rowNumbers());
+    }
+    Vector<uInt> slices(3*nrrange_p);
+    for (uInt i=0; i<nrrange_p; i++) {
+        slices[3*i]   = rangeStart_p[i];
+        slices[3*i+1] = rangeStart_p[i] + rangeRow_p[i+1] - rangeRow_p[i] - 1;
+        slices[3*i+2] = 1;
+    }
+    return RefRows (slices, True);
+}
+
+RefRows RefTable::rootRows (const RefRows& rownrs) const
+{
+    if (nrrange_p == 0) {
+        return RefRows (rownrs.convert (rowNumbers()));
+    }
+    //# Map each slice to slices in the root table.
+    //# A slice with increment 1 is split at the range boundaries; otherwise
+    //# each row is mapped. Consecutive root rows are merged into a slice.
+    Block<uInt> slices(3*nrrange_p + 3);
+    uInt nrslice = 0;
+    uInt inx = 0;
+    RefRowsSliceIter iter(rownrs);
+    while (! iter.pastEnd()) {
+        uInt rownr = iter.sliceStart();
+        uInt end   = iter.sliceEnd();
+        uInt incr  = iter.sliceIncr();
+        while (rownr <= end) {
+            inx = findRange (rownr, inx);
+            uInt st = rangeStart_p[inx] + rownr - rangeRow_p[inx];
+            uInt nr = 1;
+            if (incr == 1) {
+                nr = min(end+1, rangeRow_p[inx+1]) - rownr;
+            }
+            if (nrslice > 0  &&  st == slices[3*nrslice-2] + 1) {
+                slices[3*nrslice-2] += nr;
+            } else {
+                if (3*nrslice == slices.nelements()) {
+                    slices.resize (2*slices.nelements());
+                }
+                slices[3*nrslice]   = st;
+                slices[3*nrslice+1] = st + nr - 1;
+                slices[3*nrslice+2] = 1;
+                nrslice++;
+            }
+            rownr += nr * incr;
+        }
+        iter++;
+    }
+    Vector<uInt> vec(IPosition(1, 3*nrslice), slices.storage(), SHARE);
+    return RefRows (vec.copy(), True);
+}
+
+uInt RefTable::findRange (uInt rownr, uInt hint) const
+{
+    if (hint < nrrange_p  &&
+        rownr >= rangeRow_p[hint]  &&  rownr < rangeRow_p[hint+1]) {
+        return hint;
+    }
+    //# Binary search for the last range starting at or before rownr.
+    const uInt* first = rangeRow_p.storage();
+    return std::upper_bound (first, first + nrrange_p, rownr) - first - 1;
+}
+
+uInt RefTable::rangeRootRownr (uInt rownr) const
+{
+    uInt inx = findRange (rownr);
+    return rangeStart_p[inx] + rownr - rangeRow_p[inx];
+}
+
+void RefTable::compactRows()
+{
+    if (nrrange_p > 0  ||  nrrow_p == 0) {
+        return;
+    }
+    //# Count the number of ranges and see if it is worth it.
+    uInt nrrange = 1;
+    for (uInt i=1; i<nrrow_p; i++) {
+        if (rows_p[i] != rows_p[i-1] + 1) {
+            nrrange++;
+        }
+    }
+    if (4*nrrange > nrrow_p) {
+        return;
+    }
+    rangeStart_p.resize (nrrange, True, False);
+    rangeRow_p.resize (nrrange+1, True, False);
+    uInt nr = 0;
+    for (uInt i=0; i<nrrow_p; i++) {
+        if (i == 0  ||  rows_p[i] != rows_p[i-1] + 1) {
+            rangeStart_p[nr] = rows_p[i];
+            rangeRow_p[nr]   = i;
+            nr++;
+        }
+    }
+    rangeRow_p[nr] = nrrow_p;
+    nrrange_p   = nrrange;
+    rowStorage_p.resize (0);
+    rows_p = 0;
+}
+
+void RefTable::expandRows()
+{
+    if (nrrange_p > 0) {
+        rowStorage_p.resize (nrrow_p);
+        rows_p = getStorage (rowStorage_p);
+        uInt* rows = rows_p;
+        for (uInt i=0; i<nrrange_p; i++) {
+            uInt st = rangeStart_p[i];
+            uInt nr = rangeRow_p[i+1] - rangeRow_p[i];
+            for (uInt j=0; j<nr; j++) {
+                *rows++ = st + j;
+            }
+        }
+        nrrange_p = 0;
+        rangeStart_p.resize (0, True, False);
+        rangeRow_p.resize (0, True, False);
+    }
+}
+
+void RefTable::setRanges (const Block<uInt>& starts, const Block<uInt>& ends,
+                          uInt nrrange)
+{
+    //# All rows are replaced, so the current ranges need not be expanded.
+    nrrange_p = 0;
+    nrrow_p = 0;
+    for (uInt i=0; i<nrrange; i++) {
+        nrrow_p += ends[i] - starts[i] + 1;
+    }
+    if (nrrange > 0  &&  4*nrrange <= nrrow_p) {
+        rangeStart_p.resize (nrrange, True, False);
+        rangeRow_p.resize (nrrange+1, True, False);
+        uInt nr = 0;
+        for (uInt i=0; i<nrrange; i++) {
+            rangeStart_p[i] = starts[i];
+            rangeRow_p[i]   = nr;
+            nr += ends[i] - starts[i] + 1;
+        }
+        rangeRow_p[nrrange] = nr;
+        nrrange_p   = nrrange;
+        rowStorage_p.resize (0);
+        rows_p = 0;
+    } else {
+        rowStorage_p.resize (nrrow_p);
+        rows_p = getStorage (rowStorage_p);
+        uInt nr = 0;
+        for (uInt i=0; i<nrrange; i++) {
+            for (uInt j=starts[i]; j<=ends[i]; j++) {
+                rows_p[nr++] = j;
+            }
+        }
+    }
+}
 	
 
 BaseTable* RefTable::root()
@@ -677,6 +915,16 @@ Bool RefTable::rowOrder() const
 
 Vector<uInt> RefTable::rowNumbers () const
 {
+    if (nrrange_p > 0) {
+        Vector<uInt> vec(nrrow_p);
+        uInt nr = 0;
+        for (uInt i=0; i<nrrange_p; i++) {
+            for (uInt j=rangeRow_p[i]; j<rangeRow_p[i+1]; j++) {
+                vec[nr++] = rangeStart_p[i] + j - rangeRow_p[i];
+            }
+        }
+        return vec;
+    }
     if (nrrow_p == rowStorage_p.nelements()) {
 	return rowStorage_p;
     }
@@ -763,6 +1011,7 @@ void RefTable::removeRow (uInt rownr)
     if (rownr >= nrrow_p) {
 	throw (TableInvOper ("removeRow: rownr out of bounds"));
     }
+    expandRows();
     if (rownr < nrrow_p - 1) {
 	objmove (rows_p+rownr, rows_p+rownr+1, nrrow_p-rownr-1);
     }
@@ -843,6 +1092,7 @@ void RefTable::refAnd (uInt nr1, const uInt* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
 }
 
@@ -881,6 +1131,7 @@ void RefTable::refOr (uInt nr1, const uInt* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
 }
 
@@ -917,6 +1168,7 @@ void RefTable::refSub (uInt nr1, const uInt* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
 }
 
@@ -954,6 +1206,7 @@ void RefTable::refXor (uInt nr1, const uInt* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
 }
 
@@ -977,6 +1230,78 @@ void RefTable::refNot (uInt nr, const uInt* inx, uInt nrtot)
     for (j=start; j<nrtot; j++) {             // handle last interval
 	rows_p[nrrow_p++] = j;
     }
+    compactRows();
+    changed_p = True;
+}
+
+// And 2 tables holding their rows as ranges in ascending order.
+void RefTable::refAnd (const RefTable& that1, const RefTable& that2)
+{
+    uInt nr1 = that1.nrrange_p;
+    uInt nr2 = that2.nrrange_p;
+    Block<uInt> starts(nr1 + nr2);
+    Block<uInt> ends(nr1 + nr2);
+    uInt nrrange = 0;
+    uInt i1 = 0;
+    uInt i2 = 0;
+    while (i1 < nr1  &&  i2 < nr2) {
+        uInt st1 = that1.rangeStart_p[i1];
+        uInt end1 = st1 + that1.rangeRow_p[i1+1] - that1.rangeRow_p[i1] - 1;
+        uInt st2 = that2.rangeStart_p[i2];
+        uInt end2 = st2 + that2.rangeRow_p[i2+1] - that2.rangeRow_p[i2] - 1;
+        uInt st = max(st1, st2);
+        uInt end = min(end1, end2);
+        if (st <= end) {
+            starts[nrrange] = st;
+            ends[nrrange] = end;
+            nrrange++;
+        }
+        // Continue with the range ending first.
+        if (end1 < end2) {
+            i1++;
+        } else {
+            i2++;
+        }
+    }
+    setRanges (starts, ends, nrrange);
+    changed_p = True;
+}
+
+// Or 2 tables holding their rows as ranges in ascending order.
+void RefTable::refOr (const RefTable& that1, const RefTable& that2)
+{
+    uInt nr1 = that1.nrrange_p;
+    uInt nr2 = that2.nrrange_p;
+    Block<uInt> starts(nr1 + nr2);
+    Block<uInt> ends(nr1 + nr2);
+    uInt nrrange = 0;
+    uInt i1 = 0;
+    uInt i2 = 0;
+    while (i1 < nr1  ||  i2 < nr2) {
+        // Take the range starting first and merge it with the last one
+        // if they overlap or are adjacent.
+        uInt st, end;
+        if (i2 >= nr2  ||
+            (i1 < nr1  &&  that1.rangeStart_p[i1] <= that2.rangeStart_p[i2])) {
+            st = that1.rangeStart_p[i1];
+            end = st + that1.rangeRow_p[i1+1] - that1.rangeRow_p[i1] - 1;
+            i1++;
+        } else {
+            st = that2.rangeStart_p[i2];
+            end = st + that2.rangeRow_p[i2+1] - that2.rangeRow_p[i2] - 1;
+            i2++;
+        }
+        if (nrrange > 0  &&  st <= ends[nrrange-1] + 1) {
+            if (end > ends[nrrange-1]) {
+                ends[nrrange-1] = end;
+            }
+        } else {
+            starts[nrrange] = st;
+            ends[nrrange] = end;
+            nrrange++;
+        }
+    }
+    setRanges (starts, ends, nrrange);
     changed_p = True;
 }
 
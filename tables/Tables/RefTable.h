@@ -35,6 +35,7 @@
 #include <casa/BasicSL/String.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Containers/SimOrdMap.h>
+#include <casa/Containers/Block.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -42,6 +43,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 class TSMOption;
 class RefColumn;
 class AipsIO;
+class RefRows;
 
 
 // <summary>
@@ -75,6 +77,15 @@ class AipsIO;
 // while (if needed) converting the given row number to the row number
 // in the referenced table. For that purpose RefTable maintains a
 // Vector of the row numbers in the referenced table.
+// <br>A selection often consists of a few long runs of consecutive rows
+// (e.g. a time range). In that case the row numbers are held as ranges
+// instead of a Vector, which saves memory and makes it possible to access
+// the referenced column in bulk for each range. The Vector is
+// created again (once) when needed (e.g. when a row is added to or
+// removed from the RefTable).
+// <br>The ranges are not changed while reading the table, so it can be read
+// by multiple threads in concurrent read mode (see
+// <src>Table::setConcurrentRead</src>).
 //
 // The RefTable constructor acts in a way that it will always reference
 // the original table. This means that if a select is done on a RefTable,
@@ -88,9 +99,6 @@ class AipsIO;
 
 // <todo asof="$DATE:$">
 //# A List of bugs, limitations, extensions or planned refinements.
-//   <li> Maybe not allocating the row number vector for a projection.
-//          This saves space and time, but each rownr conversion will
-//          take a bit more time because it has to test if there is a vector.
 //   <li> Maybe maintain a Vector<String> telling on which columns
 //          the table is ordered. This may speed up selection, but
 //          it is hard to check if the order is changed by a put.
@@ -192,6 +200,9 @@ public:
     // Resync the Table object with the table file.
     virtual void resync();
 
+    // Set the concurrent read mode (also in the underlying table).
+    virtual void setConcurrentRead (Bool concurrentRead);
+
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
@@ -293,6 +304,23 @@ public:
     // This converts the given row numbers to row numbers in the root table.
     Vector<uInt> rootRownr (const Vector<uInt>& rownrs) const;
 
+    // Get the row numbers in the root table as a RefRows object.
+    // If the rows are held as ranges, the RefRows object contains a slice
+    // per range, so the root column can be accessed in bulk per range.
+    // The second version converts the given row numbers in this table.
+    // <group>
+    RefRows rootRows() const;
+    RefRows rootRows (const RefRows& rownrs) const;
+    // </group>
+
+    // Are the row numbers held as ranges?
+    Bool hasRowRanges() const
+        { return nrrange_p > 0; }
+
+    // Try to hold the row numbers as ranges. This is done if the number
+    // of ranges is at most a quarter of the number of rows.
+    void compactRows();
+
     // Tell if the table is in row order.
     virtual Bool rowOrder() const;
 
@@ -303,6 +331,15 @@ public:
     // Add a rownr to reference table.
     void addRownr (uInt rownr);
 
+    // Set the rows of the table from ranges of row numbers in the given
+    // table (which can be a RefTable itself). The ranges are converted to
+    // ranges of row numbers in the root table, so the rows can be held as
+    // ranges without creating a vector of all row numbers first.
+    // Range i contains the rows <src>starts[i]</src> till
+    // <src>ends[i]</src> (inclusive).
+    void setRows (const BaseTable& btp, const Block<uInt>& starts,
+                  const Block<uInt>& ends, uInt nrrange);
+
     // Set the exact number of rows in the table.
     // An exception is thrown if more than current nrrow.
     void setNrrow (uInt nrrow);
@@ -320,6 +357,13 @@ public:
     void refXor (uInt nr1, const uInt* rows1, uInt nr2, const uInt* rows2);
     void refNot (uInt nr1, const uInt* rows1, uInt nrmain);
 
+    // And or or the row ranges of 2 tables holding their rows as ranges
+    // in row order.
+    // <group>
+    void refAnd (const RefTable& that1, const RefTable& that2);
+    void refOr  (const RefTable& that1, const RefTable& that2);
+    // </group>
+
     // Get the internal pointer in a rowStorage vector.
     // It checks whether no copy is made of the data.
     static uInt* getStorage (Vector<uInt>& rownrs);
@@ -329,6 +373,13 @@ private:
     Bool         rowOrd_p;                     //# True = table is in row order
     Vector<uInt> rowStorage_p;                 //# row numbers in parent table
     uInt*        rows_p;                       //# Pointer to rowStorage_p
+    //# Row numbers held as ranges (only if nrrange_p > 0).
+    //# Range i contains the rows rangeRow_p[i] till rangeRow_p[i+1]
+    //# (exclusive) in this table, which map to the parent rows starting
+    //# at rangeStart_p[i].
+    uInt         nrrange_p;                    //# number of ranges
+    Block<uInt>  rangeStart_p;                 //# first parent rownr
+    Block<uInt>  rangeRow_p;                   //# first rownr (and sentinel)
     SimpleOrderedMap<String,String> nameMap_p; //# map to column name in parent
     SimpleOrderedMap<String,RefColumn*> colMap_p; //# map name to column
     Bool         changed_p;                 //# True = changed since last write
@@ -343,6 +394,22 @@ private:
     // Declaring it private, makes it unusable.
     RefTable& operator= (const RefTable&);
 
+    // Get the root rownr from the ranges.
+    uInt rangeRootRownr (uInt rownr) const;
+
+    // Find the range containing the given row number.
+    // Usually rows are accessed sequentially, so the caller can give the
+    // range found last as a hint, which is tried first.
+    uInt findRange (uInt rownr, uInt hint=0) const;
+
+    // Store the row numbers in the vector again (if held as ranges).
+    void expandRows();
+
+    // Set the row ranges (given as start and end parent rownr).
+    // The vector is used instead if the ranges do not save enough.
+    void setRanges (const Block<uInt>& starts, const Block<uInt>& ends,
+                    uInt nrrange);
+
     // Get the names of the tables this table consists of.
     virtual void getPartNames (Block<String>& names, Bool recursive) const;
 
@@ -386,7 +453,7 @@ private:
 
 
 inline uInt RefTable::rootRownr (uInt rnr) const
-    { return rows_p[rnr]; }
+    { return (nrrange_p == 0  ?  rows_p[rnr] : rangeRootRownr(rnr)); }
 
 
 
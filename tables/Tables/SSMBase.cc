@@ -40,6 +40,8 @@
 #include <casa/Utilities/Assert.h>
 #include <casa/IO/BucketCache.h>
 #include <casa/IO/BucketFile.h>
+#include <casa/IO/MMapfdIO.h>
+#include <casa/System/AipsrcValue.h>
 #include <casa/IO/AipsIO.h>
 #include <casa/IO/MemoryIO.h>
 #include <casa/IO/CanonicalIO.h>
@@ -74,7 +76,9 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (False),
+  itsUseMapped         (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -106,7 +110,9 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (False),
+  itsUseMapped         (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -138,7 +144,9 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (False),
+  itsUseMapped         (False)
 { 
   // Get bucketrows if defined.
   if (spec.isDefined ("BUCKETROWS")) {
@@ -157,6 +165,9 @@ SSMBase::SSMBase (const String& aDataManName,
   if (spec.isDefined ("PERSCACHESIZE")) {
     itsPersCacheSize = max(2, spec.asInt ("PERSCACHESIZE"));
   }
+  if (spec.isDefined ("ZONEMAPS")) {
+    itsZoneMaps = spec.asBool ("ZONEMAPS");
+  }
 }
 
 SSMBase::SSMBase (const SSMBase& that)
@@ -179,7 +190,9 @@ SSMBase::SSMBase (const SSMBase& that)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (that.itsBucketSize),
   itsBucketRows        (that.itsBucketRows),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (that.itsZoneMaps),
+  itsUseMapped         (False)
 {}
 
 SSMBase::~SSMBase()
@@ -217,6 +230,7 @@ Record SSMBase::dataManagerSpec() const
   rec.define ("BUCKETSIZE", Int(itsBucketSize));
   rec.define ("PERSCACHESIZE", Int(itsPersCacheSize));
   rec.define ("IndexLength", Int(itsIndexLength));
+  rec.define ("ZONEMAPS", itsZoneMaps);
   return rec;
 }
 
@@ -226,6 +240,7 @@ Record SSMBase::getProperties() const
   const_cast<SSMBase*>(this)->getCache();
   Record rec;
   rec.define ("ActualCacheSize", Int(itsCacheSize));
+  rec.define ("ZoneMaps", itsZoneMaps);
   return rec;
 }
 
@@ -234,6 +249,25 @@ void SSMBase::setProperties (const Record& rec)
   if (rec.isDefined("ActualCacheSize")) {
     setCacheSize (rec.asInt("ActualCacheSize"), False);
   }
+  if (rec.isDefined("ZoneMaps")) {
+    setZoneMaps (rec.asBool("ZoneMaps"));
+  }
+}
+
+void SSMBase::setZoneMaps (Bool useZoneMaps)
+{
+  // Make sure an existing index (possibly with zone maps) has been read.
+  if (itsFile != 0) {
+    getCache();
+  }
+  if (useZoneMaps != itsZoneMaps) {
+    itsZoneMaps = useZoneMaps;
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->setZoneMap (itsZoneMaps);
+    }
+    // The index has to be rewritten (with or without zone maps).
+    isDataChanged = True;
+  }
 }
 
 void SSMBase::clearCache()
@@ -275,6 +309,15 @@ void SSMBase::showCacheStatistics (ostream& anOs) const
   }
 }
 
+Record SSMBase::getCacheStatistics() const
+{
+  Record rec;
+  if (itsCache != 0) {
+    addCacheStatistics (rec, *itsCache);
+  }
+  return rec;
+}
+
 void SSMBase::showIndexStatistics (ostream & anOs) const
 {
   uInt aNrIdx=itsPtrIndex.nelements();
@@ -398,16 +441,17 @@ void SSMBase::readHeader()
   itsFile->seek(0);
   
   // Use the file indicated by the fd from the BucketFile object
+  // (or the virtual file in the MultiFile).
   // Use a buffer size (512) equal to start of buckets in the file,
   // so the IO buffers in the different objects do not overlap.
-  FilebufIO aFio (itsFile->fd(), 512);
+  CountedPtr<ByteIO> aFio = itsFile->makeByteIO (512);
   TypeIO*   aTio;
   
   // It is stored in big or little endian canonical format.
   if (asBigEndian()) {
-    aTio = new CanonicalIO (&aFio);
+    aTio = new CanonicalIO (&(*aFio));
   } else {
-    aTio = new LECanonicalIO (&aFio);
+    aTio = new LECanonicalIO (&(*aFio));
   }
   AipsIO anOs (aTio);
   uInt version = anOs.getstart("StandardStMan");
@@ -505,6 +549,24 @@ void SSMBase::readIndexBuckets()
     itsPtrIndex[i] = new SSMIndex(this);
     itsPtrIndex[i]->get(anMOs);
   }
+
+  // The zone maps (if any) follow the indices.
+  // Older tables do not have them, so check if the buffer has more data.
+  if (anMOs.getpos() < Int64(itsIndexLength)) {
+    itsZoneMaps = True;
+    anMOs.getstart ("SSMZoneMaps");
+    uInt aNrCol;
+    anMOs >> aNrCol;
+    AlwaysAssert (aNrCol == ncolumn(), AipsError);
+    for (uInt i=0; i<aNrCol; i++) {
+      itsPtrColumn[i]->getZones (anMOs);
+    }
+    anMOs.getend();
+  } else {
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->setZoneMap (itsZoneMaps);
+    }
+  }
   
   anMOs.close();
   delete aMio;
@@ -517,18 +579,26 @@ void SSMBase::writeIndex()
   MemoryIO  aMemBuf;
 
   // Use the file indicated by the fd from the BucketFile object
+  // (or the virtual file in the MultiFile).
   // Use a buffer size (512) equal to start of buckets in the file,
   // so the IO buffers in the different objects do not overlap.
-  FilebufIO aFio (itsFile->fd(), 512);
+  CountedPtr<ByteIO> aFio = itsFile->makeByteIO (512);
   uInt aCLength = 2*CanonicalConversion::canonicalSize(&itsFirstIdxBucket);
 
+  // Bring the zone maps up-to-date before they are written.
+  if (itsZoneMaps) {
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->updateZones();
+    }
+  }
+
   // Store it in big or little endian canonical format.
   if (asBigEndian()) {
     aMio = new CanonicalIO (&aMemBuf);
-    aTio = new CanonicalIO (&aFio);
+    aTio = new CanonicalIO (&(*aFio));
   } else {
     aMio = new LECanonicalIO (&aMemBuf);
-    aTio = new LECanonicalIO (&aFio);
+    aTio = new LECanonicalIO (&(*aFio));
   }
   AipsIO anMOs (aMio);
 
@@ -536,6 +606,16 @@ void SSMBase::writeIndex()
   for (uInt i=0;i<aNrIdx; i++ ){
     itsPtrIndex[i]->put(anMOs);
   }
+  // Write the zone maps after the indices, so older software can still
+  // read the index.
+  if (itsZoneMaps) {
+    anMOs.putstart ("SSMZoneMaps", 1);
+    anMOs << ncolumn();
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->putZones (anMOs);
+    }
+    anMOs.putend();
+  }
   anMOs.close();
 
   // Write total Mio in buckets.
@@ -640,7 +720,7 @@ void SSMBase::writeIndex()
   anOs.putend();  
   anOs.close();
   delete aTio;
-  aFio.flush();
+  aFio->flush();
   // Synchronize to make sure it gets written to disk.
   // This is needed for NFS-files under Linux (to resolve defect 2752).
   itsFile->fsync();
@@ -805,6 +885,7 @@ void SSMBase::addColumn (DataManagerColumn* aColumn)
 
   }
 
+  aSSMC->setZoneMap (itsZoneMaps);
   aSSMC->addRow(itsNrRows,0,aBestFit != -1);
   isDataChanged = True;
 }
@@ -813,10 +894,24 @@ void SSMBase::removeBucket (uInt aBucketNr)
 {
   getCache().getBucket(aBucketNr);
   getCache().removeBucket();
+  // The bucket number can be reused, so its zones are not valid anymore.
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsPtrColumn[i]->invalidateZone (aBucketNr);
+  }
 }  
 
 char*  SSMBase::getBucket (uInt aBucketNr)
 {
+  // Read directly from the mapped file if possible.
+  // The buckets start at offset 512 (as given to the BucketCache).
+  if (itsUseMapped) {
+    MMapfdIO* aMapFile = itsFile->mappedFile();
+    Int64 anOffset = 512 + Int64(aBucketNr) * itsBucketSize;
+    if (aMapFile != 0  &&  anOffset + itsBucketSize <= aMapFile->getFileSize()) {
+      return const_cast<char*>(static_cast<const char*>
+                               (aMapFile->getReadPointer (anOffset)));
+    }
+  }
   return itsCache->getBucket(aBucketNr);
 }
   
@@ -917,6 +1012,23 @@ char* SSMBase::find(uInt aRowNr,     uInt aColNr,
   return aPtr + itsColumnOffset[aColNr];
 }
 
+char* SSMBase::find(uInt aRowNr,     uInt aColNr, 
+		    uInt& aStartRow, uInt& anEndRow, uInt& aBucketNr)
+{
+  findBucket (aRowNr, aColNr, aBucketNr, aStartRow, anEndRow);
+  char* aPtr = getBucket(aBucketNr);
+  return aPtr + itsColumnOffset[aColNr];
+}
+
+void SSMBase::findBucket (uInt aRowNr,     uInt aColNr, uInt& aBucketNr,
+                          uInt& aStartRow, uInt& anEndRow)
+{
+  // Make sure that cache is available and filled.
+  getCache();
+  itsPtrIndex[itsColIndexMap[aColNr]]->find (aRowNr, aBucketNr,
+                                             aStartRow, anEndRow);
+}
+
 
 
 void SSMBase::recreate()
@@ -933,7 +1045,7 @@ void SSMBase::recreate()
   itsFirstIdxBucket = -1;
   itsFreeBucketsNr = 0;
   itsFirstFreeBucket   = -1;
-  itsFile = new BucketFile (fileName());
+  itsFile = new BucketFile (fileName(), 0, False, multiFile());
   makeCache();
   // Let the Index recreate itself when needed
   uInt aNrIdx=itsPtrIndex.nelements();
@@ -996,6 +1108,10 @@ void SSMBase::resync (uInt aNrRows)
     itsCache->resync (itsNrBuckets, itsFreeBucketsNr, 
 		      itsFirstFreeBucket);
   }
+  // Remap the file if another process has extended it.
+  if (itsUseMapped  &&  itsFile->mappedFile() != 0) {
+    itsFile->mappedFile()->remap();
+  }
   if (itsPtrIndex.nelements() != 0) {
     readIndexBuckets();
   }  
@@ -1015,6 +1131,9 @@ void SSMBase::resync (uInt aNrRows)
 void SSMBase::create (uInt aNrRows)
 {
   init();
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsPtrColumn[i]->setZoneMap (itsZoneMaps);
+  }
   recreate();
   itsNrRows = 0;
   addRow (aNrRows);
@@ -1029,8 +1148,16 @@ void SSMBase::open (uInt aRowNr, AipsIO& ios)
   getBlock (ios,itsColIndexMap);
   ios.getend();
   
-  itsFile = new BucketFile (fileName(), table().isWritable());
+  // A readonly file is memory-mapped (unless switched off in aipsrc).
+  // A virtual file in a MultiFile cannot be mapped.
+  Bool useMapped = False;
+  if (! table().isWritable()  &&  multiFile() == 0) {
+    AipsrcValue<Bool>::find (useMapped, "table.ssm.mmap", True);
+  }
+  itsFile = new BucketFile (fileName(), table().isWritable(), 0, useMapped,
+                            multiFile());
   AlwaysAssert (itsFile != 0, AipsError);
+  itsUseMapped = useMapped;
 
   // Let the column object initialize themselves (if needed)
   uInt aNrCol = ncolumn();
@@ -1044,13 +1171,15 @@ StManArrayFile* SSMBase::openArrayFile (ByteIO::OpenOption anOpt)
 {
   if (itsIosFile == 0) {
     itsIosFile = new StManArrayFile (fileName() + 'i', anOpt,
-				     0, asBigEndian());
+				     0, asBigEndian(), 65536, multiFile());
   }
   return itsIosFile;
 }
 
 void SSMBase::reopenRW()
 {
+  // Buckets will be changed, so they have to be accessed via the cache.
+  itsUseMapped = False;
   if (itsFile != 0) {
     itsFile->setRW();
   }
@@ -1070,7 +1199,7 @@ void SSMBase::deleteManager()
   if (itsFile != 0) {
     itsFile->remove();
   }
-  DOos::remove (fileName(), False, False);
+  removeFile (fileName());
 }
 
 void SSMBase::init()
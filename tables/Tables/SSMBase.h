@@ -82,6 +82,10 @@ class SSMStringHandler;
 // <linkto class=BucketCache>BucketCache</linkto>.
 // It also keeps a list of free buckets. A bucket is freed when it is
 // not needed anymore (e.g. all data from it are deleted).
+// If the table is opened readonly, the file is memory-mapped and buckets
+// are read directly from the mapped file, thus without copying them into
+// the cache. This can be switched off by setting the aipsrc variable
+// <src>table.ssm.mmap</src> to false.
 // <p>
 // Data buckets form the main part of the SSM. The data can be viewed as
 // a few streams of buckets, where each stream contains the data of
@@ -189,13 +193,15 @@ public:
   virtual Record dataManagerSpec() const;
 
   // Get data manager properties that can be modified.
-  // It is only ActualCacheSize (the actual cache size in buckets).
+  // They are ActualCacheSize (the actual cache size in buckets) and
+  // ZoneMaps (are per-bucket zone maps maintained?).
   // It is a subset of the data manager specification.
   virtual Record getProperties() const;
 
   // Modify data manager properties.
-  // Only ActualCacheSize can be used. It is similar to function setCacheSize
+  // ActualCacheSize is similar to function setCacheSize
   // with <src>canExceedNrBuckets=False</src>.
+  // ZoneMaps is similar to function setZoneMaps.
   virtual void setProperties (const Record& spec);
 
   // Get the version of the class.
@@ -211,6 +217,18 @@ public:
 
   // Get the current cache size (in buckets).
   uInt getCacheSize() const;
+
+  // Enable or disable the zone maps.
+  // A zone map holds per data bucket the minimum, maximum, and number of
+  // NaNs of a numeric scalar column. It is used by
+  // <linkto class=SSMColumn>SSMColumn::getRangeRows</linkto> to skip
+  // buckets not containing any value in a given interval.
+  // The zone maps are stored with the index, so enabling them on an
+  // existing table means that they are calculated at the next flush.
+  void setZoneMaps (Bool useZoneMaps);
+
+  // Are zone maps maintained?
+  Bool useZoneMaps() const;
   
   // Clear the cache used by this storage manager.
   // It will flush the cache as needed and remove all buckets from it.
@@ -219,6 +237,9 @@ public:
   // Show the statistics of all caches used.
   virtual void showCacheStatistics (ostream& anOs) const;
 
+  // Get the statistics of the cache as a record.
+  virtual Record getCacheStatistics() const;
+
   // Show statistics of all indices used.
   void showIndexStatistics (ostream & anOs) const;
 
@@ -270,12 +291,29 @@ public:
   char* find (uInt aRowNr,     uInt aColNr, 
 	      uInt& aStartRow, uInt& anEndRow);
 
+  // Same as above, but also return the bucket number.
+  char* find (uInt aRowNr,     uInt aColNr, 
+	      uInt& aStartRow, uInt& anEndRow, uInt& aBucketNr);
+
+  // Find the bucket containing the column and row, but do not read it.
+  // It fills in the bucket number and the start and end row.
+  void findBucket (uInt aRowNr,     uInt aColNr, uInt& aBucketNr,
+                   uInt& aStartRow, uInt& anEndRow);
+
+  // Get the offset of the column data in a bucket.
+  uInt getColumnOffset (uInt aColNr) const;
+
   // Add a new bucket and get its bucket number.
   uInt getNewBucket();
 
   // Read the bucket (if needed) and return the pointer to it.
+  // If the table is readonly and the file is memory-mapped, the pointer
+  // points directly into the mapped file, so it must not be written into.
   char* getBucket (uInt aBucketNr);
 
+  // Is a readonly file read via a memory-mapped file?
+  Bool usesMappedFile() const;
+
   // Remove a bucket from the bucket cache.
   void removeBucket (uInt aBucketNr);
 
@@ -456,6 +494,12 @@ private:
   
   // Has the data changed since the last flush?
   Bool isDataChanged;
+
+  // Are zone maps maintained?
+  Bool itsZoneMaps;
+
+  // Are buckets read directly from the memory-mapped file?
+  Bool itsUseMapped;
 };
 
 
@@ -469,6 +513,21 @@ inline uInt SSMBase::getCacheSize() const
   return itsCacheSize;
 }
 
+inline Bool SSMBase::useZoneMaps() const
+{
+  return itsZoneMaps;
+}
+
+inline Bool SSMBase::usesMappedFile() const
+{
+  return itsUseMapped;
+}
+
+inline uInt SSMBase::getColumnOffset (uInt aColNr) const
+{
+  return itsColumnOffset[aColNr];
+}
+
 inline uInt SSMBase::getNRow() const
 {
   return itsNrRows;
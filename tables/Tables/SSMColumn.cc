@@ -29,6 +29,7 @@
 #include <tables/Tables/SSMBase.h>
 #include <tables/Tables/SSMStringHandler.h>
 #include <tables/Tables/RefRows.h>
+#include <tables/Tables/DataManError.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Utilities/ValType.h>
@@ -37,6 +38,11 @@
 #include <casa/BasicMath/Math.h>
 #include <casa/OS/CanonicalConversion.h>
 #include <casa/OS/LECanonicalConversion.h>
+#include <casa/IO/AipsIO.h>
+#include <casa/Containers/BlockIO.h>
+#include <casa/stdvector.h>
+#include <float.h>                     // for DBL_MAX
+#include <limits>
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -50,7 +56,8 @@ SSMColumn::SSMColumn (SSMBase* aParent, int aDataType, uInt aColNr)
   itsMaxLen      (0),
   itsNrElem      (1),
   itsNrCopy      (0),
-  itsData        (0)
+  itsData        (0),
+  itsUseZoneMap  (False)
 {
   init();
 }
@@ -91,8 +98,19 @@ void SSMColumn::getFile(uInt)
 {
 }
 
-void SSMColumn::addRow (uInt aNewNrRows, uInt, Bool doInit)
+void SSMColumn::addRow (uInt aNewNrRows, uInt anOldNrRows, Bool doInit)
 {
+  // The zones of the buckets getting the new rows are unknown now.
+  if (itsUseZoneMap) {
+    uInt aRowNr = anOldNrRows;
+    while (aRowNr < aNewNrRows) {
+      uInt aBucketNr, aStartRow, anEndRow;
+      itsSSMPtr->findBucket (aRowNr, itsColNr, aBucketNr,
+                             aStartRow, anEndRow);
+      invalidateZone (aBucketNr);
+      aRowNr = anEndRow+1;
+    }
+  }
   if (doInit  &&  dataType() == TpString) {
     uInt aRowNr=0;
     uInt aNrRows=aNewNrRows;
@@ -448,10 +466,15 @@ void SSMColumn::putValue(uInt aRowNr, const void* aValue)
 {
   uInt  aStartRow;
   uInt  anEndRow;
-  char* aDummy = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow);
+  uInt  aBucketNr;
+  char* aDummy = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
+                                  aBucketNr);
   itsWriteFunc (aDummy+(aRowNr-aStartRow)*itsExternalSizeBytes,
   		aValue, itsNrCopy);
   itsSSMPtr->setBucketDirty();
+  if (itsUseZoneMap) {
+    extendZone (aBucketNr, aValue);
+  }
 }
 
 void SSMColumn::putValueShortString(uInt aRowNr, const void* aValue,
@@ -558,6 +581,150 @@ void SSMColumn::getScalarColumnStringV (Vector<String>* aDataPtr)
   }
 }
 
+void SSMColumn::getScalarColumnCellsuCharV (const RefRows& aRownrs,
+                                          Vector<uChar>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsuCharV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  uChar* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsShortV (const RefRows& aRownrs,
+                                          Vector<Short>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsShortV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  Short* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsuShortV (const RefRows& aRownrs,
+                                          Vector<uShort>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsuShortV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  uShort* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsIntV (const RefRows& aRownrs,
+                                          Vector<Int>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsIntV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  Int* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsuIntV (const RefRows& aRownrs,
+                                          Vector<uInt>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsuIntV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  uInt* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsfloatV (const RefRows& aRownrs,
+                                          Vector<float>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsfloatV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  float* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsdoubleV (const RefRows& aRownrs,
+                                          Vector<double>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsdoubleV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  double* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsComplexV (const RefRows& aRownrs,
+                                          Vector<Complex>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsComplexV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  Complex* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getScalarColumnCellsDComplexV (const RefRows& aRownrs,
+                                          Vector<DComplex>* aDataPtr)
+{
+  if (! aRownrs.isSliced()) {
+    StManColumn::getScalarColumnCellsDComplexV (aRownrs, aDataPtr);
+    return;
+  }
+  Bool deleteIt;
+  DComplex* anArray=aDataPtr->getStorage(deleteIt);
+  getColumnCellsValue(aRownrs,anArray);
+  aDataPtr->putStorage(anArray,deleteIt);
+}
+
+void SSMColumn::getColumnCellsValue (const RefRows& aRownrs, void* anArray)
+{
+  char* aDataPtr = static_cast<char*>(anArray);
+  RefRowsSliceIter anIter(aRownrs);
+  while (! anIter.pastEnd()) {
+    uInt aRowNr = anIter.sliceStart();
+    uInt anEnd  = anIter.sliceEnd();
+    uInt anIncr = anIter.sliceIncr();
+    while (aRowNr <= anEnd) {
+      uInt  aStartRow;
+      uInt  anEndRow;
+      char* aValue;
+      aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow);
+      // Copy all rows of the slice in this bucket at once if consecutive.
+      uInt aNr = 1;
+      if (anIncr == 1) {
+        aNr = min(anEnd, anEndRow) - aRowNr + 1;
+      }
+      itsReadFunc (aDataPtr, aValue + (aRowNr-aStartRow)*itsExternalSizeBytes,
+                   aNr * itsNrCopy);
+      aDataPtr += aNr * itsLocalSize;
+      aRowNr += aNr * anIncr;
+    }
+    anIter++;
+  }
+}
+
 void SSMColumn::getColumnValue(void* anArray,uInt aNrRows)
 {
   char* aDataPtr = static_cast<char*>(anArray);
@@ -685,6 +852,10 @@ void SSMColumn::putColumnValue(const void* anArray,uInt aNrRows)
 
   // Be sure cache will be emptied
   columnCache().invalidate();
+  // All zones have to be recalculated.
+  if (itsUseZoneMap) {
+    itsZoneValid = False;
+  }
 }
 
 void SSMColumn::removeColumn()
@@ -746,6 +917,191 @@ void SSMColumn::init()
   }
 }
 
+void SSMColumn::setZoneMap (Bool useZoneMap)
+{
+  int aDT = dataType();
+  itsUseZoneMap = useZoneMap  &&  itsShape.nelements() == 0  &&
+                  (aDT == TpUChar  ||  aDT == TpShort  ||  aDT == TpUShort
+               ||  aDT == TpInt    ||  aDT == TpUInt   ||  aDT == TpFloat
+               ||  aDT == TpDouble);
+  itsZoneMin.resize   (0, True, False);
+  itsZoneMax.resize   (0, True, False);
+  itsZoneNaN.resize   (0, True, False);
+  itsZoneValid.resize (0, True, False);
+}
+
+void SSMColumn::invalidateZone (uInt aBucketNr)
+{
+  if (aBucketNr < itsZoneValid.nelements()) {
+    itsZoneValid[aBucketNr] = False;
+  }
+}
+
+void SSMColumn::extendZone (uInt aBucketNr, const void* aValue)
+{
+  if (aBucketNr < itsZoneValid.nelements()  &&  itsZoneValid[aBucketNr]) {
+    Double aMin = itsZoneMin[aBucketNr];
+    Double aMax = itsZoneMax[aBucketNr];
+    uInt aNrNaN = 0;
+    zoneRange (aValue, 1, aMin, aMax, aNrNaN);
+    if (aNrNaN > 0) {
+      itsZoneValid[aBucketNr] = False;
+    } else {
+      itsZoneMin[aBucketNr] = aMin;
+      itsZoneMax[aBucketNr] = aMax;
+    }
+  }
+}
+
+template<typename T>
+static void fillZoneRange (const void* aData, uInt aNrValues,
+                           Double& aMin, Double& aMax, uInt& aNrNaN)
+{
+  const T* aValues = static_cast<const T*>(aData);
+  for (uInt i=0; i<aNrValues; i++) {
+    Double aValue = aValues[i];
+    if (isNaN(aValue)) {
+      aNrNaN++;
+    } else {
+      if (aValue < aMin) aMin = aValue;
+      if (aValue > aMax) aMax = aValue;
+    }
+  }
+}
+
+void SSMColumn::zoneRange (const void* aData, uInt aNrValues,
+                           Double& aMin, Double& aMax, uInt& aNrNaN) const
+{
+  switch (dataType()) {
+  case TpUChar:
+    fillZoneRange<uChar>  (aData, aNrValues, aMin, aMax, aNrNaN);
+    break;
+  case TpShort:
+    fillZoneRange<Short>  (aData, aNrValues, aMin, aMax, aNrNaN);
+    break;
+  case TpUShort:
+    fillZoneRange<uShort> (aData, aNrValues, aMin, aMax, aNrNaN);
+    break;
+  case TpInt:
+    fillZoneRange<Int>    (aData, aNrValues, aMin, aMax, aNrNaN);
+    break;
+  case TpUInt:
+    fillZoneRange<uInt>   (aData, aNrValues, aMin, aMax, aNrNaN);
+    break;
+  case TpFloat:
+    fillZoneRange<float>  (aData, aNrValues, aMin, aMax, aNrNaN);
+    break;
+  case TpDouble:
+    fillZoneRange<double> (aData, aNrValues, aMin, aMax, aNrNaN);
+    break;
+  default:
+    throw DataManInternalError ("SSMColumn::zoneRange: invalid data type");
+  }
+}
+
+void SSMColumn::updateZones()
+{
+  if (!itsUseZoneMap) {
+    return;
+  }
+  // Read the data of each bucket with an unknown zone and determine
+  // its range. Note that rows not written yet have value 0.
+  uInt aNrRows = itsSSMPtr->getNRow();
+  uInt aRowNr = 0;
+  std::vector<char> aBuffer;
+  while (aRowNr < aNrRows) {
+    uInt aBucketNr, aStartRow, anEndRow;
+    itsSSMPtr->findBucket (aRowNr, itsColNr, aBucketNr, aStartRow, anEndRow);
+    // Zones of new buckets are unknown.
+    uInt aNrOld = itsZoneValid.nelements();
+    if (aBucketNr >= aNrOld) {
+      uInt aNrZone = max(aBucketNr+1, 2*aNrOld);
+      itsZoneMin.resize   (aNrZone, False, True);
+      itsZoneMax.resize   (aNrZone, False, True);
+      itsZoneNaN.resize   (aNrZone, False, True);
+      itsZoneValid.resize (aNrZone, False, True);
+      for (uInt i=aNrOld; i<aNrZone; i++) {
+        itsZoneValid[i] = False;
+      }
+    }
+    if (! itsZoneValid[aBucketNr]) {
+      uInt aNr = anEndRow-aStartRow+1;
+      aBuffer.resize (aNr * itsLocalSize);
+      char* aValue = itsSSMPtr->getBucket(aBucketNr) +
+                     itsSSMPtr->getColumnOffset(itsColNr);
+      itsReadFunc (&(aBuffer[0]), aValue, aNr * itsNrCopy);
+      Double aMin = std::numeric_limits<Double>::max();
+      Double aMax = -aMin;
+      uInt aNrNaN = 0;
+      zoneRange (&(aBuffer[0]), aNr, aMin, aMax, aNrNaN);
+      itsZoneMin[aBucketNr]   = aMin;
+      itsZoneMax[aBucketNr]   = aMax;
+      itsZoneNaN[aBucketNr]   = aNrNaN;
+      itsZoneValid[aBucketNr] = True;
+    }
+    aRowNr = anEndRow+1;
+  }
+}
+
+void SSMColumn::putZones (AipsIO& anOs) const
+{
+  anOs << itsUseZoneMap;
+  if (itsUseZoneMap) {
+    putBlock (anOs, itsZoneMin);
+    putBlock (anOs, itsZoneMax);
+    putBlock (anOs, itsZoneNaN);
+    putBlock (anOs, itsZoneValid);
+  }
+}
+
+void SSMColumn::getZones (AipsIO& anOs)
+{
+  Bool aUseZoneMap;
+  anOs >> aUseZoneMap;
+  setZoneMap (aUseZoneMap);
+  if (aUseZoneMap) {
+    getBlock (anOs, itsZoneMin);
+    getBlock (anOs, itsZoneMax);
+    getBlock (anOs, itsZoneNaN);
+    getBlock (anOs, itsZoneValid);
+  }
+}
+
+Bool SSMColumn::getRangeRows (Double minValue, Double maxValue,
+                              Vector<uInt>& rownrs)
+{
+  if (!itsUseZoneMap) {
+    return False;
+  }
+  updateZones();
+  // Open bounds are given as -/+DBL_MAX (see TableExprNode::ranges).
+  // Make them unbounded, otherwise zones containing only infinite values
+  // would be skipped.
+  if (minValue <= -DBL_MAX) {
+    minValue = -std::numeric_limits<Double>::infinity();
+  }
+  if (maxValue >= DBL_MAX) {
+    maxValue = std::numeric_limits<Double>::infinity();
+  }
+  uInt aNrRows = itsSSMPtr->getNRow();
+  uInt aNrSel = 0;
+  rownrs.resize (aNrRows);
+  uInt aRowNr = 0;
+  while (aRowNr < aNrRows) {
+    uInt aBucketNr, aStartRow, anEndRow;
+    itsSSMPtr->findBucket (aRowNr, itsColNr, aBucketNr, aStartRow, anEndRow);
+    if (itsZoneMin[aBucketNr] <= maxValue  &&
+        itsZoneMax[aBucketNr] >= minValue) {
+      for (uInt i=aStartRow; i<=anEndRow; i++) {
+        rownrs[aNrSel++] = i;
+      }
+    }
+    aRowNr = anEndRow+1;
+  }
+  rownrs.resize (aNrSel, True);
+  return True;
+}
+
 void SSMColumn::resync (uInt)
 {
     // Invalidate the last value read.
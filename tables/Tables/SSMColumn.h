@@ -179,6 +179,30 @@ public:
   virtual void getScalarColumnStringV   (Vector<String>* aDataPtr);
   // </group>
   
+  // Get the scalar values of some cells of the column.
+  // Consecutive rows are copied in bulk from each data bucket.
+  // Bool and String columns use the default implementation in StManColumn.
+  // <group>
+  virtual void getScalarColumnCellsuCharV   (const RefRows& aRownrs,
+                                         Vector<uChar>* aDataPtr);
+  virtual void getScalarColumnCellsShortV   (const RefRows& aRownrs,
+                                         Vector<Short>* aDataPtr);
+  virtual void getScalarColumnCellsuShortV  (const RefRows& aRownrs,
+                                         Vector<uShort>* aDataPtr);
+  virtual void getScalarColumnCellsIntV     (const RefRows& aRownrs,
+                                         Vector<Int>* aDataPtr);
+  virtual void getScalarColumnCellsuIntV    (const RefRows& aRownrs,
+                                         Vector<uInt>* aDataPtr);
+  virtual void getScalarColumnCellsfloatV   (const RefRows& aRownrs,
+                                         Vector<float>* aDataPtr);
+  virtual void getScalarColumnCellsdoubleV  (const RefRows& aRownrs,
+                                         Vector<double>* aDataPtr);
+  virtual void getScalarColumnCellsComplexV (const RefRows& aRownrs,
+                                         Vector<Complex>* aDataPtr);
+  virtual void getScalarColumnCellsDComplexV(const RefRows& aRownrs,
+                                         Vector<DComplex>* aDataPtr);
+  // </group>
+  
   // Put the scalar values of the entire column.
   // It invalidates the cache.
   // <group>
@@ -219,6 +243,37 @@ public:
   // as is the case with Strings, it can be done here.
   void removeColumn();
 
+  // Enable or disable the zone map of this column.
+  // A zone map can only be used for a scalar column of a numeric data type
+  // (uChar, Short, uShort, Int, uInt, float, or double); for other
+  // columns it is always disabled.
+  // The zones are cleared, so they are calculated by the next
+  // <src>updateZones</src>.
+  void setZoneMap (Bool useZoneMap);
+
+  // Does the column have a zone map?
+  Bool hasZoneMap() const;
+
+  // Mark the zone of the given data bucket as unknown.
+  void invalidateZone (uInt aBucketNr);
+
+  // (Re)calculate the unknown zones from the data in the buckets.
+  void updateZones();
+
+  // Write or read the zone map.
+  // <group>
+  void putZones (AipsIO& anOs) const;
+  void getZones (AipsIO& anOs);
+  // </group>
+
+  // Get the numbers of the rows that might contain a value in the closed
+  // interval [minValue,maxValue]. It uses the zone map to skip all data
+  // buckets whose value range does not overlap the interval, so it only
+  // gives candidate rows; the caller still has to test their values.
+  // It returns False if the column has no zone map.
+  virtual Bool getRangeRows (Double minValue, Double maxValue,
+                             Vector<uInt>& rownrs);
+
 protected:
   // Shift the rows in the bucket one to the left when removing the given row.
   void shiftRows (char* aValue, uInt rowNr, uInt startRow, uInt endRow);
@@ -245,10 +300,23 @@ protected:
   // The data from all buckets is copied to the array.
   void getColumnValue (void* anArray, uInt aNrRows);
   
+  // Get the values for the given cells in the column.
+  // The data of consecutive rows is copied from each data bucket at once.
+  void getColumnCellsValue (const RefRows& aRownrs, void* anArray);
+  
   // Put the values from the array in the entire column.
   // Each data bucket is filled with the the appropriate part of the array.
   void putColumnValue (const void* anArray, uInt aNrRows);
 
+  // Extend the zone of the given bucket with a value in local format.
+  // A NaN value makes the zone unknown.
+  void extendZone (uInt aBucketNr, const void* aValue);
+
+  // Determine the minimum, maximum and number of NaNs of the given values
+  // in local format. It extends the given minimum and maximum.
+  void zoneRange (const void* aData, uInt aNrValues,
+                  Double& aMin, Double& aMax, uInt& aNrNaN) const;
+
 
   // Pointer to the parent storage manager.
   SSMBase*          itsSSMPtr;
@@ -275,6 +343,18 @@ protected:
   Conversion::ValueFunction* itsWriteFunc;
   // Pointer to a convert function for reading.
   Conversion::ValueFunction* itsReadFunc;
+  // Is a zone map used?
+  Bool              itsUseZoneMap;
+  // The zone map, indexed by bucket number.
+  // A zone holds the minimum and maximum value and the number of NaNs
+  // of the column data in a bucket. The minimum and maximum are a valid
+  // hull of the values; the number of NaNs is only exact after a flush.
+  // <group>
+  Block<Double>     itsZoneMin;
+  Block<Double>     itsZoneMax;
+  Block<uInt>       itsZoneNaN;
+  Block<Bool>       itsZoneValid;
+  // </group>
   
 private:
   // Forbid copy constructor.
@@ -311,6 +391,11 @@ inline char* SSMColumn::getDataPtr()
   return static_cast<char*>(itsData);
 }
 
+inline Bool SSMColumn::hasZoneMap() const
+{
+  return itsUseZoneMap;
+}
+
 inline uInt SSMColumn::getColNr()
 {
   return itsColNr;
@@ -181,6 +181,84 @@ void SSMDirColumn::getArrayStringV (uInt aRowNr,
   itsSSMPtr->getStringHandler()->get(*aDataPtr, buf[0], buf[1], buf[2],False);
 }
 
+Bool SSMDirColumn::canAccessArrayColumn (Bool& reask) const
+{
+  reask = False;
+  return (dataType() != TpBool  &&  dataType() != TpString);
+}
+
+void SSMDirColumn::getArrayColumnuCharV (Array<uChar>* aDataPtr)
+{
+  Bool deleteIt;
+  uChar* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumnShortV (Array<Short>* aDataPtr)
+{
+  Bool deleteIt;
+  Short* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumnuShortV (Array<uShort>* aDataPtr)
+{
+  Bool deleteIt;
+  uShort* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumnIntV (Array<Int>* aDataPtr)
+{
+  Bool deleteIt;
+  Int* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumnuIntV (Array<uInt>* aDataPtr)
+{
+  Bool deleteIt;
+  uInt* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumnfloatV (Array<float>* aDataPtr)
+{
+  Bool deleteIt;
+  float* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumndoubleV (Array<double>* aDataPtr)
+{
+  Bool deleteIt;
+  double* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumnComplexV (Array<Complex>* aDataPtr)
+{
+  Bool deleteIt;
+  Complex* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
+void SSMDirColumn::getArrayColumnDComplexV (Array<DComplex>* aDataPtr)
+{
+  Bool deleteIt;
+  DComplex* data = aDataPtr->getStorage (deleteIt);
+  getColumnValue (data, aDataPtr->shape().last());
+  aDataPtr->putStorage (data, deleteIt);
+}
+
 void SSMDirColumn::getValue(uInt aRowNr, void* data)
 {
   uInt  aStartRow;
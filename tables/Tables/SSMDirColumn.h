@@ -90,6 +90,26 @@ public:
   // It is needed to override the bahviour of the base class.
   virtual void setMaxLength (uInt maxLength);
 
+  // It can handle access to an entire column, except for Bool arrays
+  // (which are stored as bits) and String arrays.
+  virtual Bool canAccessArrayColumn (Bool& reask) const;
+
+  // Get all array values in the column.
+  // The data of all rows in a bucket are copied in one go, which is
+  // much faster than getting the arrays row by row (in particular if
+  // the buckets are read from a memory-mapped file).
+  // <group>
+  virtual void getArrayColumnuCharV     (Array<uChar>* dataPtr);
+  virtual void getArrayColumnShortV     (Array<Short>* dataPtr);
+  virtual void getArrayColumnuShortV    (Array<uShort>* dataPtr);
+  virtual void getArrayColumnIntV       (Array<Int>* dataPtr);
+  virtual void getArrayColumnuIntV      (Array<uInt>* dataPtr);
+  virtual void getArrayColumnfloatV     (Array<float>* dataPtr);
+  virtual void getArrayColumndoubleV    (Array<double>* dataPtr);
+  virtual void getArrayColumnComplexV   (Array<Complex>* dataPtr);
+  virtual void getArrayColumnDComplexV  (Array<DComplex>* dataPtr);
+  // </group>
+
   // Get an array value in the given row.
   // <group>
   virtual void getArrayBoolV     (uInt rownr, Array<Bool>* dataPtr);
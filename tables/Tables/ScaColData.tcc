@@ -100,6 +100,7 @@ Bool ScalarColumnData<T>::isDefined (uInt rownr) const
 	return True;
     }
     T val;
+    ConcurrentReadLock locker(*colSetPtr_p);
     dataColPtr_p->get (rownr, &val);
     return ( (!(val == undefVal_p)));
 }
@@ -111,6 +112,7 @@ void ScalarColumnData<T>::get (uInt rownr, void* val) const
     if (rtraceColumn_p) {
       TableTrace::trace (traceId(), columnDesc().name(), 'r', rownr);
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->get (rownr, (T*)val);
     autoReleaseLock();
@@ -127,6 +129,7 @@ void ScalarColumnData<T>::getScalarColumn (void* val) const
     if (vecPtr->nelements() != nrow()) {
 	throw (TableArrayConformanceError("ScalarColumnData::getScalarColumn"));
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getScalarColumnV (vecPtr);
     autoReleaseLock();
@@ -144,6 +147,7 @@ void ScalarColumnData<T>::getScalarColumnCells (const RefRows& rownrs,
     if (vec.nelements() != nr) {
 	throw (TableArrayConformanceError("ScalarColumnData::getColumnCells"));
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     dataColPtr_p->getScalarColumnCellsV (rownrs, &vec);
     autoReleaseLock();
@@ -157,6 +161,7 @@ void ScalarColumnData<T>::put (uInt rownr, const void* val)
       TableTrace::trace (traceId(), columnDesc().name(), 'w', rownr);
     }
     checkValueLength ((const T*)val);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->put (rownr, (const T*)val);
     autoReleaseLock();
@@ -173,6 +178,7 @@ void ScalarColumnData<T>::putScalarColumn (const void* val)
 	throw (TableArrayConformanceError("ScalarColumnData::putColumn"));
     }
     checkValueLength (vecPtr);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putScalarColumnV (vecPtr);
     autoReleaseLock();
@@ -190,6 +196,7 @@ void ScalarColumnData<T>::putScalarColumnCells (const RefRows& rownrs,
 	throw (TableArrayConformanceError("ScalarColumnData::putColumn"));
     }
     checkValueLength (&vec);
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     dataColPtr_p->putScalarColumnCellsV (rownrs, &vec);
     autoReleaseLock();
@@ -213,6 +220,7 @@ void ScalarColumnData<T>::makeSortKey (Sort& sortobj,
     if (canAccessScalarColumn (reask)) {
 	getScalarColumn (vecPtr);
     }else{
+	ConcurrentReadLock locker(*colSetPtr_p);
 	checkReadLock (True);
 	for (uInt i=0; i<nrrow; i++) {
 	    dataColPtr_p->get (i,  &(*vecPtr)(i));
@@ -240,6 +248,7 @@ void ScalarColumnData<T>::makeRefSortKey (Sort& sortobj,
     if (canAccessScalarColumnCells (reask)) {
 	getScalarColumnCells (rownrs, vecPtr);
     }else{
+	ConcurrentReadLock locker(*colSetPtr_p);
 	checkReadLock (True);
 	for (uInt i=0; i<nrrow; i++) {
 	    dataColPtr_p->get (rownrs(i),  &(*vecPtr)(i));
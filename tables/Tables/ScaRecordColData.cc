@@ -86,6 +86,7 @@ Bool ScalarRecordColumnData::isDefined (uInt) const
 
 void ScalarRecordColumnData::get (uInt rownr, void* val) const
 {
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     getRecord (rownr, *(TableRecord*)val);
     autoReleaseLock();
@@ -99,6 +100,7 @@ void ScalarRecordColumnData::getScalarColumn (void* val) const
 	throw (TableArrayConformanceError
                                  ("ScalarRecordColumnData::getScalarColumn"));
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     for (uInt i=0; i<nr; i++) {
 	getRecord (i, vec(i));
@@ -114,6 +116,7 @@ void ScalarRecordColumnData::getScalarColumnCells (const RefRows& rownrs,
 	throw (TableArrayConformanceError
                                  ("ScalarRecordColumnData::getColumnCells"));
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkReadLock (True);
     RefRowsSliceIter iter(rownrs);
     uInt i=0;
@@ -133,6 +136,7 @@ void ScalarRecordColumnData::getScalarColumnCells (const RefRows& rownrs,
 
 void ScalarRecordColumnData::put (uInt rownr, const void* val)
 {
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     putRecord (rownr, *(const TableRecord*)val);
     autoReleaseLock();
@@ -146,6 +150,7 @@ void ScalarRecordColumnData::putScalarColumn (const void* val)
 	throw (TableArrayConformanceError
                                  ("ScalarRecordColumnData::putScalarColumn"));
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     for (uInt i=0; i<nr; i++) {
 	putRecord (i, vec(i));
@@ -161,6 +166,7 @@ void ScalarRecordColumnData::putScalarColumnCells (const RefRows& rownrs,
 	throw (TableArrayConformanceError
                                  ("ScalarRecordColumnData::putColumnCells"));
     }
+    ConcurrentReadLock locker(*colSetPtr_p);
     checkWriteLock (True);
     RefRowsSliceIter iter(rownrs);
     uInt i=0;
@@ -42,16 +42,20 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 SetupNewTable::SetupNewTable (const String& tableName,
 			      const String& tableDescName,
-			      Table::TableOption opt)
+			      Table::TableOption opt,
+			      const StorageOption& storageOpt)
 {
-    newTable_p = new SetupNewTableRep (tableName, tableDescName, opt);
+    newTable_p = new SetupNewTableRep (tableName, tableDescName, opt,
+				       storageOpt);
 }
 
 SetupNewTable::SetupNewTable (const String& tableName,
 			      const TableDesc& tableDesc,
-			      Table::TableOption opt)
+			      Table::TableOption opt,
+			      const StorageOption& storageOpt)
 {
-    newTable_p = new SetupNewTableRep (tableName, tableDesc, opt);
+    newTable_p = new SetupNewTableRep (tableName, tableDesc, opt,
+				       storageOpt);
 }
 
 SetupNewTable::SetupNewTable (const SetupNewTable& that)
@@ -86,10 +90,12 @@ SetupNewTable& SetupNewTable::operator= (const SetupNewTable& that)
 
 SetupNewTableRep::SetupNewTableRep (const String& tableName,
 				    const String& tableDescName,
-				    Table::TableOption opt)
+				    Table::TableOption opt,
+				    const StorageOption& storageOpt)
 : count_p     (1),
   tabName_p   (tableName),
   option_p    (opt),
+  storageOpt_p(storageOpt),
   delete_p    (False),
   tdescPtr_p  (0),
   colSetPtr_p (0),
@@ -103,10 +109,12 @@ SetupNewTableRep::SetupNewTableRep (const String& tableName,
 
 SetupNewTableRep::SetupNewTableRep (const String& tableName,
 				    const TableDesc& tableDesc,
-				    Table::TableOption opt)
+				    Table::TableOption opt,
+				    const StorageOption& storageOpt)
 : count_p     (1),
   tabName_p   (tableName),
   option_p    (opt),
+  storageOpt_p(storageOpt),
   delete_p    (False),
   tdescPtr_p  (0),
   colSetPtr_p (0),
@@ -32,6 +32,7 @@
 //# Includes
 #include <casa/aips.h>
 #include <tables/Tables/Table.h>
+#include <tables/Tables/StorageOption.h>
 #include <casa/Containers/SimOrdMap.h>
 #include <casa/BasicSL/String.h>
 
@@ -95,11 +96,11 @@ public:
     // Create a new table using the table description with the given name.
     // The description will be read from a file.
     SetupNewTableRep (const String& tableName, const String& tableDescName,
-		      Table::TableOption);
+		      Table::TableOption, const StorageOption&);
 
     // Create a new table using the given table description.
     SetupNewTableRep (const String& tableName, const TableDesc&,
-		      Table::TableOption);
+		      Table::TableOption, const StorageOption&);
 
     ~SetupNewTableRep();
 
@@ -115,6 +116,10 @@ public:
     int option() const
 	{ return option_p; }
 
+    // Get the storage option.
+    const StorageOption& storageOption() const
+	{ return storageOpt_p; }
+
     // Test if the table is marked for delete.
     Bool isMarkedForDelete() const
 	{ return delete_p; }
@@ -196,6 +201,7 @@ private:
     String      tabName_p;
     // Constructor options.
     int         option_p;
+    StorageOption storageOpt_p;
     // Marked for delete?
     Bool        delete_p;
     TableDesc*  tdescPtr_p;
@@ -345,12 +351,16 @@ friend class MemoryTable;
 public:
     // Create a new table using the table description with the given name.
     // The description will be read from a file.
+    // The storage option tells how the table files are organized
+    // (see <linkto class=StorageOption>StorageOption</linkto>).
     SetupNewTable (const String& tableName, const String& tableDescName,
-		   Table::TableOption);
+		   Table::TableOption,
+		   const StorageOption& = StorageOption());
 
     // Create a new table using the given table description.
     SetupNewTable (const String& tableName, const TableDesc&,
-		   Table::TableOption);
+		   Table::TableOption,
+		   const StorageOption& = StorageOption());
 
     // Copy constructor (reference semantics).
     SetupNewTable (const SetupNewTable&);
@@ -368,6 +378,10 @@ public:
     int option() const
 	{ return newTable_p->option(); }
 
+    // Get the storage option.
+    const StorageOption& storageOption() const
+	{ return newTable_p->storageOption(); }
+
     // Test if the table is marked for delete.
     Bool isMarkedForDelete() const
 	{ return newTable_p->isMarkedForDelete(); }
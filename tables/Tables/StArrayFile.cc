@@ -27,6 +27,7 @@
 
 #include <tables/Tables/StArrayFile.h>
 #include <casa/OS/RegularFile.h>
+#include <casa/IO/MFFileIO.h>
 #include <casa/IO/CanonicalIO.h>
 #include <casa/IO/LECanonicalIO.h>
 #include <casa/OS/CanonicalConversion.h>
@@ -45,7 +46,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 StManArrayFile::StManArrayFile (const String& fname, ByteIO::OpenOption fop,
 				uInt version, Bool bigEndian,
-				uInt bufferSize)
+				uInt bufferSize, MultiFile* mfile)
 : leng_p    (16),
   version_p (version),
   hasPut_p  (False)
@@ -55,7 +56,11 @@ StManArrayFile::StManArrayFile (const String& fname, ByteIO::OpenOption fop,
 	version_p = 1;
     }
     //# Open file name as input and/or output; throw exception if it fails.
-    file_p = new LargeRegularFileIO (RegularFile(fname), fop, bufferSize);
+    if (mfile != 0) {
+        file_p = new MFFileIO (*mfile, fname, fop);
+    } else {
+        file_p = new LargeRegularFileIO (RegularFile(fname), fop, bufferSize);
+    }
     AlwaysAssert (file_p != 0, AipsError);
     if (bigEndian) {
 	iofil_p = new CanonicalIO (file_p);
@@ -39,6 +39,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 //# Forward Declarations
 class IPosition;
+class MultiFile;
 
 
 // <summary>
@@ -134,9 +135,11 @@ public:
     // (e.g. ByteIO::New for a new file).
     // The buffersize is used to allocate a buffer of a proper size
     // for the underlying filebuf object (see iostream package).
+    // If a MultiFile is given, the file is a virtual file in it and the
+    // buffer size is not used.
     StManArrayFile (const String& name, ByteIO::OpenOption,
 		    uInt version=0, Bool bigEndian=True,
-		    uInt bufferSize=65536);
+		    uInt bufferSize=65536, MultiFile* mfile=0);
 
     // Close the possibly opened file.
     ~StManArrayFile();
@@ -273,7 +276,7 @@ public:
     // </group>
 
 private:
-    LargeRegularFileIO* file_p;            //# File object
+    ByteIO*         file_p;                //# File object
     TypeIO*         iofil_p;               //# IO object
     Int64           leng_p;                //# File length
     uInt            version_p;             //# Version of StArrayFile file
@@ -90,7 +90,9 @@ void StManColumnIndArrayAipsIO::openFile (ByteIO::OpenOption opt)
         if (iosfile_p == 0) {
 	  char strc[8];
 	  sprintf (strc, "i%i", seqnr_p);
-	  iosfile_p = new StManArrayFile (stmanPtr_p->fileName() + strc, opt);
+	  iosfile_p = new StManArrayFile (stmanPtr_p->fileName() + strc, opt,
+					  0, True, 65536,
+					  stmanPtr_p->multiFile());
 	} else {
 	  iosfile_p->resync();
 	}
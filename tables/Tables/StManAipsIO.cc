@@ -799,7 +799,7 @@ Bool StManAipsIO::flush (AipsIO&, Bool)
 	return False;
     }
     uInt i;
-    AipsIO ios(fileName(), ByteIO::New);
+    AipsIO ios(fileName(), ByteIO::New, 65536, multiFile());
     ios.putstart ("StManAipsIO", 2);           // version 2
     //# Write the number of rows and columns and the column types.
     //# This is only done to check it when reading back.
@@ -838,7 +838,7 @@ void StManAipsIO::resync (uInt nrrow)
     if (iosfile_p != 0) {
         iosfile_p->resync();
     }
-    AipsIO ios(fileName());
+    AipsIO ios(fileName(), ByteIO::Old, 65536, multiFile());
     uInt version = ios.getstart ("StManAipsIO");
     //# Get and check the number of rows and columns and the column types.
     uInt i, nrc, snr;
@@ -896,7 +896,8 @@ void StManAipsIO::resync (uInt nrrow)
 StManArrayFile* StManAipsIO::openArrayFile (ByteIO::OpenOption opt)
 {
     if (iosfile_p == 0) {
-	iosfile_p = new StManArrayFile (fileName() + 'i', opt);
+	iosfile_p = new StManArrayFile (fileName() + 'i', opt, 0, True,
+					65536, multiFile());
     }
     return iosfile_p;
 }
@@ -912,8 +913,8 @@ void StManAipsIO::deleteManager()
 {
     delete iosfile_p;
     iosfile_p = 0;
-    DOos::remove (fileName() + 'i', False, False);
-    DOos::remove (fileName(), False, False);
+    removeFile (fileName() + 'i');
+    removeFile (fileName());
 }
 
 } //# NAMESPACE CASA - END
@@ -106,6 +106,15 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 // <p>
 // As said above all string arrays and variable length scalar strings
 // are stored in separate string buckets. 
+// <p>
+// Optionally StandardStMan can maintain zone maps for its numeric scalar
+// columns (by calling <src>setZoneMaps(True)</src> or by defining
+// ZONEMAPS=True in the specification record). A zone map holds for each
+// data bucket the minimum and maximum value and the number of NaNs.
+// They are stored together with the index and are used by the table
+// selection to skip buckets that cannot contain a value in the range
+// given in the selection expression (e.g. <src>TIME > 4.5e9</src>).
+// This is effective for columns whose values are clustered (e.g. sorted).
 // </synopsis>
 
 // <motivation>
@@ -83,6 +83,11 @@ void ROStandardStManAccessor::clearCache()
     itsSSMPtr->clearCache();
 }
 
+Bool ROStandardStManAccessor::usesMappedFile() const
+{
+    return itsSSMPtr->usesMappedFile();
+}
+
 void ROStandardStManAccessor::showBaseStatistics (ostream& anOs) const
 {
     itsSSMPtr->showBaseStatistics (anOs);
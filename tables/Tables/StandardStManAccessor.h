@@ -140,6 +140,9 @@ public:
     // resulting in a drop in memory used.
     void clearCache();
 
+    // Is the (readonly) file accessed via a memory-mapped file?
+    Bool usesMappedFile() const;
+
     // Show the statistics for the base class.
     void showBaseStatistics (ostream& anOs) const;
 
@@ -0,0 +1,148 @@
+//# StorageOption.h: Options for the storage of a table
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#ifndef TABLES_STORAGEOPTION_H
+#define TABLES_STORAGEOPTION_H
+
+
+#include <casa/aips.h>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+// <summary>
+// Options defining how table files are organized
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tStorageOption.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=SetupNewTable>SetupNewTable</linkto>
+//   <li> <linkto class=MultiFile>MultiFile</linkto>
+// </prerequisite>
+
+// <synopsis>
+// This class can be used to define how the files of a table are organized.
+// There are two ways:
+// <ol>
+//  <li> Each storage manager uses one or more separate files in the table
+//       directory. This is the old behaviour.
+//  <li> The files of all storage managers are combined in a single
+//       <linkto class=MultiFile>MultiFile</linkto> container file
+//       <src>table.mf</src> in the table directory. This reduces the number
+//       of files considerably, which is advantageous for parallel file
+//       systems like Lustre that have a high cost for file metadata
+//       operations. The block size of the container can be defined.
+//       It is best to use a multiple of the file system block size
+//       (which is the default block size).
+// </ol>
+// The table directory still contains the files table.dat, table.info and
+// table.lock. A subtable is a separate table, so it has its own container
+// file (if created using the MultiFile option).
+// <br>The option is only used when creating a table. When opening an
+// existing table, the table system finds out itself if a container
+// file is used.
+//
+// The constructor of the class can be used to define the options or
+// to read options from the aipsrc file.
+// <ul>
+//  <li> <src>StorageOption::SepFile</src>
+//       Use separate files for the storage managers.
+//  <li> <src>StorageOption::MultiFile</src>
+//       Combine the storage manager files in a MultiFile.
+//       The block size can be given as a constructor argument.
+//  <li> <src>StorageOption::Default</src>
+//       Use default. This is SepFile.
+//  <li> <src>StorageOption::Aipsrc</src>
+//       Use the option as defined in the aipsrc file.
+// </ul>
+// The aipsrc variables are:
+// <ul>
+//  <li> <src>table.storage.option</src> gives the option as the
+//       case-insensitive string value <src>sepfile</src>,
+//       <src>multifile</src>, or <src>default</src>.
+//       It defaults to value <src>default</src>.
+//  <li> <src>table.storage.blocksize</src> gives the block size for option
+//       <src>StorageOption::MultiFile</src>. A value <=0 means using the
+//       block size of the file system.
+//       It defaults to 0.
+// </ul>
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   // Create a table using a MultiFile with a block size of 1 MB.
+//   SetupNewTable newtab("tab.data", tdesc, Table::New,
+//                        StorageOption(StorageOption::MultiFile, 1048576));
+//   Table tab(newtab);
+// </srcblock>
+// </example>
+
+
+  class StorageOption
+  {
+  public:
+    // Define the possible options how table files are organized.
+    enum Option {
+      // Use separate files for the storage managers.
+      SepFile,
+      // Combine the files of the storage managers in a MultiFile.
+      MultiFile,
+      // Use default.
+      Default,
+      // Use as defined in the aipsrc file.
+      Aipsrc
+    };
+
+    // Create an option object.
+    // The parameter values are described in the synopsis.
+    // A size value -2 means reading that size from the aipsrc file.
+    StorageOption (Option option=Aipsrc, Int blockSize=-2);
+
+    // Fill the option in case Aipsrc or Default was given.
+    // It is done as explained in the synopsis.
+    void fillOption();
+
+    // Get the option.
+    Option option() const
+      { return itsOption; }
+
+    // Get the block size.
+    Int blockSize() const
+      { return itsBlockSize; }
+
+  private:
+    Option itsOption;
+    Int    itsBlockSize;
+  };
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -44,6 +44,10 @@
 #include <casa/OS/HostInfo.h>
 #include <casa/string.h>                           // for memcpy
 #include <casa/iostream.h>
+#include <algorithm>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -189,6 +193,13 @@ void TSMCube::showCacheStatistics (ostream& os) const
     }
 }
 
+void TSMCube::addCacheStatistics (Record& rec) const
+{
+    if (cache_p != 0) {
+        DataManager::addCacheStatistics (rec, *cache_p);
+    }
+}
+
 uInt TSMCube::coordinateSize (const String& coordinateName) const
 {
     if (! values_p.isDefined (coordinateName)) {
@@ -1000,6 +1011,14 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
         return;
     }
 
+    // A section spanning many tiles is accessed in parallel if possible.
+    uInt batchSize = parallelBatchSize (nrTileSection_p.product());
+    if (batchSize > 1) {
+        accessTiles (start, end, IPosition(nrdim_p, 1), section, colnr,
+                     localPixelSize, writeFlag, batchSize);
+        return;
+    }
+
     // At this point we start looping through all tiles.
     // startPixel and endPixel will contain the first and last pixels
     // needed in the current tile.
@@ -1320,8 +1339,40 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
     if (writeFlag) {
 	stmanPtr_p->setDataChanged();
     }
-    uInt i, j;
     // Get the cache (if needed).
+    getCache();
+    // Determine the number of tiles spanned by the section.
+    uInt nrTiles = 1;
+    for (uInt i=0; i<nrdim_p; i++) {
+        nrTiles *= 1 + end(i) / tileShape_p(i) - start(i) / tileShape_p(i);
+    }
+    accessTiles (start, end, stride, section, colnr, localPixelSize,
+                 writeFlag, parallelBatchSize (nrTiles));
+}
+
+uInt TSMCube::parallelBatchSize (uInt nrTiles)
+{
+#ifdef _OPENMP
+    // Only use multiple threads if enough tiles are accessed and if
+    // the cache can hold them.
+    uInt nthr = omp_get_max_threads();
+    uInt nslot = getCache()->cacheSize();
+    if (nthr > 1  &&  nrTiles >= 2*nthr  &&  nslot >= 2) {
+        return std::min (nrTiles, nslot);
+    }
+#else
+    (void)nrTiles;
+#endif
+    return 1;
+}
+
+void TSMCube::accessTiles (const IPosition& start, const IPosition& end,
+                           const IPosition& stride,
+                           char* section, uInt colnr,
+                           uInt localPixelSize, Bool writeFlag,
+                           uInt batchSize)
+{
+    uInt i;
     BucketCache* cachePtr = getCache();
 
     // A tile can contain more than one data array.
@@ -1337,20 +1388,21 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
     IPosition tilePos (nrdim_p);               // tile position
     IPosition startPixel (nrdim_p);            // start pixel in tile
     IPosition endPixel (nrdim_p);              // end pixel in tile
-    IPosition startSection (start);            // start of section in cube
     IPosition sectionShape (end - start + stride);  // section shape
     sectionShape /= stride;
     TSMShape expandedSectionShape (sectionShape);
-    IPosition dataLength(nrdim_p);
-    IPosition dataPos   (nrdim_p);
-    uInt dataOffset;
-    size_t sectionOffset;
 
-    // Find out if local size is a multiple of 4, so we can move as integers.
-    TSMCube_FindMult;
+    // The tiles are collected in batches. The tiles in a batch are
+    // fetched from the cache at the same time and copied in parallel.
+    // A batch of one tile is handled directly.
+    Block<uInt> tileNrs (batchSize);
+    Block<char*> dataArrays (batchSize);
+    Block<IPosition> startPixels (batchSize);
+    Block<IPosition> endPixels (batchSize);
+    Block<IPosition> nrPixels (batchSize);
+    Block<IPosition> sectionPoss (batchSize);
+    uInt nrBatch = 0;
 
-    // Determine if the first dimension is strided.
-    Bool strided = (stride(0) != 1);
     // The first time all dimensions are evaluated to set pixelStart/End
     // correctly.
     Bool firstTime = True;
@@ -1390,99 +1442,168 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
 //      cout << "tilePos=" << tilePos << endl;
 //      cout << "tileNr=" << tileNr << endl;
 //      cout << "start=" << startPixel << endl;
-        // Get the tile from the cache.
-        // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr);
-        if (writeFlag) {
-            cachePtr->setDirty();
+        if (batchSize == 1) {
+            // Get the tile from the cache.
+            // Set it to dirty if we are writing.
+            char* dataArray = cachePtr->getBucket (tileNr);
+            if (writeFlag) {
+                cachePtr->setDirty();
+            }
+            copyTile (dataArray, section, startPixel, endPixel, nrPixel,
+                      sectionPos, stride, expandedSectionShape,
+                      pixelOffset, localPixelSize, writeFlag);
+        } else {
+            tileNrs[nrBatch]     = tileNr;
+            startPixels[nrBatch] = startPixel;
+            endPixels[nrBatch]   = endPixel;
+            nrPixels[nrBatch]    = nrPixel;
+            sectionPoss[nrBatch] = sectionPos;
+            if (++nrBatch == batchSize) {
+                copyTiles (nrBatch, tileNrs, dataArrays, startPixels,
+                           endPixels, nrPixels, sectionPoss, stride,
+                           section, expandedSectionShape,
+                           pixelOffset, localPixelSize, writeFlag);
+                nrBatch = 0;
+            }
         }
+    }
+    if (nrBatch > 0) {
+        copyTiles (nrBatch, tileNrs, dataArrays, startPixels,
+                   endPixels, nrPixels, sectionPoss, stride,
+                   section, expandedSectionShape,
+                   pixelOffset, localPixelSize, writeFlag);
+    }
+}
 
-        // At this point we start looping through all pixels in the tile.
-        // We do a vector at a time.
-        // Calculate the start and end pixel in the tile.
-        // Initialize the pixel position in the data and section.
-        dataPos = startPixel;
-        IPosition dataIncr    = localPixelSize *
-                         expandedTileShape_p.offsetIncrement (nrPixel, stride);
-        IPosition sectionIncr = localPixelSize *
-                         expandedSectionShape.offsetIncrement (nrPixel);
-        dataOffset = pixelOffset + localPixelSize *
-                         expandedTileShape_p.offset (startPixel);
-        sectionOffset = localPixelSize *
-                         expandedSectionShape.offset (sectionPos);
-        uInt strideSize = 0;
-        uInt localSize  = nrPixel(0) * localPixelSize;
-        if (strided) {
-            strideSize = stride(0) * localPixelSize;
-        }
+void TSMCube::copyTiles (uInt nrTile, const Block<uInt>& tileNrs,
+                         Block<char*>& dataArrays,
+                         const Block<IPosition>& startPixels,
+                         const Block<IPosition>& endPixels,
+                         const Block<IPosition>& nrPixels,
+                         const Block<IPosition>& sectionPoss,
+                         const IPosition& stride, char* section,
+                         const TSMShape& expandedSectionShape,
+                         uInt pixelOffset, uInt localPixelSize,
+                         Bool writeFlag)
+{
+    // Get all tiles; the ones not in the cache are read and converted
+    // in parallel. Thereafter the tiles are copied in parallel.
+    // Each tile is a different part of the section, so the copies
+    // do not interfere.
+    getCache()->getBuckets (dataArrays.storage(), tileNrs.storage(),
+                            nrTile, writeFlag);
+    Int nr = nrTile;
+#ifdef _OPENMP
+# pragma omp parallel for
+#endif
+    for (Int i=0; i<nr; i++) {
+        copyTile (dataArrays[i], section, startPixels[i], endPixels[i],
+                  nrPixels[i], sectionPoss[i], stride, expandedSectionShape,
+                  pixelOffset, localPixelSize, writeFlag);
+    }
+}
 
-	// Find out if we should use a simple "do-loop" move instead of memcpy
-	// because memcpy is slow for small blocks.
-	TSMCube_FindMove(nrPixel(0));
+void TSMCube::copyTile (char* dataArray, char* section,
+                        const IPosition& startPixel,
+                        const IPosition& endPixel,
+                        const IPosition& nrPixel,
+                        const IPosition& sectionPos,
+                        const IPosition& stride,
+                        const TSMShape& expandedSectionShape,
+                        uInt pixelOffset, uInt localPixelSize,
+                        Bool writeFlag) const
+{
+    uInt j;
+    // Find out if local size is a multiple of 4, so we can move as integers.
+    TSMCube_FindMult;
+    // Determine if the first dimension is strided.
+    Bool strided = (stride(0) != 1);
 
-        while (True) {
-            if (strided) {
-		uInt nrp = nrPixel(0);
-                for (j=0; j<nrp; j++) {
-                    if (writeFlag) {
-		      switch (localPixelWords) {
-		      case 2:
-			((Int*)(dataArray+dataOffset))[1] =
-			  ((Int*)(section+sectionOffset))[1];
-		      case 1:
-			((Int*)(dataArray+dataOffset))[0] =
-			  ((Int*)(section+sectionOffset))[0];
-			break;
-		      default:
-			TSMCube_copyChar ((Char*)(dataArray+dataOffset),
-					  (Char*)(section+sectionOffset),
-					  localPixelSize);
-		      }
-                    }else{
-		      switch (localPixelWords) {
-		      case 2:
-			((Int*)(section+sectionOffset))[1] =
-			  ((Int*)(dataArray+dataOffset))[1];
-		      case 1:
-			((Int*)(section+sectionOffset))[0] =
-			  ((Int*)(dataArray+dataOffset))[0];
-			break;
-		      default:
-			TSMCube_copyChar ((Char*)(section+sectionOffset),
-					  (Char*)(dataArray+dataOffset),
-					  localPixelSize);
-		      }
-                    }
-                    dataOffset    += strideSize;
-                    sectionOffset += localPixelSize;
-                }
-            }else{
+    // At this point we start looping through all pixels in the tile.
+    // We do a vector at a time.
+    // Calculate the start and end pixel in the tile.
+    // Initialize the pixel position in the data and section.
+    IPosition dataPos (startPixel);
+    IPosition dataIncr    = localPixelSize *
+                     expandedTileShape_p.offsetIncrement (nrPixel, stride);
+    IPosition sectionIncr = localPixelSize *
+                     expandedSectionShape.offsetIncrement (nrPixel);
+    uInt dataOffset = pixelOffset + localPixelSize *
+                     expandedTileShape_p.offset (startPixel);
+    size_t sectionOffset = localPixelSize *
+                     expandedSectionShape.offset (sectionPos);
+    uInt strideSize = 0;
+    uInt localSize  = nrPixel(0) * localPixelSize;
+    if (strided) {
+        strideSize = stride(0) * localPixelSize;
+    }
+
+    // Find out if we should use a simple "do-loop" move instead of memcpy
+    // because memcpy is slow for small blocks.
+    TSMCube_FindMove(nrPixel(0));
+
+    while (True) {
+        if (strided) {
+            uInt nrp = nrPixel(0);
+            for (j=0; j<nrp; j++) {
                 if (writeFlag) {
-                    TSMCube_MoveData (dataArray+dataOffset,
-				      section+sectionOffset);
+                  switch (localPixelWords) {
+                  case 2:
+                    ((Int*)(dataArray+dataOffset))[1] =
+                      ((Int*)(section+sectionOffset))[1];
+                  case 1:
+                    ((Int*)(dataArray+dataOffset))[0] =
+                      ((Int*)(section+sectionOffset))[0];
+                    break;
+                  default:
+                    TSMCube_copyChar ((Char*)(dataArray+dataOffset),
+                                      (Char*)(section+sectionOffset),
+                                      localPixelSize);
+                  }
                 }else{
-		    TSMCube_MoveData (section+sectionOffset,
-				      dataArray+dataOffset);
-                }
-                dataOffset    += localSize;
-                sectionOffset += localSize;
-            }
-            for (j=1; j<nrdim_p; j++) {
-              // Catch attempt to increment dataOffset below 0
-                DebugAssert(dataIncr(j) >= 0 ||
-                            dataOffset >= static_cast<uInt>(-dataIncr(j)),
-                            DataManError);
-                dataOffset    += dataIncr(j);
-                sectionOffset += sectionIncr(j);
-                dataPos(j) += stride(j);
-                if (dataPos(j) <= endPixel(j)) {
+                  switch (localPixelWords) {
+                  case 2:
+                    ((Int*)(section+sectionOffset))[1] =
+                      ((Int*)(dataArray+dataOffset))[1];
+                  case 1:
+                    ((Int*)(section+sectionOffset))[0] =
+                      ((Int*)(dataArray+dataOffset))[0];
                     break;
+                  default:
+                    TSMCube_copyChar ((Char*)(section+sectionOffset),
+                                      (Char*)(dataArray+dataOffset),
+                                      localPixelSize);
+                  }
                 }
-                dataPos(j) = startPixel(j);
+                dataOffset    += strideSize;
+                sectionOffset += localPixelSize;
             }
-            if (j == nrdim_p) {
+        }else{
+            if (writeFlag) {
+                TSMCube_MoveData (dataArray+dataOffset,
+                                  section+sectionOffset);
+            }else{
+                TSMCube_MoveData (section+sectionOffset,
+                                  dataArray+dataOffset);
+            }
+            dataOffset    += localSize;
+            sectionOffset += localSize;
+        }
+        for (j=1; j<nrdim_p; j++) {
+          // Catch attempt to increment dataOffset below 0
+            DebugAssert(dataIncr(j) >= 0 ||
+                        dataOffset >= static_cast<uInt>(-dataIncr(j)),
+                        DataManError);
+            dataOffset    += dataIncr(j);
+            sectionOffset += sectionIncr(j);
+            dataPos(j) += stride(j);
+            if (dataPos(j) <= endPixel(j)) {
                 break;
             }
+            dataPos(j) = startPixel(j);
+        }
+        if (j == nrdim_p) {
+            break;
         }
     }
 }
@@ -150,6 +150,10 @@ public:
     // Show the cache statistics.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // Add the cache statistics to the record
+    // (see <src>DataManager::addCacheStatistics</src>).
+    virtual void addCacheStatistics (Record& rec) const;
+
     // Put the data of the object into the AipsIO stream.
     void putObject (AipsIO& ios);
 
@@ -331,6 +335,48 @@ private:
 		     uInt endPixelInLastTile,
 		     uInt lineIndex);
 
+    // Determine how many tiles can be accessed at the same time when
+    // accessing a section spanning the given number of tiles.
+    // It returns 1 if the tiles have to be accessed one by one, which is
+    // the case if OpenMP is not used or if the cache cannot hold multiple
+    // tiles.
+    uInt parallelBatchSize (uInt nrTiles);
+
+    // Access the tiles in a (strided) section.
+    // The tiles are fetched and copied in batches of <src>batchSize</src>
+    // tiles. The tiles in a batch are read, converted and copied in
+    // parallel (see <src>BucketCache::getBuckets</src>).
+    void accessTiles (const IPosition& start, const IPosition& end,
+                      const IPosition& stride,
+                      char* section, uInt colnr,
+                      uInt localPixelSize, Bool writeFlag,
+                      uInt batchSize);
+
+    // Get a batch of tiles from the cache and copy the data in parallel.
+    void copyTiles (uInt nrTile, const Block<uInt>& tileNrs,
+                    Block<char*>& dataArrays,
+                    const Block<IPosition>& startPixels,
+                    const Block<IPosition>& endPixels,
+                    const Block<IPosition>& nrPixels,
+                    const Block<IPosition>& sectionPoss,
+                    const IPosition& stride, char* section,
+                    const TSMShape& expandedSectionShape,
+                    uInt pixelOffset, uInt localPixelSize,
+                    Bool writeFlag);
+
+    // Copy the data of the part of a tile from or to the section.
+    // The part is given by its first and last pixel in the tile, the number
+    // of pixels (per axis) and its position in the section.
+    void copyTile (char* dataArray, char* section,
+                   const IPosition& startPixel,
+                   const IPosition& endPixel,
+                   const IPosition& nrPixel,
+                   const IPosition& sectionPos,
+                   const IPosition& stride,
+                   const TSMShape& expandedSectionShape,
+                   uInt pixelOffset, uInt localPixelSize,
+                   Bool writeFlag) const;
+
     // Define the callback functions for the BucketCache.
     // <group>
     static char* readCallBack (void* owner, const char* external);
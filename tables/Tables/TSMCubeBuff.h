@@ -120,6 +120,10 @@ public:
     // Show the cache statistics.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // There are no cache statistics, so nothing is added.
+    virtual void addCacheStatistics (Record&) const
+      {}
+
     // Set the hypercube shape.
     // This is only possible if the shape was not defined yet.
     virtual void setShape (const IPosition& cubeShape,
@@ -52,7 +52,9 @@ TSMFile::TSMFile (const TiledStMan* stman, uInt fileSequenceNr,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
-    file_p = new BucketFile (fileName, bufSize, mapOpt);
+    Bool directOpt = tsmOpt.option() == TSMOption::Direct;
+    file_p = new BucketFile (fileName, bufSize, mapOpt, stman->multiFile(),
+                             directOpt);
 }
 
 TSMFile::TSMFile (const String& fileName, Bool writable,
@@ -67,7 +69,9 @@ TSMFile::TSMFile (const String& fileName, Bool writable,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
-    file_p = new BucketFile (fileName, writable, bufSize, mapOpt);
+    Bool directOpt = tsmOpt.option() == TSMOption::Direct;
+    file_p = new BucketFile (fileName, writable, bufSize, mapOpt, 0,
+                             directOpt);
 }
 
 TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
@@ -86,8 +90,9 @@ TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
+    Bool directOpt = tsmOpt.option() == TSMOption::Direct;
     file_p = new BucketFile (fileName, stman->table().isWritable(),
-                             bufSize, mapOpt);
+                             bufSize, mapOpt, stman->multiFile(), directOpt);
 }
 
 TSMFile::~TSMFile()
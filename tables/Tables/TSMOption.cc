@@ -48,6 +48,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
         itsOption = TSMOption::MMap;
       } else if (opt == "cache") {
         itsOption = TSMOption::Cache;
+      } else if (opt == "direct") {
+        itsOption = TSMOption::Direct;
         ///      } else if (opt == "buffer") {
         ///        itsOption = TSMOption::Buffer;
       } else if (opt == "default32") {
@@ -50,7 +50,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 // <synopsis>
 // This class can be used to define how the Tiled Storage Manager accesses
-// its data. There are three ways:
+// its data. There are four ways:
 // <ol>
 //  <li> Using a cache of its own. The cache size is derived using the hinted
 //       access pattern. The cache can be (too) large when using large tables
@@ -66,6 +66,12 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //  <li> Use buffered IO; the kernel's file cache should avoid unnecessary IO.
 //       Its performance is less than mmap, but it works well on 32-bit systems.
 //       The buffer size to be used can be defined.
+//  <li> Using a cache of its own like the first way, but reading and writing
+//       the file using direct IO (O_DIRECT), thus bypassing the kernel's
+//       file cache. It is meant for streaming through large data cubes,
+//       where the data would otherwise evict all useful pages from the file
+//       cache. If the file system does not support direct IO, normal IO is
+//       used.
 // </ol>
 //
 // The constructor of the class can be used to define the options or
@@ -80,6 +86,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //  <li> <src>TSMOption::Buffer</src>
 //       Use buffered file IO without.
 //       The buffer size can be given as a constructor argument.
+//  <li> <src>TSMOption::Direct</src>
+//       Use direct file IO with internal TSM caching.
+//       The maximum cache size can be given as a constructor argument.
 //  <li> <src>TSMOption::Default</src>
 //       Use default. This is MMap for existing files on 64-bit systems,
 //       otherwise Buffer.
@@ -96,13 +105,15 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //    <li> <src>mmapold</src> (or <src>mapold</src>) means TSMMap for existing
 //         tables and TSMDefault for new tables.
 //    <li> <src>buffer</src> means TSMBuffer.
+//    <li> <src>direct</src> means TSMDirect.
 //    <li> <src>default</src> means TSMDefault.
 //   </ul>
 //       It defaults to value <src>default</src>.
 //       Note that <src>mmapold</src> is almost the same as <src>default</src>.
 //       Only on 32-bit systems it is different.
 //  <li> <src>tables.tsm.maxcachesizemb</src> gives the maximum cache size in MB
-//       for option <src>TSMOption::Cache</src>. A value -1 means that
+//       for options <src>TSMOption::Cache</src> and
+//       <src>TSMOption::Direct</src>. A value -1 means that
 //       the system determines the maximum. A value 0 means unlimited.
 //       It defaults to -1.
 //       Note it can always be overridden using class ROTiledStManAccessor.
@@ -127,7 +138,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
       // Use default.
       Default,
       // Use as defined in the aipsrc file.
-      Aipsrc
+      Aipsrc,
+      // Use direct file IO (bypassing the file cache) with internal
+      // TSM caching.
+      Direct
     };
 
     // Create an option object.
@@ -490,8 +490,14 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     TaQLNodeResult res(hrval);
     if (! node.getNoExecute()) {
       if (outer) {
+	if (node.style().doExplain()) {
+	  curSel->setExplain (node.style().doAnalyze());
+	}
 	curSel->execute (node.style().doTiming(), False, False, 0,
                          node.style().doTracing());
+	if (node.style().doExplain()) {
+	  hrval->setRecord (curSel->getPlan());
+	}
 	hrval->setTable (curSel->getTable());
 	hrval->setNames (new Vector<String>(curSel->getColumnNames()));
 	hrval->setString ("select");
@@ -516,12 +522,18 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     handleWhere   (node.itsWhere);
     visitNode     (node.itsSort);
     visitNode     (node.itsLimitOff);
+    if (node.style().doExplain()) {
+      curSel->setExplain (node.style().doAnalyze());
+    }
     curSel->execute (node.style().doTiming(), False, True, 0);
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
     hrval->setTable (curSel->getTable());
     hrval->setNames (new Vector<String>(curSel->getColumnNames()));
     hrval->setString ("update");
+    if (node.style().doExplain()) {
+      hrval->setRecord (curSel->getPlan());
+    }
     popStack();
     return res;
   }
@@ -543,6 +555,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
       curSel->handleInsert (topStack());
       addedSel = True;
     }
+    if (node.style().doExplain()) {
+      curSel->setExplain (node.style().doAnalyze());
+    }
     curSel->execute (node.style().doTiming(), False, True, 0);
     if (addedSel) {
       popStack();        // remove insert subquery
@@ -552,6 +567,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     hrval->setTable (curSel->getTable());
     hrval->setNames (new Vector<String>(curSel->getColumnNames()));
     hrval->setString ("insert");
+    if (node.style().doExplain()) {
+      hrval->setRecord (curSel->getPlan());
+    }
     popStack();
     return res;
   }
@@ -563,11 +581,17 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     handleWhere   (node.itsWhere);
     visitNode     (node.itsSort);
     visitNode     (node.itsLimitOff);
+    if (node.style().doExplain()) {
+      curSel->setExplain (node.style().doAnalyze());
+    }
     curSel->execute (node.style().doTiming(), False, True, 0);
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
     hrval->setTable (curSel->getTable());
     hrval->setString ("delete");
+    if (node.style().doExplain()) {
+      hrval->setRecord (curSel->getPlan());
+    }
     popStack();
     return res;
   }
@@ -584,7 +608,13 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     TaQLNodeResult res(hrval);
     AlwaysAssert (! node.getNoExecute(), AipsError);
     if (outer) {
+      if (node.style().doExplain()) {
+        curSel->setExplain (node.style().doAnalyze());
+      }
       curSel->execute (node.style().doTiming(), False, True, 0);
+      if (node.style().doExplain()) {
+        hrval->setRecord (curSel->getPlan());
+      }
       hrval->setTable (curSel->getTable());
       hrval->setNames (new Vector<String>(curSel->getColumnNames()));
       hrval->setString ("count");
@@ -598,6 +628,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
   TaQLNodeResult TaQLNodeHandler::visitCalcNode (const TaQLCalcNodeRep& node)
   {
+    // A CALC command has no query plan; do not evaluate it.
+    if (node.style().doExplain()) {
+      throw TableInvExpr ("EXPLAIN cannot be used for a CALC command");
+    }
     TableParseSelect* curSel = pushStack (TableParseSelect::PCALC);
     handleTables (node.itsTables);
     // If where, orderby, limit and/or offset is given, handle as FROM query.
@@ -622,6 +656,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
   TaQLNodeResult TaQLNodeHandler::visitCreTabNode (const TaQLCreTabNodeRep& node)
   {
+    // A CREATE TABLE command has no query plan; do not create the table.
+    if (node.style().doExplain()) {
+      throw TableInvExpr ("EXPLAIN cannot be used for a CREATE TABLE command");
+    }
     TableParseSelect* curSel = pushStack (TableParseSelect::PCRETAB);
     handleColSpec (node.itsColumns);
     Record datamans = handleRecord (node.itsDataMans.getMultiRep());
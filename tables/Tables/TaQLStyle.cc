@@ -37,7 +37,9 @@ TaQLStyle::TaQLStyle (uInt origin)
     itsEndExcl   (False),
     itsCOrder    (False),
     itsDoTiming  (False),
-    itsDoTracing (False)
+    itsDoTracing (False),
+    itsDoExplain (False),
+    itsDoAnalyze (False)
 {
   // Define mscal as a synonym for derivedmscal.
   defineSynonym ("mscal", "derivedmscal");
@@ -84,6 +86,8 @@ void TaQLStyle::reset()
   set ("GLISH"); 
   itsDoTiming  = False;
   itsDoTracing = False;
+  itsDoExplain = False;
+  itsDoAnalyze = False;
 }
 
 void TaQLStyle::defineSynonym (const String& synonym, const String& udfLibName)
@@ -54,6 +54,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //
 // The class is also used to tell the TaQL execution engine if timings
 // or tracing of the various parts of the TaQL command need to be done.
+// It also tells if the query plan has to be given (EXPLAIN) and if the
+// query has to be executed to fill in the actual row counts, times and
+// I/O statistics of the plan (EXPLAIN ANALYZE).
 //
 // Finally it is possible to define synonyms for UDF library names.
 // For example, 'derivedmscal' is a lot to type, so a synonym 'mscal'
@@ -63,10 +66,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 class TaQLStyle
 {
 public:
-  // Default style is Glish and no timing/tracing.
+  // Default style is Glish and no timing/tracing/explain.
   explicit TaQLStyle (uInt origin=1);
 
-  // Reset to the default Glish style and no timing/tracing.
+  // Reset to the default Glish style and no timing/tracing/explain.
   void reset();
 
   // Set the style according to the (case-insensitive) value.
@@ -114,12 +117,27 @@ public:
   Bool doTracing() const
     { return itsDoTracing; }
 
+  // Set if the query plan has to be given and if the query has to
+  // be executed to analyze it.
+  void setExplain (Bool doExplain, Bool doAnalyze)
+    { itsDoExplain = doExplain; itsDoAnalyze = doAnalyze; }
+
+  // Should the query plan be given?
+  Bool doExplain() const
+    { return itsDoExplain; }
+
+  // Should the query be executed to analyze the plan?
+  Bool doAnalyze() const
+    { return itsDoAnalyze; }
+
 private:
   uInt itsOrigin;
   Bool itsEndExcl;
   Bool itsCOrder;
   Bool itsDoTiming;
   Bool itsDoTracing;
+  Bool itsDoExplain;
+  Bool itsDoAnalyze;
   std::map<String,String> itsUDFLibNameMap;
 };
 
@@ -609,6 +609,17 @@ void Table::throwIfNull() const
     }
 }
 
+void Table::setConcurrentRead (Bool concurrentRead)
+{
+#ifndef USE_THREADS
+    if (concurrentRead) {
+	throw (TableInvOper ("Table::setConcurrentRead: casacore is built "
+			     "without thread support (USE_THREADS)"));
+    }
+#endif
+    baseTabPtr_p->setConcurrentRead (concurrentRead);
+}
+
 
 Bool Table::isOpened (const String& tableName)
 {
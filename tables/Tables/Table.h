@@ -158,6 +158,7 @@ friend class TableIterator;
 friend class RODataManAccessor;
 friend class TableExprNode;
 friend class TableExprNodeRep;
+friend class ColumnsIndex;
 
 public:
     // Define the possible options how a table can be opened.
@@ -474,6 +475,12 @@ public:
     // (or is being changed) since the last time this function was called.
     Bool hasDataChanged();
 
+    // Get the modify counter of the table.
+    // It is incremented each time changed table data are flushed.
+    // It can be used to test if information derived from the table data
+    // (e.g. a persistent index) is still up-to-date.
+    uInt getModifyCounter() const;
+
     // Flush the table, i.e. write out the buffers. If <src>sync=True</src>,
     // it is ensured that all data are physically written to disk.
     // Nothing will be done if the table is not writable.
@@ -495,6 +502,32 @@ public:
     // does not synchronize itself automatically.
     void resync();
 
+    // Set or get the concurrent read mode of the table.
+    // In this mode multiple threads can read the same Table object
+    // at the same time (e.g. using <src>ScalarColumn::get</src>,
+    // <src>ArrayColumn::getSlice</src>, or <src>getColumnRange</src>).
+    // In this mode the access to the data managers of the underlying plain
+    // tables (and their caches) is serialized by a mutex and the column
+    // caches used by <src>ScalarColumn::get</src> are disabled (also for
+    // column objects created before the mode was set).
+    // Outside this mode no locking is done.
+    // <br>The following rules apply:
+    // <ul>
+    //  <li> The Table and column objects should be created before the
+    //       threads are started and each thread should use its own column
+    //       objects. Copying a Table object is not thread-safe, because
+    //       it changes a reference count.
+    //  <li> The mode should be set or cleared before or after the threads
+    //       read the table, not while they are doing it.
+    //  <li> The table should not be written while being read concurrently.
+    //  <li> An exception is thrown when setting the mode if casacore is
+    //       built without thread support (USE_THREADS).
+    // </ul>
+    // <group>
+    void setConcurrentRead (Bool concurrentRead=True);
+    Bool concurrentRead() const;
+    // </group>
+
     // Test if the object is null, i.e. does not reference a proper table.
     // This is the case if the default constructor is used.
     Bool isNull() const
@@ -1086,6 +1119,8 @@ inline void Table::flush (Bool fsync, Bool recursive)
     { baseTabPtr_p->flush (fsync, recursive); }
 inline void Table::resync()
     { baseTabPtr_p->resync(); }
+inline Bool Table::concurrentRead() const
+    { return baseTabPtr_p->concurrentRead(); }
 
 inline Bool Table::isMultiUsed(Bool checkSubTables) const
     { return baseTabPtr_p->isMultiUsed(checkSubTables); }
@@ -1159,6 +1194,8 @@ inline void Table::flushTableInfo() const
 
 inline const String& Table::tableName() const
     { return baseTabPtr_p->tableName(); }
+inline uInt Table::getModifyCounter() const
+    { return baseTabPtr_p->getModifyCounter(); }
 inline Table::TableType Table::tableType() const
     { return TableType(baseTabPtr_p->tableType()); }
 inline int Table::tableOption() const
@@ -203,6 +203,15 @@ public:
     Bool canChangeShape() const
         { return canChangeShape_p; }
 
+    // Get the numbers of the rows that might contain a value in the closed
+    // interval [minValue,maxValue]. It can only be done if the data manager
+    // keeps statistics making it possible (like the zone maps of
+    // StandardStMan); otherwise False is returned.
+    // Note that the values in the returned rows still have to be tested.
+    Bool getRangeRows (Double minValue, Double maxValue,
+                       Vector<uInt>& rownrs) const
+        { return baseColPtr_p->getRangeRows (minValue, maxValue, rownrs); }
+
     // Get the global #dimensions of an array (ie. for all cells in column).
     // This is always set for fixed shape arrays.
     // Otherwise, 0 will be returned.
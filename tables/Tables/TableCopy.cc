@@ -32,6 +32,8 @@
 #include <tables/Tables/TableRow.h>
 #include <tables/Tables/TableDesc.h>
 #include <tables/Tables/TableColumn.h>
+#include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/ArrayColumn.h>
 #include <tables/Tables/TableLocker.h>
 #include <tables/Tables/TableError.h>
 #include <tables/Tables/DataManager.h>
@@ -40,6 +42,8 @@
 #include <casa/Containers/SimOrdMap.h>
 #include <casa/Utilities/LinearSearch.h>
 #include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/Utilities/ValType.h>
 #include <casa/OS/Path.h>
 #include <casa/BasicSL/String.h>
 
@@ -113,11 +117,11 @@ void TableCopy::copyRows (Table& out, const Table& in, uInt startout,
     if (startout + nrrow > out.nrow()) {
       out.addRow (startout + nrrow - out.nrow());
     }
-    ROTableRow inrow(in, cols);
-    outrow = TableRow(out, cols);
-    for (uInt i=0; i<nrrow; i++) {
-      inrow.get (startin + i);
-      outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
+    // Copy column by column in chunks of rows.
+    // Reading and writing can overlap if the tables are different.
+    Bool parallel = !out.isSameRoot (in);
+    for (uInt i=0; i<nrcol; i++) {
+      copyColumn (out, in, cols(i), startout, startin, nrrow, parallel);
     }
     if (flush) {
       out.flush();
@@ -125,6 +129,170 @@ void TableCopy::copyRows (Table& out, const Table& in, uInt startout,
   }
 }
 
+// Copy a range of rows of a column in chunks.
+// The next chunk is read while the current one is written; that is done
+// in parallel if possible. An exception cannot leave a parallel region,
+// so its message is kept.
+template<typename COL, typename ARR>
+static void copyChunks (COL& outCol, const COL& inCol,
+                        uInt startout, uInt startin, uInt nrrow,
+                        uInt chunkSize, Bool parallel)
+{
+  ARR bufs[2];
+  uInt nr = min(chunkSize, nrrow);
+  inCol.getColumnRange (Slicer(IPosition(1,startin), IPosition(1,nr)),
+                        bufs[0], True);
+  for (uInt st=0; st<nrrow; st+=chunkSize) {
+    uInt inx = (st / chunkSize) % 2;
+    nr = min(chunkSize, nrrow-st);
+    uInt nrnext = (st+nr < nrrow  ?  min(chunkSize, nrrow-st-nr) : 0);
+    String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel sections if (parallel  &&  nrnext > 0)
+#endif
+    {
+#ifdef _OPENMP
+#pragma omp section
+#endif
+      {
+        try {
+          if (nrnext > 0) {
+            inCol.getColumnRange (Slicer(IPosition(1,startin+st+nr),
+                                         IPosition(1,nrnext)),
+                                  bufs[1-inx], True);
+          }
+        } catch (AipsError& x) {
+#ifdef _OPENMP
+#pragma omp critical(TableCopy_copyChunks)
+#endif
+          errMsg = x.getMesg();
+        }
+      }
+#ifdef _OPENMP
+#pragma omp section
+#endif
+      {
+        try {
+          outCol.putColumnRange (Slicer(IPosition(1,startout+st),
+                                        IPosition(1,nr)),
+                                 bufs[inx]);
+        } catch (AipsError& x) {
+#ifdef _OPENMP
+#pragma omp critical(TableCopy_copyChunks)
+#endif
+          errMsg = x.getMesg();
+        }
+      }
+    }
+    if (! errMsg.empty()) {
+      throw TableError ("TableCopy: " + errMsg);
+    }
+  }
+}
+
+template<typename T>
+static void copyScalarChunks (Table& out, const Table& in,
+                              const String& name, uInt startout,
+                              uInt startin, uInt nrrow,
+                              uInt chunkSize, Bool parallel)
+{
+  ScalarColumn<T> outCol(out, name);
+  ScalarColumn<T> inCol(in, name);
+  copyChunks<ScalarColumn<T>,Vector<T> > (outCol, inCol, startout, startin,
+                                          nrrow, chunkSize, parallel);
+}
+
+template<typename T>
+static void copyArrayChunks (Table& out, const Table& in,
+                             const String& name, uInt startout,
+                             uInt startin, uInt nrrow,
+                             uInt chunkSize, Bool parallel)
+{
+  ArrayColumn<T> outCol(out, name);
+  ArrayColumn<T> inCol(in, name);
+  copyChunks<ArrayColumn<T>,Array<T> > (outCol, inCol, startout, startin,
+                                        nrrow, chunkSize, parallel);
+}
+
+#define TABLECOPY_CHUNKS(FUNC) \
+  switch (dtype) { \
+  case TpBool: \
+    FUNC<Bool> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpUChar: \
+    FUNC<uChar> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpShort: \
+    FUNC<Short> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpUShort: \
+    FUNC<uShort> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpInt: \
+    FUNC<Int> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpUInt: \
+    FUNC<uInt> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpFloat: \
+    FUNC<Float> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpDouble: \
+    FUNC<Double> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpComplex: \
+    FUNC<Complex> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpDComplex: \
+    FUNC<DComplex> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  case TpString: \
+    FUNC<String> (out, in, name, startout, startin, nrrow, chunkSize, parallel); \
+    return; \
+  default: \
+    break; \
+  }
+
+void TableCopy::copyColumn (Table& out, const Table& in, const String& name,
+                            uInt startout, uInt startin, uInt nrrow,
+                            Bool parallel)
+{
+  TableColumn outCol(out, name);
+  TableColumn inCol(in, name);
+  const ColumnDesc& outDesc = outCol.columnDesc();
+  const ColumnDesc& inDesc = inCol.columnDesc();
+  DataType dtype = inDesc.dataType();
+  if (nrrow > 0  &&  dtype == outDesc.dataType()) {
+    // Copy in chunks of about 4 MB.
+    uInt nbytes = 4*1024*1024;
+    uInt cellSize = ValType::getTypeSize (dtype);
+    if (inDesc.isScalar()  &&  outDesc.isScalar()) {
+      uInt chunkSize = max(1u, nbytes / cellSize);
+      TABLECOPY_CHUNKS(copyScalarChunks);
+    } else if (inDesc.isArray()  &&  outDesc.isArray()) {
+      // Only fixed shaped arrays can be copied in chunks, because only
+      // then all cells are defined and have the same shape.
+      Bool inFixed  = ((inDesc.options() & ColumnDesc::FixedShape)
+                       == ColumnDesc::FixedShape);
+      Bool outFixed = ((outDesc.options() & ColumnDesc::FixedShape)
+                       == ColumnDesc::FixedShape);
+      IPosition shape = (inFixed  ?  inCol.shapeColumn() : IPosition());
+      if (inFixed  &&  shape.nelements() > 0  &&
+          (!outFixed  ||  shape.isEqual (outCol.shapeColumn()))) {
+        uInt chunkSize = max(1u, uInt(nbytes / (cellSize * shape.product())));
+        TABLECOPY_CHUNKS(copyArrayChunks);
+      }
+    }
+  }
+  // Otherwise copy cell by cell (converting the type if needed).
+  // Undefined array cells are not copied.
+  for (uInt i=0; i<nrrow; i++) {
+    if (inCol.isDefined (startin + i)) {
+      outCol.put (startout + i, inCol, startin + i);
+    }
+  }
+}
+
 void TableCopy::copyInfo (Table& out, const Table& in)
 {
   out.tableInfo() = in.tableInfo();
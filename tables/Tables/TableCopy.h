@@ -64,6 +64,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //       existing table.
 //  <li> <src>copyRows</src> copies the data of one to another table.
 //       It is possible to specify where to start in the input and output.
+//       The data are copied column by column in chunks of rows.
 //  <li> <src>CopyInfo</src> copies the table info data.
 //  <li> <src>copySubTables</src> copies all the subtables in table and
 //       column keywords. It is done recursively.
@@ -120,6 +121,17 @@ public:
                         Bool flush=True);
   // </group>
 
+  // Copy a range of rows of the given column from the input to the output.
+  // Scalars and fixed shaped arrays of the same data type are copied in
+  // chunks of rows (of about 4 MB). If the tables are different, reading
+  // the next chunk and writing the current one is done in parallel
+  // (if compiled with OpenMP).
+  // Other columns are copied cell by cell, where undefined cells are skipped.
+  // The output table must contain the rows already.
+  static void copyColumn (Table& out, const Table& in, const String& name,
+                          uInt startout, uInt startin, uInt nrrow,
+                          Bool parallel = False);
+
   // Copy the table info block from input to output table.
   static void copyInfo (Table& out, const Table& in);
 
@@ -102,6 +102,8 @@ INTERSECT [Ii][Nn][Tt][Ee][Rr][Ss][Ee][Cc][Tt]
 EXCEPT    ([Ee][Xx][Cc][Ee][Pp][Tt])|([Mm][Ii][Nn][Uu][Ss])
 STYLE     [Uu][Ss][Ii][Nn][Gg]{WHITE}[Ss][Tt][Yy][Ll][Ee]{WHITE1}
 TIMEWORD  [Tt][Ii][Mm][Ee]
+EXPLAIN   [Ee][Xx][Pp][Ll][Aa][Ii][Nn]
+EXPLANAL  {EXPLAIN}{WHITE}[Aa][Nn][Aa][Ll][Yy][Zz][Ee]
 SELECT    [Ss][Ee][Ll][Ee][Cc][Tt]
 UPDATE    [Uu][Pp][Dd][Aa][Tt][Ee]
 INSERT    [Ii][Nn][Ss][Ee][Rr][Tt]
@@ -538,6 +540,25 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
             tableGramPosition() += yyleng;
 	    return TIMING;
 	  }
+
+ /* EXPLAIN [ANALYZE] tells that the query plan has to be shown.
+    In the Exprstate the word EXPLAIN is a normal column or function name.
+ */
+<EXPRstate>{EXPLAIN} { 
+            tableGramPosition() += yyleng;
+            lvalp->val = new TaQLConstNode(
+                new TaQLConstNodeRep (tableGramRemoveEscapes (TableGramtext)));
+            TaQLNode::theirNodesCreated.push_back (lvalp->val);
+	    return NAME;
+	  }
+{EXPLANAL} {
+            tableGramPosition() += yyleng;
+	    return EXPLANAL;
+	  }
+{EXPLAIN} {
+            tableGramPosition() += yyleng;
+	    return EXPLAIN;
+	  }
             
  /* In the FROM clause a shorthand (for a table) can be given.
     In the WHERE and ORDERBY clause a function name can be given.
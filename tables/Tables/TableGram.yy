@@ -42,6 +42,8 @@ using namespace casa;
 
 %token STYLE
 %token TIMING
+%token EXPLAIN
+%token EXPLANAL
 %token SELECT
 %token UPDATE
 %token UPDSET
@@ -205,6 +207,15 @@ int TableGramlex (YYSTYPE*);
 %%
 topcomm:   command
          | sttimcoms command
+         | explcomm command
+         | explcomm sttimcoms command
+         | sttimcoms explcomm command
+         ;
+
+explcomm:  EXPLAIN
+             { TaQLNode::theirStyle.setExplain (True, False); }
+         | EXPLANAL
+             { TaQLNode::theirStyle.setExplain (True, True); }
          ;
 
 sttimcoms: TIMING
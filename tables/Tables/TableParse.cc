@@ -52,6 +52,7 @@
 #include <tables/Tables/ArrColDesc.h>
 #include <tables/Tables/SetupNewTab.h>
 #include <tables/Tables/StandardStMan.h>
+#include <tables/Tables/DataManager.h>
 #include <tables/Tables/TableError.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Arrays/ArrayMath.h>
@@ -168,7 +169,10 @@ TableParseSelect::TableParseSelect (CommandType commandType)
     offset_p        (0),
     insSel_p        (0),
     noDupl_p        (False),
-    order_p         (Sort::Ascending)
+    order_p         (Sort::Ascending),
+    explain_p       (False),
+    analyze_p       (False),
+    planTime_p      (0)
 {}
 
 TableParseSelect::~TableParseSelect()
@@ -2260,25 +2264,22 @@ TableParseSelect::doGroupByAggrMultipleKeys
   // We have to group the data according to the (maybe empty) groupby.
   // We step through the table in the normal order which may not be the
   // groupby order.
-  // A map<key,int> is used to keep track of the results where the int
-  // is the index in a vector of a set of aggregate function objects.
+  // A hash map is used to map the keyset to the index in a vector of
+  // a set of aggregate function objects.
   vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-  std::map<TableExprGroupKeySet, int> keyFuncMap;
+  TableExprGroupHashMap<TableExprGroupKeySet> keyFuncMap;
   // Create the set of groupby key objects.
   TableExprGroupKeySet keySet(groupbyNodes_p);
   // Loop through all rows.
   // For each row generate the key to get the right entry.
   TableExprId rowid(0);
+  Bool isNew;
   for (uInt i=0; i<rownrs_p.size(); ++i) {
     rowid.setRownr (rownrs_p[i]);
     keySet.fill (groupbyNodes_p, rowid);
-    int groupnr = funcSets.size();
-    std::map<TableExprGroupKeySet, int>::iterator iter=keyFuncMap.find (keySet);
-    if (iter == keyFuncMap.end()) {
-      keyFuncMap[keySet] = groupnr;
+    int groupnr = keyFuncMap.find (keySet, isNew);
+    if (isNew) {
       funcSets.push_back (new TableExprGroupFuncSet (aggrNodes));
-    } else {
-      groupnr = iter->second;
     }
     funcSets[groupnr]->apply (rowid);
   }
@@ -2318,6 +2319,9 @@ CountedPtr<TableExprGroupResult> TableParseSelect::doGroupByAggr
   } else if (groupbyNodes_p.size() == 1  &&
              groupbyNodes_p[0].dataType() == TpInt) {
     funcSets = doGroupByAggrSingleKey<Int64> (immediateNodes);
+  } else if (groupbyNodes_p.size() == 1  &&
+             groupbyNodes_p[0].dataType() == TpString) {
+    funcSets = doGroupByAggrSingleKey<String> (immediateNodes);
   } else {
     funcSets = doGroupByAggrMultipleKeys (immediateNodes);
   }
@@ -2531,7 +2535,15 @@ void TableParseSelect::doSort (Bool showTimings)
   if (noDupl_p) {
     sortOpt += Sort::NoDuplicates;
   }
-  sort.sort (newRownrs, nrrow, sortOpt);
+  // If a positive limit is given (and no DISTINCT), only the first
+  // limit+offset rows are needed, so a partial sort suffices.
+  // doLimOff takes care of the offset and limit thereafter.
+  if (!distinct_p  &&  !noDupl_p  &&  limit_p > 0  &&  offset_p >= 0
+  &&  limit_p + offset_p < nrrow) {
+    sort.partialSort (newRownrs, nrrow, limit_p + offset_p, sortOpt);
+  } else {
+    sort.sort (newRownrs, nrrow, sortOpt);
+  }
   for (i=0; i<nrkey; i++) {
     const TableParseSort& key = sort_p[i];
     switch (key.node().getColumnDataType()) {
@@ -2642,8 +2654,11 @@ Table TableParseSelect::doProject
   if (showTimings) {
     timer.show ("  Projection  ");
   }
+  addPlanStage ("projection", rownrs_p.size(), tabp.nrow(), timer);
   if (distinct_p) {
+    Int64 nrowIn = tabp.nrow();
     tabp = doDistinct (showTimings, tabp);
+    addPlanStage ("distinct", nrowIn, tabp.nrow(), timer);
   }
   return tabp;
 }
@@ -2949,6 +2964,29 @@ void TableParseSelect::handleGiving (const TableExprNodeSet& set)
 
 
 //# Execute all parts of a TaQL command doing some selection.
+// Subtract the cache statistics at the start from the statistics at the end.
+static Record diffIOStatistics (const Record& start, const Record& end)
+{
+  Record rec(end);
+  for (uInt i=0; i<rec.nfields(); ++i) {
+    String name = rec.name(i);
+    if (rec.dataType(i) == TpRecord) {
+      if (start.isDefined(name)  &&  start.dataType(name) == TpRecord) {
+        rec.defineRecord (name, diffIOStatistics (start.subRecord(name),
+                                                  rec.subRecord(i)));
+      }
+    } else if (rec.dataType(i) == TpInt64  &&  start.isDefined(name)) {
+      rec.define (i, rec.asInt64(i) - start.asInt64(name));
+    }
+  }
+  if (rec.isDefined ("hitrate")) {
+    Int64 naccess = rec.asInt64 ("naccess");
+    rec.define ("hitrate", (naccess == 0  ?  0. :
+                            Double(rec.asInt64("nhit")) / naccess));
+  }
+  return rec;
+}
+
 void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
 				Bool mustSelect, uInt maxRow,
                                 Bool doTracing)
@@ -3030,6 +3068,17 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
   if (groupAggrUsed != 0  &&  (groupAggrUsed & GROUPBY) == 0) {
     distinct_p = False;
   }
+  //# Only check the command if the plan is made without executing it.
+  if (explain_p  &&  !analyze_p) {
+    return;
+  }
+  //# Keep the IO statistics at the start to know the IO done.
+  Timer execTimer;
+  Timer stageTimer;
+  if (analyze_p) {
+    planStages_p = Record();
+    planIO_p = getIOStatistics();
+  }
   //# The first table in the list is the source table.
   Table table = fromTables_p[0].table();
   //# Determine if we can pre-empt the selection loop.
@@ -3058,6 +3107,7 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
     if (showTimings) {
       timer.show ("  Where       ");
     }
+    addPlanStage ("where", table.nrow(), resultTable.nrow(), timer);
     if (doTracing) {
       cerr << "WHERE resulted in " << resultTable.nrow() << " rows" << endl;
     }
@@ -3067,11 +3117,14 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
   // Execute possible groupby/aggregate.
   CountedPtr<TableExprGroupResult> groupResult;
   if (groupAggrUsed != 0) {
+    Int64 nrowIn = rownrs_p.size();
+    stageTimer.mark();
     groupResult = doGroupby (showTimings, aggrNodes, groupAggrUsed);
     // Aggregate results and normal table rows need to have the same rownrs,
     // so set the selected rows in the table column objects.
     resultTable = adjustApplySelNodes(table);
     table = resultTable;
+    addPlanStage ("groupby", nrowIn, table.nrow(), stageTimer);
     if (doTracing) {
       cerr << "GROUPBY resulted in " << table.nrow() << " groups" << endl;
       cerr << "  applySelection called for " << applySelNodes_p.size()
@@ -3093,14 +3146,20 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
   }
   // Do the possible HAVING step.
   if (! havingNode_p.isNull()) {
+    Int64 nrowIn = rownrs_p.size();
+    stageTimer.mark();
     doHaving (showTimings, groupResult);
+    addPlanStage ("having", nrowIn, rownrs_p.size(), stageTimer);
     if (doTracing) {
       cerr << "HAVING resulted in " << rownrs_p.size() << " rows" << endl;
     }
   }
   //# Then do the sort.
   if (sort_p.size() > 0) {
+    Int64 nrowIn = rownrs_p.size();
+    stageTimer.mark();
     doSort (showTimings);
+    addPlanStage ("orderby", nrowIn, rownrs_p.size(), stageTimer);
     if (doTracing) {
       cerr << "ORDERBY resulted in " << rownrs_p.size() << " rows" << endl;
     }
@@ -3108,7 +3167,10 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
   // If select distinct is given, limit/offset can only be done thereafter
   // because duplicate rows will be removed.
   if (!distinct_p  &&  (offset_p != 0  ||  limit_p != 0)) {
+    Int64 nrowIn = rownrs_p.size();
+    stageTimer.mark();
     doLimOff (showTimings);
+    addPlanStage ("limitoffset", nrowIn, rownrs_p.size(), stageTimer);
     if (doTracing) {
       cerr << "LIMIT/OFFSET resulted in " << rownrs_p.size() << " rows" << endl;
     }
@@ -3119,18 +3181,24 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
   }
   resultTable = table(rownrs_p);
   //# Then do the update, delete, insert, or projection and so.
+  Int64 nrowIn = resultTable.nrow();
+  stageTimer.mark();
   if (commandType_p == PUPDATE) {
     doUpdate (showTimings, table, resultTable, rownrs_p);
     table.flush();
+    addPlanStage ("update", nrowIn, nrowIn, stageTimer);
   } else if (commandType_p == PINSERT) {
     Table tabNewRows = doInsert (showTimings, table);
     table.flush();
     resultTable = tabNewRows;
+    addPlanStage ("insert", 0, resultTable.nrow(), stageTimer);
   } else if (commandType_p == PDELETE) {
     doDelete (showTimings, table);
     table.flush();
+    addPlanStage ("delete", nrowIn, nrowIn, stageTimer);
   } else if (commandType_p == PCOUNT) {
     resultTable = doCount (showTimings, table);
+    addPlanStage ("count", nrowIn, resultTable.nrow(), stageTimer);
   } else {
     //# Then do the projection.
     if (columnNames_p.nelements() > 0) {
@@ -3144,7 +3212,10 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
     }
     // If select distinct is given, limit/offset must be done at the end.
     if (distinct_p  &&  (offset_p != 0  ||  limit_p != 0)) {
+      nrowIn = resultTable.nrow();
+      stageTimer.mark();
       resultTable = doLimOff (showTimings, resultTable);
+      addPlanStage ("limitoffset", nrowIn, resultTable.nrow(), stageTimer);
       if (doTracing) {
         cerr << "LIMIT/OFFSET resulted in " << resultTable.nrow()
              << " rows" << endl;
@@ -3152,7 +3223,10 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
     }
     //# Finally rename or copy using the given name (and flush it).
     if (resultType_p != 0  ||  ! resultName_p.empty()) {
+      nrowIn = resultTable.nrow();
+      stageTimer.mark();
       resultTable = doFinish (showTimings, resultTable);
+      addPlanStage ("giving", nrowIn, resultTable.nrow(), stageTimer);
       if (doTracing) {
         cerr << "Finished the GIVING command" << endl;
       }
@@ -3160,6 +3234,10 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
   }
   //# Keep the table for later.
   table_p = resultTable;
+  if (analyze_p) {
+    planTime_p = execTimer.real();
+    planIO_p = diffIOStatistics (planIO_p, getIOStatistics());
+  }
 }    
 
 void TableParseSelect::checkAggrFuncs (const TableExprNode& node)
@@ -3221,6 +3299,106 @@ void TableParseSelect::show (ostream& os) const
   }
 }
 
+void TableParseSelect::setExplain (Bool analyze)
+{
+  explain_p = True;
+  analyze_p = analyze;
+}
+
+void TableParseSelect::addPlanStage (const String& name, Int64 nrowIn,
+                                     Int64 nrowOut, Timer& timer)
+{
+  if (analyze_p) {
+    Record rec;
+    rec.define ("nrow_in", nrowIn);
+    rec.define ("nrow_out", nrowOut);
+    rec.define ("time", timer.real());
+    planStages_p.defineRecord (name, rec);
+    timer.mark();
+  }
+}
+
+Record TableParseSelect::getIOStatistics() const
+{
+  // Find the data managers used by the columns of the FROM tables.
+  Record rec;
+  for (uInt i=0; i<fromTables_p.size(); ++i) {
+    const Table& tab = fromTables_p[i].table();
+    Record tabRec;
+    if (! tab.isNull()) {
+      Vector<String> colNames (tab.tableDesc().columnNames());
+      for (uInt j=0; j<colNames.size(); ++j) {
+        DataManager* dmPtr = tab.findDataManager (colNames[j], True);
+        String fieldName = "dm" + String::toString(dmPtr->sequenceNr());
+        if (tabRec.isDefined (fieldName)) {
+          Record& dmRec = tabRec.rwSubRecord (fieldName);
+          Vector<String> cols (dmRec.asArrayString ("columns"));
+          cols.resize (cols.size() + 1, True);
+          cols[cols.size() - 1] = colNames[j];
+          dmRec.define ("columns", cols);
+        } else {
+          Record dmRec;
+          dmRec.define ("name", dmPtr->dataManagerName());
+          dmRec.define ("type", dmPtr->dataManagerType());
+          dmRec.define ("columns", Vector<String>(1, colNames[j]));
+          dmRec.defineRecord ("cache", dmPtr->getCacheStatistics());
+          tabRec.defineRecord (fieldName, dmRec);
+        }
+      }
+    }
+    rec.defineRecord ("table" + String::toString(i), tabRec);
+  }
+  return rec;
+}
+
+Record TableParseSelect::getPlan() const
+{
+  Record plan;
+  const char* commands[] = {"select", "update", "insert", "delete",
+                            "count", "calc", "create table"};
+  plan.define ("command", commands[commandType_p]);
+  plan.define ("analyzed", analyze_p);
+  Record tabRec;
+  for (uInt i=0; i<fromTables_p.size(); ++i) {
+    const Table& tab = fromTables_p[i].table();
+    Record rec;
+    if (! tab.isNull()) {
+      rec.define ("name", tab.tableName());
+      rec.define ("nrow", Int64(tab.nrow()));
+    }
+    tabRec.defineRecord ("table" + String::toString(i), rec);
+  }
+  plan.defineRecord ("tables", tabRec);
+  plan.define ("where", !node_p.isNull());
+  plan.define ("groupby", Int(groupbyNodes_p.size()));
+  plan.define ("rollup", groupbyRollup_p);
+  plan.define ("having", !havingNode_p.isNull());
+  plan.define ("orderby", Int(sort_p.size()));
+  plan.define ("noduplicates", noDupl_p);
+  // A partial (top-K) sort is done if a positive limit is given (see doSort).
+  Int64 topk = 0;
+  if (!sort_p.empty()  &&  !distinct_p  &&  !noDupl_p
+  &&  limit_p > 0  &&  offset_p >= 0) {
+    topk = limit_p + offset_p;
+  }
+  plan.define ("topk", topk);
+  plan.define ("distinct", distinct_p);
+  plan.define ("limit", limit_p);
+  plan.define ("offset", offset_p);
+  Vector<String> cols(columnNames_p.nelements());
+  for (uInt i=0; i<cols.size(); ++i) {
+    cols[i] = columnNames_p[i];
+  }
+  plan.define ("columns", cols);
+  plan.define ("giving", resultName_p);
+  if (analyze_p) {
+    plan.defineRecord ("stages", planStages_p);
+    plan.define ("time", planTime_p);
+    plan.defineRecord ("io", planIO_p);
+  }
+  return plan;
+}
+
 
 //# Simplified forms of general tableCommand function.
 TaQLResult tableCommand (const String& str)
@@ -3262,13 +3440,24 @@ TaQLResult tableCommand (const String& str,
   return tableCommand (str, tempTables, cols, commandType);
 }
 
-//# Do the actual parsing of a command and execute it.
 TaQLResult tableCommand (const String& str,
 			 const std::vector<const Table*>& tempTables,
 			 Vector<String>& cols,
 			 String& commandType)
+{
+  Record plan;
+  return tableCommand (str, tempTables, cols, commandType, plan);
+}
+
+//# Do the actual parsing of a command and execute it.
+TaQLResult tableCommand (const String& str,
+			 const std::vector<const Table*>& tempTables,
+			 Vector<String>& cols,
+			 String& commandType,
+			 Record& plan)
 {
   commandType = "error";
+  plan = Record();
   // Do the first parse step. It returns a raw parse tree
   // (or throws an exception).
   Timer timer;
@@ -3279,6 +3468,9 @@ TaQLResult tableCommand (const String& str,
     TaQLNodeResult res = treeHandler.handleTree (tree, tempTables);
     const TaQLNodeHRValue& hrval = TaQLNodeHandler::getHR(res);
     commandType = hrval.getString();
+    if (tree.style().doExplain()) {
+      plan = hrval.getRecord();
+    }
     TableExprNode expr = hrval.getExpr();
     if (tree.style().doTiming()) {
       timer.show (" Total time   ");
@@ -38,6 +38,7 @@
 #include <casa/BasicSL/String.h>
 #include <casa/Utilities/Sort.h>
 #include <casa/Containers/Block.h>
+#include <casa/Containers/Record.h>
 #include <map>
 #include <vector>
 #include <limits>
@@ -49,6 +50,7 @@ class TableExprNodeSet;
 class TableExprNodeIndex;
 class TableColumn;
 class AipsIO;
+class Timer;
 template<class T> class Vector;
 
 
@@ -143,6 +145,16 @@ private:
 // column names can be returned.
 // Zero or more temporary tables can be used in the command
 // using the $nnn syntax.
+// <p>
+// If the command is preceded by EXPLAIN, the query plan is made without
+// executing the command (a null table is returned). EXPLAIN ANALYZE
+// executes the command and adds to the plan the number of rows and time
+// of each stage executed and the IO statistics (bytes read, cache hit
+// rate, etc.) of the data managers of the tables used.
+// The plan is returned in the <src>plan</src> argument (which is empty if
+// no EXPLAIN is given), so the caller can decide what to do with it.
+// The functions without that argument ignore the plan.
+// See <src>TableParseSelect::getPlan</src> for its layout.
 // </synopsis>
 // <group name=tableCommand>
 TaQLResult tableCommand (const String& command);
@@ -163,6 +175,11 @@ TaQLResult tableCommand (const String& command,
 			 const std::vector<const Table*>& tempTables,
 			 Vector<String>& columnNames,
 			 String& commandType);
+TaQLResult tableCommand (const String& command,
+			 const std::vector<const Table*>& tempTables,
+			 Vector<String>& columnNames,
+			 String& commandType,
+			 Record& plan);
 // </group>
 
 
@@ -399,6 +416,35 @@ public:
   // Show the expression tree.
   void show (ostream& os) const;
 
+  // Tell that the query plan has to be made (EXPLAIN).
+  // If <src>analyze</src> is True, <src>execute</src> executes the command
+  // and collects the number of rows and time of each stage and the IO
+  // statistics of the data managers used. Otherwise <src>execute</src>
+  // only checks the command.
+  void setExplain (Bool analyze);
+
+  // Get the query plan. It is a record containing the fields:
+  // <ul>
+  //  <li> command: the command type (select, update, etc.).
+  //  <li> analyzed: was the command executed?
+  //  <li> tables: a subrecord per FROM table giving its name and #rows.
+  //  <li> the clauses given: where, groupby (#keys), rollup, having,
+  //       orderby (#keys), noduplicates, topk (#rows sorted partially
+  //       because of a LIMIT, 0 means full sort), distinct, limit, offset,
+  //       columns (projected column names) and giving.
+  //  <li> stages (only if analyzed): a subrecord per stage executed (where,
+  //       groupby, having, orderby, limitoffset, projection, distinct, 
+  //       update, insert, delete, count, giving) in order of execution
+  //       giving its nrow_in, nrow_out and time (in seconds).
+  //  <li> time (only if analyzed): the execution time (in seconds).
+  //  <li> io (only if analyzed): a subrecord per FROM table containing
+  //       a subrecord per data manager giving its name, type, columns
+  //       used in the table, and its cache statistics during the execution
+  //       (see <src>DataManager::addCacheStatistics</src>).
+  //       Note that the statistics are per data manager, not per column.
+  // </ul>
+  Record getPlan() const;
+
   // Keep the selection expression.
   void handleWhere (const TableExprNode&);
 
@@ -578,7 +624,16 @@ private:
   CountedPtr<TableExprGroupResult> doGroupByAggr
   (const vector<TableExprNodeRep*>& aggrNodes);
 
+  // Add a stage to the plan if the command is analyzed.
+  // The timer gives the time used by the stage; it is reset.
+  void addPlanStage (const String& name, Int64 nrowIn, Int64 nrowOut,
+                     Timer& timer);
+
+  // Get the cache statistics of the data managers of the FROM tables.
+  Record getIOStatistics() const;
+
   // Do the sort step.
+  // If a LIMIT is given, only the rows needed are sorted (top-K).
   void doSort (Bool showTimings);
 
   // Do the limit/offset step.
@@ -680,30 +735,29 @@ private:
     // We have to group the data according to the (possibly empty) groupby.
     // We step through the table in the normal order which may not be the
     // groupby order.
-    // A map<key,int> is used to keep track of the results where the int
-    // is the index in a vector of a set of aggregate function objects.
+    // A hash map is used to map the key to the index in a vector of
+    // a set of aggregate function objects.
+    // Consecutive rows often have the same key, so the group of the
+    // last key is kept.
     vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-    std::map<T, int> keyFuncMap;
-    T lastKey = std::numeric_limits<Double>::max();
+    TableExprGroupHashMap<T> keyFuncMap;
+    T lastKey = T();
     int groupnr = -1;
     // Loop through all rows.
     // For each row generate the key to get the right entry.
     TableExprId rowid(0);
     T key;
+    Bool isNew;
     for (uInt i=0; i<rownrs_p.size(); ++i) {
       rowid.setRownr (rownrs_p[i]);
       groupbyNodes_p[0].get (rowid, key);
-      if (key != lastKey) {
-        typename std::map<T, int>::iterator iter = keyFuncMap.find (key);
-        if (iter == keyFuncMap.end()) {
-          groupnr = funcSets.size();
-          keyFuncMap[key] = groupnr;
+      if (groupnr < 0  ||  !groupKeyEqual (key, lastKey)) {
+        groupnr = keyFuncMap.find (key, isNew);
+        if (isNew) {
           funcSets.push_back (new TableExprGroupFuncSet (aggrNodes));
-        } else {
-          groupnr = iter->second;
         }
+        lastKey = key;
       }
-      rowid.setRownr (rownrs_p[i]);
       funcSets[groupnr]->apply (rowid);
     }
     return funcSets;
@@ -777,6 +831,13 @@ private:
   Block<Bool>  projectExprSelColumn_p;
   //# The resulting row numbers.
   Vector<uInt> rownrs_p;
+  //# Make the query plan (EXPLAIN) and execute the command (ANALYZE)?
+  Bool   explain_p;
+  Bool   analyze_p;
+  //# The stages executed, the IO statistics and the execution time.
+  Record planStages_p;
+  Record planIO_p;
+  Double planTime_p;
 };
 
 
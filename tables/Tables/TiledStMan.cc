@@ -38,6 +38,7 @@
 #include <tables/Tables/TableDesc.h>
 #include <tables/Tables/ColumnDesc.h>
 #include <casa/Arrays/Vector.h>
+#include <casa/Containers/Record.h>
 #include <casa/Arrays/IPosition.h>
 #include <casa/Utilities/DataType.h>
 #include <casa/BasicSL/String.h>
@@ -348,7 +349,7 @@ void TiledStMan::deleteManager()
 	    fileSet_p[i]->bucketFile()->remove();
 	}
     }
-    DOos::remove (fileName(), False, False);
+    removeFile (fileName());
 }
 
 void TiledStMan::setMaximumCacheSize (uInt nbytes)
@@ -482,6 +483,17 @@ void TiledStMan::showCacheStatistics (ostream& os) const
     }
 }
 
+Record TiledStMan::getCacheStatistics() const
+{
+    Record rec;
+    for (uInt i=0; i<cubeSet_p.nelements(); i++) {
+	if (cubeSet_p[i] != 0) {
+	    cubeSet_p[i]->addCacheStatistics (rec);
+	}
+    }
+    return rec;
+}
+
 TSMCube* TiledStMan::singleHypercube()
 {
     if (cubeSet_p.nelements() != 1  ||  cubeSet_p[0] == 0) {
@@ -1013,13 +1025,13 @@ Bool TiledStMan::flushCaches (Bool fsync)
 
 AipsIO* TiledStMan::headerFileCreate()
 {
-    AipsIO* file = new AipsIO (fileName(), ByteIO::New);
+    AipsIO* file = new AipsIO (fileName(), ByteIO::New, 65536, multiFile());
     return file;
 }
 
 AipsIO* TiledStMan::headerFileOpen()
 {
-    AipsIO* file = new AipsIO (fileName());
+    AipsIO* file = new AipsIO (fileName(), ByteIO::Old, 65536, multiFile());
     return file;
 }
 
@@ -1181,6 +1193,16 @@ void TiledStMan::headerFileClose (AipsIO* headerFile)
 }
 
 
+Bool TiledStMan::usesDirectIO() const
+{
+    for (uInt i=0; i<fileSet_p.nelements(); i++) {
+	if (fileSet_p[i] != 0  &&  fileSet_p[i]->bucketFile()->isDirect()) {
+	    return True;
+	}
+    }
+    return False;
+}
+
 TSMFile* TiledStMan::getFile (uInt sequenceNumber)
 {
     //# Do internal check to see if TSMFile really exists.
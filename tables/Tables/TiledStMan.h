@@ -253,6 +253,9 @@ public:
     // Show the statistics of all caches used.
     void showCacheStatistics (ostream& os) const;
 
+    // Get the statistics of all caches used summed as a record.
+    Record getCacheStatistics() const;
+
     // Get the length of the data for the given number of pixels.
     // This can be used to calculate the length of a tile.
     uInt getLengthOffset (uInt nrPixels, Block<uInt>& dataOffset,
@@ -275,6 +278,11 @@ public:
     // Return the number of hypercubes.
     uInt nhypercubes() const;
 
+    // Are the files accessed using direct IO?
+    // It is False if TSMOption::Direct was not used or if the file system
+    // does not support direct IO.
+    Bool usesDirectIO() const;
+
     // Test if only one hypercube is used by this storage manager.
     // If not, throw an exception. Otherwise return the hypercube.
     virtual TSMCube* singleHypercube();
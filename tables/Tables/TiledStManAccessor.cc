@@ -118,6 +118,11 @@ uInt ROTiledStManAccessor::nhypercubes() const
     return dataManPtr_p->nhypercubes();
 }
 
+Bool ROTiledStManAccessor::usesDirectIO() const
+{
+    return dataManPtr_p->usesDirectIO();
+}
+
 uInt ROTiledStManAccessor::getCacheSize (uInt hypercube) const
 {
     return dataManPtr_p->getTSMCube(hypercube)->cacheSize();
@@ -207,6 +207,11 @@ public:
     // Return the number of hypercubes.
     uInt nhypercubes() const;
 
+    // Are the files accessed using direct IO?
+    // It is False if TSMOption::Direct was not used or if the file system
+    // does not support direct IO.
+    Bool usesDirectIO() const;
+
     // Get the current cache size (in buckets) for the given hypercube.
     uInt getCacheSize (uInt hypercube) const;
 
@@ -31,6 +31,8 @@
 #include <tables/Tables/ScaColDesc.h>
 #include <tables/Tables/ScalarColumn.h>
 #include <tables/Tables/ColumnsIndex.h>
+#include <tables/Tables/ExprNode.h>
+#include <tables/Tables/TableParse.h>
 #include <casa/Arrays/ArrayIO.h>
 #include <casa/Arrays/ArrayUtil.h>
 #include <casa/Containers/Record.h>
@@ -325,6 +327,103 @@ void d()
     cout << "<<<" << endl;
 }
 
+void e()
+{
+    // Test a persistent index.
+    Vector<String> names(1, "auint");
+    {
+        Table tab("tColumnsIndex_tmp.data", Table::Update);
+	AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, names));
+        ColumnsIndex colInx (tab, "auint");
+	AlwaysAssertExit (! colInx.isPersistent());
+	colInx.makePersistent();
+	AlwaysAssertExit (colInx.isPersistent());
+    }
+    {
+        // The index is now read from the file.
+        Table tab("tColumnsIndex_tmp.data");
+	AlwaysAssertExit (ColumnsIndex::hasPersistentIndex (tab, names));
+	ColumnsIndex colInx (tab, "auint");
+	AlwaysAssertExit (colInx.isPersistent());
+	AlwaysAssertExit (colInx.isReadFromFile());
+	RecordFieldPtr<uInt> auint (colInx.accessKey(), "auint");
+	for (Int i=0; i<4; i++) {
+	    *auint = 1+2*i;
+	    cout << colInx.getRowNumbers() << endl;
+	}
+	// A selection uses the index to preselect the rows.
+	cout << tab(tab.col("auint") == 3).rowNumbers() << endl;
+	cout << tab(tab.col("auint") >= 4  &&
+		    tab.col("adouble") < 8).rowNumbers() << endl;
+	cout << tableCommand ("select from tColumnsIndex_tmp.data"
+			      " where auint in [1,7]").table().rowNumbers()
+	     << endl;
+	cout << tableCommand ("select from tColumnsIndex_tmp.data"
+			      " where auint > 6 || aint == -1")
+	             .table().rowNumbers() << endl;
+    }
+    {
+        // Add rows; only the new rows are read into the index.
+        Table tab("tColumnsIndex_tmp.data", Table::Update);
+	ColumnsIndex colInx (tab, "auint");
+	AlwaysAssertExit (colInx.isPersistent());
+	RecordFieldPtr<uInt> auint (colInx.accessKey(), "auint");
+	tab.addRow (2);
+	ScalarColumn<uInt> auintCol(tab, "auint");
+	auintCol.put (tab.nrow()-2, 11);
+	auintCol.put (tab.nrow()-1, 11);
+	colInx.setAppended();
+	// Flush the table first, so the index file matches the table.
+	tab.flush();
+	*auint = 11;
+	cout << colInx.getRowNumbers() << endl;
+    }
+    {
+        // The index file has been updated, so it can be used.
+        Table tab("tColumnsIndex_tmp.data");
+	ColumnsIndex colInx (tab, "auint");
+	AlwaysAssertExit (colInx.isReadFromFile());
+	RecordFieldPtr<uInt> auint (colInx.accessKey(), "auint");
+	*auint = 11;
+	cout << colInx.getRowNumbers() << endl;
+	cout << tab(tab.col("auint") == 11).rowNumbers() << endl;
+    }
+    {
+        // Change a value without locking; the modify counter of the table
+        // is not changed, but the index file is out-of-date.
+        Table tab("tColumnsIndex_tmp.data",
+		  TableLock(TableLock::NoLocking), Table::Update);
+	ScalarColumn<uInt> auintCol(tab, "auint");
+	auintCol.put (0, 11);
+    }
+    {
+        // The index file must not be used, so the changed row is found.
+        Table tab("tColumnsIndex_tmp.data");
+	ColumnsIndex colInx (tab, "auint");
+	AlwaysAssertExit (colInx.isPersistent());
+	AlwaysAssertExit (! colInx.isReadFromFile());
+	RecordFieldPtr<uInt> auint (colInx.accessKey(), "auint");
+	*auint = 11;
+	cout << colInx.getRowNumbers() << endl;
+	cout << tab(tab.col("auint") == 11).rowNumbers() << endl;
+    }
+    {
+        // Remove a row and add two; all rows have to be reread.
+        Table tab("tColumnsIndex_tmp.data", Table::Update);
+	ColumnsIndex colInx (tab, "auint");
+	RecordFieldPtr<uInt> auint (colInx.accessKey(), "auint");
+	*auint = 11;
+	cout << colInx.getRowNumbers() << endl;
+	tab.removeRow (0);
+	tab.addRow (2);
+	ScalarColumn<uInt> auintCol(tab, "auint");
+	auintCol.put (tab.nrow()-1, 11);
+	cout << colInx.getRowNumbers() << endl;
+	ColumnsIndex::removePersistentIndex (tab, names);
+	AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, names));
+    }
+}
+
 int main()
 {
     try {
@@ -332,6 +431,7 @@ int main()
 	b();
 	c();
 	d();
+	e();
     } catch (AipsError x) {
         cout << "Exception caught: " << x.getMesg() << endl;
 	return 1;
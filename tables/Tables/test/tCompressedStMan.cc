@@ -0,0 +1,330 @@
+//# tCompressedStMan.cc: Test program for the CompressedStMan storage manager
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <tables/Tables/CompressedStMan.h>
+#include <tables/Tables/CSMCodec.h>
+#include <tables/Tables/TableDesc.h>
+#include <tables/Tables/SetupNewTab.h>
+#include <tables/Tables/Table.h>
+#include <tables/Tables/ScaColDesc.h>
+#include <tables/Tables/ArrColDesc.h>
+#include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/ArrayColumn.h>
+#include <tables/Tables/DataManError.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Matrix.h>
+#include <casa/Arrays/Cube.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/Arrays/ArrayIO.h>
+#include <casa/Containers/Block.h>
+#include <casa/Containers/Record.h>
+#include <casa/OS/File.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+#include <cstring>
+
+#include <casa/namespace.h>
+// <summary>
+// Test program for the CompressedStMan storage manager
+// </summary>
+
+// This program tests the codecs and the CompressedStMan storage manager.
+// The results are written to stdout. The script executing this program,
+// compares the results with the reference output file.
+
+
+// Compress and decompress a buffer and check if the result is the same.
+uInt roundTrip (const CSMCodec& codec, const Block<uChar>& data)
+{
+  Block<uChar> comp(data.nelements());
+  uInt n = codec.compress (data.storage(), data.nelements(), comp.storage());
+  if (n > 0) {
+    AlwaysAssertExit (n < data.nelements());
+    Block<uChar> decomp(data.nelements());
+    codec.decompress (comp.storage(), n, decomp.storage(), decomp.nelements());
+    AlwaysAssertExit (memcmp (data.storage(), decomp.storage(),
+                              data.nelements()) == 0);
+  }
+  return n;
+}
+
+void testCodec()
+{
+  CSMCodec* lz4 = CSMCodec::create ("lz4");
+  CSMCodec* none = CSMCodec::create ("none");
+  cout << "codecs: " << lz4->name() << ' ' << none->name() << endl;
+  // Zeroes compress very well.
+  Block<uChar> zeroes(100000, uChar(0));
+  uInt n = roundTrip (*lz4, zeroes);
+  cout << "zeroes compressed " << (n > 0  &&  n < 1000) << endl;
+  AlwaysAssertExit (roundTrip (*none, zeroes) == 0);
+  // A repeating pattern.
+  Block<uChar> pattern(65536);
+  for (uInt i=0; i<pattern.nelements(); i++) {
+    pattern[i] = (i%7) * (i%13);
+  }
+  n = roundTrip (*lz4, pattern);
+  cout << "pattern compressed " << (n > 0  &&  n < 10000) << endl;
+  // Pseudo-random data do not compress.
+  Block<uChar> noise(10000);
+  uInt seed = 12345;
+  for (uInt i=0; i<noise.nelements(); i++) {
+    seed = seed * 1103515245 + 12345;
+    noise[i] = seed >> 24;
+  }
+  cout << "noise compressed " << roundTrip (*lz4, noise) << endl;
+  // Short buffers.
+  for (uInt sz=0; sz<40; sz++) {
+    Block<uChar> buf(sz, uChar(1));
+    roundTrip (*lz4, buf);
+  }
+  // Shuffle followed by unshuffle.
+  Vector<Double> vals(1000);
+  indgen (vals, 1e9, 0.5);
+  Block<uChar> shuf(8000), unshuf(8000);
+  CSMCodec::shuffle (shuf.storage(), (const uChar*)(vals.data()), 1000, 8);
+  CSMCodec::unshuffle (unshuf.storage(), shuf.storage(), 1000, 8);
+  AlwaysAssertExit (memcmp (vals.data(), unshuf.storage(), 8000) == 0);
+  // Shuffled data compress better.
+  Block<uChar> orig(8000);
+  memcpy (orig.storage(), vals.data(), 8000);
+  uInt n1 = roundTrip (*lz4, orig);
+  uInt n2 = roundTrip (*lz4, shuf);
+  cout << "shuffle helps " << (n2 > 0  &&  (n1 == 0  ||  n2 < n1)) << endl;
+  // Corrupt data must be detected.
+  Block<uChar> comp(zeroes.nelements());
+  n = lz4->compress (zeroes.storage(), zeroes.nelements(), comp.storage());
+  Block<uChar> decomp(zeroes.nelements());
+  try {
+    lz4->decompress (comp.storage(), n-2, decomp.storage(),
+                     decomp.nelements());
+    cout << "corrupt data not detected" << endl;
+  } catch (DataManError& x) {
+    cout << x.getMesg() << endl;
+  }
+  try {
+    CSMCodec::create ("unknown");
+  } catch (DataManError& x) {
+    cout << x.getMesg() << endl;
+  }
+  delete lz4;
+  delete none;
+}
+
+// Create a table with a few columns and fill it row by row.
+void createTable (uInt nrrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ArrayColumnDesc<Bool>    ("FLAG", IPosition(2,4,8),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float>   ("WEIGHT", IPosition(1,4),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Complex> ("DATA", IPosition(2,4,8),
+                                          ColumnDesc::FixedShape));
+  SetupNewTable newtab("tCompressedStMan_tmp.data", td, Table::New);
+  // Use small chunks to get many of them.
+  CompressedStMan csm ("CSM", "lz4", True, 1024);
+  newtab.bindAll (csm);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int>    ant  (tab, "ANTENNA1");
+  ScalarColumn<Double> time (tab, "TIME");
+  ArrayColumn<Bool>    flag (tab, "FLAG");
+  ArrayColumn<Float>   wgt  (tab, "WEIGHT");
+  ArrayColumn<Complex> data (tab, "DATA");
+  Matrix<Bool> fl(4,8);
+  Vector<Float> wt(4);
+  Matrix<Complex> dt(4,8);
+  for (uInt i=0; i<nrrow; i++) {
+    ant.put (i, i%10);
+    time.put (i, 4.5e9 + i/10);
+    fl = False;
+    fl(i%4, i%8) = True;
+    flag.put (i, fl);
+    wt = Float(i%3);
+    wgt.put (i, wt);
+    indgen (dt, Complex(i, 0), Complex(0,1));
+    data.put (i, dt);
+  }
+}
+
+// Check the contents of the given row with the original row number.
+void checkRow (const Table& tab, uInt rownr, uInt orignr)
+{
+  ROScalarColumn<Int>    ant  (tab, "ANTENNA1");
+  ROScalarColumn<Double> time (tab, "TIME");
+  ROArrayColumn<Bool>    flag (tab, "FLAG");
+  ROArrayColumn<Float>   wgt  (tab, "WEIGHT");
+  ROArrayColumn<Complex> data (tab, "DATA");
+  AlwaysAssertExit (ant(rownr) == Int(orignr%10));
+  AlwaysAssertExit (time(rownr) == 4.5e9 + orignr/10);
+  Matrix<Bool> fl(4,8);
+  fl = False;
+  fl(orignr%4, orignr%8) = True;
+  AlwaysAssertExit (allEQ (flag(rownr), fl));
+  AlwaysAssertExit (allEQ (wgt(rownr), Float(orignr%3)));
+  Matrix<Complex> dt(4,8);
+  indgen (dt, Complex(orignr, 0), Complex(0,1));
+  AlwaysAssertExit (allEQ (data(rownr), dt));
+}
+
+void readTable (uInt nrrow)
+{
+  Table tab("tCompressedStMan_tmp.data");
+  AlwaysAssertExit (tab.nrow() == nrrow);
+  Record dminfo = tab.dataManagerInfo();
+  cout << "type=" << dminfo.subRecord(0).asString("TYPE")
+       << " spec=" << dminfo.subRecord(0).subRecord("SPEC") << endl;
+  // Read backwards to access the chunks at random.
+  for (Int i=nrrow-1; i>=0; i--) {
+    checkRow (tab, i, i);
+  }
+  // Read entire columns.
+  ROScalarColumn<Int> ant (tab, "ANTENNA1");
+  Vector<Int> ants = ant.getColumn();
+  ROArrayColumn<Bool> flag (tab, "FLAG");
+  Cube<Bool> flags = flag.getColumn();
+  AlwaysAssertExit (ntrue(flags) == nrrow);
+  for (uInt i=0; i<nrrow; i++) {
+    AlwaysAssertExit (ants[i] == Int(i%10));
+    AlwaysAssertExit (flags(i%4, i%8, i));
+  }
+  // Read a slice.
+  ROArrayColumn<Complex> data (tab, "DATA");
+  Matrix<Complex> slice = data.getSlice (5, Slicer(IPosition(2,1,2),
+                                                   IPosition(2,2,3)));
+  cout << "slice " << slice.shape() << ' ' << slice(0,0) << endl;
+  // The data file has to be much smaller than the uncompressed data.
+  uInt size = 4+8+32+16+256;
+  Int64 fsize = File("tCompressedStMan_tmp.data/table.f0").size();
+  cout << "compressed " << (fsize < Int64(nrrow*size/2)) << endl;
+}
+
+void removeRows()
+{
+  Table tab("tCompressedStMan_tmp.data", Table::Update);
+  uInt nrrow = tab.nrow();
+  tab.removeRow (nrrow-1);
+  tab.removeRow (500);
+  tab.removeRow (0);
+  tab.flush();
+  Table tab2("tCompressedStMan_tmp.data");
+  cout << "after remove nrow=" << tab2.nrow() << endl;
+  for (uInt i=0; i<tab2.nrow(); i++) {
+    checkRow (tab2, i, (i<499 ? i+1 : i+2));
+  }
+}
+
+void addRows()
+{
+  Table tab("tCompressedStMan_tmp.data", Table::Update);
+  uInt nrrow = tab.nrow();
+  tab.addRow (20);
+  ScalarColumn<Int> ant (tab, "ANTENNA1");
+  ArrayColumn<Bool> flag (tab, "FLAG");
+  cout << "after add nrow=" << tab.nrow() << ' ' << ant(nrrow+19)
+       << ' ' << anyEQ(flag(nrrow), True) << endl;
+  // Put entire columns.
+  Vector<Int> ants(tab.nrow());
+  indgen (ants);
+  ant.putColumn (ants);
+  Cube<Bool> flags(4, 8, tab.nrow());
+  flags = True;
+  flag.putColumn (flags);
+  ArrayColumn<Float> wgt (tab, "WEIGHT");
+  wgt.putSlice (3, Slicer(IPosition(1,1), IPosition(1,2)),
+                Vector<Float>(2, 5.));
+  tab.flush();
+  Table tab2("tCompressedStMan_tmp.data");
+  ROScalarColumn<Int> ant2 (tab2, "ANTENNA1");
+  ROArrayColumn<Bool> flag2 (tab2, "FLAG");
+  ROArrayColumn<Float> wgt2 (tab2, "WEIGHT");
+  for (uInt i=0; i<tab2.nrow(); i++) {
+    AlwaysAssertExit (ant2(i) == Int(i));
+    AlwaysAssertExit (allEQ (flag2(i), True));
+  }
+  cout << "weight " << wgt2(3) << endl;
+}
+
+void addRemoveColumn()
+{
+  Table tab("tCompressedStMan_tmp.data", Table::Update);
+  Record spec;
+  spec.define ("CODEC", "none");
+  spec.define ("SHUFFLE", False);
+  CompressedStMan csm ("CSM2", spec);
+  tab.addColumn (ScalarColumnDesc<uShort>("SPW"), csm);
+  ScalarColumn<uShort> spw (tab, "SPW");
+  for (uInt i=0; i<tab.nrow(); i++) {
+    spw.put (i, i%4);
+  }
+  tab.removeColumn ("WEIGHT");
+  tab.flush();
+  Table tab2("tCompressedStMan_tmp.data");
+  ROScalarColumn<uShort> spw2 (tab2, "SPW");
+  for (uInt i=0; i<tab2.nrow(); i++) {
+    AlwaysAssertExit (spw2(i) == i%4);
+  }
+  Record dminfo = tab2.dataManagerInfo();
+  cout << "ncolumn=" << tab2.tableDesc().ncolumn()
+       << " spec2=" << dminfo.subRecord(1).subRecord("SPEC") << endl;
+}
+
+void testError()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  SetupNewTable newtab("tCompressedStMan_tmp.data2", td, Table::New);
+  CompressedStMan csm;
+  newtab.bindAll (csm);
+  try {
+    Table tab(newtab, 10);
+  } catch (DataManError& x) {
+    cout << x.getMesg() << endl;
+  }
+}
+
+int main()
+{
+  try {
+    testCodec();
+    createTable (1000);
+    readTable (1000);
+    removeRows();
+    addRows();
+    addRemoveColumn();
+    testError();
+  } catch (AipsError& x) {
+    cout << "Caught an exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  return 0;
+}
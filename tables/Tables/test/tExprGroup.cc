@@ -28,6 +28,7 @@
 #include <tables/Tables/ExprNode.h>
 #include <tables/Tables/ExprAggrNode.h>
 #include <tables/Tables/ExprGroupAggrFunc.h>
+#include <tables/Tables/ExprGroup.h>
 #include <tables/Tables/RecordExpr.h>
 #include <casa/Containers/Record.h>
 #include <casa/Arrays/Vector.h>
@@ -36,6 +37,7 @@
 #include <casa/Arrays/ArrayIO.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/stdvector.h>
+#include <limits>
 #include <casa/iostream.h>
 
 #include <casa/namespace.h>
@@ -445,6 +447,74 @@ void doDComplexArr()
 }
 
 
+void doHashMap()
+{
+  // Check that keys are mapped to groups in order of first appearance.
+  // Use enough keys to resize the hash table a few times.
+  TableExprGroupHashMap<Int64> intMap;
+  TableExprGroupHashMap<String> strMap;
+  Bool isNew;
+  for (Int64 i=0; i<1000; ++i) {
+    AlwaysAssertExit (intMap.find (i*i, isNew) == i  &&  isNew);
+    AlwaysAssertExit (strMap.find (String::toString(i), isNew) == i  &&  isNew);
+  }
+  for (Int64 i=999; i>=0; --i) {
+    AlwaysAssertExit (intMap.find (i*i, isNew) == i  &&  !isNew);
+    AlwaysAssertExit (strMap.find (String::toString(i), isNew) == i  &&  !isNew);
+  }
+  AlwaysAssertExit (intMap.size() == 1000  &&  strMap.size() == 1000);
+  // -0 and 0 are the same key, and so are all NaNs.
+  TableExprGroupHashMap<Double> dblMap;
+  AlwaysAssertExit (dblMap.find (0., isNew) == 0  &&  isNew);
+  AlwaysAssertExit (dblMap.find (-0., isNew) == 0  &&  !isNew);
+  Double nan = std::numeric_limits<Double>::quiet_NaN();
+  AlwaysAssertExit (dblMap.find (nan, isNew) == 1  &&  isNew);
+  AlwaysAssertExit (dblMap.find (-nan, isNew) == 1  &&  !isNew);
+  AlwaysAssertExit (dblMap.find (1.5, isNew) == 2  &&  isNew);
+  // Check a keyset of an integer and a string key.
+  Record rec;
+  rec.define ("i", Int(0));
+  rec.define ("s", String());
+  TableExprNode inode (makeRecordExpr (rec, "i"));
+  TableExprNode snode (makeRecordExpr (rec, "s"));
+  vector<TableExprNode> nodes;
+  nodes.push_back (inode);
+  nodes.push_back (snode);
+  TableExprGroupKeySet keySet (nodes);
+  TableExprGroupHashMap<TableExprGroupKeySet> keyMap;
+  for (Int i=0; i<100; ++i) {
+    rec.define ("i", i%10);
+    rec.define ("s", String::toString(i/10));
+    keySet.fill (nodes, rec);
+    AlwaysAssertExit (keyMap.find (keySet, isNew) == i  &&  isNew);
+  }
+  rec.define ("i", 3);
+  rec.define ("s", "4");
+  keySet.fill (nodes, rec);
+  AlwaysAssertExit (keyMap.find (keySet, isNew) == 43  &&  !isNew);
+  // Check that NaNs in a keyset with a double key form a single group.
+  rec.define ("d", Double(0));
+  TableExprNode dnode (makeRecordExpr (rec, "d"));
+  nodes[1] = dnode;
+  TableExprGroupKeySet dkeySet (nodes);
+  TableExprGroupHashMap<TableExprGroupKeySet> dkeyMap;
+  for (Int i=0; i<1000; ++i) {
+    rec.define ("i", i%2);
+    rec.define ("d", (i%3 == 0  ?  nan : Double(i%3)));
+    dkeySet.fill (nodes, rec);
+    dkeyMap.find (dkeySet, isNew);
+  }
+  AlwaysAssertExit (dkeyMap.size() == 6);
+  rec.define ("i", 0);
+  rec.define ("d", -nan);
+  dkeySet.fill (nodes, rec);
+  AlwaysAssertExit (dkeyMap.find (dkeySet, isNew) == 0  &&  !isNew);
+  TableExprGroupKeySet dkeySet2 (nodes);
+  dkeySet2.fill (nodes, rec);
+  AlwaysAssertExit (dkeySet == dkeySet2);
+  AlwaysAssertExit (! (dkeySet < dkeySet2)  &&  ! (dkeySet2 < dkeySet));
+}
+
 int main()
 {
   try {
@@ -458,6 +528,8 @@ int main()
     doIntArr();
     doDoubleArr();
     doDComplexArr();
+    cout << "test groupby hash map ..." << endl;
+    doHashMap();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
@@ -0,0 +1,251 @@
+//# tExprNodeRows.cc: Test program for selecting rows in blocks
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <tables/Tables/TableDesc.h>
+#include <tables/Tables/SetupNewTab.h>
+#include <tables/Tables/Table.h>
+#include <tables/Tables/ScaColDesc.h>
+#include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/StandardStMan.h>
+#include <tables/Tables/IncrementalStMan.h>
+#include <tables/Tables/ExprNode.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+
+#include <casa/namespace.h>
+
+// <summary>
+// Test program for the selection of rows in a table.
+// The selection evaluates the expression for blocks of rows. The result is
+// compared with the result of evaluating the expression row by row.
+// </summary>
+
+// The selection uses blocks of 4096 rows, so use a few blocks and
+// a partially filled last block.
+const uInt nrow = 2*4096 + 100;
+
+// Rows around the edges of the blocks.
+const uInt edgeRows[] = {0, 4095, 4096, 8191, 8192, nrow-1};
+const uInt nedge = 6;
+
+void createTable()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("i"));
+  td.addColumn (ScalarColumnDesc<Short> ("s"));
+  td.addColumn (ScalarColumnDesc<uInt> ("u"));
+  td.addColumn (ScalarColumnDesc<Float> ("f"));
+  td.addColumn (ScalarColumnDesc<Double> ("d"));
+  td.addColumn (ScalarColumnDesc<Bool> ("b"));
+  td.addColumn (ScalarColumnDesc<String> ("str"));
+  td.addColumn (ScalarColumnDesc<Int> ("inc"));
+  td.addColumn (ScalarColumnDesc<Bool> ("edge"));
+  SetupNewTable newtab("tExprNodeRows_tmp.tab", td, Table::New);
+  StandardStMan ssm(1024);
+  IncrementalStMan ism(1024);
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("inc", ism);
+  newtab.bindColumn ("edge", ism);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> iCol(tab, "i");
+  ScalarColumn<Short> sCol(tab, "s");
+  ScalarColumn<uInt> uCol(tab, "u");
+  ScalarColumn<Float> fCol(tab, "f");
+  ScalarColumn<Double> dCol(tab, "d");
+  ScalarColumn<Bool> bCol(tab, "b");
+  ScalarColumn<String> strCol(tab, "str");
+  ScalarColumn<Int> incCol(tab, "inc");
+  ScalarColumn<Bool> edgeCol(tab, "edge");
+  for (uInt i=0; i<nrow; ++i) {
+    iCol.put (i, i%17);
+    sCol.put (i, i%5);
+    uCol.put (i, i%11);
+    fCol.put (i, (i%7) / 2.);
+    dCol.put (i, (i%100) / 10.);
+    bCol.put (i, i%3 == 0);
+    strCol.put (i, String::toString(i%4));
+    incCol.put (i, i/1000);
+    edgeCol.put (i, False);
+  }
+  for (uInt i=0; i<nedge; ++i) {
+    edgeCol.put (edgeRows[i], True);
+  }
+}
+
+// Get the edge rows less than nr.
+Vector<uInt> edgeVector (uInt nr)
+{
+  Vector<uInt> rows(nedge);
+  uInt n = 0;
+  for (uInt i=0; i<nedge; ++i) {
+    if (edgeRows[i] < nr) {
+      rows[n++] = edgeRows[i];
+    }
+  }
+  rows.resize (n, True);
+  return rows;
+}
+
+// Select the rows row by row.
+Vector<uInt> selectRows (const TableExprNode& expr, uInt nr,
+                         uInt maxRow, uInt offset)
+{
+  Vector<uInt> rows(nr);
+  uInt n = 0;
+  TableExprId id;
+  Bool val;
+  for (uInt i=0; i<nr; ++i) {
+    id.setRownr (i);
+    expr.get (id, val);
+    if (val) {
+      if (offset > 0) {
+        offset--;
+      } else {
+        rows[n++] = i;
+        if (n == maxRow) {
+          break;
+        }
+      }
+    }
+  }
+  rows.resize (n, True);
+  return rows;
+}
+
+// Check if the selection gives the same rows as the row by row evaluation.
+void checkSelect (const Table& tab, const TableExprNode& expr,
+                  uInt maxRow=0, uInt offset=0)
+{
+  Vector<uInt> expRows = selectRows (expr, tab.nrow(), maxRow, offset);
+  Table sel = tab(expr, maxRow, offset);
+  Vector<uInt> rows = sel.rowNumbers (tab);
+  AlwaysAssertExit (rows.nelements() == expRows.nelements());
+  AlwaysAssertExit (allEQ (rows, expRows));
+}
+
+// Check if getBoolRows gives the same values as getting them row by row
+// for the given (ascending) row numbers.
+void checkRows (const TableExprNode& expr, const Vector<uInt>& rownrs)
+{
+  Vector<Bool> vals(rownrs.nelements());
+  expr.getBoolRows (rownrs, vals);
+  TableExprId id;
+  Bool val;
+  for (uInt i=0; i<rownrs.nelements(); ++i) {
+    id.setRownr (rownrs[i]);
+    expr.get (id, val);
+    AlwaysAssertExit (vals[i] == val);
+  }
+}
+
+void checkExpr (const Table& tab, const TableExprNode& expr)
+{
+  checkSelect (tab, expr);
+  // With a limit and offset smaller blocks are used.
+  checkSelect (tab, expr, 1);
+  checkSelect (tab, expr, 10, 7);
+  checkSelect (tab, expr, 3, 20);
+  checkSelect (tab, expr, 20, 4090);
+  checkSelect (tab, expr, 5000, 1);
+  checkSelect (tab, expr, 0, 4000);
+  // Non-contiguous rows.
+  Vector<uInt> rownrs(tab.nrow() / 3);
+  indgen (rownrs, 0u, 3u);
+  checkRows (expr, rownrs);
+  checkRows (expr, edgeVector (tab.nrow()));
+}
+
+void checkTable (const Table& tab)
+{
+  TableExprNode i(tab.col("i"));
+  TableExprNode s(tab.col("s"));
+  TableExprNode u(tab.col("u"));
+  TableExprNode f(tab.col("f"));
+  TableExprNode d(tab.col("d"));
+  TableExprNode b(tab.col("b"));
+  TableExprNode str(tab.col("str"));
+  TableExprNode inc(tab.col("inc"));
+  TableExprNode edge(tab.col("edge"));
+  // Comparisons of a column and a constant (in both orders).
+  checkExpr (tab, i > 5);
+  checkExpr (tab, 5 >= i);
+  checkExpr (tab, i == 3);
+  checkExpr (tab, i != 3);
+  checkExpr (tab, s < 2);
+  checkExpr (tab, u <= 7);
+  checkExpr (tab, f == 1.5);
+  checkExpr (tab, d < 4.5);
+  checkExpr (tab, 4.5 < d);
+  checkExpr (tab, inc == 3);
+  checkExpr (tab, str == "2");
+  // Comparisons of columns with different types.
+  checkExpr (tab, d >= i);
+  checkExpr (tab, i < u);
+  checkExpr (tab, f != s);
+  // Bool columns and logical operators.
+  checkExpr (tab, b);
+  checkExpr (tab, !b);
+  checkExpr (tab, edge);
+  checkExpr (tab, edge && i >= 0);
+  checkExpr (tab, b && i > 10);
+  checkExpr (tab, b || d < 1);
+  checkExpr (tab, (i < 3 || i > 14) && !b);
+  checkExpr (tab, !(edge || (b && u == 4)));
+  checkExpr (tab, edge || str == "3");
+  // Nodes evaluated row by row within a block.
+  checkExpr (tab, s + 1 > 3);
+  checkExpr (tab, (i*2 < d) || b);
+  // Constant expressions.
+  checkExpr (tab, TableExprNode(True));
+  checkExpr (tab, TableExprNode(False));
+  checkExpr (tab, TableExprNode(1) < 2);
+}
+
+int main()
+{
+  try {
+    createTable();
+    Table tab("tExprNodeRows_tmp.tab");
+    checkTable (tab);
+    // Do the same for a reference table (with non-contiguous rows).
+    Table sel = tab(tab.col("i") != 4);
+    AlwaysAssertExit (sel.nrow() < nrow);
+    checkTable (sel);
+    // Check that the edge rows are found.
+    Vector<uInt> rows = tab(tab.col("edge")).rowNumbers (tab);
+    AlwaysAssertExit (rows.nelements() == nedge);
+    AlwaysAssertExit (allEQ (rows, edgeVector (nrow)));
+  } catch (AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -62,6 +62,8 @@ void c();
 void d();
 void e (uInt nrrow);
 void f();
+void g();
+void h();
 
 int main (int argc, const char* argv[])
 {
@@ -81,6 +83,8 @@ int main (int argc, const char* argv[])
 	e (20);
 	a (nr, 0);
 	f();
+	g();
+	h();
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
 	return 1;
@@ -514,3 +518,130 @@ void f()
     arr2.put (12, arrrow12);
     b (removedRows);
 }
+
+// Check the values of the ISM columns in g() for all rows.
+// The expected value changes every 7 rows, except for the Int value
+// put in the special row.
+void checkg (const Table& tab, Int special)
+{
+    ScalarColumn<Int> col(tab, "int");
+    ScalarColumn<String> scol(tab, "str");
+    uInt nrrow = tab.nrow();
+    Vector<Int> exp(nrrow);
+    for (uInt i=0; i<nrrow; i++) {
+	exp(i) = i/7;
+    }
+    if (special >= 0) {
+	exp(special) = -1;
+    }
+    // Reverse and strided access.
+    for (Int i=nrrow-1; i>=0; i--) {
+	AlwaysAssertExit (col(i) == exp(i));
+    }
+    for (uInt j=0; j<13; j++) {
+	for (uInt i=j; i<nrrow; i+=13) {
+	    AlwaysAssertExit (col(i) == exp(i));
+	    ostringstream ostr;
+	    ostr << i/7;
+	    AlwaysAssertExit (scol(i) == String(ostr.str()));
+	}
+    }
+    // Bulk access.
+    AlwaysAssertExit (allEQ (col.getColumn(), exp));
+    AlwaysAssertExit (allEQ (col.getColumnRange (Slicer(Slice(5, nrrow-10))),
+			     exp(Slice(5, nrrow-10))));
+    AlwaysAssertExit (allEQ (col.getColumnRange (Slicer(Slice(3,nrrow/3,3))),
+			     exp(Slice(3,nrrow/3,3))));
+    Vector<uInt> rows(nrrow/2);
+    for (uInt i=0; i<rows.nelements(); i++) {
+	rows(i) = (i*37) % nrrow;
+    }
+    Vector<Int> vals = col.getColumnCells (rows);
+    for (uInt i=0; i<rows.nelements(); i++) {
+	AlwaysAssertExit (vals(i) == exp(rows(i)));
+    }
+}
+
+// Test random and bulk access spanning many buckets, also after
+// changing and removing rows.
+void g()
+{
+    TableDesc td("", "1", TableDesc::Scratch);
+    td.addColumn (ScalarColumnDesc<Int>("int"));
+    td.addColumn (ScalarColumnDesc<String>("str"));
+    SetupNewTable newtab("tIncrementalStMan_tmp.datg", td, Table::New);
+    IncrementalStMan sm1 ("ISM", 512, False);
+    newtab.bindAll (sm1);
+    Table tab(newtab, 5000);
+    ScalarColumn<Int> col(tab, "int");
+    ScalarColumn<String> scol(tab, "str");
+    for (uInt i=0; i<tab.nrow(); i++) {
+	col.put (i, i/7);
+	ostringstream ostr;
+	ostr << i/7;
+	scol.put (i, ostr.str());
+    }
+    checkg (tab, -1);
+    col.put (2500, -1);
+    checkg (tab, 2500);
+    col.put (2500, 2500/7);
+    checkg (tab, -1);
+    // Remove a row at the start of an interval, so all values shift.
+    tab.removeRow (0);
+    for (uInt i=0; i<tab.nrow(); i++) {
+	AlwaysAssertExit (col(i) == Int((i+1)/7));
+    }
+}
+
+// Test putting a value in the last row after rows have been added.
+// The added rows share the value of the last row, thus putting the
+// last row again should not change the added rows.
+void h()
+{
+    TableDesc td("", "1", TableDesc::Scratch);
+    td.addColumn (ScalarColumnDesc<Int>("int"));
+    td.addColumn (ArrayColumnDesc<Float>("arr"));
+    SetupNewTable newtab("tIncrementalStMan_tmp.dath", td, Table::New);
+    IncrementalStMan sm1 ("ISM", 512, False);
+    newtab.bindAll (sm1);
+    Table tab(newtab, 10);
+    ScalarColumn<Int> col(tab, "int");
+    ArrayColumn<Float> arr(tab, "arr");
+    Vector<Float> vec(5);
+    for (uInt i=0; i<tab.nrow(); i++) {
+	col.put (i, i);
+	indgen (vec, Float(i));
+	arr.put (i, vec);
+    }
+    // Read the last row, so its interval gets cached.
+    AlwaysAssertExit (col(9) == 9);
+    indgen (vec, Float(9));
+    AlwaysAssertExit (allEQ (arr(9), vec));
+    tab.addRow (2);
+    AlwaysAssertExit (col(11) == 9);
+    AlwaysAssertExit (col(9) == 9);
+    AlwaysAssertExit (allEQ (arr(9), vec));
+    // Put an array with another shape, so it cannot be replaced in place.
+    col.put (9, 20);
+    Vector<Float> vec20(3);
+    indgen (vec20, Float(20));
+    arr.put (9, vec20);
+    AlwaysAssertExit (col(9) == 20);
+    AlwaysAssertExit (allEQ (arr(9), vec20));
+    for (uInt i=10; i<12; i++) {
+	AlwaysAssertExit (col(i) == 9);
+	AlwaysAssertExit (arr.shape(i) == IPosition(1,5));
+	AlwaysAssertExit (allEQ (arr(i), vec));
+    }
+    // The same after reopening the table.
+    tab = Table();
+    Table tab2("tIncrementalStMan_tmp.dath");
+    ScalarColumn<Int> col2(tab2, "int");
+    ArrayColumn<Float> arr2(tab2, "arr");
+    AlwaysAssertExit (col2(9) == 20);
+    AlwaysAssertExit (allEQ (arr2(9), vec20));
+    for (uInt i=10; i<12; i++) {
+	AlwaysAssertExit (col2(i) == 9);
+	AlwaysAssertExit (allEQ (arr2(i), vec));
+    }
+}
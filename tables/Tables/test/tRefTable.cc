@@ -30,6 +30,11 @@
 #include <tables/Tables/Table.h>
 #include <tables/Tables/ScaColDesc.h>
 #include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/RefRows.h>
+#include <tables/Tables/ExprNode.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
@@ -38,7 +43,7 @@
 #include <casa/namespace.h>
 
 // <summary>
-// Test program for RefTable::addColumn
+// Test program for RefTable::addColumn and for row numbers held as ranges
 // </summary>
 
 void readTab (const String& tabName, uInt nrow, uInt ncol)
@@ -108,6 +113,125 @@ void makeRef()
   readTab ("tRefTable_tmp.dataref", 10, 4);
 }
 
+// Check that the table contains the expected rows of the root table.
+void checkRows (const Table& tab, const Vector<uInt>& rows)
+{
+  AlwaysAssertExit (tab.nrow() == rows.nelements());
+  AlwaysAssertExit (allEQ (tab.rowNumbers(), rows));
+  ScalarColumn<Int> col(tab, "ab");
+  Vector<Int> vals = col.getColumn();
+  for (uInt i=0; i<rows.nelements(); ++i) {
+    AlwaysAssertExit (vals[i] == Int(rows[i]));
+    AlwaysAssertExit (col(i) == Int(rows[i]));
+  }
+  // Get some cells as a slice, crossing the range boundaries.
+  if (rows.nelements() > 10) {
+    uInt nr = rows.nelements();
+    Vector<Int> cells = col.getColumnCells (RefRows(3, nr-4, 1));
+    Vector<Int> cells2 = col.getColumnCells (RefRows(1, nr-2, 3));
+    for (uInt i=0; i<cells.nelements(); ++i) {
+      AlwaysAssertExit (cells[i] == Int(rows[i+3]));
+    }
+    for (uInt i=0; i<cells2.nelements(); ++i) {
+      AlwaysAssertExit (cells2[i] == Int(rows[1+3*i]));
+    }
+  }
+}
+
+// Make a vector with the rows in the given ranges (pairs of start,nrow).
+Vector<uInt> makeRows (uInt nrange, const uInt* ranges)
+{
+  uInt nrow = 0;
+  for (uInt i=0; i<nrange; ++i) {
+    nrow += ranges[2*i+1];
+  }
+  Vector<uInt> rows(nrow);
+  nrow = 0;
+  for (uInt i=0; i<nrange; ++i) {
+    Vector<uInt> part (rows(Slice(nrow, ranges[2*i+1])));
+    indgen (part, ranges[2*i]);
+    nrow += ranges[2*i+1];
+  }
+  return rows;
+}
+
+void checkRanges()
+{
+  // Create a table with 1000 rows.
+  TableDesc td("", "1", TableDesc::Scratch);
+  td.addColumn (ScalarColumnDesc<Int>("ab"));
+  SetupNewTable newtab("tRefTable_tmp.range", td, Table::New);
+  Table tab(newtab, 1000);
+  ScalarColumn<Int> ab(tab,"ab");
+  Vector<Int> vals(1000);
+  indgen (vals);
+  ab.putColumn (vals);
+  // Select two ranges and a selection of them.
+  const uInt r1[] = {100,100, 500,400};
+  const uInt r2[] = {150,200, 800,50};
+  const uInt r12[] = {10,140, 460,20};
+  const uInt r12exp[] = {110,90, 500,50, 860,20};
+  Vector<uInt> rows1 = makeRows (2, r1);
+  Vector<uInt> rows2 = makeRows (2, r2);
+  Table t1 = tab(rows1);
+  Table t2 = tab(rows2);
+  checkRows (t1, rows1);
+  checkRows (t2, rows2);
+  checkRows (t1(makeRows(2, r12)), makeRows (3, r12exp));
+  // Do logical operations on them.
+  const uInt rand[] = {150,50, 800,50};
+  const uInt ror[]  = {100,250, 500,400};
+  const uInt rsub[] = {100,50, 500,300, 850,50};
+  const uInt rxor[] = {100,50, 200,150, 500,300, 850,50};
+  const uInt rnot[] = {0,100, 200,300, 900,100};
+  checkRows (t1 & t2, makeRows (2, rand));
+  checkRows (t1 | t2, makeRows (2, ror));
+  checkRows (t1 - t2, makeRows (3, rsub));
+  checkRows (t1 ^ t2, makeRows (4, rxor));
+  checkRows (!t1, makeRows (3, rnot));
+  // Write the selection and read it back.
+  Table t3 = t1 & t2;
+  t3.rename ("tRefTable_tmp.rangeref", Table::New);
+  t3.flush();
+  t3 = Table();
+  checkRows (Table("tRefTable_tmp.rangeref"), makeRows (2, rand));
+  // Changing the row numbers requires the row number vector.
+  Table t4 = tab(rows1);
+  t4.removeRow (0);
+  checkRows (t4, rows1(Slice(1,499)));
+  // Sort a selection.
+  Table t5 = t1.sort ("ab", Sort::Descending);
+  Vector<uInt> sortRows(rows1.nelements());
+  for (uInt i=0; i<sortRows.nelements(); ++i) {
+    sortRows[i] = rows1[rows1.nelements() - 1 - i];
+  }
+  checkRows (t5, sortRows);
+  // Select with an expression, which collects the rows as ranges.
+  const uInt rsel[] = {100,100, 500,400};
+  checkRows (tab((tab.col("ab") >= 100  &&  tab.col("ab") < 200)  ||
+                 (tab.col("ab") >= 500  &&  tab.col("ab") < 900)),
+             makeRows (2, rsel));
+  // Select from a RefTable with ranges, thus convert to root ranges.
+  const uInt rsel1[] = {150,50, 500,350};
+  checkRows (t1(t1.col("ab") >= 150  &&  t1.col("ab") < 850),
+             makeRows (2, rsel1));
+  // Select from a RefTable with a row vector in descending order.
+  Vector<uInt> rowsSel5(40);
+  for (uInt i=0; i<20; ++i) {
+    rowsSel5[i] = 899 - i;
+    rowsSel5[20+i] = 119 - i;
+  }
+  checkRows (t5(t5.col("ab") >= 880  ||  t5.col("ab") < 120), rowsSel5);
+  // A selection of many short ranges.
+  Vector<uInt> rowsOdd(500);
+  indgen (rowsOdd, 1u, 2u);
+  checkRows (tab(tab.col("ab") % 2 == 1), rowsOdd);
+  Vector<uInt> rowsOdd1(250);
+  rowsOdd1(Slice(0,50)) = rowsOdd(Slice(50,50));
+  rowsOdd1(Slice(50,200)) = rowsOdd(Slice(250,200));
+  checkRows (t1(t1.col("ab") % 2 == 1), rowsOdd1);
+}
+
 int main()
 {
   try {
@@ -115,6 +239,7 @@ int main()
     makeRef();
     readTab ("tRefTable_tmp.data", 10, 5);
     readTab ("tRefTable_tmp.dataref", 10, 4);
+    checkRanges();
   } catch (AipsError x) {
     cout << "Caught an exception: " << x.getMesg() << endl;
     return 1;
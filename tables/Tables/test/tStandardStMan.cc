@@ -34,6 +34,9 @@
 #include <tables/Tables/ArrayColumn.h>
 #include <tables/Tables/StandardStMan.h>
 #include <tables/Tables/StandardStManAccessor.h>
+#include <tables/Tables/ExprNode.h>
+#include <casa/Containers/Record.h>
+#include <casa/BasicMath/Math.h>
 #include <casa/BasicSL/Complex.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Arrays/ArrayIO.h>
@@ -45,6 +48,8 @@
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
 #include <casa/sstream.h>
+#include <float.h>                     // for DBL_MAX
+#include <limits>
 
 #include <casa/namespace.h>
 // <summary>
@@ -92,6 +97,12 @@ void info(const Table aTable);
 // put/putColumn cache test
 void putColumnTest();
 
+// zone map test
+void zoneMapTest();
+
+// readonly (memory-mapped) access test
+void mappedTest();
+
 int main (int argc, const char* argv[])
 {
     uInt aNr = 250;
@@ -134,7 +145,8 @@ int main (int argc, const char* argv[])
 	  aNewNrRows(i) = i;
 	}
 	deleteRows      (aNewNrRows);
-
+	zoneMapTest();
+	mappedTest();
 
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
@@ -275,6 +287,15 @@ void init (uInt aBucketSize, uInt aMode)
   
   // Print column data
   info(aTable);
+
+  // Check the cache statistics record.
+  Record stats = anA.getCacheStatistics();
+  AlwaysAssertExit (stats.asInt64("naccess") > 0);
+  AlwaysAssertExit (stats.asInt64("nhit") <= stats.asInt64("naccess"));
+  AlwaysAssertExit (stats.asInt64("nhit") + stats.asInt64("nread")
+                    + stats.asInt64("ninit") >= stats.asInt64("naccess"));
+  AlwaysAssertExit (stats.asDouble("hitrate") >= 0  &&
+                    stats.asDouble("hitrate") <= 1);
 }
 
 void deleteRow(const uInt aRow)
@@ -598,18 +619,172 @@ void putColumnTest()
   AlwaysAssertExit (ab(5) == 4);
 }
 
+// Zones containing only infinite values must not be skipped for open
+// ranges (which are given as -/+DBL_MAX).
+void zoneMapInfTest()
+{
+  TableDesc aTableDesc;
+  aTableDesc.addColumn (ScalarColumnDesc<Double> ("D"));
+  aTableDesc.addColumn (ScalarColumnDesc<Float> ("F"));
+  SetupNewTable aNewTab("tStandardStMan_tmp.zoneinf", aTableDesc, Table::New);
+  StandardStMan aSSM(-16);
+  aSSM.setZoneMaps (True);
+  aNewTab.bindAll (aSSM);
+  Table aTable(aNewTab, 64);
+  ScalarColumn<Double> aD(aTable, "D");
+  ScalarColumn<Float>  aF(aTable, "F");
+  Double inf = std::numeric_limits<Double>::infinity();
+  for (uInt i=0; i<64; i++) {
+    Double val = i;
+    if (i >= 16  &&  i < 32) {
+      val = inf;
+    } else if (i >= 32  &&  i < 48) {
+      val = -inf;
+    }
+    aD.put (i, val);
+    aF.put (i, Float(val));
+  }
+  Vector<uInt> aRows;
+  AlwaysAssertExit (aD.getRangeRows (50, DBL_MAX, aRows));
+  AlwaysAssertExit (anyEQ (aRows, 16u)  &&  anyEQ (aRows, 31u));
+  AlwaysAssertExit (aD.getRangeRows (-DBL_MAX, 5, aRows));
+  AlwaysAssertExit (anyEQ (aRows, 32u)  &&  anyEQ (aRows, 47u));
+  // The selections have to find all infinite values.
+  const char* names[] = {"D", "F"};
+  for (uInt j=0; j<2; j++) {
+    Table aSel = aTable(aTable.col(names[j]) > 50);
+    AlwaysAssertExit (aSel.nrow() == 16+13);
+    AlwaysAssertExit (aSel.rowNumbers(aTable)(0) == 16);
+    aSel = aTable(aTable.col(names[j]) < 5);
+    AlwaysAssertExit (aSel.nrow() == 5+16);
+    AlwaysAssertExit (aSel.rowNumbers(aTable)(5) == 32);
+    aSel = aTable(aTable.col(names[j]) < 2  ||  aTable.col(names[j]) > 62);
+    AlwaysAssertExit (aSel.nrow() == 2+16+16+1);
+  }
+}
 
+void zoneMapTest()
+{
+  cout << "zoneMapTest" << endl;
+  TableDesc aTableDesc;
+  aTableDesc.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  aTableDesc.addColumn (ScalarColumnDesc<Int> ("ANT"));
+  SetupNewTable aNewTab("tStandardStMan_tmp.zone", aTableDesc, Table::New);
+  StandardStMan aSSM(-16);
+  aSSM.setZoneMaps (True);
+  aNewTab.bindAll (aSSM);
+  {
+    Table aTable(aNewTab, 200);
+    ScalarColumn<Double> aTime(aTable, "TIME");
+    ScalarColumn<Int>    anAnt(aTable, "ANT");
+    for (uInt i=0; i<200; i++) {
+      aTime.put (i, i);
+      anAnt.put (i, i%10);
+    }
+    // Zone maps are up-to-date before a flush.
+    Vector<uInt> aRows;
+    AlwaysAssertExit (aTime.getRangeRows (100.5, 110, aRows));
+    cout << "candidates " << aRows.nelements() << ' '
+         << aRows(0) << ' ' << aRows(aRows.nelements()-1) << endl;
+    Table aSel = aTable(aTable.col("TIME") > 100.5
+                        &&  aTable.col("TIME") < 110);
+    cout << aSel.rowNumbers(aTable) << endl;
+  }
+  {
+    // Zone maps are persistent.
+    Table aTable("tStandardStMan_tmp.zone");
+    ROStandardStManAccessor anAcc(aTable, "SSM");
+    cout << "ZoneMaps " << anAcc.getProperties().asBool("ZoneMaps") << endl;
+    ScalarColumn<Double> aTime(aTable, "TIME");
+    Vector<uInt> aRows;
+    AlwaysAssertExit (aTime.getRangeRows (150, 1000, aRows));
+    cout << "candidates " << aRows.nelements() << endl;
+    // Scalar columns of other types have zone maps too.
+    ScalarColumn<Int> anAnt(aTable, "ANT");
+    AlwaysAssertExit (anAnt.getRangeRows (20, 30, aRows));
+    cout << "candidates " << aRows.nelements() << endl;
+    Table aSel = aTable(aTable.col("TIME") >= 150
+                        &&  aTable.col("TIME") <= 151);
+    cout << aSel.rowNumbers(aTable) << endl;
+  }
+  {
+    // Zones are updated on put and row removal.
+    Table aTable("tStandardStMan_tmp.zone", Table::Update);
+    ScalarColumn<Double> aTime(aTable, "TIME");
+    aTime.put (5, 1000.);
+    aTime.put (6, doubleNaN());
+    aTable.removeRow (200-1);
+    Table aSel = aTable(aTable.col("TIME") > 500);
+    cout << aSel.rowNumbers(aTable) << endl;
+    aSel = aTable(aTable.col("TIME") > 198);
+    cout << aSel.nrow() << endl;
+    aTable.addRow (20);
+    Vector<uInt> aRows;
+    AlwaysAssertExit (aTime.getRangeRows (-1, -1, aRows));
+    cout << "candidates " << aRows.nelements() << endl;
+    AlwaysAssertExit (aTime.getRangeRows (0, 0, aRows));
+    cout << "candidates " << aRows.nelements() << endl;
+  }
+  zoneMapInfTest();
+}
 
-
-
-
-
-
-
-
-
-
-
-
-
-
+void mappedTest()
+{
+  TableDesc aTableDesc;
+  aTableDesc.addColumn (ScalarColumnDesc<Int> ("INT"));
+  aTableDesc.addColumn (ArrayColumnDesc<Float> ("ARRF", IPosition(1,3),
+                                                ColumnDesc::FixedShape));
+  aTableDesc.addColumn (ArrayColumnDesc<Bool> ("ARRB", IPosition(1,5),
+                                               ColumnDesc::FixedShape));
+  SetupNewTable aNewTab("tStandardStMan_tmp.mmap", aTableDesc, Table::New);
+  StandardStMan aSSM(512);
+  aNewTab.bindAll (aSSM);
+  const uInt nrrow = 1000;
+  {
+    Table aTable(aNewTab, nrrow);
+    ScalarColumn<Int>  anInt(aTable, "INT");
+    ArrayColumn<Float> anArrf(aTable, "ARRF");
+    ArrayColumn<Bool>  anArrb(aTable, "ARRB");
+    Vector<Float> arrf(3);
+    Vector<Bool>  arrb(5);
+    for (uInt i=0; i<nrrow; i++) {
+      anInt.put (i, i);
+      indgen (arrf, Float(3*i));
+      anArrf.put (i, arrf);
+      for (uInt j=0; j<5; j++) {
+        arrb(j) = ((i+j)%3 == 0);
+      }
+      anArrb.put (i, arrb);
+    }
+  }
+  // Reading a readonly table uses the mapped file (if enabled).
+  // The results of the column and cell access must match.
+  Table aTable("tStandardStMan_tmp.mmap");
+  ScalarColumn<Int>  anInt(aTable, "INT");
+  ArrayColumn<Float> anArrf(aTable, "ARRF");
+  ArrayColumn<Bool>  anArrb(aTable, "ARRB");
+  Vector<Int> ints = anInt.getColumn();
+  Matrix<Float> arrfs = anArrf.getColumn();
+  Matrix<Bool>  arrbs = anArrb.getColumn();
+  AlwaysAssertExit (ROStandardStManAccessor(aTable, "INT", True)
+                    .usesMappedFile());
+  AlwaysAssertExit (arrfs.shape() == IPosition(2,3,nrrow));
+  for (uInt i=0; i<nrrow; i++) {
+    AlwaysAssertExit (ints(i) == Int(i)  &&  anInt(i) == Int(i));
+    Vector<Float> arrf = anArrf(i);
+    Vector<Bool>  arrb = anArrb(i);
+    for (uInt j=0; j<3; j++) {
+      AlwaysAssertExit (arrfs(j,i) == Float(3*i+j)  &&  arrf(j) == arrfs(j,i));
+    }
+    for (uInt j=0; j<5; j++) {
+      AlwaysAssertExit (arrbs(j,i) == ((i+j)%3 == 0)  &&  arrb(j) == arrbs(j,i));
+    }
+  }
+  // After reopening for write the values are still correct and can be changed.
+  aTable.reopenRW();
+  AlwaysAssertExit (! ROStandardStManAccessor(aTable, "INT", True)
+                    .usesMappedFile());
+  anInt.put (10, -10);
+  AlwaysAssertExit (anInt(10) == -10);
+  AlwaysAssertExit (anInt.getColumn()(11) == 11);
+}
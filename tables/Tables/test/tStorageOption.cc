@@ -0,0 +1,211 @@
+//# tStorageOption.cc: Test program for tables using a StorageOption
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <tables/Tables/TableDesc.h>
+#include <tables/Tables/SetupNewTab.h>
+#include <tables/Tables/Table.h>
+#include <tables/Tables/ScaColDesc.h>
+#include <tables/Tables/ArrColDesc.h>
+#include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/ArrayColumn.h>
+#include <tables/Tables/StandardStMan.h>
+#include <tables/Tables/IncrementalStMan.h>
+#include <tables/Tables/StManAipsIO.h>
+#include <tables/Tables/TiledShapeStMan.h>
+#include <tables/Tables/StorageOption.h>
+#include <casa/IO/MultiFile.h>
+#include <casa/OS/File.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Matrix.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/ArrayUtil.h>
+#include <casa/BasicSL/String.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+
+#include <casa/namespace.h>
+
+// <summary>
+// Test program for tables created with a StorageOption.
+// </summary>
+
+// This program creates tables with the files of the storage managers
+// combined in a MultiFile and checks that they can be read back, extended
+// and updated. It also checks that the default still uses separate files.
+
+
+void createTable (const String& name, const StorageOption& stopt, uInt nrrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ad"));
+  td.addColumn (ScalarColumnDesc<String> ("as"));
+  td.addColumn (ArrayColumnDesc<float>   ("arr"));
+  td.addColumn (ScalarColumnDesc<Int>    ("ai"));
+  td.addColumn (ScalarColumnDesc<double> ("aa"));
+  td.addColumn (ArrayColumnDesc<float>   ("Data", IPosition(2,4,5),
+                                          ColumnDesc::FixedShape));
+  td.defineHypercolumn ("TSMData", 3, stringToVector("Data"));
+  SetupNewTable newtab (name, td, Table::New, stopt);
+  // Use small buckets, so the files span multiple blocks.
+  StandardStMan ssm ("SSM", 512);
+  IncrementalStMan ism ("ISM", 512);
+  StManAipsIO aipsio ("AipsIO");
+  TiledShapeStMan tsm ("TSMData", IPosition(3,4,5,8));
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("ai", ism);
+  newtab.bindColumn ("aa", aipsio);
+  newtab.bindColumn ("Data", tsm);
+  Table tab (newtab, nrrow);
+  ScalarColumn<Int> ad (tab, "ad");
+  ScalarColumn<String> as (tab, "as");
+  ArrayColumn<float> arr (tab, "arr");
+  ScalarColumn<Int> ai (tab, "ai");
+  ScalarColumn<double> aa (tab, "aa");
+  ArrayColumn<float> data (tab, "Data");
+  Matrix<float> mat(4,5);
+  for (uInt i=0; i<nrrow; ++i) {
+    ad.put (i, i);
+    as.put (i, "str" + String::toString(i));
+    Vector<float> vec(i%7 + 1);
+    indgen (vec, float(i));
+    arr.put (i, vec);
+    ai.put (i, i/10);
+    aa.put (i, i+0.5);
+    indgen (mat, float(i));
+    data.put (i, mat);
+  }
+}
+
+void checkTable (const String& name, uInt nrrow, Int offset)
+{
+  Table tab (name);
+  AlwaysAssertExit (tab.nrow() == nrrow);
+  ScalarColumn<Int> ad (tab, "ad");
+  ScalarColumn<String> as (tab, "as");
+  ArrayColumn<float> arr (tab, "arr");
+  ScalarColumn<double> aa (tab, "aa");
+  ArrayColumn<float> data (tab, "Data");
+  Matrix<float> mat(4,5);
+  for (uInt i=0; i<nrrow; ++i) {
+    AlwaysAssertExit (ad(i) == Int(i) + offset);
+    AlwaysAssertExit (as(i) == "str" + String::toString(i));
+    Vector<float> vec(i%7 + 1);
+    indgen (vec, float(i));
+    AlwaysAssertExit (allEQ (arr(i), vec));
+    AlwaysAssertExit (aa(i) == i+0.5);
+    indgen (mat, float(i));
+    AlwaysAssertExit (allEQ (data(i), mat));
+  }
+  if (tab.tableDesc().isColumn ("ai")) {
+    ScalarColumn<Int> ai (tab, "ai");
+    for (uInt i=0; i<nrrow; ++i) {
+      AlwaysAssertExit (ai(i) == Int(i/10));
+    }
+  }
+}
+
+void checkFiles (const String& name, Bool multiFile)
+{
+  AlwaysAssertExit (File(name + "/table.dat").exists());
+  AlwaysAssertExit (File(name + "/table.mf").exists() == multiFile);
+  AlwaysAssertExit (File(name + "/table.f0").exists() == !multiFile);
+  if (multiFile) {
+    MultiFile mfile (name + "/table.mf", ByteIO::Old);
+    AlwaysAssertExit (mfile.fileId ("table.f0", False) >= 0);
+    AlwaysAssertExit (mfile.fileId ("table.f0i", False) >= 0);
+    AlwaysAssertExit (mfile.fileId ("table.f1", False) >= 0);
+    AlwaysAssertExit (mfile.fileId ("table.f2", False) >= 0);
+    AlwaysAssertExit (mfile.fileId ("table.f3", False) >= 0);
+    AlwaysAssertExit (mfile.fileId ("table.f3_TSM1", False) >= 0);
+    AlwaysAssertExit (mfile.blockSize() == 512);
+  }
+}
+
+void addRemoveColumn (const String& name, uInt nrrow)
+{
+  {
+    Table tab (name, Table::Update);
+    tab.addColumn (ScalarColumnDesc<Int>("ac"), StandardStMan("SSM2", 512));
+    ScalarColumn<Int> ac (tab, "ac");
+    for (uInt i=0; i<nrrow; ++i) {
+      ac.put (i, 2*i);
+    }
+    tab.removeColumn ("ai");
+  }
+  checkTable (name, nrrow, 0);
+  MultiFile mfile (name + "/table.mf", ByteIO::Old);
+  AlwaysAssertExit (mfile.fileId ("table.f1", False) < 0);
+  AlwaysAssertExit (mfile.fileId ("table.f4", False) >= 0);
+  Table tab (name);
+  ScalarColumn<Int> ac (tab, "ac");
+  for (uInt i=0; i<nrrow; ++i) {
+    AlwaysAssertExit (ac(i) == Int(2*i));
+  }
+}
+
+void updateTable (const String& name, uInt nrrow)
+{
+  {
+    Table tab (name);
+    AlwaysAssertExit (! tab.isWritable());
+    tab.reopenRW();
+    ScalarColumn<Int> ad (tab, "ad");
+    for (uInt i=0; i<nrrow; ++i) {
+      ad.put (i, ad(i) + 10);
+    }
+  }
+  checkTable (name, nrrow, 10);
+}
+
+int main()
+{
+  try {
+    const uInt nrrow = 1000;
+    createTable ("tStorageOption_tmp.mf",
+                 StorageOption(StorageOption::MultiFile, 512), nrrow);
+    checkFiles ("tStorageOption_tmp.mf", True);
+    checkTable ("tStorageOption_tmp.mf", nrrow, 0);
+    addRemoveColumn ("tStorageOption_tmp.mf", nrrow);
+    updateTable ("tStorageOption_tmp.mf", nrrow);
+    createTable ("tStorageOption_tmp.sep",
+                 StorageOption(StorageOption::SepFile), nrrow);
+    checkFiles ("tStorageOption_tmp.sep", False);
+    checkTable ("tStorageOption_tmp.sep", nrrow, 0);
+    // Overwriting a MultiFile table with separate files removes the
+    // MultiFile.
+    createTable ("tStorageOption_tmp.mf",
+                 StorageOption(StorageOption::SepFile), nrrow);
+    checkFiles ("tStorageOption_tmp.mf", False);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,197 @@
+//# tTableConcurrentRead.cc: Test program for the concurrent read mode
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <tables/Tables/TableDesc.h>
+#include <tables/Tables/SetupNewTab.h>
+#include <tables/Tables/Table.h>
+#include <tables/Tables/ScaColDesc.h>
+#include <tables/Tables/ArrColDesc.h>
+#include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/ArrayColumn.h>
+#include <tables/Tables/StandardStMan.h>
+#include <tables/Tables/IncrementalStMan.h>
+#include <tables/Tables/ExprNode.h>
+#include <tables/Tables/TableError.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+#ifdef USE_THREADS
+# include <pthread.h>
+#endif
+
+#include <casa/namespace.h>
+
+// <summary>
+// Test program for the concurrent read mode of a Table.
+// </summary>
+
+const uInt nrow = 5000;
+
+void createTable()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ssm"));
+  td.addColumn (ScalarColumnDesc<Int> ("ism"));
+  td.addColumn (ArrayColumnDesc<Float> ("arr", IPosition(1,8),
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTableConcurrentRead_tmp.tab", td, Table::New);
+  // Use small buckets, so many buckets have to be read.
+  StandardStMan ssm(1024);
+  IncrementalStMan ism(1024);
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("ism", ism);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Int> ismCol(tab, "ism");
+  ArrayColumn<Float> arrCol(tab, "arr");
+  Vector<Float> arr(8);
+  for (uInt i=0; i<nrow; ++i) {
+    ssmCol.put (i, i);
+    ismCol.put (i, i/10);
+    indgen (arr, Float(i));
+    arrCol.put (i, arr);
+  }
+}
+
+// Read all rows in a different order for each start value, so the
+// threads need different buckets at the same time.
+Bool checkColumns (const ScalarColumn<Int>& ssmCol,
+                   const ScalarColumn<Int>& ismCol,
+                   const ArrayColumn<Float>& arrCol, uInt start)
+{
+  Vector<Float> arr(8);
+  for (uInt j=0; j<nrow; ++j) {
+    uInt i = (j*7 + start) % nrow;
+    if (ssmCol(i) != Int(i)  ||  ismCol(i) != Int(i/10)) {
+      return False;
+    }
+    arrCol.get (i, arr);
+    if (arr(0) != Float(i)  ||  arr(7) != Float(i+7)) {
+      return False;
+    }
+  }
+  return True;
+}
+
+#ifdef USE_THREADS
+struct Reader
+{
+  ScalarColumn<Int>  ssmCol;
+  ScalarColumn<Int>  ismCol;
+  ArrayColumn<Float> arrCol;
+  uInt start;
+  Bool ok;
+};
+
+void* readColumns (void* arg)
+{
+  Reader& reader = *static_cast<Reader*>(arg);
+  try {
+    reader.ok = checkColumns (reader.ssmCol, reader.ismCol, reader.arrCol,
+                              reader.start);
+  } catch (AipsError&) {
+    reader.ok = False;
+  }
+  return 0;
+}
+
+void testThreads (Table& tab, const ScalarColumn<Int>& oldSsmCol)
+{
+  // Setting the mode in a selection sets it in the root table.
+  Table sel = tab(tab.col("ssm") < 100);
+  sel.setConcurrentRead();
+  AlwaysAssertExit (tab.concurrentRead());
+  sel.setConcurrentRead (False);
+  AlwaysAssertExit (!tab.concurrentRead());
+  tab.setConcurrentRead();
+  AlwaysAssertExit (tab.concurrentRead());
+  // Create the column objects before starting the threads.
+  // The first thread uses the column object made before the mode was set.
+  const uInt nthread = 4;
+  Reader readers[nthread];
+  for (uInt i=0; i<nthread; ++i) {
+    if (i == 0) {
+      readers[i].ssmCol.reference (oldSsmCol);
+    } else {
+      readers[i].ssmCol.attach (tab, "ssm");
+    }
+    readers[i].ismCol.attach (tab, "ism");
+    readers[i].arrCol.attach (tab, "arr");
+    readers[i].start = i*1234;
+    readers[i].ok = False;
+  }
+  pthread_t threads[nthread];
+  for (uInt i=0; i<nthread; ++i) {
+    AlwaysAssertExit (pthread_create (&threads[i], 0, readColumns,
+                                      &readers[i]) == 0);
+  }
+  for (uInt i=0; i<nthread; ++i) {
+    pthread_join (threads[i], 0);
+  }
+  for (uInt i=0; i<nthread; ++i) {
+    AlwaysAssertExit (readers[i].ok);
+  }
+  tab.setConcurrentRead (False);
+  AlwaysAssertExit (!tab.concurrentRead());
+}
+#else
+void testThreads (Table& tab, const ScalarColumn<Int>&)
+{
+  // The mode cannot be set without thread support.
+  Bool failed = False;
+  try {
+    tab.setConcurrentRead();
+  } catch (TableInvOper&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  AlwaysAssertExit (!tab.concurrentRead());
+  tab.setConcurrentRead (False);
+}
+#endif
+
+int main()
+{
+  try {
+    createTable();
+    Table tab("tTableConcurrentRead_tmp.tab");
+    AlwaysAssertExit (!tab.concurrentRead());
+    // Create a column object before the mode is set and fill its cache.
+    ScalarColumn<Int> oldSsmCol(tab, "ssm");
+    AlwaysAssertExit (oldSsmCol(10) == 10);
+    testThreads (tab, oldSsmCol);
+    // Serial reading still works after the mode has been cleared.
+    AlwaysAssertExit (checkColumns (oldSsmCol, ScalarColumn<Int>(tab, "ism"),
+                                    ArrayColumn<Float>(tab, "arr"), 0));
+  } catch (AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -63,6 +63,62 @@ void testDM()
     cout << dminfo << endl;
 }
 
+// Test copying rows column by column.
+void testCopyRows()
+{
+  // Array af is large enough to be copied in multiple chunks.
+  TableDesc td;
+  td.addColumn(ScalarColumnDesc<Int>("ci"));
+  td.addColumn(ScalarColumnDesc<Bool>("cb"));
+  td.addColumn(ScalarColumnDesc<String>("cs"));
+  td.addColumn(ArrayColumnDesc<Double>("af", IPosition(2,256,512),
+                                       ColumnDesc::FixedShape));
+  td.addColumn(ArrayColumnDesc<Int>("av"));
+  SetupNewTable newtab("tTableCopy_tmp.rows", td, Table::New);
+  Table tab(newtab, 10);
+  ScalarColumn<Int> ci(tab, "ci");
+  ScalarColumn<Bool> cb(tab, "cb");
+  ScalarColumn<String> cs(tab, "cs");
+  ArrayColumn<Double> af(tab, "af");
+  ArrayColumn<Int> av(tab, "av");
+  for (uInt i=0; i<10; ++i) {
+    ci.put (i, i);
+    cb.put (i, i%3==0);
+    cs.put (i, String::toString(i));
+    af.put (i, Array<Double>(IPosition(2,256,512), Double(i)));
+    if (i%2 == 0) {
+      av.put (i, Vector<Int>(i+1, i));
+    }
+  }
+  // The output has column ci as Double, so that one is copied per cell.
+  TableDesc tdout(td);
+  tdout.removeColumn ("ci");
+  tdout.addColumn(ScalarColumnDesc<Double>("ci"));
+  SetupNewTable newtabout("tTableCopy_tmp.rowsout", tdout, Table::New);
+  Table tabout(newtabout, 1);
+  // Copy a selection of rows.
+  Vector<uInt> rows(8);
+  indgen (rows, 2u);
+  TableCopy::copyRows (tabout, tab(rows), 1, 0, 8);
+  AlwaysAssertExit (tabout.nrow() == 9);
+  ScalarColumn<Double> oci(tabout, "ci");
+  ScalarColumn<Bool> ocb(tabout, "cb");
+  ScalarColumn<String> ocs(tabout, "cs");
+  ArrayColumn<Double> oaf(tabout, "af");
+  ArrayColumn<Int> oav(tabout, "av");
+  for (uInt i=1; i<9; ++i) {
+    uInt j = i+1;
+    AlwaysAssertExit (oci(i) == Double(j));
+    AlwaysAssertExit (ocb(i) == (j%3==0));
+    AlwaysAssertExit (ocs(i) == String::toString(j));
+    AlwaysAssertExit (allEQ (oaf(i), Double(j)));
+    AlwaysAssertExit (oav.isDefined(i) == (j%2 == 0));
+    if (j%2 == 0) {
+      AlwaysAssertExit (allEQ (oav(i), Vector<Int>(j+1, j)));
+    }
+  }
+}
+
 int main (int argc, const char* argv[])
 {
   Table::TableType ttyp = Table::Plain;
@@ -104,6 +160,7 @@ int main (int argc, const char* argv[])
 
     if (argc <= 1) {
       testDM();
+      testCopyRows();
     }
   } catch (exception& x) {
     cout << x.what() << endl;
@@ -30,6 +30,7 @@
 #include <tables/Tables/TableDesc.h>
 #include <tables/Tables/TableColumn.h>
 #include <tables/Tables/ExprNodeArray.h>
+#include <casa/Containers/Record.h>
 #include <casa/Arrays/Matrix.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Arrays/ArrayIO.h>
@@ -321,6 +322,38 @@ void showExpr(const TableExprNode& expr)
 }
 
 
+// Show the query plan given by EXPLAIN.
+// The table names, times and I/O statistics are not shown, because they
+// depend on the test environment.
+void showPlan (const Record& plan)
+{
+  cout << "    plan of " << plan.asString("command");
+  if (plan.asBool("analyzed")) {
+    cout << " (analyzed)";
+  }
+  cout << endl;
+  const Record& tabs = plan.subRecord("tables");
+  for (uInt i=0; i<tabs.nfields(); i++) {
+    cout << "     " << tabs.name(i) << " has "
+         << tabs.subRecord(i).asInt64("nrow") << " rows" << endl;
+  }
+  cout << "     where=" << plan.asBool("where")
+       << " orderby=" << plan.asInt("orderby")
+       << " topk=" << plan.asInt64("topk")
+       << " limit=" << plan.asInt64("limit")
+       << " offset=" << plan.asInt64("offset") << endl;
+  cout << "     columns=" << plan.asArrayString("columns") << endl;
+  if (plan.isDefined("stages")) {
+    const Record& stages = plan.subRecord("stages");
+    for (uInt i=0; i<stages.nfields(); i++) {
+      const Record& stage = stages.subRecord(i);
+      cout << "     " << stages.name(i) << ": "
+           << stage.asInt64("nrow_in") << " -> "
+           << stage.asInt64("nrow_out") << " rows" << endl;
+    }
+  }
+}
+
 // Sort and select data.
 void seltab (const String& str)
 {
@@ -337,7 +370,8 @@ void seltab (const String& str)
       s.downcase();
       addCalc = !(s=="select" || s=="update" || s=="insert" || s=="calc" ||
                   s=="delete" || s=="create" || s=="createtable" ||
-                  s=="count"  || s=="using"  || s=="usingstyle"  || s=="time");
+                  s=="count"  || s=="using"  || s=="usingstyle"  || s=="time" ||
+                  s=="explain");
     }
   } 
   String strc(str);
@@ -351,16 +385,26 @@ void seltab (const String& str)
   uInt i;
   Vector<String> vecstr;
   String cmd;
+  Record plan;
   // A semicolon can be used to specify a possible table after it (for $1).
   String::size_type semipos = strc.find(';');
   if (semipos == String::npos) {
-    result = tableCommand (strc, vecstr, cmd);
+    std::vector<const Table*> tabblock;
+    result = tableCommand (strc, tabblock, vecstr, cmd, plan);
   } else {
     Table tab(strc.after(semipos));
     std::vector<const Table*> tabblock(1, &tab);
-    result = tableCommand (strc.before(semipos), tabblock, vecstr, cmd);
+    result = tableCommand (strc.before(semipos), tabblock, vecstr, cmd, plan);
   }
   cout << "    has been executed" << endl;
+  // Show the plan if EXPLAIN was given.
+  // Without ANALYZE the command is not executed, thus has no result.
+  if (plan.nfields() > 0) {
+    showPlan (plan);
+    if (result.isTable()  &&  result.table().isNull()) {
+      return;
+    }
+  }
   if (result.isTable()) {
     tabp = new Table(result.table());
     cout << "    " << cmd << " result of " << tabp->nrow()
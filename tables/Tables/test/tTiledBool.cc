@@ -33,12 +33,15 @@
 #include <tables/Tables/ScalarColumn.h>
 #include <tables/Tables/ArrayColumn.h>
 #include <tables/Tables/TiledShapeStMan.h>
+#include <tables/Tables/TiledStManAccessor.h>
+#include <casa/IO/BucketFile.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Arrays/Matrix.h>
 #include <casa/Arrays/ArrayMath.h>
 #include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/ArrayUtil.h>
 #include <casa/Arrays/ArrayIO.h>
+#include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
 
@@ -47,6 +50,25 @@
 // Test program for tiling a boolean column
 // </summary>
 
+// Check if the file system supports direct IO, thus if a table
+// using TSMOption::Direct really uses it.
+Bool directIOSupported()
+{
+  BucketFile file("tTiledBool_tmp.direct", 0, False, 0, True);
+  file.open();
+  Bool direct = file.isDirect();
+  file.remove();
+  return direct;
+}
+
+// Check that the storage manager uses direct IO if asked for.
+void checkDirectIO (const Table& table, const TSMOption& tsmOpt)
+{
+  ROTiledStManAccessor accessor(table, "TSMExample");
+  Bool direct = (tsmOpt.option() == TSMOption::Direct);
+  AlwaysAssertExit (accessor.usesDirectIO() == (direct && directIOSupported()));
+}
+
 // First build a description.
 void writeTable (const TSMOption& tsmOpt, const IPosition& arrayShape,
                  const IPosition& tileShape)
@@ -84,6 +106,7 @@ void writeTable (const TSMOption& tsmOpt, const IPosition& arrayShape,
       cout << "mismatch in flag row " << i << endl;
     }
   }
+  checkDirectIO (table, tsmOpt);
 }
 
 void readTable (const TSMOption& tsmOpt)
@@ -102,6 +125,7 @@ void readTable (const TSMOption& tsmOpt)
       cout << "mismatch in flag row " << i << endl;
     }
   }
+  checkDirectIO (table, tsmOpt);
 }
 
 void testAll (const IPosition& arrayShape, const IPosition& tileShape)
@@ -118,6 +142,12 @@ void testAll (const IPosition& arrayShape, const IPosition& tileShape)
   readTable (TSMOption::Cache);
   readTable (TSMOption::Buffer);
   readTable (TSMOption::MMap);
+  readTable (TSMOption::Direct);
+  writeTable (TSMOption::Direct, arrayShape, tileShape);
+  readTable (TSMOption::Cache);
+  readTable (TSMOption::Buffer);
+  readTable (TSMOption::MMap);
+  readTable (TSMOption::Direct);
 }
 
 int main()
@@ -59,6 +59,7 @@
 void writeFixed(const TSMOption&);
 void readTable(const TSMOption&, Bool readKeys);
 void writeNoHyper(const TSMOption&);
+void checkSlices(uInt cacheSize);
 
 int main () {
     try {
@@ -68,6 +69,9 @@ int main () {
 	readTable(TSMOption::Buffer, False);
         writeFixed(TSMOption::Buffer);
 	readTable(TSMOption::Cache, False);
+	checkSlices(1);
+	checkSlices(1000);
+	checkSlices(7);
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
 	return 1;
@@ -439,3 +443,48 @@ void writeNoHyper(const TSMOption& tsmOpt)
     AlwaysAssertExit (accessor.getBucketSize(0) == accessor.bucketSize(2));
     AlwaysAssertExit (accessor.getCacheSize(0) == accessor.cacheSize(2));
 }
+
+// Put and get sections spanning many tiles (possibly partially),
+// which can be accessed in parallel if the cache is large enough.
+void checkSlices(uInt cacheSize)
+{
+    TableDesc td ("", "1", TableDesc::Scratch);
+    td.addColumn (ArrayColumnDesc<Int> ("Data", IPosition(2,13,17),
+					 ColumnDesc::FixedShape));
+    SetupNewTable newtab("tTiledColumnStMan_tmp.data", td, Table::New);
+    TiledColumnStMan sm1 ("TSMSlices", IPosition(3,4,5,3));
+    newtab.bindAll (sm1);
+    Table table(newtab, 23, False, Table::LittleEndian, TSMOption::Cache);
+    ROTiledStManAccessor accessor (table, "TSMSlices");
+    accessor.setCacheSize (0, cacheSize);
+    ArrayColumn<Int> data (table, "Data");
+    Cube<Int> cube(13,17,23);
+    indgen (cube);
+    // Put the cube in two parts, so partial tiles are written.
+    data.putColumn (Slicer(IPosition(2,0,0), IPosition(2,13,7)),
+		    cube(IPosition(3,0,0,0), IPosition(3,12,6,22)));
+    data.putColumn (Slicer(IPosition(2,0,7), IPosition(2,13,10)),
+		    cube(IPosition(3,0,7,0), IPosition(3,12,16,22)));
+    table.flush();
+    accessor.clearCaches();
+    accessor.setCacheSize (0, cacheSize);
+    AlwaysAssertExit (allEQ (data.getColumn(), cube));
+    // Get a section and a strided section.
+    Slicer slicer(IPosition(2,1,2), IPosition(2,11,14));
+    AlwaysAssertExit (allEQ (data.getColumn(slicer),
+			     cube(IPosition(3,1,2,0), IPosition(3,11,15,22))));
+    Slicer strided(IPosition(2,1,0), IPosition(2,5,6), IPosition(2,2,3));
+    AlwaysAssertExit (allEQ (data.getColumn(strided),
+			     cube(IPosition(3,1,0,0), IPosition(3,9,15,22),
+				  IPosition(3,2,3,1))));
+    Array<Int> rows = data.getColumnRange (Slicer(IPosition(1,3),
+						  IPosition(1,15)), slicer);
+    AlwaysAssertExit (allEQ (rows, cube(IPosition(3,1,2,3),
+					IPosition(3,11,15,17))));
+    // Overwrite a strided section and check the result.
+    Cube<Int> part(5,6,23);
+    indgen (part, -1000);
+    data.putColumn (strided, part);
+    cube(IPosition(3,1,0,0), IPosition(3,9,15,22), IPosition(3,2,3,1)) = part;
+    AlwaysAssertExit (allEQ (data.getColumn(), cube));
+}
@@ -32,6 +32,7 @@
 #include <tables/Tables/TableDesc.h>
 #include <tables/Tables/TableColumn.h>
 #include <tables/Tables/ExprNodeArray.h>
+#include <casa/Containers/Record.h>
 #include <casa/Containers/ValueHolder.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Arrays/ArrayIO.h>
@@ -478,7 +479,8 @@ Table doCommand (bool printCommand, bool printSelect, bool printMeas,
       s.downcase();
       addCalc = !(s=="select" || s=="update" || s=="insert" || s=="calc" ||
                   s=="delete" || s=="create" || s=="createtable" ||
-                  s=="count"  || s=="using"  || s=="usingstyle"  || s=="time");
+                  s=="count"  || s=="using"  || s=="usingstyle"  || s=="time" ||
+                  s=="explain");
       showResult = (s=="select");
       if (s=="count") {
         doCount    = True;
@@ -495,8 +497,17 @@ Table doCommand (bool printCommand, bool printSelect, bool printMeas,
   uInt i;
   Vector<String> colNames;
   String cmd;
+  Record plan;
   TaQLResult result;
-  result = tableCommand (strc, tempTables, colNames, cmd);
+  result = tableCommand (strc, tempTables, colNames, cmd, plan);
+  // Show the query plan if EXPLAIN was given.
+  // Without ANALYZE the command is not executed, thus has no result.
+  if (plan.nfields() > 0) {
+    cout << plan;
+    if (result.isTable()  &&  result.table().isNull()) {
+      return tabp;
+    }
+  }
   // Show result of COUNT as well.
   if (doCount) {
     colNames.resize (colNames.size() + 1, True);